@@ -0,0 +1,16 @@
+#pragma once
+// Copy to include/env.h (not committed) and adjust for your board.
+
+// I2S microphone (INMP441)
+#define SAMPLE_RATE 16000
+#define I2S_BCLK_PIN 26
+#define I2S_LRCL_PIN 25
+#define I2S_DOUT_PIN 22
+#define LED_PIN 27
+
+// Feature shape, must match include/frontend_params.h
+#define MFCC_NUM_COEFFS 10
+#define MFCC_NUM_FRAMES 65
+
+#define DETECTION_COOLDOWN_MS 2000
+#define DEBUG_LEVEL 2          // 0=Off, 1=Error, 2=Info, 3=Verbose
@@ -0,0 +1,7 @@
+#pragma once
+// Generated by tools/host/vad_calibrate; no noise recording was available,
+// so these are the uncalibrated defaults. Re-run the tool on
+// data/calibration/noise_samples.wav from the target microphone.
+#define VAD_NOISE_FLOOR 0      // Mean square per frame (0 = learned from the first frame)
+#define VAD_ONSET_RATIO 4.0f   // Speech above floor * ratio (+6.0 dB)
+#define VAD_ZCR_THRESHOLD 60   // Zero crossings per 240-sample frame marking fricatives
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <esp_task_wdt.h>
 #include "env.h"
+#include "Trace.h"
+#include "Logger.h"
+
+static_assert(AUDIO_CAPTURE_CHANNELS == 1 || AUDIO_CAPTURE_CHANNELS == 2, "I2S carries one or two microphones");
 
 AudioCapture::AudioCapture() : is_initialized(false) {}
 
@@ -23,7 +27,7 @@ bool AudioCapture::init() {
         .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX),
         .sample_rate = SAMPLE_RATE,
         .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
-        .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
+        .channel_format = AUDIO_CAPTURE_CHANNELS == 2 ? I2S_CHANNEL_FMT_RIGHT_LEFT : I2S_CHANNEL_FMT_ONLY_LEFT,
         .communication_format = I2S_COMM_FORMAT_STAND_I2S,
         .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
         .dma_buf_count = 8,
@@ -66,50 +70,59 @@ bool AudioCapture::init() {
     return true;
 }
 
-bool AudioCapture::read(int16_t* buffer, size_t samples) {
+bool AudioCapture::read(int16_t* buffer, size_t frames) {
+    TRACE_SPAN("capture.read");
+    if (!capture(buffer, frames)) {
+        return false;
+    }
+    condition(buffer, frames * AUDIO_CAPTURE_CHANNELS);
+
+    vTaskDelay(1 / portTICK_PERIOD_MS);
+    esp_task_wdt_reset();
+    return true;
+}
+
+bool AudioCapture::capture(int16_t* buffer, size_t frames) {
     if (!is_initialized) {
-        Serial.println("❌ AudioCapture not initialized");
+        LOG_ERROR("❌ AudioCapture not initialized");
         return false;
     }
 
-    size_t bytes_to_read = samples * sizeof(int16_t);
+    size_t bytes_to_read = frames * AUDIO_CAPTURE_CHANNELS * sizeof(int16_t);
     size_t bytes_read = 0;
 
-    esp_err_t err = i2s_read(I2S_NUM_0, buffer, bytes_to_read, &bytes_read, pdMS_TO_TICKS(100));
+    esp_err_t err;
+    {
+        TRACE_SPAN("capture.i2s_read");
+        err = i2s_read(I2S_NUM_0, buffer, bytes_to_read, &bytes_read, pdMS_TO_TICKS(100));
+    }
     if (err != ESP_OK) {
-        Serial.printf("❌ I2S read failed: %s\n", esp_err_to_name(err));
+        LOG_ERROR("❌ I2S read failed: %s", esp_err_to_name(err));
         return false;
     }
 
     if (bytes_read != bytes_to_read) {
-        Serial.printf("⚠️ Incomplete I2S read: %u/%u bytes\n", bytes_read, bytes_to_read);
+        LOG_ERROR("⚠️ Incomplete I2S read: %u/%u bytes", bytes_read, bytes_to_read);
         return false;
     }
+    LOG_VERBOSE("I2S read %u bytes", bytes_read);
+    return true;
+}
 
+void AudioCapture::condition(int16_t* buffer, size_t samples) {
     // Dynamic gain adjustment
+    TRACE_SPAN("capture.gain");
     int max_amplitude = 0;
     for (size_t i = 0; i < samples; i++) {
         max_amplitude = max(max_amplitude, abs(buffer[i]));
     }
     float gain = (max_amplitude < 1000) ? 32.0f : (max_amplitude < 5000) ? 16.0f : 8.0f;
     for (size_t i = 0; i < samples; i++) {
-        buffer[i] = (int16_t)(buffer[i] * gain);
-        if (buffer[i] > 32767) buffer[i] = 32767;
-        if (buffer[i] < -32768) buffer[i] = -32768;
+        float scaled = buffer[i] * gain; // Clamp before narrowing, not after
+        buffer[i] = (int16_t)(scaled > 32767.0f ? 32767.0f : scaled < -32768.0f ? -32768.0f : scaled);
     }
-    Serial.printf("Applied gain: %.1f\n", gain);
-
-    Serial.printf("I2S read %u bytes\n", bytes_read);
-    #if DEBUG_LEVEL >= 3
-    Serial.print("Raw I2S buffer (first 10 samples): ");
-    for (int i = 0; i < min(10, (int)(bytes_read / sizeof(int16_t))); i++) {
-        Serial.print(buffer[i]);
-        Serial.print(" ");
+    LOG_VERBOSE("Applied gain: %.1f", gain);
+    if (samples >= 4) {
+        LOG_VERBOSE("Conditioned samples: %d %d %d %d", buffer[0], buffer[1], buffer[2], buffer[3]);
     }
-    Serial.println();
-    #endif
-
-    vTaskDelay(1 / portTICK_PERIOD_MS);
-    esp_task_wdt_reset();
-    return true;
 }
\ No newline at end of file
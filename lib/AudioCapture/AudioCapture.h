@@ -4,13 +4,22 @@
 #include <driver/i2s.h>
 #include "env.h" // For SAMPLE_RATE, I2S pins
 
+// Microphones on the bus: 1 (left only) or 2 (an L/R-strapped pair).
+// Frames are then interleaved and need a Beamformer before the front end.
+#ifndef AUDIO_CAPTURE_CHANNELS
+#define AUDIO_CAPTURE_CHANNELS 1
+#endif
+
 class AudioCapture {
 public:
     AudioCapture();
     ~AudioCapture(); // Declare destructor
 
     bool init();
-    bool read(int16_t* buffer, size_t samples);
+    // `frames` of AUDIO_CAPTURE_CHANNELS samples each.
+    bool read(int16_t* buffer, size_t frames); // capture() + condition()
+    bool capture(int16_t* buffer, size_t frames); // Blocks until the DMA delivers
+    static void condition(int16_t* buffer, size_t samples); // Dynamic gain
 
 private:
     bool is_initialized; // Declare member variable
@@ -1,104 +1,248 @@
 #include "AudioProcessor.h"
-#include <cstdint>
-#include "esp_task_wdt.h"
-#include <Arduino.h>
-#include <ArduinoFFT.h>
-
-void AudioProcessor::applyWindow(float* samples, int length) {
-    #if DEBUG_LEVEL >= 2
-    Serial.printf("Applying window to %d samples\n", length);
-    #endif
-    for (int i = 0; i < length; i++) {
-        float window = 0.54f - 0.46f * cos(2.0f * PI * i / (length - 1));
-        samples[i] *= window;
-        if (i % 128 == 0) {
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
+#include <cmath>
+#include <cstring>
+#include "Trace.h"
+#include "Logger.h"
+
+#define FFT_HALF (KWS_FFT_SIZE / 2)
+
+namespace {
+
+float hzToMel(float hz) {
+    return 1127.0f * logf(1.0f + hz / 700.0f);
+}
+
+// Read-only tables shared by every processor, built once on first use.
+struct FrontendTables {
+    float window[KWS_FRAME_SAMPLES];
+    float cos_table[FFT_HALF];    // cos(2*pi*k / KWS_FFT_SIZE)
+    float sin_table[FFT_HALF];
+    uint16_t bit_reverse[FFT_HALF];
+    // Bin k lies on the rising edge of band mel_band[k] with weight
+    // mel_weight[k] and on the falling edge of band mel_band[k] - 1 with
+    // 1 - mel_weight[k]. -1 marks bins outside the filterbank.
+    int8_t mel_band[KWS_SPECTRUM_BINS];
+    float mel_weight[KWS_SPECTRUM_BINS];
+    float dct[KWS_NUM_MFCC * KWS_NUM_MEL];
+
+    FrontendTables() {
+        const double pi = 3.14159265358979323846;
+        for (int n = 0; n < KWS_FRAME_SAMPLES; n++) {
+            window[n] = (float)(0.5 - 0.5 * cos(2.0 * pi * n / KWS_FRAME_SAMPLES));
+        }
+        for (int k = 0; k < FFT_HALF; k++) {
+            cos_table[k] = (float)cos(2.0 * pi * k / KWS_FFT_SIZE);
+            sin_table[k] = (float)sin(2.0 * pi * k / KWS_FFT_SIZE);
+            int reversed = 0;
+            for (int bit = 1, r = FFT_HALF >> 1; bit < FFT_HALF; bit <<= 1, r >>= 1) {
+                if (k & bit) reversed |= r;
+            }
+            bit_reverse[k] = (uint16_t)reversed;
+        }
+
+        // Band edges are evenly spaced in mel, so every segment has the same width.
+        const float mel_low = hzToMel(KWS_MEL_LOW_HZ);
+        const float mel_step = (hzToMel(KWS_MEL_HIGH_HZ) - mel_low) / (KWS_NUM_MEL + 1);
+        mel_band[0] = -1; // DC is excluded, as in tf.signal
+        mel_weight[0] = 0.0f;
+        for (int k = 1; k < KWS_SPECTRUM_BINS; k++) {
+            float position = (hzToMel(k * (float)KWS_SAMPLE_RATE_HZ / KWS_FFT_SIZE) - mel_low) / mel_step;
+            int segment = (int)floorf(position);
+            if (position < 0.0f || segment > KWS_NUM_MEL) {
+                mel_band[k] = -1;
+                mel_weight[k] = 0.0f;
+            } else {
+                mel_band[k] = (int8_t)segment;
+                mel_weight[k] = position - segment;
+            }
+        }
+
+        // tf.signal.mfccs_from_log_mel_spectrograms: unnormalized DCT-II
+        // scaled by 1/sqrt(2 * num_mel).
+        const double scale = sqrt(2.0 / KWS_NUM_MEL);
+        for (int c = 0; c < KWS_NUM_MFCC; c++) {
+            for (int m = 0; m < KWS_NUM_MEL; m++) {
+                dct[c * KWS_NUM_MEL + m] = (float)(scale * cos(pi * c * (2 * m + 1) / (2.0 * KWS_NUM_MEL)));
+            }
         }
     }
-    #if DEBUG_LEVEL >= 3
-    Serial.println("Window application completed");
-    #endif
+};
+
+const FrontendTables& tables() {
+    static const FrontendTables instance;
+    return instance;
 }
 
-void AudioProcessor::computeFFT(float* samples, float* output, int length) {
-    #if DEBUG_LEVEL >= 2
-    Serial.printf("Computing FFT for %d samples\n", length);
-    #endif
-    float* imag = (float*)heap_caps_malloc(WINDOW_SIZE * sizeof(float), MALLOC_CAP_8BIT);
-    if (!imag) {
-        Serial.println("❌ Failed to allocate imag buffer for FFT");
-        return;
+// In-place radix-2 complex FFT of FFT_HALF points (twiddles from the
+// KWS_FFT_SIZE table at stride 2).
+void complexFft(float* re, float* im, const FrontendTables& t) {
+    for (int i = 0; i < FFT_HALF; i++) {
+        int j = t.bit_reverse[i];
+        if (j > i) {
+            float tr = re[i]; re[i] = re[j]; re[j] = tr;
+            float ti = im[i]; im[i] = im[j]; im[j] = ti;
+        }
     }
-    memset(imag, 0, WINDOW_SIZE * sizeof(float));
-    ArduinoFFT<float> FFT = ArduinoFFT<float>(samples, imag, length, SAMPLE_RATE);
-    FFT.windowing(FFT_WIN_TYP_HAMMING, FFT_FORWARD);
-    FFT.compute(FFT_FORWARD);
-    FFT.complexToMagnitude();
-    for (int i = 0; i < length / 2; i++) {
-        output[i] = samples[i] * 100.0f; // Scale magnitude
-        if (i % 128 == 0) {
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
+    for (int size = 2; size <= FFT_HALF; size <<= 1) {
+        int half = size >> 1;
+        int stride = KWS_FFT_SIZE / size;
+        for (int start = 0; start < FFT_HALF; start += size) {
+            for (int k = 0; k < half; k++) {
+                float wr = t.cos_table[k * stride];
+                float wi = -t.sin_table[k * stride];
+                int a = start + k;
+                int b = a + half;
+                float xr = re[b] * wr - im[b] * wi;
+                float xi = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - xr;
+                im[b] = im[a] - xi;
+                re[a] += xr;
+                im[a] += xi;
+            }
         }
     }
-    #if DEBUG_LEVEL >= 3
-    Serial.println("FFT computation completed");
-    Serial.print("First 10 FFT values: ");
-    for (int i = 0; i < min(10, length / 2); i++) {
-        Serial.print(output[i]);
-        Serial.print(" ");
+}
+
+// Magnitude spectrum of KWS_FFT_SIZE real samples (packed as FFT_HALF
+// complex pairs in re/im), KWS_SPECTRUM_BINS outputs.
+void realFftMagnitude(float* re, float* im, float* magnitude, const FrontendTables& t) {
+    complexFft(re, im, t);
+    magnitude[0] = fabsf(re[0] + im[0]);
+    magnitude[FFT_HALF] = fabsf(re[0] - im[0]);
+    for (int k = 1; k < FFT_HALF; k++) {
+        float ar = re[k], ai = im[k];
+        float br = re[FFT_HALF - k], bi = -im[FFT_HALF - k];
+        float even_r = 0.5f * (ar + br), even_i = 0.5f * (ai + bi);
+        float odd_r = 0.5f * (ai - bi), odd_i = -0.5f * (ar - br);
+        float wr = t.cos_table[k], wi = -t.sin_table[k];
+        float xr = even_r + odd_r * wr - odd_i * wi;
+        float xi = even_i + odd_r * wi + odd_i * wr;
+        magnitude[k] = sqrtf(xr * xr + xi * xi);
     }
-    Serial.println();
-    #endif
-    heap_caps_free(imag);
+}
+
+} // namespace
+
+void AudioProcessor::fft(float* re, float* im) {
+    complexFft(re, im, tables());
+}
+
+void FeatureState::reset() {
+    memset(frame, 0, sizeof(frame));
+    memset(history, 0, sizeof(history));
+    frame_fill = 0;
+    history_head = 0;
+    frames_seen = 0;
+}
+
+AudioProcessor::AudioProcessor() : scratch("mfcc", scratch_storage, sizeof(scratch_storage)) {
+    quant.scale = 1.0f;
+    quant.zero_point = 0;
+    tables();
+    state.reset();
+}
+
+void AudioProcessor::setInputQuantization(float scale, int32_t zero_point) {
+    quant.scale = scale;
+    quant.zero_point = zero_point;
+}
+
+void AudioProcessor::reset() {
+    state.reset();
+}
+
+int AudioProcessor::processSamples(const int16_t* samples, size_t count) {
+    return process(state, quant, scratch, samples, count);
+}
+
+void AudioProcessor::copyFeatures(int8_t* mfcc_output) const {
+    copyFeatures(state, mfcc_output);
 }
 
 void AudioProcessor::computeMFCC(const int16_t* audio_samples, int8_t* mfcc_output) {
-    #if DEBUG_LEVEL >= 2
-    Serial.printf("Starting MFCC computation for %d samples\n", WINDOW_SIZE);
-    #endif
-    float* samples = (float*)heap_caps_malloc(WINDOW_SIZE * sizeof(float), MALLOC_CAP_8BIT);
-    if (!samples) {
-        Serial.println("❌ Failed to allocate samples buffer for MFCC");
+    TRACE_SPAN("mfcc");
+    state.reset();
+    processSamples(audio_samples, KWS_WINDOW_SAMPLES);
+    copyFeatures(mfcc_output);
+    LOG_VERBOSE("MFCC computed for %d samples", KWS_WINDOW_SAMPLES);
+}
+
+int AudioProcessor::process(FeatureState& state, const FrontendQuant& quant, Arena& scratch,
+                            const int16_t* samples, size_t count) {
+    int completed = 0;
+    while (count > 0) {
+        size_t take = state.samplesToNextFrame();
+        if (take > count) take = count;
+        memcpy(state.frame + state.frame_fill, samples, take * sizeof(int16_t));
+        state.frame_fill += take;
+        samples += take;
+        count -= take;
+        if (state.frame_fill < KWS_FRAME_SAMPLES) break;
+
+        computeFrame(state.frame, quant, scratch, state.history + state.history_head * KWS_NUM_MFCC);
+        state.history_head = (state.history_head + 1) % KWS_FRAMES;
+        state.frames_seen++;
+        completed++;
+
+        // Frames overlap: keep the tail for the next one.
+        memmove(state.frame, state.frame + KWS_STRIDE_SAMPLES,
+                (KWS_FRAME_SAMPLES - KWS_STRIDE_SAMPLES) * sizeof(int16_t));
+        state.frame_fill = KWS_FRAME_SAMPLES - KWS_STRIDE_SAMPLES;
+    }
+    return completed;
+}
+
+void AudioProcessor::copyFeatures(const FeatureState& state, int8_t* mfcc_output) {
+    // history_head is the oldest frame once the history has wrapped.
+    const size_t tail = (size_t)(KWS_FRAMES - state.history_head) * KWS_NUM_MFCC;
+    memcpy(mfcc_output, state.history + state.history_head * KWS_NUM_MFCC, tail);
+    memcpy(mfcc_output + tail, state.history, (size_t)state.history_head * KWS_NUM_MFCC);
+}
+
+void AudioProcessor::computeFrame(const int16_t* frame, const FrontendQuant& quant, Arena& scratch,
+                                  int8_t* coefficients) {
+    TRACE_SPAN("mfcc.frame");
+    const FrontendTables& t = tables();
+    ArenaScope scope(scratch);
+    float* re = scratch.allocateArray<float>(FFT_HALF);
+    float* im = scratch.allocateArray<float>(FFT_HALF);
+    float* magnitude = scratch.allocateArray<float>(KWS_SPECTRUM_BINS);
+    float* mel = scratch.allocateArray<float>(KWS_NUM_MEL);
+    if (!re || !im || !magnitude || !mel) {
+        LOG_ERROR("❌ MFCC scratch arena exhausted");
+        memset(coefficients, 0, KWS_NUM_MFCC);
         return;
     }
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        samples[i] = (float)audio_samples[i % WINDOW_SIZE] / 32768.0f; // Normalize
-        if (i % 128 == 0) {
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
-        }
+
+    // Even samples go to the real part, odd ones to the imaginary part;
+    // the tail past the frame is zero padding.
+    const float normalize = 1.0f / 32768.0f;
+    for (int i = 0; i < FFT_HALF; i++) {
+        int n = 2 * i;
+        re[i] = n < KWS_FRAME_SAMPLES ? frame[n] * normalize * t.window[n] : 0.0f;
+        im[i] = n + 1 < KWS_FRAME_SAMPLES ? frame[n + 1] * normalize * t.window[n + 1] : 0.0f;
     }
-    #if DEBUG_LEVEL >= 3
-    Serial.println("Converted samples to float");
-    #endif
-
-    float* fft_out = (float*)heap_caps_malloc((WINDOW_SIZE / 2) * sizeof(float), MALLOC_CAP_8BIT);
-    if (!fft_out) {
-        Serial.println("❌ Failed to allocate fft_out buffer for MFCC");
-        heap_caps_free(samples);
-        return;
+    {
+        TRACE_SPAN("mfcc.fft");
+        realFftMagnitude(re, im, magnitude, t);
     }
-    applyWindow(samples, WINDOW_SIZE);
-    computeFFT(samples, fft_out, WINDOW_SIZE);
-
-    for (int i = 0; i < MFCC_NUM_FRAMES * MFCC_NUM_COEFFS; i++) {
-        float value = fft_out[i % (WINDOW_SIZE / 2)] * 10.0f; // Scale for int8_t
-        mfcc_output[i] = (int8_t)min(max((int)value, -128), 127);
-        if (i % 100 == 0) {
-            #if DEBUG_LEVEL >= 3
-            Serial.printf("Processed %d MFCC coefficients\n", i);
-            #endif
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
-        }
+
+    memset(mel, 0, KWS_NUM_MEL * sizeof(float));
+    for (int k = 0; k < KWS_SPECTRUM_BINS; k++) {
+        int band = t.mel_band[k];
+        if (band < 0) continue;
+        if (band < KWS_NUM_MEL) mel[band] += magnitude[k] * t.mel_weight[k];
+        if (band > 0) mel[band - 1] += magnitude[k] * (1.0f - t.mel_weight[k]);
+    }
+    for (int m = 0; m < KWS_NUM_MEL; m++) {
+        mel[m] = logf(mel[m] + 1e-6f);
     }
-    #if DEBUG_LEVEL >= 2
-    Serial.println("MFCC computation completed");
-    #endif
-    heap_caps_free(samples);
-    heap_caps_free(fft_out);
-}
 
-const int16_t AudioProcessor::mfcc_coefficients[MFCC_NUM_COEFFS * MFCC_NUM_FRAMES] = {0};
\ No newline at end of file
+    for (int c = 0; c < KWS_NUM_MFCC; c++) {
+        const float* basis = t.dct + c * KWS_NUM_MEL;
+        float value = 0.0f;
+        for (int m = 0; m < KWS_NUM_MEL; m++) value += basis[m] * mel[m];
+        long q = lrintf(value / quant.scale) + quant.zero_point;
+        coefficients[c] = (int8_t)(q < -128 ? -128 : q > 127 ? 127 : q);
+    }
+}
@@ -1,15 +1,92 @@
 #ifndef AUDIO_PROCESSOR_H
 #define AUDIO_PROCESSOR_H
 
+#include <cstddef>
 #include <cstdint>
-#include "env.h"  // For MFCC_NUM_COEFFS and MFCC_NUM_FRAMES
+#include "frontend_params.h"
+#include "Arena.h"
 
+// Derived front-end geometry (frontend_params.h is exported by the notebook).
+#define KWS_FRAME_SAMPLES (KWS_SAMPLE_RATE_HZ * KWS_FRAME_MS / 1000)    // 480
+#define KWS_STRIDE_SAMPLES (KWS_SAMPLE_RATE_HZ * KWS_STRIDE_MS / 1000)  // 240
+#define KWS_FFT_SIZE 512
+#define KWS_SPECTRUM_BINS (KWS_FFT_SIZE / 2 + 1)
+#define KWS_MEL_LOW_HZ 20.0f
+#define KWS_MEL_HIGH_HZ 4000.0f
+// Samples covered by one model input (KWS_FRAMES frames).
+#define KWS_WINDOW_SAMPLES ((KWS_FRAMES - 1) * KWS_STRIDE_SAMPLES + KWS_FRAME_SAMPLES)
+
+#define MFCC_SCRATCH_SIZE ((KWS_FFT_SIZE + KWS_SPECTRUM_BINS + KWS_NUM_MEL) * sizeof(float) + 32)
+
+// Quantization of the model input the front end produces.
+struct FrontendQuant {
+    float scale;
+    int32_t zero_point;
+};
+
+// Per-stream front-end state (~1.6 KB): the partial frame being collected
+// and the ring of the last KWS_FRAMES feature frames.
+struct FeatureState {
+    int16_t frame[KWS_FRAME_SAMPLES];
+    int8_t history[KWS_FRAMES * KWS_NUM_MFCC];
+    uint16_t frame_fill;
+    uint16_t history_head; // Slot the next frame is written to
+    uint32_t frames_seen;
+
+    void reset();
+    bool ready() const { return frames_seen >= KWS_FRAMES; }
+    // Samples still needed to complete the next frame.
+    size_t samplesToNextFrame() const { return KWS_FRAME_SAMPLES - frame_fill; }
+};
+
+// Streaming log-mel MFCC front end, the same pipeline the model was trained
+// with (tf.signal): 30 ms periodic-Hann frames every 15 ms, 512-point FFT
+// magnitude, 40 mel bands over 20-4000 Hz, log, DCT-II, first 10
+// coefficients, quantized to the model's int8 input.
+//
+// The static functions are the stateless core: any number of streams can
+// share the (read-only) tables, each with its own FeatureState, and a worker
+// supplies MFCC_SCRATCH_SIZE bytes of scratch. An AudioProcessor instance
+// bundles one state with its own scratch for single-stream use.
 class AudioProcessor {
 public:
-    static void computeMFCC(const int16_t* audio_samples, int8_t* mfcc_output);
-    static void applyWindow(float* samples, int length);
-    static void computeFFT(float* samples, float* output, int length);
-    static const int16_t mfcc_coefficients[MFCC_NUM_COEFFS * MFCC_NUM_FRAMES];
+    AudioProcessor();
+
+    // Quantization of the model input (scale, zero point); raw rounded
+    // coefficients until set.
+    void setInputQuantization(float scale, int32_t zero_point);
+    void reset();
+
+    // Returns the number of feature frames completed by these samples.
+    int processSamples(const int16_t* samples, size_t count);
+    bool featuresReady() const { return state.ready(); }
+    uint32_t framesSeen() const { return state.frames_seen; }
+    // Last KWS_FRAMES frames, oldest first: [KWS_FRAMES][KWS_NUM_MFCC].
+    void copyFeatures(int8_t* mfcc_output) const;
+
+    // One-shot: features for exactly KWS_WINDOW_SAMPLES samples. Resets the
+    // streaming state.
+    void computeMFCC(const int16_t* audio_samples, int8_t* mfcc_output);
+
+    const Arena& getArena() const { return scratch; }
+
+    static int process(FeatureState& state, const FrontendQuant& quant, Arena& scratch,
+                       const int16_t* samples, size_t count);
+    static void copyFeatures(const FeatureState& state, int8_t* mfcc_output);
+    // KWS_NUM_MFCC coefficients of one KWS_FRAME_SAMPLES frame (windowed
+    // here), for callers that do their own framing.
+    static void computeFrame(const int16_t* frame, const FrontendQuant& quant, Arena& scratch,
+                             int8_t* coefficients);
+    // The front end's in-place complex FFT of KWS_FFT_SIZE / 2 points, on
+    // its shared tables, for other spectral stages (Beamformer).
+    static void fft(float* re, float* im);
+
+private:
+
+    FrontendQuant quant;
+    FeatureState state;
+    alignas(16) uint8_t scratch_storage[MFCC_SCRATCH_SIZE];
+    Arena scratch;
 };
 
-#endif
\ No newline at end of file
+#endif
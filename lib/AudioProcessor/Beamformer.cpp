@@ -0,0 +1,205 @@
+#include "Beamformer.h"
+#include <cmath>
+#include <cstring>
+#include "Trace.h"
+
+#define BAND_LOW ((int)(KWS_MEL_LOW_HZ * BEAMFORMER_FFT_POINTS / KWS_SAMPLE_RATE_HZ) + 1)
+#define BAND_HIGH ((int)(KWS_MEL_HIGH_HZ * BEAMFORMER_FFT_POINTS / KWS_SAMPLE_RATE_HZ))
+
+namespace {
+
+// Windowed-sinc fractional delays, unity gain: phase p delays by
+// p / BEAMFORMER_FRACTIONS on top of BEAMFORMER_TAPS / 2 - 1 samples.
+struct DelayTable {
+    float taps[BEAMFORMER_FRACTIONS][BEAMFORMER_TAPS];
+
+    DelayTable() {
+        const double pi = 3.14159265358979323846;
+        const double half = BEAMFORMER_TAPS / 2.0;
+        for (int p = 0; p < BEAMFORMER_FRACTIONS; p++) {
+            const double fraction = (double)p / BEAMFORMER_FRACTIONS;
+            double sum = 0.0;
+            for (int j = 0; j < BEAMFORMER_TAPS; j++) {
+                const double x = half - 1 - j + fraction; // Distance from the wanted instant
+                const double sinc = x == 0.0 ? 1.0 : sin(pi * x) / (pi * x);
+                const double window = 0.5 + 0.5 * cos(pi * x / half);
+                taps[p][j] = (float)(sinc * window);
+                sum += taps[p][j];
+            }
+            for (int j = 0; j < BEAMFORMER_TAPS; j++) taps[p][j] = (float)(taps[p][j] / sum);
+        }
+    }
+};
+
+const DelayTable& delayTable() {
+    static const DelayTable instance;
+    return instance;
+}
+
+// Channels a and b of a two-real-in-one-complex FFT, bin k.
+inline void separate(const float* re, const float* im, int k, float& ar, float& ai, float& br, float& bi) {
+    const int m = (BEAMFORMER_FFT_POINTS - k) % BEAMFORMER_FFT_POINTS;
+    ar = 0.5f * (re[k] + re[m]);
+    ai = 0.5f * (im[k] - im[m]);
+    br = 0.5f * (im[k] + im[m]);
+    bi = -0.5f * (re[k] - re[m]);
+}
+
+} // namespace
+
+Beamformer::Beamformer(int channels) {
+    delayTable();
+    configure(channels);
+}
+
+void Beamformer::configure(int channels) {
+    channels_ = channels < 1 ? 1 : channels > BEAMFORMER_MAX_CHANNELS ? BEAMFORMER_MAX_CHANNELS : channels;
+    reset();
+}
+
+void Beamformer::reset() {
+    memset(work_, 0, sizeof(work_));
+    memset(cross_re_, 0, sizeof(cross_re_));
+    memset(cross_im_, 0, sizeof(cross_im_));
+    for (int c = 0; c < BEAMFORMER_MAX_CHANNELS; c++) {
+        delay_[c] = 0.0f;
+        coherence_[c] = 0.0f;
+        setTaps(c);
+    }
+}
+
+void Beamformer::process(const int16_t* interleaved, size_t frames, int16_t* out) {
+    if (channels_ == 1) {
+        memcpy(out, interleaved, frames * sizeof(int16_t));
+        return;
+    }
+    TRACE_SPAN("beamformer");
+    const size_t segments = (frames + BEAMFORMER_SEGMENT - 1) / BEAMFORMER_SEGMENT;
+    if (segments == 0) return;
+    for (int c = 0; c < channels_ - 1; c++) {
+        for (int k = 0; k < BEAMFORMER_BINS; k++) {
+            cross_re_[c][k] *= BEAMFORMER_SMOOTHING;
+            cross_im_[c][k] *= BEAMFORMER_SMOOTHING;
+        }
+    }
+    const float weight = (1.0f - BEAMFORMER_SMOOTHING) / segments;
+
+    for (size_t done = 0; done < frames; done += BEAMFORMER_SEGMENT) {
+        const size_t count = frames - done < BEAMFORMER_SEGMENT ? frames - done : BEAMFORMER_SEGMENT;
+        const int16_t* in = interleaved + done * channels_;
+        for (size_t i = 0; i < count; i++) {
+            for (int c = 0; c < channels_; c++) work_[c][BEAMFORMER_HISTORY + i] = in[i * channels_ + c];
+        }
+        estimate(count, weight);
+        sum(count, out + done);
+        for (int c = 0; c < channels_; c++) {
+            memmove(work_[c], work_[c] + count, BEAMFORMER_HISTORY * sizeof(int16_t));
+        }
+    }
+    steer();
+}
+
+// Adds the block's phase-only cross-spectra, two channels per FFT.
+void Beamformer::estimate(size_t count, float weight) {
+    for (int first = 0; first < channels_; first += 2) {
+        const int16_t* a = work_[first] + BEAMFORMER_HISTORY;
+        const int16_t* b = first + 1 < channels_ ? work_[first + 1] + BEAMFORMER_HISTORY : nullptr;
+        for (size_t i = 0; i < count; i++) {
+            re_[i] = a[i];
+            im_[i] = b ? b[i] : 0.0f;
+        }
+        for (size_t i = count; i < BEAMFORMER_FFT_POINTS; i++) re_[i] = im_[i] = 0.0f;
+        AudioProcessor::fft(re_, im_);
+
+        for (int k = BAND_LOW; k <= BAND_HIGH; k++) {
+            float ar, ai, br, bi;
+            separate(re_, im_, k, ar, ai, br, bi);
+            if (first == 0) {
+                reference_re_[k] = ar;
+                reference_im_[k] = ai;
+            }
+            // Channel c's spectrum times the reference's conjugate, phase only.
+            for (int side = first == 0 ? 1 : 0; side < 2 && first + side < channels_; side++) {
+                const float xr = side ? br : ar, xi = side ? bi : ai;
+                const float gr = xr * reference_re_[k] + xi * reference_im_[k];
+                const float gi = xi * reference_re_[k] - xr * reference_im_[k];
+                const float magnitude = sqrtf(gr * gr + gi * gi);
+                if (magnitude < 1e-3f) continue; // Silence carries no phase
+                const int c = first + side - 1;
+                cross_re_[c][k] += weight * gr / magnitude;
+                cross_im_[c][k] += weight * gi / magnitude;
+            }
+        }
+    }
+}
+
+// Inverse FFT of each averaged cross-spectrum (the forward one on the
+// conjugate) and a parabola through the peak within BEAMFORMER_MAX_LAG.
+void Beamformer::steer() {
+    const int n = BEAMFORMER_FFT_POINTS;
+    const float scale = (float)n / (2 * (BAND_HIGH - BAND_LOW + 1)); // A coherent peak reads 1
+    for (int c = 1; c < channels_; c++) {
+        for (int k = 0; k < n; k++) re_[k] = im_[k] = 0.0f;
+        for (int k = BAND_LOW; k <= BAND_HIGH; k++) {
+            // Conjugated, and mirrored so the correlation comes out real.
+            re_[k] = re_[n - k] = cross_re_[c - 1][k];
+            im_[k] = -cross_im_[c - 1][k];
+            im_[n - k] = cross_im_[c - 1][k];
+        }
+        AudioProcessor::fft(re_, im_);
+
+        int peak = 0;
+        for (int lag = -BEAMFORMER_MAX_LAG; lag <= BEAMFORMER_MAX_LAG; lag++) {
+            if (re_[(lag + n) % n] > re_[(peak + n) % n]) peak = lag;
+        }
+        const float height = re_[(peak + n) % n] / n * scale;
+        coherence_[c] = height;
+        if (height < BEAMFORMER_MIN_COHERENCE) continue;
+
+        float offset = 0.0f;
+        if (peak > -BEAMFORMER_MAX_LAG && peak < BEAMFORMER_MAX_LAG) {
+            const float before = re_[(peak - 1 + n) % n], at = re_[(peak + n) % n], after = re_[(peak + 1) % n];
+            const float curvature = before - 2.0f * at + after;
+            if (curvature < 0.0f) offset = 0.5f * (before - after) / curvature;
+        }
+        delay_[c] = peak + offset;
+        setTaps(c);
+    }
+}
+
+// Channel c is delayed by BEAMFORMER_MAX_LAG - delay, so every channel
+// lines up BEAMFORMER_LATENCY samples behind the input.
+void Beamformer::setTaps(int c) {
+    const float total = BEAMFORMER_MAX_LAG - delay_[c] + BEAMFORMER_TAPS / 2 - 1;
+    int whole = (int)floorf(total);
+    int phase = (int)lrintf((total - whole) * BEAMFORMER_FRACTIONS);
+    if (phase == BEAMFORMER_FRACTIONS) {
+        whole++;
+        phase = 0;
+    }
+    shift_[c] = whole;
+    const float gain = 32767.0f / channels_;
+    for (int j = 0; j < BEAMFORMER_TAPS; j++) {
+        taps_[c][j] = (int16_t)lrintf(delayTable().taps[phase][j] * gain);
+    }
+}
+
+// One tap of one channel over the whole block per pass: an int16 multiply-
+// add of fixed length the compiler vectorizes. A short last block computes
+// the full length (over stale samples) and keeps only its own outputs.
+void Beamformer::sum(size_t count, int16_t* out) {
+    int32_t acc[BEAMFORMER_SEGMENT];
+    for (int i = 0; i < BEAMFORMER_SEGMENT; i++) acc[i] = 1 << 14;
+    for (int c = 0; c < channels_; c++) {
+        const int16_t* newest = work_[c] + BEAMFORMER_HISTORY - shift_[c] + BEAMFORMER_TAPS / 2 - 1;
+        for (int j = 0; j < BEAMFORMER_TAPS; j++) {
+            const int16_t tap = taps_[c][j];
+            const int16_t* __restrict source = newest - j;
+            for (int i = 0; i < BEAMFORMER_SEGMENT; i++) acc[i] += (int32_t)source[i] * tap;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        const int32_t value = acc[i] >> 15;
+        out[i] = (int16_t)(value > 32767 ? 32767 : value < -32768 ? -32768 : value);
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef BEAMFORMER_H
+#define BEAMFORMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "AudioProcessor.h"
+
+#define BEAMFORMER_MAX_CHANNELS 4
+// Largest inter-mic delay steered to, in samples either way (8 is 17 cm of
+// spacing at 16 kHz).
+#define BEAMFORMER_MAX_LAG 8
+#define BEAMFORMER_TAPS 8      // Fractional-delay FIR per channel
+#define BEAMFORMER_FRACTIONS 32 // Delays are rounded to 1/32 sample
+// GCC-PHAT block: half the FFT, so the zero padding keeps the correlation
+// linear.
+#define BEAMFORMER_SEGMENT (KWS_FFT_SIZE / 4)
+#define BEAMFORMER_FFT_POINTS (KWS_FFT_SIZE / 2)
+#define BEAMFORMER_BINS (BEAMFORMER_FFT_POINTS / 2 + 1)
+#define BEAMFORMER_SMOOTHING 0.8f     // Weight of earlier calls in the averaged cross-spectrum
+#define BEAMFORMER_MIN_COHERENCE 0.2f // Correlation peak needed to re-steer
+#define BEAMFORMER_HISTORY (2 * BEAMFORMER_MAX_LAG + BEAMFORMER_TAPS)
+
+// Delay-and-sum beamformer: interleaved frames from several microphones in,
+// one enhanced channel out, ahead of the front end.
+//
+// Each call measures the delay of every channel against channel 0 with
+// GCC-PHAT: blocks of BEAMFORMER_SEGMENT frames go through the front end's
+// FFT two channels at a time, their phase-only cross-spectra over the mel
+// band (KWS_MEL_LOW_HZ - KWS_MEL_HIGH_HZ) are averaged across calls, and the
+// correlation peak is refined to a fraction of a sample. Steering only
+// follows peaks above BEAMFORMER_MIN_COHERENCE, so it holds through silence.
+// The channels are then aligned by Q15 windowed-sinc fractional delays and
+// averaged; the kernel runs over a block at a time so the compiler
+// vectorizes it. Talk from the steered direction adds coherently while
+// diffuse noise does not, about 3 dB per doubling of microphones.
+//
+// Output lags input by a constant BEAMFORMER_LATENCY samples, whatever the
+// steering. One channel is passed straight through.
+#define BEAMFORMER_LATENCY (BEAMFORMER_MAX_LAG + BEAMFORMER_TAPS / 2 - 1)
+
+class Beamformer {
+public:
+    explicit Beamformer(int channels = 1);
+
+    // 1..BEAMFORMER_MAX_CHANNELS; resets.
+    void configure(int channels);
+    int channels() const { return channels_; }
+    // Forgets the audio and the steering (broadside: no delays).
+    void reset();
+    // `frames` interleaved frames in, as many mono samples out.
+    void process(const int16_t* interleaved, size_t frames, int16_t* out);
+
+    // Samples by which channel `c` lags channel 0, as steered now.
+    float delay(int c) const { return delay_[c]; }
+    // Height of the latest correlation peak for channel `c` (1 = coherent).
+    float coherence(int c) const { return coherence_[c]; }
+
+private:
+    void estimate(size_t count, float weight);
+    void steer();
+    void setTaps(int c);
+    void sum(size_t count, int16_t* out);
+
+    int channels_;
+    float delay_[BEAMFORMER_MAX_CHANNELS];
+    float coherence_[BEAMFORMER_MAX_CHANNELS];
+    int shift_[BEAMFORMER_MAX_CHANNELS];                   // Whole samples of delay
+    int16_t taps_[BEAMFORMER_MAX_CHANNELS][BEAMFORMER_TAPS]; // Q15, 1/channels gain
+    // Per channel: the last BEAMFORMER_HISTORY samples, then the block.
+    int16_t work_[BEAMFORMER_MAX_CHANNELS][BEAMFORMER_HISTORY + BEAMFORMER_SEGMENT];
+    // Averaged phase-only cross-spectrum of channel c + 1 against channel 0.
+    float cross_re_[BEAMFORMER_MAX_CHANNELS - 1][BEAMFORMER_BINS];
+    float cross_im_[BEAMFORMER_MAX_CHANNELS - 1][BEAMFORMER_BINS];
+    float reference_re_[BEAMFORMER_BINS]; // Channel 0's spectrum of the block
+    float reference_im_[BEAMFORMER_BINS];
+    alignas(16) float re_[BEAMFORMER_FFT_POINTS];
+    alignas(16) float im_[BEAMFORMER_FFT_POINTS];
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "VoiceActivity.h"
+
+VadConfig VadConfig::calibrated() {
+    VadConfig config;
+    config.noise_floor = VAD_NOISE_FLOOR;
+    config.onset_ratio = VAD_ONSET_RATIO;
+    config.zcr_threshold = VAD_ZCR_THRESHOLD;
+    return config;
+}
+
+VoiceActivity::VoiceActivity(const VadConfig& config) : config_(config) {
+    reset();
+}
+
+void VoiceActivity::reset() {
+    sum_squares_ = 0;
+    crossings_ = 0;
+    fill_ = 0;
+    previous_ = 0;
+    floor_ = config_.noise_floor;
+    hangover_ = VAD_HANGOVER_FRAMES;
+    last_energy_ = 0;
+    last_crossings_ = 0;
+    frames_ = 0;
+    speech_frames_ = 0;
+}
+
+void VoiceActivity::configure(const VadConfig& config) {
+    config_ = config;
+    reset();
+}
+
+void VoiceActivity::update(const int16_t* samples, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const int32_t x = samples[i];
+        sum_squares_ += (uint32_t)(x * x);
+        if ((x ^ previous_) < 0) crossings_++; // Sign change (zero counts as positive)
+        previous_ = (int16_t)x;
+        if (++fill_ == KWS_STRIDE_SAMPLES) endFrame();
+    }
+}
+
+void VoiceActivity::endFrame() {
+    const uint32_t energy = (uint32_t)(sum_squares_ / KWS_STRIDE_SAMPLES);
+    last_energy_ = energy;
+    last_crossings_ = crossings_;
+    sum_squares_ = 0;
+    crossings_ = 0;
+    fill_ = 0;
+    frames_++;
+
+    if (floor_ == 0) floor_ = energy > VAD_MIN_ENERGY ? energy : VAD_MIN_ENERGY;
+    const bool speech = energy > VAD_MIN_ENERGY &&
+                        (energy > floor_ * config_.onset_ratio ||
+                         (energy > floor_ * VAD_FRICATIVE_RATIO && last_crossings_ >= config_.zcr_threshold));
+    if (speech) {
+        speech_frames_++;
+        hangover_ = VAD_HANGOVER_FRAMES;
+        // Creep up even while "speaking", so a noise source that switches
+        // on for good is absorbed after a few seconds instead of holding
+        // the gate open forever.
+        floor_ += (energy - floor_) >> 9;
+    } else {
+        if (hangover_ > 0) hangover_--;
+        if (energy < floor_) floor_ = energy > VAD_MIN_ENERGY ? energy : VAD_MIN_ENERGY;
+        else floor_ += (energy - floor_) >> 5;
+    }
+}
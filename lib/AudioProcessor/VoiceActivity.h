@@ -0,0 +1,70 @@
+#ifndef VOICE_ACTIVITY_H
+#define VOICE_ACTIVITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include "AudioProcessor.h"
+#include "vad_params.h"
+
+// The gate stays open this many frames after the last speech frame: one
+// model window, so a word keeps being inferred on until it has crossed the
+// whole input (the posterior peaks once all of it is in view).
+#define VAD_HANGOVER_FRAMES KWS_FRAMES
+// Conditioned frames below this mean square are silent whatever the floor.
+#define VAD_MIN_ENERGY 64
+// Unvoiced onsets (/s/, /f/) are quiet but cross zero often: a frame this
+// far above the floor counts as speech when its crossings are noise-unlike.
+#define VAD_FRICATIVE_RATIO 2.0f
+
+struct VadConfig {
+    uint32_t noise_floor;   // Initial mean square per frame; 0 = learn it from the first frame
+    float onset_ratio;      // Speech when a frame's energy exceeds floor * ratio
+    uint16_t zcr_threshold; // Zero crossings per frame that mark fricatives
+
+    static VadConfig calibrated(); // From vad_params.h
+};
+
+// Energy plus zero-crossing voice activity detector for one stream, on
+// KWS_STRIDE_SAMPLES frames (aligned with the feature frames when fed the
+// same samples). The noise floor falls to quiet frames at once and rises
+// slowly, so it follows a changing room without locking onto speech. About
+// one multiply-add per sample.
+class VoiceActivity {
+public:
+    explicit VoiceActivity(const VadConfig& config = VadConfig::calibrated());
+
+    // Starts open (one hangover), so a fresh stream is never gated before
+    // the floor has been measured.
+    void reset();
+    // New parameters take effect from a reset gate.
+    void configure(const VadConfig& config);
+    const VadConfig& config() const { return config_; }
+    // A frame may span calls; decisions are taken as frames complete.
+    void update(const int16_t* samples, size_t count);
+    // Speech seen within the last VAD_HANGOVER_FRAMES frames.
+    bool active() const { return hangover_ > 0; }
+
+    uint32_t noiseFloor() const { return floor_; }
+    uint32_t frames() const { return frames_; }
+    uint32_t speechFrames() const { return speech_frames_; }
+    // Latest complete frame.
+    uint32_t lastEnergy() const { return last_energy_; }
+    uint16_t lastCrossings() const { return last_crossings_; }
+
+private:
+    void endFrame();
+
+    VadConfig config_;
+    uint64_t sum_squares_;
+    uint16_t crossings_;
+    uint16_t fill_;
+    int16_t previous_;
+    uint32_t floor_;
+    uint16_t hangover_;
+    uint32_t last_energy_;
+    uint16_t last_crossings_;
+    uint32_t frames_;
+    uint32_t speech_frames_;
+};
+
+#endif
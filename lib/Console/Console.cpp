@@ -0,0 +1,291 @@
+#include "Console.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "Adpcm.h"
+#include "Arena.h"
+#include "Logger.h"
+#include "Trace.h"
+
+static bool parseFloat(const char* text, float& value) {
+    if (!text) return false;
+    char* end = nullptr;
+    value = strtof(text, &end);
+    return end != text && *end == '\0' && std::isfinite(value);
+}
+
+static bool parseUnsigned(const char* text, unsigned long max, unsigned long& value) {
+    if (!text || *text < '0' || *text > '9') return false;
+    char* end = nullptr;
+    value = strtoul(text, &end, 10);
+    return *end == '\0' && value <= max;
+}
+
+// A complete IMA-ADPCM WAV as hex lines between markers, a quarter of the
+// bytes of the PCM. tools/audio_dump.py turns a captured log into .wav files.
+static void dumpRecording(const DetectorRecording& recording) {
+    uint8_t header[ADPCM_WAV_HEADER_BYTES];
+    Adpcm::wavHeader(header, KWS_SAMPLE_RATE_HZ, recording.samples, (uint32_t)recording.block_count);
+    const size_t bytes = recording.block_count * ADPCM_BLOCK_BYTES;
+    Serial.printf("AUDIO-BEGIN v1 rate=%d samples=%u bytes=%u\n", KWS_SAMPLE_RATE_HZ, (unsigned)recording.samples,
+                  (unsigned)(sizeof(header) + bytes));
+    static const char digits[] = "0123456789abcdef";
+    char line[2 * CONSOLE_HEX_BYTES + 1];
+    for (size_t offset = 0; offset < sizeof(header) + bytes; offset += CONSOLE_HEX_BYTES) {
+        size_t length = 0;
+        for (size_t i = offset; i < offset + CONSOLE_HEX_BYTES && i < sizeof(header) + bytes; i++) {
+            const uint8_t byte = i < sizeof(header) ? header[i] : recording.blocks[i - sizeof(header)];
+            line[length++] = digits[byte >> 4];
+            line[length++] = digits[byte & 15];
+        }
+        line[length] = '\0';
+        Serial.println(line);
+    }
+    Serial.println("AUDIO-END");
+}
+
+Console::Console(WakeWordDetector& detector)
+    : detector_(detector), tuning_(detector.getTuning()), length_(0), overflow_(false), bench_pending_(false),
+      record_pending_(false) {}
+
+void Console::begin() {
+    tuning_ = detector_.getTuning();
+}
+
+void Console::poll() {
+    int c;
+    while ((c = Serial.read()) >= 0) accept((char)c);
+
+    DetectorBench bench;
+    if (bench_pending_ && detector_.takeBench(bench)) {
+        bench_pending_ = false;
+        Serial.printf("⏱️ Bench, mean of %u runs (us): condition %u, features %u, vad %u, inference %u, "
+                      "keywords %u\n", (unsigned)bench.repetitions, (unsigned)bench.condition_us,
+                      (unsigned)bench.features_us, (unsigned)bench.vad_us, (unsigned)bench.inference_us,
+                      (unsigned)bench.keywords_us);
+    }
+
+    DetectorRecording recording;
+    if (record_pending_ && detector_.takeRecording(recording)) {
+        record_pending_ = false;
+        dumpRecording(recording);
+        detector_.releaseRecording();
+    }
+}
+
+void Console::feed(const char* text, size_t length) {
+    for (size_t i = 0; i < length; i++) accept(text[i]);
+}
+
+void Console::task(void* console) {
+    Console& self = *static_cast<Console*>(console);
+    for (;;) {
+        self.poll();
+        vTaskDelay(CONSOLE_POLL_MS / portTICK_PERIOD_MS);
+    }
+}
+
+void Console::accept(char c) {
+    if (c == '\r' || c == '\n') {
+        if (overflow_) {
+            Serial.printf("⚠️ Line longer than %d characters ignored\n", CONSOLE_LINE_MAX - 1);
+        } else if (length_ > 0) {
+            line_[length_] = '\0';
+            execute(line_);
+        }
+        length_ = 0;
+        overflow_ = false;
+    } else if (c == '\b' || c == 0x7f) {
+        if (length_ > 0) length_--;
+    } else if (length_ + 1 < CONSOLE_LINE_MAX) {
+        line_[length_++] = c;
+    } else {
+        overflow_ = true;
+    }
+}
+
+bool Console::submit(const DetectorTuning& tuning) {
+    DetectorRequest request = {};
+    request.type = DETECTOR_REQUEST_TUNE;
+    request.tuning = tuning;
+    if (!detector_.post(request)) {
+        Serial.println("⚠️ Detector busy, try again");
+        return false;
+    }
+    tuning_ = tuning;
+    return true;
+}
+
+void Console::help() {
+    Serial.println("📖 Commands:");
+    Serial.println("   help | stats | reset");
+    Serial.println("   threshold <0..1>        trigger threshold");
+    Serial.printf("   cadence <1..%d>          built-in model every Nth hop (%d ms)\n", DETECTOR_MAX_STRIDE,
+                  DETECTOR_HOP_SAMPLES * 1000 / KWS_SAMPLE_RATE_HZ);
+    Serial.println("   vad on|off | vad onset <ratio> | vad zcr <n> | vad floor <n>");
+    Serial.println("   calibrate               seed the gate's noise floor from the room");
+    Serial.printf("   bench [1..%d]           time each stage in place\n", DETECTOR_BENCH_MAX_REPETITIONS);
+    Serial.println("   trace on|off|dump|clear");
+    Serial.printf("   record                  last %d ms of audio, IMA-ADPCM WAV in hex\n", DETECTOR_RECORD_MS);
+}
+
+void Console::execute(char* line) {
+    char* words[3] = {};
+    int count = 0;
+    char* rest = nullptr;
+    for (char* word = strtok_r(line, " \t", &rest); word; word = strtok_r(nullptr, " \t", &rest)) {
+        if (count == 3) {
+            Serial.println("⚠️ Too many arguments (try help)");
+            return;
+        }
+        words[count++] = word;
+    }
+    if (count == 0) return;
+    const char* command = words[0];
+    const char* arg = words[1];
+    DetectorTuning next = tuning_;
+    float value;
+    unsigned long number;
+
+    if (!strcmp(command, "help")) {
+        help();
+    } else if (!strcmp(command, "stats")) {
+        Serial.printf("📊 Heap free %u bytes, threshold %.3f, cadence %u, detections %d, log drops %u\n",
+                      esp_get_free_heap_size(), tuning_.threshold, (unsigned)tuning_.stride_hops,
+                      detector_.getDetectionCount(), (unsigned)Logger::droppedCount());
+        printStats(detector_);
+    } else if (!strcmp(command, "reset")) {
+        DetectorRequest request = {};
+        request.type = DETECTOR_REQUEST_RESET_STATS;
+        if (detector_.post(request)) Serial.println("✅ Statistics cleared");
+        else Serial.println("⚠️ Detector busy, try again");
+    } else if (!strcmp(command, "threshold") && count == 2) {
+        if (!parseFloat(arg, value) || value < 0.0f || value > 1.0f) {
+            Serial.println("⚠️ threshold takes a value in 0..1");
+            return;
+        }
+        next.threshold = value;
+        if (submit(next)) Serial.printf("🎯 Threshold %.3f\n", value);
+    } else if (!strcmp(command, "cadence") && count == 2) {
+        if (!parseUnsigned(arg, DETECTOR_MAX_STRIDE, number) || number < 1) {
+            Serial.printf("⚠️ cadence takes 1..%d hops\n", DETECTOR_MAX_STRIDE);
+            return;
+        }
+        next.stride_hops = (uint8_t)number;
+        if (submit(next)) {
+            Serial.printf("⏲️ Built-in model every %lu hop(s), %lu ms\n", number,
+                          number * DETECTOR_HOP_SAMPLES * 1000 / KWS_SAMPLE_RATE_HZ);
+        }
+    } else if (!strcmp(command, "vad") && count >= 2) {
+        const char* setting = words[2];
+        if (!strcmp(arg, "on") || !strcmp(arg, "off")) {
+            if (count != 2) {
+                help();
+                return;
+            }
+            next.vad_enabled = !strcmp(arg, "on");
+        } else if (!strcmp(arg, "onset") && parseFloat(setting, value) && value >= 1.0f) {
+            next.vad.onset_ratio = value;
+        } else if (!strcmp(arg, "zcr") && parseUnsigned(setting, UINT16_MAX, number)) {
+            next.vad.zcr_threshold = (uint16_t)number;
+        } else if (!strcmp(arg, "floor") && parseUnsigned(setting, UINT32_MAX, number)) {
+            next.vad.noise_floor = (uint32_t)number;
+        } else {
+            Serial.println("⚠️ vad on|off, vad onset <ratio >= 1>, vad zcr <n>, vad floor <n>");
+            return;
+        }
+        if (submit(next)) {
+            Serial.printf("🔇 VAD %s: onset %.2f, zcr %u, floor %u\n", next.vad_enabled ? "on" : "off",
+                          next.vad.onset_ratio, (unsigned)next.vad.zcr_threshold, (unsigned)next.vad.noise_floor);
+        }
+    } else if (!strcmp(command, "calibrate") && count == 1) {
+        // The live floor tracks the quietest recent frames; a reset gate
+        // starts from it instead of relearning.
+        DetectorStats stats;
+        detector_.getStats(stats);
+        next.vad.noise_floor = stats.noise_floor;
+        if (submit(next)) {
+            Serial.printf("🔇 Noise floor %u (rms %.0f); warm start keeps the live floor across reboots\n",
+                          (unsigned)stats.noise_floor, sqrt((double)stats.noise_floor));
+        }
+    } else if (!strcmp(command, "bench") && count <= 2) {
+        number = CONSOLE_BENCH_REPETITIONS;
+        if (arg && (!parseUnsigned(arg, DETECTOR_BENCH_MAX_REPETITIONS, number) || number < 1)) {
+            Serial.printf("⚠️ bench takes 1..%d runs\n", DETECTOR_BENCH_MAX_REPETITIONS);
+            return;
+        }
+        if (bench_pending_) {
+            Serial.println("⚠️ A bench is already running");
+            return;
+        }
+        DetectorRequest request = {};
+        request.type = DETECTOR_REQUEST_BENCH;
+        request.repetitions = (uint16_t)number;
+        if (!detector_.post(request)) {
+            Serial.println("⚠️ Detector busy, try again");
+            return;
+        }
+        bench_pending_ = true;
+        Serial.printf("⏱️ Bench of %lu runs queued for the next hop\n", number);
+    } else if (!strcmp(command, "record") && count == 1) {
+        if (record_pending_) {
+            Serial.println("⚠️ A recording is already on its way");
+            return;
+        }
+        DetectorRequest request = {};
+        request.type = DETECTOR_REQUEST_RECORD;
+        if (!detector_.post(request)) {
+            Serial.println("⚠️ Detector busy, try again");
+            return;
+        }
+        record_pending_ = true;
+        Serial.printf("🎙️ Recording of the last %d ms queued for the next hop\n", DETECTOR_RECORD_MS);
+    } else if (!strcmp(command, "trace") && count == 2) {
+#if ENABLE_TRACE
+        if (!strcmp(arg, "on") || !strcmp(arg, "off")) {
+            Trace::setEnabled(!strcmp(arg, "on"));
+            Serial.printf("🧵 Tracing %s\n", arg);
+        } else if (!strcmp(arg, "dump")) {
+            // Convert the captured log with tools/trace_to_chrome.py.
+#ifdef ARDUINO
+            Trace::dump(Serial);
+#else
+            Trace::dump(stdout);
+#endif
+        } else if (!strcmp(arg, "clear")) {
+            Trace::clear();
+            Serial.println("🧵 Trace rings cleared");
+        } else {
+            help();
+        }
+#else
+        Serial.println("⚠️ Tracing is not built in (build with -DENABLE_TRACE=1)");
+#endif
+    } else {
+        Serial.printf("⚠️ Unknown command or arguments: %s (try help)\n", command);
+    }
+}
+
+void Console::printStats(const WakeWordDetector& detector) {
+    for (const Arena* arena = Arena::first(); arena; arena = arena->next()) {
+        Serial.printf("   Arena %-6s high-water %u/%u bytes%s\n", arena->name(), (unsigned)arena->highWater(),
+                      (unsigned)arena->capacity(), arena->failures() ? " ⚠️ exhausted" : "");
+    }
+    DetectorStats stats;
+    detector.getStats(stats);
+    Serial.printf("   Latency (us)   count      p50      p90      p99      max\n");
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        const LatencySnapshot& s = stats.stages[i];
+        Serial.printf("   %-10s %9u %8u %8u %8u %8u\n", WakeWordDetector::stageName(i), (unsigned)s.count,
+                      (unsigned)s.p50_us, (unsigned)s.p90_us, (unsigned)s.p99_us, (unsigned)s.max_us);
+    }
+    if (stats.voice_gate && stats.inferences_due) {
+        Serial.printf("   VAD: skipped %u/%u inferences (%.0f%%), noise floor rms %.0f\n",
+                      (unsigned)stats.inferences_skipped, (unsigned)stats.inferences_due,
+                      100.0 * stats.inferences_skipped / stats.inferences_due, sqrt((double)stats.noise_floor));
+    }
+}
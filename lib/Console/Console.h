@@ -0,0 +1,68 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "WakeWordDetector.h"
+
+#define CONSOLE_LINE_MAX 64        // Longest command, terminator included
+#define CONSOLE_POLL_MS 50
+#define CONSOLE_BENCH_REPETITIONS 20
+#define CONSOLE_HEX_BYTES 32       // Bytes per line of a recording dump
+
+// Line-oriented control plane on Serial (stdin in the native build), for
+// tuning a running detector without a rebuild:
+//
+//   help                  commands
+//   stats                 heap, arenas, latency histograms and counters
+//   reset                 clear the latency histograms and counters
+//   threshold 0.8         trigger threshold
+//   cadence 2             built-in model every 2nd hop (1..DETECTOR_MAX_STRIDE)
+//   vad on|off            voice-activity gate
+//   vad onset 8.5         gate parameters (VadConfig)
+//   vad zcr 120
+//   vad floor 400
+//   calibrate             seed the gate's noise floor with the one measured now
+//   bench [N]             time each stage N times in place
+//   trace on|off|dump|clear
+//   record                the latest DETECTOR_RECORD_MS as an IMA-ADPCM WAV, in hex
+//
+// Input is read without blocking and parsed as it arrives. Commands never
+// touch the detector's state: changes go through WakeWordDetector::post()
+// as one complete DetectorTuning, applied between hops by the detection
+// task, so the console can run in its own low-priority task.
+class Console {
+public:
+    explicit Console(WakeWordDetector& detector);
+
+    // Takes the detector's current tuning as the base for changes. Call once
+    // the detector is configured, before the console task starts.
+    void begin();
+    // Drains pending input and runs every complete line, then reports a
+    // finished bench and dumps a finished recording. Never blocks on input.
+    void poll();
+    // Input from elsewhere than Serial; runs every complete line.
+    void feed(const char* text, size_t length);
+
+    // FreeRTOS task body: poll() every CONSOLE_POLL_MS. `console` is the
+    // Console.
+    static void task(void* console);
+    // Arena high-water marks, stage latencies and gate counters.
+    static void printStats(const WakeWordDetector& detector);
+
+private:
+    void accept(char c);
+    void execute(char* line);
+    bool submit(const DetectorTuning& tuning);
+    void help();
+
+    WakeWordDetector& detector_;
+    DetectorTuning tuning_; // As last posted
+    char line_[CONSOLE_LINE_MAX];
+    size_t length_;
+    bool overflow_;
+    bool bench_pending_;
+    bool record_pending_;
+};
+
+#endif
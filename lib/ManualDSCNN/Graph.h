@@ -0,0 +1,105 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <cstdint>
+
+// Compact description of a quantized DS-CNN, emitted by
+// tools/model_converter.py (model_graph.h/.cpp) and run by ManualDSCNN.
+// Everything is const data in flash; the only RAM a model needs is the
+// activation arena, whose layout the converter has already planned.
+
+enum GraphOp : uint8_t {
+    OP_CONV2D,          // KxK convolution, weights [out][ky][kx][in]
+    OP_DEPTHWISE,       // KxK depthwise, weights [ky][kx][channel]
+    OP_POINTWISE,       // 1x1 convolution, weights [out][in]
+    OP_AVGPOOL,         // global average pool, same scale in and out
+    OP_FULLY_CONNECTED, // int8 in, float logits out (accumulator * output_scale)
+    OP_SOFTMAX,         // float in, float out
+    OP_COUNT
+};
+
+enum GraphActivation : uint8_t {
+    ACT_NONE,
+    ACT_RELU // Clamp at the output zero point
+};
+
+enum GraphType : uint8_t {
+    TYPE_INT8,
+    TYPE_FLOAT32
+};
+
+// An activation tensor, [h][w][c] (channels innermost).
+struct GraphTensor {
+    uint16_t h, w, c;
+    GraphType type;
+    int32_t zero_point;
+    float scale;
+    uint32_t arena_offset; // Bytes from the arena base, for one window
+};
+
+struct GraphNode {
+    GraphOp op;
+    GraphActivation activation;
+    uint8_t kernel_h, kernel_w;
+    uint8_t stride_h, stride_w;
+    uint8_t pad_top, pad_left;
+    uint8_t per_channel;   // One multiplier/shift per output channel
+    uint8_t weight_bits;   // 8, or 4: two weights per byte, low nibble first
+    uint8_t input, output; // Tensor indices
+    uint32_t weights;      // Offsets into GraphModel::weights,
+    uint32_t bias;         //   ::biases
+    uint32_t quant;        //   and ::multipliers/::shifts
+    float output_scale;    // OP_FULLY_CONNECTED: real value of one accumulator unit
+};
+
+struct GraphModel {
+    const char* name;
+    const GraphTensor* tensors;
+    uint8_t tensor_count;
+    const GraphNode* nodes;
+    uint8_t node_count;
+    uint8_t input, output;
+    const int8_t* weights;      // Byte blob; int4 layers are packed
+    const int32_t* biases;
+    const int32_t* multipliers; // Q31 fixed-point output multipliers
+    const int8_t* shifts;       // Power-of-two exponents applied with them
+    uint32_t arena_size;        // Bytes per window
+    bool placeholder_scales;    // Activation scales are stand-ins, not the trained model's
+};
+
+inline uint32_t graphTensorBytes(const GraphTensor& t) {
+    return (uint32_t)t.h * t.w * t.c * (t.type == TYPE_FLOAT32 ? sizeof(float) : 1);
+}
+
+// Number of weights a node reads (elements, whatever their width).
+inline uint32_t graphWeightCount(const GraphModel& model, const GraphNode& node) {
+    const GraphTensor& in = model.tensors[node.input];
+    const GraphTensor& out = model.tensors[node.output];
+    switch (node.op) {
+    case OP_CONV2D: return (uint32_t)out.c * node.kernel_h * node.kernel_w * in.c;
+    case OP_DEPTHWISE: return (uint32_t)node.kernel_h * node.kernel_w * out.c;
+    case OP_POINTWISE: return (uint32_t)in.c * out.c;
+    case OP_FULLY_CONNECTED: return (uint32_t)in.h * in.w * in.c * out.c;
+    default: return 0;
+    }
+}
+
+inline uint32_t graphWeightBytes(const GraphModel& model, const GraphNode& node) {
+    return (graphWeightCount(model, node) * node.weight_bits + 7) / 8;
+}
+
+// Multiply-accumulates of one window: every weight once per output pixel
+// (once in all for the fully connected layer). Pooling and softmax are
+// negligible next to them.
+inline uint32_t graphMacs(const GraphModel& model) {
+    uint32_t macs = 0;
+    for (int i = 0; i < model.node_count; i++) {
+        const GraphNode& node = model.nodes[i];
+        const GraphTensor& out = model.tensors[node.output];
+        const uint32_t pixels = node.op == OP_FULLY_CONNECTED ? 1 : (uint32_t)out.h * out.w;
+        macs += graphWeightCount(model, node) * pixels;
+    }
+    return macs;
+}
+
+#endif
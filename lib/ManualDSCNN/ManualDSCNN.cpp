@@ -1,22 +1,479 @@
 #include "ManualDSCNN.h"
 #include <Arduino.h>
+#include <cmath>
+#include <cstring>
 #include "esp_task_wdt.h"
+#include "Trace.h"
+#include "Logger.h"
+#include "Quantize.h"
 
-ManualDSCNN::ManualDSCNN() : initialized(false) {}
+// The network itself is data (model_graph.cpp, from tools/model_converter.py):
+// tensors with planned arena offsets and nodes with their weights and
+// requantization. This file only holds the op kernels and the loop that
+// dispatches nodes to them.
 
-ManualDSCNN::~ManualDSCNN() {
-    cleanup();
+#if !DSCNN_BACKEND_AOT
+
+// Output quantization of one node, copied out of the graph so the inner
+// loops keep it in registers (int8 stores may alias any graph field).
+struct Requant {
+    const int32_t* multipliers;
+    const int8_t* shifts;
+    bool per_channel;
+    int32_t multiplier; // Per-tensor case
+    int shift;
+    int32_t zero_point;
+    int32_t low; // ReLU clamps at the zero point
+
+    Requant(const GraphModel& model, const GraphNode& node, const GraphTensor& out)
+        : multipliers(model.multipliers + node.quant), shifts(model.shifts + node.quant),
+          per_channel(node.per_channel != 0), multiplier(multipliers[0]), shift(shifts[0]),
+          zero_point(out.zero_point), low(node.activation == ACT_RELU ? out.zero_point : -128) {}
+
+    inline int8_t operator()(int32_t acc, int channel) const {
+        if (per_channel) return requantize(acc, multipliers[channel], shifts[channel], zero_point, low);
+        return requantize(acc, multiplier, shift, zero_point, low);
+    }
+};
+
+// One node over a batch: window b of a tensor starts at base + b * bytes.
+struct NodeTask {
+    const GraphModel* model;
+    const GraphNode* node;
+    const GraphTensor* in;
+    const GraphTensor* out;
+    const int8_t* input;
+    int8_t* output;
+    int windows;
+};
+
+// Weight `index` of a node; BITS = 4 unpacks it from its nibble inside the
+// MAC loop, so int4 layers never expand into RAM.
+template <int BITS>
+static inline int32_t weightAt(const int8_t* weights, int index) {
+    return BITS == 4 ? unpackInt4(weights, index) : weights[index];
 }
 
-void ManualDSCNN::cleanup() {
-    if (weights) {
-        heap_caps_free(weights);
-        weights = nullptr;
+// Spatial kernels compute output rows [row_begin, row_end) of every window
+// so a node can be split across cores; inputs are read whole, halo rows
+// included. KH/KW fix the kernel size at compile time (0 = read it from the
+// node), which lets the 3x3 case every DS-CNN uses unroll its taps.
+
+// Shape of a spatial node, copied into locals for the same reason as Requant.
+struct Window {
+    int in_h, in_w, in_c, in_bytes;
+    int out_h, out_w, out_c, out_bytes;
+    int stride_h, stride_w, pad_top, pad_left;
+    int32_t zero_point; // Input
+
+    explicit Window(const NodeTask& task)
+        : in_h(task.in->h), in_w(task.in->w), in_c(task.in->c), in_bytes(graphTensorBytes(*task.in)),
+          out_h(task.out->h), out_w(task.out->w), out_c(task.out->c), out_bytes(graphTensorBytes(*task.out)),
+          stride_h(task.node->stride_h), stride_w(task.node->stride_w),
+          pad_top(task.node->pad_top), pad_left(task.node->pad_left), zero_point(task.in->zero_point) {}
+};
+
+template <int KH, int KW, int BITS>
+static void conv2dKernel(const NodeTask& task, int part, int parts) {
+    const GraphNode& node = *task.node;
+    const int kernel_h = KH ? KH : node.kernel_h;
+    const int kernel_w = KW ? KW : node.kernel_w;
+    const Window g(task);
+    const int8_t* weights = task.model->weights + node.weights;
+    const int32_t* bias = task.model->biases + node.bias;
+    const Requant requant(*task.model, node, *task.out);
+    const int taps = kernel_h * kernel_w * g.in_c;
+    int row_begin, row_end;
+    DualCore::split(g.out_h, part, parts, row_begin, row_end);
+    for (int b = 0; b < task.windows; b++) {
+        const int8_t* input = task.input + b * g.in_bytes;
+        int8_t* output = task.output + b * g.out_bytes;
+        for (int oy = row_begin; oy < row_end; oy++) {
+            for (int ox = 0; ox < g.out_w; ox++) {
+                int8_t* px = output + (oy * g.out_w + ox) * g.out_c;
+                for (int oc = 0; oc < g.out_c; oc++) {
+                    int32_t acc = bias[oc];
+                    const int kernel = oc * taps;
+                    for (int ky = 0; ky < kernel_h; ky++) {
+                        int iy = oy * g.stride_h - g.pad_top + ky;
+                        if (iy < 0 || iy >= g.in_h) continue;
+                        for (int kx = 0; kx < kernel_w; kx++) {
+                            int ix = ox * g.stride_w - g.pad_left + kx;
+                            if (ix < 0 || ix >= g.in_w) continue;
+                            const int8_t* src = input + (iy * g.in_w + ix) * g.in_c;
+                            const int w = kernel + (ky * kernel_w + kx) * g.in_c;
+                            for (int ic = 0; ic < g.in_c; ic++) {
+                                acc += (src[ic] - g.zero_point) * weightAt<BITS>(weights, w + ic);
+                            }
+                        }
+                    }
+                    px[oc] = requant(acc, oc);
+                }
+            }
+        }
+    }
+}
+
+template <int KH, int KW, int STRIDE, int BITS>
+static void depthwiseKernel(const NodeTask& task, int part, int parts) {
+    const GraphNode& node = *task.node;
+    const int kernel_h = KH ? KH : node.kernel_h;
+    const int kernel_w = KW ? KW : node.kernel_w;
+    Window g(task);
+    if (STRIDE) g.stride_h = g.stride_w = STRIDE;
+    const int8_t* weights = task.model->weights + node.weights;
+    const int32_t* bias = task.model->biases + node.bias;
+    const Requant requant(*task.model, node, *task.out);
+    const int channels = g.out_c;
+    int row_begin, row_end;
+    DualCore::split(g.out_h, part, parts, row_begin, row_end);
+    for (int b = 0; b < task.windows; b++) {
+        const int8_t* input = task.input + b * g.in_bytes;
+        int8_t* output = task.output + b * g.out_bytes;
+        for (int oy = row_begin; oy < row_end; oy++) {
+            for (int ox = 0; ox < g.out_w; ox++) {
+                int8_t* px = output + (oy * g.out_w + ox) * channels;
+                for (int c = 0; c < channels; c++) {
+                    int32_t acc = bias[c];
+                    for (int ky = 0; ky < kernel_h; ky++) {
+                        int iy = oy * g.stride_h - g.pad_top + ky;
+                        if (iy < 0 || iy >= g.in_h) continue;
+                        for (int kx = 0; kx < kernel_w; kx++) {
+                            int ix = ox * g.stride_w - g.pad_left + kx;
+                            if (ix < 0 || ix >= g.in_w) continue;
+                            acc += (input[(iy * g.in_w + ix) * channels + c] - g.zero_point) *
+                                   weightAt<BITS>(weights, (ky * kernel_w + kx) * channels + c);
+                        }
+                    }
+                    px[c] = requant(acc, c);
+                }
+            }
+        }
     }
-    initialized = false;
 }
 
+template <int BITS>
+static void conv2dBits(const NodeTask& task, int part, int parts) {
+    if (task.node->kernel_h == 3 && task.node->kernel_w == 3) conv2dKernel<3, 3, BITS>(task, part, parts);
+    else conv2dKernel<0, 0, BITS>(task, part, parts);
+}
+
+static void conv2d(const NodeTask& task, int part, int parts) {
+    if (task.node->weight_bits == 4) conv2dBits<4>(task, part, parts);
+    else conv2dBits<8>(task, part, parts);
+}
+
+template <int BITS>
+static void depthwiseBits(const NodeTask& task, int part, int parts) {
+    const GraphNode& node = *task.node;
+    if (node.kernel_h == 3 && node.kernel_w == 3 && node.stride_h == 1 && node.stride_w == 1) {
+        depthwiseKernel<3, 3, 1, BITS>(task, part, parts);
+    } else {
+        depthwiseKernel<0, 0, 0, BITS>(task, part, parts);
+    }
+}
+
+static void depthwise(const NodeTask& task, int part, int parts) {
+    if (task.node->weight_bits == 4) depthwiseBits<4>(task, part, parts);
+    else depthwiseBits<8>(task, part, parts);
+}
+
+// 1x1 convolution: a [rows x in] by [out x in]^T product, where rows are
+// the positions of every window in the batch (windows are stacked). Rows
+// are taken four at a time so each weight is loaded once per tile.
+template <int BITS>
+static void pointwiseKernel(const NodeTask& task, int part, int parts) {
+    const GraphNode& node = *task.node;
+    const int in_channels = task.in->c;
+    const int out_channels = task.out->c;
+    const int32_t zero_point = task.in->zero_point;
+    const int8_t* weights = task.model->weights + node.weights;
+    const int32_t* bias = task.model->biases + node.bias;
+    const Requant requant(*task.model, node, *task.out);
+    int row_begin, row_end;
+    DualCore::split(task.windows * task.out->h * task.out->w, part, parts, row_begin, row_end);
+    const int8_t* input = task.input;
+    int8_t* output = task.output;
+    int r = row_begin;
+    for (; r + 4 <= row_end; r += 4) {
+        const int8_t* in0 = input + r * in_channels;
+        const int8_t* in1 = in0 + in_channels;
+        const int8_t* in2 = in1 + in_channels;
+        const int8_t* in3 = in2 + in_channels;
+        int8_t* out = output + r * out_channels;
+        for (int oc = 0; oc < out_channels; oc++) {
+            const int row = oc * in_channels;
+            int32_t acc0 = bias[oc], acc1 = bias[oc], acc2 = bias[oc], acc3 = bias[oc];
+            for (int i = 0; i < in_channels; i++) {
+                int32_t w = weightAt<BITS>(weights, row + i);
+                acc0 += (in0[i] - zero_point) * w;
+                acc1 += (in1[i] - zero_point) * w;
+                acc2 += (in2[i] - zero_point) * w;
+                acc3 += (in3[i] - zero_point) * w;
+            }
+            out[oc] = requant(acc0, oc);
+            out[out_channels + oc] = requant(acc1, oc);
+            out[2 * out_channels + oc] = requant(acc2, oc);
+            out[3 * out_channels + oc] = requant(acc3, oc);
+        }
+    }
+    for (; r < row_end; r++) {
+        const int8_t* in = input + r * in_channels;
+        int8_t* out = output + r * out_channels;
+        for (int oc = 0; oc < out_channels; oc++) {
+            const int row = oc * in_channels;
+            int32_t acc = bias[oc];
+            for (int i = 0; i < in_channels; i++) {
+                acc += (in[i] - zero_point) * weightAt<BITS>(weights, row + i);
+            }
+            out[oc] = requant(acc, oc);
+        }
+    }
+}
+
+static void pointwise(const NodeTask& task, int part, int parts) {
+    if (task.node->weight_bits == 4) pointwiseKernel<4>(task, part, parts);
+    else pointwiseKernel<8>(task, part, parts);
+}
+
+// Global average pool (same scale in and out, round half away from zero).
+static void avgpool(const NodeTask& task, int, int) {
+    const GraphTensor& in = *task.in;
+    const int positions = in.h * in.w;
+    for (int b = 0; b < task.windows; b++) {
+        const int8_t* features = task.input + b * graphTensorBytes(in);
+        int8_t* pooled = task.output + b * in.c;
+        for (int c = 0; c < in.c; c++) {
+            int32_t sum = 0;
+            for (int p = 0; p < positions; p++) sum += features[p * in.c + c];
+            int32_t half = positions / 2;
+            int32_t mean = sum >= 0 ? (sum + half) / positions : -((-sum + half) / positions);
+            pooled[c] = (int8_t)(mean < -128 ? -128 : mean > 127 ? 127 : mean);
+        }
+    }
+}
+
+// Each weight row is read once per four windows of the batch, as in the
+// pointwise kernel, instead of once per window.
+static void fullyConnected(const NodeTask& task, int, int) {
+    const GraphNode& node = *task.node;
+    const int inputs = graphTensorBytes(*task.in);
+    const int outputs = task.out->c;
+    const int32_t zero_point = task.in->zero_point;
+    const int8_t* weights = task.model->weights + node.weights;
+    const int32_t* bias = task.model->biases + node.bias;
+    float* logits = reinterpret_cast<float*>(task.output);
+    for (int k = 0; k < outputs; k++) {
+        const int8_t* row = weights + k * inputs;
+        int b = 0;
+        for (; b + 4 <= task.windows; b += 4) {
+            const int8_t* in0 = task.input + b * inputs;
+            const int8_t* in1 = in0 + inputs;
+            const int8_t* in2 = in1 + inputs;
+            const int8_t* in3 = in2 + inputs;
+            int32_t acc0 = bias[k], acc1 = bias[k], acc2 = bias[k], acc3 = bias[k];
+            for (int c = 0; c < inputs; c++) {
+                int32_t w = row[c];
+                acc0 += (in0[c] - zero_point) * w;
+                acc1 += (in1[c] - zero_point) * w;
+                acc2 += (in2[c] - zero_point) * w;
+                acc3 += (in3[c] - zero_point) * w;
+            }
+            logits[b * outputs + k] = acc0 * node.output_scale;
+            logits[(b + 1) * outputs + k] = acc1 * node.output_scale;
+            logits[(b + 2) * outputs + k] = acc2 * node.output_scale;
+            logits[(b + 3) * outputs + k] = acc3 * node.output_scale;
+        }
+        for (; b < task.windows; b++) {
+            const int8_t* in = task.input + b * inputs;
+            int32_t acc = bias[k];
+            for (int c = 0; c < inputs; c++) acc += (in[c] - zero_point) * row[c];
+            logits[b * outputs + k] = acc * node.output_scale;
+        }
+    }
+}
+
+static void softmax(const NodeTask& task, int, int) {
+    const int classes = task.out->c;
+    for (int b = 0; b < task.windows; b++) {
+        const float* logits = reinterpret_cast<const float*>(task.input) + b * classes;
+        float* output = reinterpret_cast<float*>(task.output) + b * classes;
+        float max_logit = -INFINITY;
+        for (int k = 0; k < classes; k++) {
+            if (logits[k] > max_logit) max_logit = logits[k];
+        }
+        float total = 0.0f;
+        for (int k = 0; k < classes; k++) {
+            output[k] = expf(logits[k] - max_logit);
+            total += output[k];
+        }
+        for (int k = 0; k < classes; k++) output[k] /= total;
+    }
+}
+
+typedef void (*GraphKernel)(const NodeTask& task, int part, int parts);
+
+struct OpKernel {
+    GraphKernel run;
+    bool splittable;   // Output rows are independent: runs on both cores
+    const char* name;  // Trace span
+};
+
+// Indexed by GraphOp. A new op needs a kernel here and in the converter.
+static const OpKernel OP_REGISTRY[OP_COUNT] = {
+    {conv2d, true, "dscnn.conv2d"},
+    {depthwise, true, "dscnn.depthwise"},
+    {pointwise, true, "dscnn.pointwise"},
+    {avgpool, false, "dscnn.avgpool"},
+    {fullyConnected, false, "dscnn.fc"},
+    {softmax, false, "dscnn.softmax"},
+};
+
+static void runNodePart(void* context, int part, int parts) {
+    const NodeTask& task = *static_cast<const NodeTask*>(context);
+    OP_REGISTRY[task.node->op].run(task, part, parts);
+}
+
+// Runs one node, on both cores when the helper is up and the op splits.
+// DualCore::run() returns only when both halves are written, so it is also
+// the barrier before the next node reads them.
+static void runNode(DualCore& dual_core, const NodeTask& task) {
+    const OpKernel& kernel = OP_REGISTRY[task.node->op];
+    TRACE_SPAN(kernel.name);
+    if (kernel.splittable) {
+        dual_core.run(runNodePart, const_cast<NodeTask*>(&task));
+    } else {
+        kernel.run(task, 0, 1);
+    }
+}
+
+// Shapes and types each op relies on; the converter emits nothing else, but
+// a hand-edited or stale model_graph.cpp should fail init(), not corrupt RAM.
+static const char* checkNode(const GraphModel& model, const GraphNode& node) {
+    if (node.op >= OP_COUNT) return "unknown op";
+    if (node.input >= model.tensor_count || node.output >= model.tensor_count) return "tensor index out of range";
+    const GraphTensor& in = model.tensors[node.input];
+    const GraphTensor& out = model.tensors[node.output];
+    if (in.arena_offset + graphTensorBytes(in) > model.arena_size ||
+        out.arena_offset + graphTensorBytes(out) > model.arena_size) return "tensor outside the arena";
+    if (node.weight_bits != 8 &&
+        !(node.weight_bits == 4 && (node.op == OP_CONV2D || node.op == OP_DEPTHWISE || node.op == OP_POINTWISE))) {
+        return "unsupported weight width";
+    }
+    switch (node.op) {
+    case OP_CONV2D:
+    case OP_DEPTHWISE:
+        if (node.stride_h == 0 || node.stride_w == 0) return "zero stride";
+        if (node.op == OP_DEPTHWISE && in.c != out.c) return "depthwise channel multiplier is not 1";
+        break;
+    case OP_POINTWISE:
+        if (in.h != out.h || in.w != out.w) return "pointwise changes the map size";
+        break;
+    case OP_AVGPOOL:
+        if (out.h != 1 || out.w != 1 || out.c != in.c) return "only global pooling is supported";
+        break;
+    case OP_FULLY_CONNECTED:
+        if (in.type != TYPE_INT8 || out.type != TYPE_FLOAT32) return "expects int8 in, float logits out";
+        return nullptr;
+    case OP_SOFTMAX:
+        if (in.type != TYPE_FLOAT32 || out.type != TYPE_FLOAT32 || in.c != out.c) return "expects float in and out";
+        return nullptr;
+    default:
+        break;
+    }
+    if (in.type != TYPE_INT8 || out.type != TYPE_INT8) return "expects int8 tensors";
+    return nullptr;
+}
+
+// A graph this engine can run: an int8 [frames][KWS_NUM_MFCC][1] input,
+// `classes` float probabilities out (0 = up to DSCNN_MAX_CLASSES), an
+// arena that fits and nodes the kernels support. Says why not.
+static bool checkGraph(const GraphModel& model, int frames, int classes, uint32_t arena_limit) {
+    const GraphTensor& input = model.tensors[model.input];
+    const GraphTensor& output = model.tensors[model.output];
+    const bool window_ok = frames ? input.h == frames : input.h >= 1 && input.h <= KWS_FRAMES;
+    if (!window_ok || input.w != KWS_NUM_MFCC || input.c != 1 || input.type != TYPE_INT8) {
+        Serial.printf("❌ Model %s expects a %ux%ux%u input, front end makes %dx%dx1\n", model.name,
+                      input.h, input.w, input.c, KWS_FRAMES, KWS_NUM_MFCC);
+        return false;
+    }
+    const int outputs = output.h * output.w * output.c;
+    if ((classes ? outputs != classes : outputs > DSCNN_MAX_CLASSES) || output.type != TYPE_FLOAT32) {
+        Serial.printf("❌ Model %s does not output %d float probabilities\n", model.name,
+                      classes ? classes : DSCNN_MAX_CLASSES);
+        return false;
+    }
+    if (model.placeholder_scales && !DSCNN_ALLOW_PLACEHOLDER_SCALES) {
+        Serial.printf("❌ Model %s has placeholder activation scales: convert the .tflite export "
+                      "(or build with DSCNN_ALLOW_PLACEHOLDER_SCALES=1)\n", model.name);
+        return false;
+    }
+    if (model.arena_size > arena_limit) {
+        Serial.printf("❌ Model %s needs %u arena bytes per window, built for %u\n", model.name,
+                      (unsigned)model.arena_size, (unsigned)arena_limit);
+        return false;
+    }
+    for (int i = 0; i < model.node_count; i++) {
+        const char* problem = checkNode(model, model.nodes[i]);
+        if (problem) {
+            Serial.printf("❌ Model %s node %d: %s\n", model.name, i, problem);
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // !DSCNN_BACKEND_AOT
+
+ManualDSCNN::ManualDSCNN()
+    : initialized(false), model(nullptr), observer(nullptr), observer_context(nullptr),
+      arena("dscnn", arena_storage, sizeof(arena_storage)) {}
+
+ManualDSCNN::~ManualDSCNN() {}
+
+#if DSCNN_BACKEND_AOT
+static_assert(MODEL_AOT_INPUT_H == KWS_FRAMES && MODEL_AOT_INPUT_W == KWS_NUM_MFCC && MODEL_AOT_INPUT_C == 1,
+              "model_aot.cpp was generated for a different front end");
+static_assert(MODEL_AOT_OUTPUTS == KWS_NUM_CLASSES, "model_aot.cpp was generated for a different label set");
+
+float ManualDSCNN::inputScale() {
+    return MODEL_AOT_INPUT_SCALE;
+}
+
+int32_t ManualDSCNN::inputZeroPoint() {
+    return MODEL_AOT_INPUT_ZERO_POINT;
+}
+
+bool ManualDSCNN::refusesBuiltinModel() {
+    return MODEL_AOT_PLACEHOLDER_SCALES && !DSCNN_ALLOW_PLACEHOLDER_SCALES;
+}
+#else
+float ManualDSCNN::inputScale() {
+    return model_graph.tensors[model_graph.input].scale;
+}
+
+int32_t ManualDSCNN::inputZeroPoint() {
+    return model_graph.tensors[model_graph.input].zero_point;
+}
+
+bool ManualDSCNN::refusesBuiltinModel() {
+    return model_graph.placeholder_scales && !DSCNN_ALLOW_PLACEHOLDER_SCALES;
+}
+#endif
+
 bool ManualDSCNN::init() {
+#if DSCNN_BACKEND_AOT
+    return initModel(nullptr);
+#else
+    return initModel(&model_graph);
+#endif
+}
+
+bool ManualDSCNN::init(const GraphModel& graph) {
+    return initModel(&graph);
+}
+
+bool ManualDSCNN::initModel(const GraphModel* graph) {
     Serial.println("🧠 Initializing ManualDSCNN...");
     esp_task_wdt_reset();
 
@@ -25,47 +482,136 @@ bool ManualDSCNN::init() {
         return true;
     }
 
-    weights = (float*)heap_caps_malloc(1024 * sizeof(float), MALLOC_CAP_8BIT);
-    if (!weights) {
-        Serial.println("❌ Failed to allocate weights");
+#if DSCNN_BACKEND_AOT
+    if (graph) {
+        Serial.printf("❌ Built with DSCNN_BACKEND_AOT: cannot run model %s\n", graph->name);
         return false;
     }
-    Serial.println("✅ Weights allocated");
-    esp_task_wdt_reset();
-
-    for (int i = 0; i < 1024; i++) {
-        weights[i] = 0.01f; // Simple non-zero weights
-        if (i % 256 == 0) {
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
-        }
+    if (MODEL_AOT_PLACEHOLDER_SCALES && !DSCNN_ALLOW_PLACEHOLDER_SCALES) {
+        Serial.printf("❌ Model %s has placeholder activation scales: convert the .tflite export "
+                      "(or build with DSCNN_ALLOW_PLACEHOLDER_SCALES=1)\n", MODEL_AOT_NAME);
+        return false;
     }
-    Serial.println("✅ Weights initialized");
-    esp_task_wdt_reset();
+    Serial.printf("✅ Model %s: compiled ahead of time\n", MODEL_AOT_NAME);
+#else
+    const GraphModel& model = *graph;
+    if (!checkGraph(model, KWS_FRAMES, KWS_NUM_CLASSES, MODEL_GRAPH_ARENA_SIZE)) return false;
 
-    Serial.printf("Heap after ManualDSCNN init: %u bytes\n", esp_get_free_heap_size());
+    Serial.printf("✅ Model %s: %d nodes\n", model.name, model.node_count);
+    this->model = graph;
+#endif
+    // Weights are read straight from flash; only activations need RAM.
+    Serial.printf("✅ Activation arena: %u bytes (static)\n", (unsigned)sizeof(arena_storage));
     initialized = true;
     Serial.println("✅ ManualDSCNN initialized successfully");
     return true;
 }
 
-float ManualDSCNN::predict(const int8_t* input) {
-    if (!initialized || !weights) {
-        Serial.println("⚠️ ManualDSCNN not initialized or weights null");
-        return 0.0f;
-    }
-
-    float confidence = 0.0f;
-    int non_zero_count = 0;
-    for (int i = 0; i < MFCC_NUM_FRAMES * MFCC_NUM_COEFFS; i++) {
-        if (input[i] != 0) non_zero_count++;
-        confidence += input[i] * weights[i % 1024];
-        if (i % 100 == 0) {
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
+bool ManualDSCNN::infer(const int8_t* input, float* output) {
+    TRACE_SPAN("dscnn.infer");
+    return predictBatch(&input, 1, output);
+}
+
+bool ManualDSCNN::enableDualCore(int core, int priority) {
+    if (!dual_core.start(core, priority)) {
+        LOG_ERROR("❌ DSCNN helper task failed to start");
+        return false;
+    }
+    LOG_INFO("✅ DSCNN layers split across two cores (helper on core %d)", core);
+    return true;
+}
+
+void ManualDSCNN::disableDualCore() {
+    dual_core.stop();
+}
+
+void ManualDSCNN::setLayerObserver(LayerObserver observer, void* context) {
+    this->observer = observer;
+    observer_context = context;
+}
+
+bool ManualDSCNN::predictBatch(const int8_t* const* inputs, int count, float* outputs) {
+    TRACE_SPAN("dscnn.batch");
+    if (!initialized) {
+        LOG_ERROR("⚠️ ManualDSCNN not initialized");
+        return false;
+    }
+
+#if DSCNN_BACKEND_AOT
+    for (int first = 0; first < count; first += DSCNN_MAX_BATCH) {
+        const int n = count - first < DSCNN_MAX_BATCH ? count - first : DSCNN_MAX_BATCH;
+        ArenaScope scope(arena);
+        int8_t* base = static_cast<int8_t*>(arena.allocate((size_t)n * MODEL_AOT_ARENA_SIZE, 16));
+        if (!base) {
+            LOG_ERROR("❌ DSCNN arena exhausted");
+            return false;
         }
+        model_aot_run(inputs + first, n, base, outputs + first * KWS_NUM_CLASSES, dual_core);
+    }
+#else
+    for (int first = 0; first < count; first += DSCNN_MAX_BATCH) {
+        const int n = count - first < DSCNN_MAX_BATCH ? count - first : DSCNN_MAX_BATCH;
+        if (!runGraph(*model, inputs + first, n, outputs + first * KWS_NUM_CLASSES)) return false;
+    }
+#endif
+    return true;
+}
+
+bool ManualDSCNN::acceptsGraph(const GraphModel& graph) const {
+#if DSCNN_BACKEND_AOT
+    Serial.printf("❌ Built with DSCNN_BACKEND_AOT: cannot run model %s\n", graph.name);
+    return false;
+#else
+    return checkGraph(graph, 0, 0, sizeof(arena_storage) - 16);
+#endif
+}
+
+bool ManualDSCNN::inferGraph(const GraphModel& graph, const int8_t* input, float* output) {
+    TRACE_SPAN("dscnn.infer_graph");
+    if (!initialized) {
+        LOG_ERROR("⚠️ ManualDSCNN not initialized");
+        return false;
+    }
+#if DSCNN_BACKEND_AOT
+    return false;
+#else
+    return runGraph(graph, &input, 1, output);
+#endif
+}
+
+#if !DSCNN_BACKEND_AOT
+bool ManualDSCNN::runGraph(const GraphModel& graph, const int8_t* const* inputs, int n, float* outputs) {
+    const GraphTensor& input = graph.tensors[graph.input];
+    const GraphTensor& output = graph.tensors[graph.output];
+    ArenaScope scope(arena);
+    int8_t* base = static_cast<int8_t*>(arena.allocate((size_t)n * graph.arena_size, 16));
+    if (!base) {
+        LOG_ERROR("❌ DSCNN arena exhausted");
+        return false;
     }
-    confidence /= (MFCC_NUM_FRAMES * MFCC_NUM_COEFFS);
-    Serial.printf("DSCNN predict: %d non-zero MFCCs, confidence: %.3f\n", non_zero_count, confidence);
-    return confidence;
-}
\ No newline at end of file
+
+    int8_t* windows = base + input.arena_offset * n;
+    for (int b = 0; b < n; b++) {
+        memcpy(windows + b * graphTensorBytes(input), inputs[b], graphTensorBytes(input));
+    }
+    for (int i = 0; i < graph.node_count; i++) {
+        const GraphNode& node = graph.nodes[i];
+        const GraphTensor& in = graph.tensors[node.input];
+        const GraphTensor& out = graph.tensors[node.output];
+        NodeTask task = {&graph, &node, &in, &out, base + in.arena_offset * n, base + out.arena_offset * n, n};
+        runNode(dual_core, task);
+        if (observer) observer(i, out, task.output, n, observer_context);
+    }
+    memcpy(outputs, base + output.arena_offset * n, n * graphTensorBytes(output));
+    return true;
+}
+#endif
+
+float ManualDSCNN::predict(const int8_t* input) {
+    TRACE_SPAN("dscnn.predict");
+    float probabilities[KWS_NUM_CLASSES];
+    if (!infer(input, probabilities)) return 0.0f;
+    LOG_VERBOSE("DSCNN predict: marvin %.3f, unknown %.3f, silence %.3f",
+                probabilities[0], probabilities[1], probabilities[2]);
+    return probabilities[KWS_LABEL_MARVIN_IDX];
+}
@@ -2,18 +2,123 @@
 #define MANUALDSCNN_H
 #include <cstdint>
 #include "env.h"
+#include "frontend_params.h"
+#include "Arena.h"
+#include "DualCore.h"
+#include "Graph.h"
 
+// 1 = run the model compiled to straight-line C++ (model_aot.cpp, from
+// tools/model_converter.py --aot) instead of interpreting model_graph.
+// Same arena, same results; no dispatch or shape handling at run time.
+#ifndef DSCNN_BACKEND_AOT
+#define DSCNN_BACKEND_AOT 0
+#endif
+
+#if DSCNN_BACKEND_AOT
+#include "model_aot.h"
+#define DSCNN_MODEL_ARENA_SIZE MODEL_AOT_ARENA_SIZE
+#else
+#include "model_graph.h"
+#define DSCNN_MODEL_ARENA_SIZE MODEL_GRAPH_ARENA_SIZE
+#endif
+
+// Feature windows one predictBatch() pass holds in the arena. The device
+// runs one stream, so it only pays for one; hosts serving many streams
+// batch them to reuse every weight load across windows.
+#ifndef DSCNN_MAX_BATCH
+#ifdef ARDUINO
+#define DSCNN_MAX_BATCH 1
+#else
+#define DSCNN_MAX_BATCH 8
+#endif
+#endif
+
+// Most classes a graph run through inferGraph() may output.
+#define DSCNN_MAX_CLASSES 16
+
+// 1 = the device detector splits every layer across both cores (helper task
+// on core 0, see enableDualCore()).
+#ifndef DSCNN_DUAL_CORE
+#define DSCNN_DUAL_CORE 0
+#endif
+
+// 1 = accept a graph whose activation scales are placeholders (converted
+// from a legacy model_weights.h, which has none). Its requantization is not
+// the trained model's, so scores mean little; for tests and bring-up only.
+#ifndef DSCNN_ALLOW_PLACEHOLDER_SCALES
+#define DSCNN_ALLOW_PLACEHOLDER_SCALES 0
+#endif
+
+// Every tensor of a window sits at the offset the converter planned;
+// a batch scales each region by the window count, so the windows of one
+// tensor are stacked and a pointwise layer sees one tall map.
+#define DSCNN_ARENA_SIZE (DSCNN_MAX_BATCH * DSCNN_MODEL_ARENA_SIZE + 16)
+
+// Called after every interpreted node with its output: `windows` windows of
+// `tensor`, stacked at `data`.
+typedef void (*LayerObserver)(int node, const GraphTensor& tensor, const void* data, int windows, void* context);
+
+// Interpreter for the int8 DS-CNN described by model_graph.h: each node is
+// dispatched to the kernel registered for its op. A wider, deeper or
+// 49-frame variant only needs a new model_graph.cpp from the converter
+// (and a new model_aot.cpp for the AOT backend).
 class ManualDSCNN {
 public:
     ManualDSCNN();
     ~ManualDSCNN();
+    // Fails when the graph does not match the front end (frontend_params.h).
     bool init();
-    float predict(const int8_t* input);
+    // Runs `graph` instead of the built-in model_graph (host tools comparing
+    // model variants). It must outlive the engine; fails with the AOT backend.
+    bool init(const GraphModel& graph);
+    float predict(const int8_t* input); // Probability of KWS_LABEL_MARVIN_IDX
+    bool infer(const int8_t* input, float* output); // KWS_NUM_CLASSES probabilities
+    // `count` independent windows; outputs is [count][KWS_NUM_CLASSES].
+    // Pointwise layers run over all windows at once, so each weight is
+    // loaded once per tile instead of once per window. Bit-exact with
+    // infer(); batches above DSCNN_MAX_BATCH are split.
+    bool predictBatch(const int8_t* const* inputs, int count, float* outputs);
+    // Runs another interpreted graph on this engine's arena, so one engine
+    // serves several keyword models in turn. `graph` must pass
+    // acceptsGraph(): int8 [frames <= KWS_FRAMES][KWS_NUM_MFCC][1] in, at
+    // most DSCNN_MAX_CLASSES float probabilities out, an arena that fits.
+    // Not available with the AOT backend.
+    bool acceptsGraph(const GraphModel& graph) const;
+    bool inferGraph(const GraphModel& graph, const int8_t* input, float* output);
+    // Splits every convolution of every call in half, by output rows, with the
+    // second half on a helper task pinned to `core`. Cuts single-window
+    // latency when the other core is idle; results are unchanged. Hosts
+    // running one engine per worker thread should leave this off.
+    bool enableDualCore(int core, int priority);
+    void disableDualCore();
+    // Host tools inspecting intermediate activations (tools/host/quant_check).
+    // Interpreter only; nullptr removes it.
+    void setLayerObserver(LayerObserver observer, void* context);
+    const Arena& getArena() const { return arena; }
+#if !DSCNN_BACKEND_AOT
+    const GraphModel& graph() const { return model ? *model : model_graph; }
+#endif
+    // Quantization the front end must produce (model input tensor).
+    static float inputScale();
+    static int32_t inputZeroPoint();
+    // True when init() refuses the built-in model for how it was built
+    // (placeholder scales without DSCNN_ALLOW_PLACEHOLDER_SCALES), so every
+    // boot of this firmware would fail the same way.
+    static bool refusesBuiltinModel();
 
 private:
+    bool initModel(const GraphModel* graph);
+#if !DSCNN_BACKEND_AOT
+    bool runGraph(const GraphModel& graph, const int8_t* const* inputs, int n, float* outputs);
+#endif
+
     bool initialized;
-    float* weights; // Example weights
-    void cleanup();
+    const GraphModel* model; // Interpreted graph, set by init()
+    LayerObserver observer;
+    void* observer_context;
+    alignas(16) int8_t arena_storage[DSCNN_ARENA_SIZE];
+    Arena arena;
+    DualCore dual_core;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,41 @@
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include <cstdint>
+
+// TFLite reference requantization, shared by the graph interpreter and the
+// generated model_aot.cpp so both stay bit-exact.
+
+static inline int32_t saturatingRoundingDoublingHighMul(int32_t a, int32_t b) {
+    if (a == b && a == INT32_MIN) return INT32_MAX;
+    int64_t ab = (int64_t)a * (int64_t)b;
+    int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+    return (int32_t)((ab + nudge) / (1ll << 31));
+}
+
+static inline int32_t roundingDivideByPOT(int32_t x, int exponent) {
+    int32_t mask = (int32_t)((1ll << exponent) - 1);
+    int32_t remainder = x & mask;
+    int32_t threshold = (mask >> 1) + (x < 0 ? 1 : 0);
+    return (x >> exponent) + (remainder > threshold ? 1 : 0);
+}
+
+// acc * multiplier * 2^shift / 2^31 + zero_point, clamped to [low, 127]
+// (low = zero_point for a fused ReLU).
+static inline int8_t requantize(int32_t acc, int32_t multiplier, int shift, int32_t zero_point, int32_t low) {
+    int left = shift > 0 ? shift : 0;
+    int right = shift > 0 ? 0 : -shift;
+    int32_t value = roundingDivideByPOT(saturatingRoundingDoublingHighMul(acc * (1 << left), multiplier), right);
+    value += zero_point;
+    if (value < low) value = low;
+    if (value > 127) value = 127;
+    return (int8_t)value;
+}
+
+// Element `index` of an int4 array packed two per byte, low nibble first.
+static inline int32_t unpackInt4(const int8_t* packed, int index) {
+    int32_t byte = packed[index >> 1];
+    return index & 1 ? byte >> 4 : (int8_t)((uint8_t)byte << 4) >> 4;
+}
+
+#endif
@@ -0,0 +1,591 @@
+// Generated by tools/model_converter.py --aot from model_weights.h. Do not edit.
+#include "model_aot.h"
+#include <cmath>
+#include <cstring>
+#include "Quantize.h"
+#include "Trace.h"
+
+typedef void (*AotLayer)(const int8_t* input, int8_t* output, int windows, int part, int parts);
+
+static constexpr int8_t aot_conv_weights[] = {
+    46, 53, -51, 115, -107, 9, 127, -91, -27, 17, -25, 75, 60, -48, 55, 47,
+    -90, -83, -76, -127, -103, 127, 119, -53, 57, -99, 22, -27, 59, -123, -114, 123,
+    -103, -12, -18, 70, 40, -64, -72, 83, -127, 44, 19, -20, 83, 38, 6, -80,
+    -66, 6, 56, 42, -64, -66, 77, 88, -16, -30, -31, -66, -18, 36, -63, 63,
+    6, 50, -127, -44, 69, 33, 79, 80, 80, 4, 37, -127, 45, 25, 3, -87,
+    -55, 74, -72, 66, -41, -25, 61, 127, -21, -6, 63, 47, -17, -127, 94, -72,
+    42, 127, 26, -36, 127, 82, -113, -83, -24, 70, -44, -53, 48, -10, -80, 37,
+    62, 69, -16, -90, 64, -86, -70, -76, 52, -127, -56, 101, -38, -8, 127, -127,
+    127, -127, 117, 22, 44, -30, -1, -28, -21, -79, 127, -117, -127, -78, -7, 66,
+};
+
+static constexpr int32_t aot_conv_bias[] = {
+    170, 2571, -2172, -1804, 117, 1434, 1836, -851,
+    1607, -899, -658, 710, 1741, -224, -394, 1354,
+};
+
+static void aot_conv(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(33, part, parts, row_begin, row_end);
+    for (int b = 0; b < windows; b++) {
+        const int8_t* in = input + b * 650;
+        int8_t* out = output + b * 2640;
+        for (int oy = row_begin; oy < row_end; oy++) {
+            const int iy0 = oy * 2 - 1;
+            const int ky_begin = iy0 < 0 ? -iy0 : 0;
+            const int ky_end = iy0 + 3 > 65 ? 65 - iy0 : 3;
+            for (int ox = 0; ox < 5; ox++) {
+                const int ix0 = ox * 2 - 0;
+                const int kx_begin = ix0 < 0 ? -ix0 : 0;
+                const int kx_end = ix0 + 3 > 10 ? 10 - ix0 : 3;
+                int32_t acc[16];
+                for (int c = 0; c < 16; c++) acc[c] = aot_conv_bias[c];
+                for (int ky = ky_begin; ky < ky_end; ky++) {
+                    for (int kx = kx_begin; kx < kx_end; kx++) {
+                        const int8_t* src = in + ((iy0 + ky) * 10 + ix0 + kx) * 1;
+                        const int tap = (ky * 3 + kx) * 16;
+                        for (int i = 0; i < 1; i++) {
+                            const int32_t x = src[i] - 58;
+                            for (int c = 0; c < 16; c++) acc[c] += x * aot_conv_weights[tap + i * 16 + c];
+                        }
+                    }
+                }
+                int8_t* px = out + (oy * 5 + ox) * 16;
+                for (int c = 0; c < 16; c++) px[c] = requantize(acc[c], 1244122582, -6, -128, -128);
+            }
+        }
+    }
+}
+
+static constexpr int8_t aot_b1_dw_weights[] = {
+    106, 107, 90, 34, 127, -68, 2, 3, -52, -66, -68, -21, -17, 62, -80, -35,
+    80, 127, -28, -9, 8, 70, 22, 127, -26, 67, -45, -28, 16, 27, -119, -17,
+    -59, 22, -127, 12, -86, -59, -109, -31, -67, 127, 7, 93, 19, 127, -89, 12,
+    10, -29, 86, 22, 12, 96, 47, 33, 40, 92, 27, -54, 51, -57, -127, -28,
+    11, 20, 54, -55, 13, -127, 127, 18, -124, -11, -6, 127, 67, -54, -72, -48,
+    6, -45, -14, 127, -3, -74, -70, 40, -20, -27, -127, 100, -71, 107, 0, -34,
+    68, -118, 4, 44, 83, -99, -24, -33, 127, -1, -29, -78, 38, -97, -9, -127,
+    -37, 25, -49, 25, -34, 24, 14, -99, 33, -57, -30, -22, 127, -109, 20, -12,
+    -127, -33, -91, 55, -43, 43, 6, -41, -73, -67, -124, 51, -1, 46, 52, -19,
+};
+
+static constexpr int32_t aot_b1_dw_bias[] = {
+    -1019, -1399, -2232, -477, -580, 2843, -692, -316,
+    2802, 5, 4053, -1263, -3997, 1165, 6466, 4614,
+};
+
+static void aot_b1_dw(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(33, part, parts, row_begin, row_end);
+    for (int b = 0; b < windows; b++) {
+        const int8_t* in = input + b * 2640;
+        int8_t* out = output + b * 2640;
+        for (int oy = row_begin; oy < row_end; oy++) {
+            const int iy0 = oy * 1 - 1;
+            const int ky_begin = iy0 < 0 ? -iy0 : 0;
+            const int ky_end = iy0 + 3 > 33 ? 33 - iy0 : 3;
+            for (int ox = 0; ox < 5; ox++) {
+                const int ix0 = ox * 1 - 1;
+                const int kx_begin = ix0 < 0 ? -ix0 : 0;
+                const int kx_end = ix0 + 3 > 5 ? 5 - ix0 : 3;
+                int32_t acc[16];
+                for (int c = 0; c < 16; c++) acc[c] = aot_b1_dw_bias[c];
+                for (int ky = ky_begin; ky < ky_end; ky++) {
+                    for (int kx = kx_begin; kx < kx_end; kx++) {
+                        const int8_t* src = in + ((iy0 + ky) * 5 + ix0 + kx) * 16;
+                        const int tap = (ky * 3 + kx) * 16;
+                        for (int c = 0; c < 16; c++) acc[c] += (src[c] + 128) * aot_b1_dw_weights[tap + c];
+                    }
+                }
+                int8_t* px = out + (oy * 5 + ox) * 16;
+                for (int c = 0; c < 16; c++) px[c] = requantize(acc[c], 1887948562, -7, -128, -128);
+            }
+        }
+    }
+}
+
+static constexpr int8_t aot_b1_pw_weights[] = {
+    127, -12, 2, -75, -89, 70, -94, 4, -87, -116, -25, 40, -7, 63, -21, -15,
+    -9, 8, -54, -11, -42, 102, -109, -107, -57, 9, 57, 36, 42, -27, 107, 29,
+    -110, -26, 96, 23, 43, 33, -19, -96, 2, 118, -69, -61, 13, 7, 2, 87,
+    40, 101, -123, -45, -24, 24, -37, -119, 86, -124, 38, 16, 117, 30, -12, -32,
+    -127, -116, -124, 33, 75, -29, 32, -70, -60, -124, -79, 76, -13, 20, 127, 126,
+    36, 6, -29, -71, 13, 41, 20, -41, -64, 1, -83, -2, -45, -104, -29, -24,
+    -118, 104, 41, -57, 127, -101, -125, -22, 69, 5, -81, 36, -14, -17, -8, 102,
+    -52, -67, 14, 95, 64, 55, -104, -66, -82, 15, 30, 67, 56, -30, 39, 87,
+    -68, -122, -1, 93, 108, 44, 66, 127, -2, -112, 32, -26, -67, 127, 44, 12,
+    -39, 26, -21, 95, -25, 65, 57, -83, -40, -4, -24, -46, -53, 17, -54, 10,
+    -58, -39, -11, 8, 24, 69, 14, -1, 69, -29, -14, 96, -41, 63, -65, 127,
+    127, -127, 31, 69, 95, -51, -111, 11, 55, 89, -95, 127, 44, 24, -51, 1,
+    -54, -48, 89, -127, 18, 60, -60, 86, 91, -62, -24, 59, -93, 21, -18, 90,
+    -112, -55, 26, -24, -109, -89, 105, -101, -41, -5, -37, 17, -67, 67, 27, 56,
+    -88, 56, -60, 96, 46, 75, 12, 89, -7, -127, -127, 77, 38, -92, 81, 82,
+    5, 87, -63, 53, 52, -62, -9, 52, 16, 79, 59, -6, -121, -127, -127, -18,
+    -96, -100, -17, -103, 6, -3, 19, -65, -25, 18, -49, 116, -55, -127, -3, -110,
+    -8, 102, -127, -53, 79, -46, 27, 23, -2, -31, 6, -1, 8, -51, 113, 114,
+    74, -48, -28, 82, 17, -28, -85, 37, 124, 15, -48, 31, 127, -14, 53, 5,
+    34, -31, 62, -51, -127, -5, 76, 12, 59, 3, 106, -118, 127, -44, 87, 28,
+    5, 50, 25, -123, 42, -50, -108, 7, -84, -19, -11, -88, 48, 46, -127, 11,
+    -67, -127, -127, 17, -110, -69, 65, -124, -14, -86, 11, -127, 93, 30, -34, -64,
+    -107, -25, 38, 35, -90, -61, -23, 14, 99, 86, 50, -20, 72, 53, -85, -8,
+    60, -96, -71, 78, 63, -17, -17, 116, 94, -35, -37, 75, -83, -2, -59, -127,
+};
+
+static constexpr int32_t aot_b1_pw_bias[] = {
+    -8113, 6993, -17816, 25018, 9668, -7147, -5191, 21403,
+    21988, -48464, -25241, 13376, 62401, 3499, -40435, 34944,
+    -60993, -61679, -49261, 8275, -25255, -841, -1873, -23713,
+};
+
+static void aot_b1_pw(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(windows * 165, part, parts, row_begin, row_end);
+    for (int r = row_begin; r < row_end; r++) {
+        const int8_t* in = input + r * 16;
+        int32_t acc[24];
+        for (int c = 0; c < 24; c++) acc[c] = aot_b1_pw_bias[c];
+        for (int i = 0; i < 16; i++) {
+            const int32_t x = in[i];
+            const int row = i * 24;
+            for (int c = 0; c < 24; c++) acc[c] += x * aot_b1_pw_weights[row + c];
+        }
+        int8_t* out = output + r * 24;
+        for (int c = 0; c < 24; c++) out[c] = requantize(acc[c], 1643120239, -7, -128, -128);
+    }
+}
+
+static constexpr int8_t aot_b2_dw_weights[] = {
+    28, 36, 127, 67, 98, 78, 92, 81, -127, -71, -127, 127, -4, -91, -41, -11,
+    -8, -69, 49, -42, 2, 103, 89, 96, -127, 83, -9, -100, 86, -4, 83, 44,
+    -32, -63, 7, 51, -7, 27, 124, 45, 127, -121, 65, 75, 38, 37, -127, -34,
+    55, -40, -40, -127, 57, -89, 77, 2, 1, 34, 92, 9, 92, 79, 84, -83,
+    93, -17, 36, -2, -70, -22, 18, -30, -101, 73, -53, 125, 112, 13, -41, 127,
+    54, -47, -69, 28, -82, 82, -30, 46, -86, -98, 27, 86, 7, 17, 22, -17,
+    -24, 43, -25, 9, -60, -21, -7, -57, 23, -84, -3, 22, 96, 90, -54, -100,
+    -22, -16, -4, 127, -26, -46, 24, 55, 50, -22, 18, -30, 40, -127, -55, -86,
+    36, 31, 34, -28, -14, -41, -127, 14, 19, 37, -27, -77, -85, 127, -9, -3,
+    18, -57, -74, -40, 77, 72, -121, 70, -32, -127, 20, -68, -35, 48, 98, 2,
+    -77, -127, -45, 67, 87, -92, 49, 1, -5, -127, 113, -98, -127, -86, -127, -11,
+    1, 30, -15, -48, 127, -127, -3, 24, -58, 36, -25, -50, -127, 30, -46, -27,
+    -2, 4, 1, 72, 38, -125, -42, -8, -55, 94, -64, 32, -51, -5, -115, 127,
+    -90, 85, -127, -39, -113, -51, -4, -127,
+};
+
+static constexpr int32_t aot_b2_dw_bias[] = {
+    1045, -241, -579, 2555, -3374, 5239, 553, -1642,
+    1272, 3418, 1236, -2759, -2279, -1120, -751, -689,
+    885, 3153, 571, -1817, 4075, -463, 21, 171,
+};
+
+static void aot_b2_dw(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(33, part, parts, row_begin, row_end);
+    for (int b = 0; b < windows; b++) {
+        const int8_t* in = input + b * 3960;
+        int8_t* out = output + b * 3960;
+        for (int oy = row_begin; oy < row_end; oy++) {
+            const int iy0 = oy * 1 - 1;
+            const int ky_begin = iy0 < 0 ? -iy0 : 0;
+            const int ky_end = iy0 + 3 > 33 ? 33 - iy0 : 3;
+            for (int ox = 0; ox < 5; ox++) {
+                const int ix0 = ox * 1 - 1;
+                const int kx_begin = ix0 < 0 ? -ix0 : 0;
+                const int kx_end = ix0 + 3 > 5 ? 5 - ix0 : 3;
+                int32_t acc[24];
+                for (int c = 0; c < 24; c++) acc[c] = aot_b2_dw_bias[c];
+                for (int ky = ky_begin; ky < ky_end; ky++) {
+                    for (int kx = kx_begin; kx < kx_end; kx++) {
+                        const int8_t* src = in + ((iy0 + ky) * 5 + ix0 + kx) * 24;
+                        const int tap = (ky * 3 + kx) * 24;
+                        for (int c = 0; c < 24; c++) acc[c] += (src[c] + 128) * aot_b2_dw_weights[tap + c];
+                    }
+                }
+                int8_t* px = out + (oy * 5 + ox) * 24;
+                for (int c = 0; c < 24; c++) px[c] = requantize(acc[c], 1617488549, -7, -128, -128);
+            }
+        }
+    }
+}
+
+static constexpr int8_t aot_b2_pw_weights[] = {
+    108, -67, 59, -47, 38, -33, -14, -127, 94, -42, 34, 29, -21, 25, -14, -63,
+    13, -85, -41, 32, 22, 35, 22, -104, -7, -22, -22, 15, 17, 69, -23, -1,
+    6, 35, 12, -39, 35, 34, -127, 49, -2, 48, -93, 1, -115, 127, -58, -127,
+    -61, 67, -47, 39, -15, 56, -61, -89, -10, -77, -78, 22, -62, 67, -21, -127,
+    67, 88, -46, 26, 22, -7, -15, -77, 61, 37, 15, 19, -98, -126, -55, -111,
+    -1, 54, -37, -127, -1, -31, -22, 81, -2, 56, 61, 3, 15, -21, -125, -28,
+    82, 15, -56, 26, -31, -24, -51, 47, -24, -75, 46, 30, -54, -7, -47, 72,
+    -56, -74, -126, -9, 33, 27, -54, -56, 28, -28, -80, 38, -20, -127, -39, 54,
+    7, 15, -78, 83, -27, 20, -91, -14, -13, -19, 22, -73, 67, -17, -14, 109,
+    -71, -53, -103, 16, 50, 127, -32, -42, 61, 63, -103, -38, -65, -22, 64, -99,
+    -41, 12, 59, 25, 7, 16, -2, -69, 22, 23, -65, 55, 63, -44, 47, 55,
+    -59, 64, -80, -67, -67, 48, -18, 86, -52, -44, -50, -23, 98, -84, -64, -41,
+    -27, 31, 34, -66, -87, -127, -34, -76, 127, 84, -54, 15, -19, -90, 74, 55,
+    -67, -65, 4, 2, -48, 27, -33, 19, -2, 85, 26, 127, 21, -5, 62, -85,
+    99, -64, 75, 35, -25, 24, 64, -61, -52, -9, 10, -5, -25, 66, -84, -112,
+    -18, -3, -127, -18, 41, 23, -7, 13, 24, -98, 24, 27, 80, -31, 11, -45,
+    -34, 46, -33, 12, 22, 33, 33, 10, 3, 65, 43, -12, 105, 15, 48, -8,
+    -80, -86, -18, -34, -81, 43, 96, 49, -100, 27, -23, -59, -64, -7, 35, 12,
+    29, -43, 70, -7, 127, -12, 53, -61, 33, -82, 14, -21, -27, 3, -63, -60,
+    -2, -81, -65, 10, 127, 92, 76, 89, -77, -3, 45, -35, 9, -75, -71, -15,
+    29, 37, -68, 127, 32, 47, -16, -39, 90, -50, 42, 44, -31, 52, -127, -85,
+    58, 127, -25, 58, 38, 72, 30, -70, 105, -39, 24, 33, 16, -8, 62, -9,
+    77, 56, -58, 42, -8, 29, -26, 12, 15, -14, -74, 7, -49, -31, -58, -2,
+    36, 56, -32, -59, -10, 32, -91, 88, 1, 53, 72, -2, -21, 61, 31, 48,
+    9, -70, -52, -6, 34, 23, -35, 61, 72, -46, -6, -22, 43, -24, -80, 100,
+    6, -114, 35, 10, 78, 81, -53, 22, 40, 56, -127, 8, -98, 29, 11, 2,
+    -63, 24, -43, -74, 91, 44, 56, -30, 30, 21, -90, 47, 70, -64, 86, -102,
+    -3, -9, 20, 21, 26, -59, -96, 22, 23, -8, -82, 7, 63, 72, -9, -29,
+    -77, -80, -28, -21, -8, 57, -60, 59, -75, 42, -42, 22, 116, 45, -90, 73,
+    -9, -44, -41, 32, 0, -24, 76, -127, -48, 37, -31, 9, -127, 10, 3, -98,
+    26, -127, -30, 27, -9, -8, -94, 40, -83, 34, 59, -61, -124, -79, 13, 86,
+    127, 42, -53, 8, -21, -72, -32, -51, 39, 127, -106, 10, 6, -2, 25, -121,
+    -48, 45, 7, 71, -26, 63, -92, -92, -87, -12, -98, -15, -40, -53, -65, 78,
+    -81, -5, -59, -27, 52, 35, -81, -94, -68, -109, -56, 69, 84, -16, 58, -96,
+    90, 26, 24, -113, -7, -27, -8, -33, -93, -127, 17, 98, -55, 28, -85, -49,
+    -32, -50, -69, -23, 106, -27, -23, 31, -113, -25, -52, -26, 18, -18, 11, -24,
+    -12, -45, -38, 66, -101, 7, 32, 50, -19, 96, -127, 41, 31, -26, -41, -64,
+    25, -1, -29, 39, 79, -97, -63, -24, -58, -31, 56, 45, -85, 32, 103, 116,
+    -65, -31, -17, 32, 6, 43, -14, 92, 49, 7, 10, 85, 21, 82, -13, 69,
+    28, -108, -69, 5, 74, 67, 40, -74, -37, 59, -45, -97, 19, -32, -57, 29,
+    -127, 99, -127, -16, 106, -4, -5, -3, 33, 20, 57, -73, 56, -1, 10, 29,
+    -44, 90, -55, -21, 45, 111, 28, -68, 127, 4, -69, -79, 5, -44, 32, 46,
+    0, 31, 61, 55, 43, 7, -13, 37, -1, -1, 80, -2, -84, -68, -88, -74,
+    -81, 67, -90, -48, 5, -62, -127, 24, 3, -20, -31, -70, 20, -89, -46, 5,
+    9, -58, -35, 101, 27, -34, 12, -17, 66, 63, 3, 66, -127, 62, -9, 47,
+    41, 83, -117, 41, 12, 3, 30, 32, 7, 83, 91, 15, 42, -94, -122, -55,
+    -109, 53, 24, 20, -2, 19, -51, 89, -103, 47, -7, 127, -42, 56, -47, 47,
+    51, 51, -23, 17, 8, -31, 0, -77, 95, 54, -92, -73, 9, -11, -127, 25,
+};
+
+static constexpr int32_t aot_b2_pw_bias[] = {
+    1909, 3435, -33107, 40322, 32969, 21848, -59516, -19167,
+    15803, 13684, -23685, 47088, -40396, -8813, -88694, -5412,
+    -33064, -9976, -141879, -9395, 62960, 54449, -45678, -33789,
+    -3077, 23183, -73296, -9019, -2513, -38001, -20815, -63884,
+};
+
+static void aot_b2_pw(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(windows * 165, part, parts, row_begin, row_end);
+    for (int r = row_begin; r < row_end; r++) {
+        const int8_t* in = input + r * 24;
+        int32_t acc[32];
+        for (int c = 0; c < 32; c++) acc[c] = aot_b2_pw_bias[c];
+        for (int i = 0; i < 24; i++) {
+            const int32_t x = in[i];
+            const int row = i * 32;
+            for (int c = 0; c < 32; c++) acc[c] += x * aot_b2_pw_weights[row + c];
+        }
+        int8_t* out = output + r * 32;
+        for (int c = 0; c < 32; c++) out[c] = requantize(acc[c], 1173747719, -6, -128, -128);
+    }
+}
+
+static constexpr int8_t aot_b3_dw_weights[] = {
+    123, -127, 15, -19, 9, -61, -89, 26, 120, 63, -103, 23, -127, -127, -48, 16,
+    10, 127, 127, 115, -26, -57, -127, 1, -23, 5, 21, 120, 95, 20, 0, -1,
+    127, 20, 41, -25, -25, -127, -127, -74, -7, 127, -105, -29, 24, 20, 46, 46,
+    -6, -33, 94, -55, -48, -60, 44, -83, 40, 34, 20, 66, -42, 59, -60, 23,
+    45, 28, 57, -127, -103, -40, -97, 52, 127, 72, -127, -80, 30, -44, 68, -110,
+    -111, 104, 122, -51, -30, -25, 77, -99, 102, 38, 65, 121, 99, 53, -35, 41,
+    -4, -68, 16, -65, 72, 6, -55, -8, 93, 44, -80, -53, -101, -83, -115, 24,
+    10, 103, -113, 42, -18, -91, -99, -22, -127, -127, -19, 69, 3, -45, -53, -127,
+    86, -44, -1, -59, -5, 20, -43, -76, -31, 74, -107, 23, 15, -42, -19, 5,
+    -4, -6, -46, -10, -14, 49, 6, -13, 68, 32, -27, 45, -110, -10, -54, -127,
+    -42, 51, 42, -77, -60, -24, -46, 50, 105, 45, -118, -102, 57, -10, -33, -40,
+    -127, 69, -46, -127, -94, 5, 99, -58, 74, 2, 45, 87, 96, 1, -64, 12,
+    61, -45, 97, -19, 23, 1, -79, 62, 127, 74, -97, 56, -77, -38, -127, -25,
+    -1, 100, -101, 118, 127, 12, -66, -75, 29, -52, -95, 127, 127, -127, -127, -90,
+    -27, -45, 104, -24, -35, -85, -87, -127, 12, 111, -94, 27, 22, -90, 6, 45,
+    -3, -60, -36, 53, 103, 127, 37, -127, 93, 71, -127, 91, -88, 10, -111, 48,
+    -114, 33, 127, 31, -127, 20, -55, -1, 126, 61, -119, -127, 30, -62, -58, -127,
+    -97, 52, -18, -63, -37, 86, 68, -65, 3, 1, 27, 102, 63, 38, -44, 111,
+};
+
+static constexpr int32_t aot_b3_dw_bias[] = {
+    -3272, 2422, -3588, 5239, 2841, 3519, 7724, -1549,
+    -4720, -7905, 17852, 1702, 329, 4182, 3038, -343,
+    -271, -5301, 116, -874, 163, -1612, -2121, 10939,
+    -4166, -1662, 954, -6143, -5380, -283, 9115, 753,
+};
+
+static void aot_b3_dw(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(33, part, parts, row_begin, row_end);
+    for (int b = 0; b < windows; b++) {
+        const int8_t* in = input + b * 5280;
+        int8_t* out = output + b * 5280;
+        for (int oy = row_begin; oy < row_end; oy++) {
+            const int iy0 = oy * 1 - 1;
+            const int ky_begin = iy0 < 0 ? -iy0 : 0;
+            const int ky_end = iy0 + 3 > 33 ? 33 - iy0 : 3;
+            for (int ox = 0; ox < 5; ox++) {
+                const int ix0 = ox * 1 - 1;
+                const int kx_begin = ix0 < 0 ? -ix0 : 0;
+                const int kx_end = ix0 + 3 > 5 ? 5 - ix0 : 3;
+                int32_t acc[32];
+                for (int c = 0; c < 32; c++) acc[c] = aot_b3_dw_bias[c];
+                for (int ky = ky_begin; ky < ky_end; ky++) {
+                    for (int kx = kx_begin; kx < kx_end; kx++) {
+                        const int8_t* src = in + ((iy0 + ky) * 5 + ix0 + kx) * 32;
+                        const int tap = (ky * 3 + kx) * 32;
+                        for (int c = 0; c < 32; c++) acc[c] += (src[c] + 128) * aot_b3_dw_weights[tap + c];
+                    }
+                }
+                int8_t* px = out + (oy * 5 + ox) * 32;
+                for (int c = 0; c < 32; c++) px[c] = requantize(acc[c], 1498308458, -7, -128, -128);
+            }
+        }
+    }
+}
+
+static constexpr int8_t aot_b3_pw_weights[] = {
+    115, 69, 73, 81, 71, 88, 5, 67, 0, -4, -2, 6, 31, -9, 101, 50,
+    90, -6, 94, 74, 61, 55, 52, -2, 74, 62, 0, 73, -12, 0, -11, 31,
+    88, 11, 60, 78, 70, 92, 82, 92, 70, 68, -6, -7, 105, 71, -3, 83,
+    59, 99, 38, 88, 127, 40, -43, 49, -34, -36, -32, -63, -60, -14, 89, 43,
+    90, -45, 122, 86, 85, 39, 87, -28, 109, 107, -45, 37, -57, -35, -39, -15,
+    124, -30, 83, 81, 32, 101, 113, 103, 101, 92, -50, -42, 60, 82, -37, 82,
+    79, 83, 84, 104, 82, 79, -35, 77, -23, -28, -32, -27, 2, -14, 55, 112,
+    118, -34, 127, 38, 39, 86, 65, -32, 127, 43, -20, 87, -35, -30, -35, 60,
+    80, -26, 92, 115, 89, 86, 105, 96, 46, 72, -30, -31, 60, 127, -32, 67,
+    -32, -25, -71, -73, -52, -86, -4, -96, 29, 51, 21, 29, 44, 1, -50, -78,
+    -5, -16, 16, -77, -43, -127, -127, -16, -30, -95, 30, -52, 14, 18, -25, -41,
+    12, 13, -24, -29, -127, -86, -85, -127, -127, -127, 43, 33, 9, -95, 56, -1,
+    -114, 84, 21, -84, -5, 102, -70, 70, -34, -68, -37, -87, -58, -47, -28, -27,
+    80, -51, 46, -56, 53, -33, -2, -29, -25, -100, -37, -97, -34, -39, -40, -30,
+    -65, -60, 65, 26, 7, -86, -39, -34, -41, 15, -51, -51, 46, 89, -24, -39,
+    49, 58, -6, -74, -6, -88, -66, -44, 14, -26, -76, 52, 21, -35, -76, -47,
+    -85, -50, -88, 10, -18, -82, 2, -68, 31, 48, 23, -57, -61, -57, -99, -65,
+    98, 38, -38, -9, -21, -107, 25, -21, -23, 61, -46, -65, 63, -6, -98, 15,
+    -77, -125, -61, -100, -83, 15, 59, -103, 46, 46, 51, 44, 61, 66, 19, -80,
+    -116, 49, -74, -99, -87, -90, -44, 58, -77, -127, 44, -127, 57, 52, 56, -68,
+    -109, 48, -73, -51, -117, -108, -70, -120, -109, -21, 62, 47, -89, -84, 64, -53,
+    94, -12, -96, -21, 13, -42, -30, -31, -11, -19, 7, 40, 17, -18, 0, -1,
+    10, -51, 113, 14, -2, 34, 51, 11, -29, 4, 34, -42, -69, -20, 3, -16,
+    50, -5, 4, 65, 65, -27, -56, 59, -8, -1, -10, 1, -33, -41, 10, -10,
+    -2, -58, -87, -27, -21, -57, 39, -24, 34, 31, 30, 32, 8, 22, -32, -94,
+    -54, 41, -13, -11, 14, -100, -13, 36, -120, 5, 55, -12, 39, 35, 37, -45,
+    -101, 50, 14, -6, -29, -19, -76, -20, -56, -33, 21, 34, -21, -102, 32, -18,
+    69, 9, 54, 34, -10, 57, -66, 1, -89, -74, -81, -76, -60, -72, 10, 1,
+    6, -83, -34, 26, -30, -19, 8, -83, 42, 33, -95, 46, -83, -82, -75, 11,
+    3, -93, 50, -5, -18, 29, 36, 42, 8, 31, -82, -74, -24, 63, -68, 55,
+    -122, -87, -121, -127, -102, -127, 127, -102, 127, 127, 127, 127, 104, 127, -124, -127,
+    -117, 127, -99, -73, -86, -105, -73, 127, -93, -99, 127, -110, 127, 127, 127, -108,
+    -119, 127, -127, -114, -122, -86, -127, -117, -113, -92, 127, 127, -36, -54, 127, -121,
+    -63, -8, -14, -50, 21, -26, 16, 48, 89, -22, -22, -87, -39, 22, 83, -37,
+    -28, 21, 10, -35, -50, -37, -24, 1, -58, -16, 11, -39, 88, 51, 53, -30,
+    -94, 44, -38, -58, -39, 30, 43, -71, 35, 2, -15, 35, -34, 21, 40, 9,
+    -39, 25, -73, -55, -33, 22, 30, -116, -21, 34, 20, -29, -23, 51, -45, 42,
+    61, 32, 52, -81, -86, 74, 61, 11, 9, -78, 32, -101, -18, 29, 3, -25,
+    -72, 13, -90, 78, 24, 5, -20, -116, 76, 3, 14, -15, -24, -13, 26, 56,
+    -47, 86, -16, 83, 84, 82, -8, 14, -42, -31, -39, -31, -74, -30, 66, -13,
+    114, -10, -9, 5, 74, 22, -8, -24, 9, -15, -40, 8, -1, -32, 12, 61,
+    -19, -40, 4, 119, 42, 14, 40, 97, 39, 51, 7, -54, 105, 105, -41, 82,
+    78, -10, 53, -46, -17, 90, 2, -23, -13, 3, -59, 14, -56, -61, 63, 61,
+    10, -30, 54, -36, 61, 66, 84, -77, -58, 64, -12, -2, 5, -42, -25, -42,
+    5, -36, -63, 17, 81, -79, 35, -35, 94, -11, -21, -4, -29, -86, -31, 83,
+    62, 61, -72, -79, -21, -19, -22, 65, -66, -48, 26, 85, -25, -2, 122, 28,
+    7, -25, 73, 58, 19, 4, -31, -14, -85, -67, 61, 70, -54, -64, 59, -4,
+    -59, 14, 41, -30, 71, -42, -83, -125, -47, -50, -37, -60, -3, 33, 11, 70,
+    14, -32, 93, -90, 8, 21, 11, -53, -13, 42, -20, 54, 55, -46, -23, -28,
+    -5, 14, 71, 22, -46, 44, 60, -11, 37, -60, 56, -24, 2, -35, 68, 34,
+    27, -29, -6, 75, -117, -91, 11, -91, -15, 114, -33, -68, 50, -25, -17, -32,
+    30, 68, 41, 69, 58, 25, -25, 39, -15, -9, -19, -12, -20, -19, 78, 65,
+    57, -24, 67, 32, 63, 73, 33, -21, 79, 52, -12, 56, -23, -19, -23, 35,
+    75, -16, 87, 75, 38, 49, 47, 51, 70, 52, -10, -20, 20, 65, -21, 40,
+    13, 72, 0, 15, 10, 61, -51, 127, -33, -43, -25, -48, -7, -25, 60, -6,
+    97, -42, 76, 11, 12, 97, 94, -16, -3, 24, -35, 105, -37, -25, -37, 127,
+    23, -31, 58, 80, 2, 53, -20, -26, 120, 104, -22, -42, -33, 29, -14, -48,
+    -54, -50, 28, 11, -69, 90, -38, -63, 3, -12, 1, 1, 5, 16, 59, 22,
+    -15, 20, 74, -86, -78, -6, 26, -4, 73, -51, -1, -88, 10, 9, -16, -59,
+    -25, 5, -85, 56, -17, 31, -58, -36, 5, 49, 21, -5, -61, -44, 7, -58,
+    -58, -88, -106, 31, -62, -97, -15, -82, -42, -11, -39, -8, 4, -26, 10, -57,
+    -127, -43, -31, -63, 8, -105, -3, -39, -22, -98, -5, 4, -53, -43, -34, -45,
+    -42, -10, -111, -58, -91, -1, -34, 29, -71, -76, -36, -26, 14, 51, -56, -46,
+    -101, -31, -69, -18, -74, 16, 18, -30, 4, 25, 19, 5, -1, 26, 28, 39,
+    5, 5, -76, 1, 62, 20, -11, 15, -12, -83, -11, 43, 9, 4, -27, 22,
+    -63, 8, -72, -27, -52, -4, -65, 39, 20, -11, 27, 2, 3, 9, -4, -95,
+    38, 127, 127, 125, 83, 70, -39, -14, -19, -33, -29, -23, -30, -29, 127, 103,
+    102, -34, 106, 54, 65, 100, 25, -27, 104, 110, -35, 76, -25, -32, -32, 38,
+    115, -32, 81, 127, 74, 25, 42, 30, 86, 98, -33, -26, -45, 75, -29, -15,
+    -26, 27, 50, 85, 74, 5, -87, 66, -62, -73, -79, -60, -73, -65, 59, 67,
+    53, -77, 63, -7, 12, 3, 53, -86, 73, 11, -49, 31, -80, -86, -89, -30,
+    52, -56, -39, -16, 66, 61, 46, 58, 64, 28, -84, -76, 78, 29, -103, 1,
+    11, 102, 53, 101, -25, 60, -48, -29, -2, -1, -20, -6, -44, -15, 49, 55,
+    -9, -14, 50, 77, 61, 67, -33, -24, 111, 6, -36, 82, 6, -12, -7, 7,
+    85, -32, 98, 91, -8, 48, 40, 45, 43, 30, 0, -27, 1, 62, 9, 35,
+    -107, -35, -23, -34, 49, 4, 49, 48, 22, -13, -65, -120, 55, -10, 25, -13,
+    16, -48, -50, 29, 48, 44, 67, -11, -81, -20, 1, -80, -53, 8, -81, 16,
+    -47, 14, -30, -78, -62, -84, 63, -25, 65, 27, -67, 34, 65, 76, -76, -54,
+    56, 82, 45, 48, 79, 93, -57, 27, -50, -42, -21, -39, -34, -41, 105, 1,
+    -73, -37, 44, 33, -66, 92, 14, -38, 74, -4, -43, 8, -39, -33, -53, -1,
+    76, -33, 73, 78, 33, 9, -9, -55, 26, 62, -47, -52, 38, -24, -51, 57,
+    -57, -30, -17, -52, -32, -38, 95, -22, 83, 86, 97, 98, 127, 56, -53, -18,
+    -42, 91, -65, -24, -48, -6, -30, 91, -42, -35, 90, -45, 107, 87, 98, -18,
+    -6, 91, -80, -70, -30, -51, -27, -43, -23, -42, 96, 79, -34, -59, 88, -28,
+    -32, -66, 4, -104, -30, 3, -74, -56, -37, -45, -46, -19, -59, -38, -31, -9,
+    4, -48, 28, -22, 1, 37, 31, -63, -6, 50, -79, -88, -32, -53, -51, 23,
+    18, -81, -10, -5, -54, -65, 49, -38, 8, 49, -4, -48, 80, -8, -33, 53,
+    -19, 73, 106, 50, 85, 35, 0, 75, 22, -6, 24, 46, 12, -13, 17, -11,
+    -21, 53, 22, -29, -21, -18, -27, 9, 84, 57, -5, 94, 57, 20, 25, 76,
+    -7, 27, 28, -27, 38, 45, 73, -15, 2, 62, 27, 20, 48, 88, 15, 68,
+    127, 118, 102, 100, 85, 19, -6, 57, -2, -3, 5, 1, -25, -9, -13, 57,
+    126, 1, 6, 127, 127, -4, -21, -1, 110, 88, -2, 75, 0, -2, -2, 103,
+    127, -6, 121, 59, 58, 127, 111, 125, 13, 16, -2, -2, 127, 125, -5, 127,
+    -30, -61, 5, -45, -68, -43, 26, -51, 35, 24, 21, 25, 10, 46, 14, -12,
+    -84, 23, -40, 5, -73, 17, -18, 21, -34, -35, 25, -94, 24, 21, 21, -56,
+    -20, 25, -117, -52, -61, -6, -61, -60, -21, -35, 26, 30, -40, -102, 16, -98,
+};
+
+static constexpr int32_t aot_b3_pw_bias[] = {
+    -10525, 63940, 17248, -5571, 27851, 54921, -37138, -10311,
+    -13456, -22463, -35664, -10202, -16317, -24599, 92321, 13331,
+    33014, -35349, 90862, 2653, 16964, 33050, 44415, -39982,
+    43884, -25201, 2760, -16680, -28122, -34517, -27979, -3088,
+    25436, -11605, -2650, 71359, -18537, -16853, 16084, -35846,
+    43966, 72824, -27548, -43476, 55842, 55764, -29728, 31811,
+};
+
+static void aot_b3_pw(const int8_t* input, int8_t* output, int windows, int part, int parts) {
+    int row_begin, row_end;
+    DualCore::split(windows * 165, part, parts, row_begin, row_end);
+    for (int r = row_begin; r < row_end; r++) {
+        const int8_t* in = input + r * 32;
+        int32_t acc[48];
+        for (int c = 0; c < 48; c++) acc[c] = aot_b3_pw_bias[c];
+        for (int i = 0; i < 32; i++) {
+            const int32_t x = in[i];
+            const int row = i * 48;
+            for (int c = 0; c < 48; c++) acc[c] += x * aot_b3_pw_weights[row + c];
+        }
+        int8_t* out = output + r * 48;
+        for (int c = 0; c < 48; c++) out[c] = requantize(acc[c], 1829410577, -7, -128, -128);
+    }
+}
+
+static void aot_pool(const int8_t* input, int8_t* output, int windows, int, int) {
+    for (int b = 0; b < windows; b++) {
+        const int8_t* in = input + b * 7920;
+        int8_t* out = output + b * 48;
+        int32_t sum[48] = {0};
+        for (int p = 0; p < 165; p++) {
+            for (int c = 0; c < 48; c++) sum[c] += in[p * 48 + c];
+        }
+        for (int c = 0; c < 48; c++) {
+            int32_t mean = sum[c] >= 0 ? (sum[c] + 82) / 165 : -((-sum[c] + 82) / 165);
+            out[c] = (int8_t)(mean < -128 ? -128 : mean > 127 ? 127 : mean);
+        }
+    }
+}
+
+static constexpr int8_t aot_logits_weights[] = {
+    -46, -6, -100, -53, -45, -60, 121, -13, 80, 114, 48, 68, 76, 49, -23, -12,
+    -86, 35, -9, -55, -75, -79, -13, 83, -60, -113, 66, -35, 22, 84, 121, -46,
+    -66, 104, -36, -67, -84, -48, -88, -41, 26, -2, 97, 127, -2, -33, 84, -90,
+    33, 114, 78, 82, 106, 59, -88, 78, -50, -45, -77, -38, 3, -30, 104, 111,
+    95, -96, 109, 63, 10, 64, 66, -89, 83, 39, -43, 88, -94, -78, -65, 56,
+    71, -18, 96, 77, 61, 30, 99, 81, 105, 103, -75, -22, 94, 112, -54, 62,
+    42, 18, -25, 9, -18, -100, -60, -96, -67, -4, -29, 35, 40, -105, -73, 18,
+    -59, -56, 14, -102, -50, -110, -87, -51, 9, -71, 29, -77, -5, -41, -10, -77,
+    0, 7, 35, -10, -69, 16, 26, -101, -23, -7, 20, -37, -64, -39, -46, -97,
+};
+
+static constexpr int32_t aot_logits_bias[] = {
+    -12552, 190974, -201610,
+};
+
+static void aot_logits(const int8_t* input, int8_t* output, int windows, int, int) {
+    for (int b = 0; b < windows; b++) {
+        const int8_t* in = input + b * 48;
+        float* logits = reinterpret_cast<float*>(output) + b * 3;
+        for (int k = 0; k < 3; k++) {
+            int32_t acc = aot_logits_bias[k];
+            const int8_t* w = aot_logits_weights + k * 48;
+            for (int i = 0; i < 48; i++) acc += in[i] * w[i];
+            logits[k] = acc * 7.2191e-05f;
+        }
+    }
+}
+
+static void aot_probabilities(const int8_t* input, int8_t* output, int windows, int, int) {
+    for (int b = 0; b < windows; b++) {
+        const float* logits = reinterpret_cast<const float*>(input) + b * 3;
+        float* probabilities = reinterpret_cast<float*>(output) + b * 3;
+        float max_logit = -INFINITY;
+        for (int k = 0; k < 3; k++) {
+            if (logits[k] > max_logit) max_logit = logits[k];
+        }
+        float total = 0.0f;
+        for (int k = 0; k < 3; k++) {
+            probabilities[k] = expf(logits[k] - max_logit);
+            total += probabilities[k];
+        }
+        for (int k = 0; k < 3; k++) probabilities[k] /= total;
+    }
+}
+
+struct AotCall {
+    AotLayer layer;
+    const int8_t* input;
+    int8_t* output;
+    int windows;
+};
+
+static void runPart(void* context, int part, int parts) {
+    const AotCall& call = *static_cast<const AotCall*>(context);
+    call.layer(call.input, call.output, call.windows, part, parts);
+}
+
+static void runSplit(DualCore& dual_core, AotLayer layer, const int8_t* input, int8_t* output, int windows) {
+    AotCall call = {layer, input, output, windows};
+    dual_core.run(runPart, &call);
+}
+
+void model_aot_run(const int8_t* const* inputs, int windows, int8_t* arena, float* outputs, DualCore& dual_core) {
+    for (int b = 0; b < windows; b++) {
+        memcpy(arena + 2640 * windows + b * 650, inputs[b], 650);
+    }
+    {
+        TRACE_SPAN("aot_conv");
+        runSplit(dual_core, aot_conv, arena + 2640 * windows, arena + 0 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_b1_dw");
+        runSplit(dual_core, aot_b1_dw, arena + 0 * windows, arena + 3968 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_b1_pw");
+        runSplit(dual_core, aot_b1_pw, arena + 3968 * windows, arena + 0 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_b2_dw");
+        runSplit(dual_core, aot_b2_dw, arena + 0 * windows, arena + 5280 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_b2_pw");
+        runSplit(dual_core, aot_b2_pw, arena + 5280 * windows, arena + 0 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_b3_dw");
+        runSplit(dual_core, aot_b3_dw, arena + 0 * windows, arena + 7920 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_b3_pw");
+        runSplit(dual_core, aot_b3_pw, arena + 7920 * windows, arena + 0 * windows, windows);
+    }
+    {
+        TRACE_SPAN("aot_pool");
+        aot_pool(arena + 0 * windows, arena + 7920 * windows, windows, 0, 1);
+    }
+    {
+        TRACE_SPAN("aot_logits");
+        aot_logits(arena + 7920 * windows, arena + 0 * windows, windows, 0, 1);
+    }
+    {
+        TRACE_SPAN("aot_probabilities");
+        aot_probabilities(arena + 0 * windows, arena + 16 * windows, windows, 0, 1);
+    }
+    memcpy(outputs, arena + 16 * windows, windows * 12);
+}
@@ -0,0 +1,20 @@
+// Generated by tools/model_converter.py --aot from model_weights.h. Do not edit.
+#pragma once
+#include <cstdint>
+#include "DualCore.h"
+
+#define MODEL_AOT_NAME "ds_cnn_tiny_v2"
+#define MODEL_AOT_ARENA_SIZE 13200 // Bytes per window
+#define MODEL_AOT_INPUT_H 65
+#define MODEL_AOT_INPUT_W 10
+#define MODEL_AOT_INPUT_C 1
+#define MODEL_AOT_INPUT_SCALE 0.6634234189987183f
+#define MODEL_AOT_INPUT_ZERO_POINT 58
+#define MODEL_AOT_OUTPUTS 3
+#define MODEL_AOT_PLACEHOLDER_SCALES 1 // 1: activation scales are stand-ins
+
+// Runs `windows` feature windows through the network. `arena` holds
+// windows * MODEL_AOT_ARENA_SIZE bytes, 16-byte aligned; outputs is
+// [windows][MODEL_AOT_OUTPUTS]. Convolutions are split by rows through
+// dual_core (inline unless its helper is running).
+void model_aot_run(const int8_t* const* inputs, int windows, int8_t* arena, float* outputs, DualCore& dual_core);
@@ -0,0 +1,308 @@
+// Generated by tools/model_converter.py from model_weights.h. Do not edit.
+#include "model_graph.h"
+
+static const int8_t graph_weights[] = {
+    46, -90, -103, -66, 6, -55, 42, 62, 127, 53, -83, -12, 6, 50, 74, 127,
+    69, -127, -51, -76, -18, 56, -127, -72, 26, -16, 117, 115, -127, 70, 42, -44,
+    66, -36, -90, 22, -107, -103, 40, -64, 69, -41, 127, 64, 44, 9, 127, -64,
+    -66, 33, -25, 82, -86, -30, 127, 119, -72, 77, 79, 61, -113, -70, -1, -91,
+    -53, 83, 88, 80, 127, -83, -76, -28, -27, 57, -127, -16, 80, -21, -24, 52,
+    -21, 17, -99, 44, -30, 4, -6, 70, -127, -79, -25, 22, 19, -31, 37, 63,
+    -44, -56, 127, 75, -27, -20, -66, -127, 47, -53, 101, -117, 60, 59, 83, -18,
+    45, -17, 48, -38, -127, -48, -123, 38, 36, 25, -127, -10, -8, -78, 55, -114,
+    6, -63, 3, 94, -80, 127, -7, 47, 123, -80, 63, -87, -72, 37, -127, 66,
+    106, 107, 90, 34, 127, -68, 2, 3, -52, -66, -68, -21, -17, 62, -80, -35,
+    80, 127, -28, -9, 8, 70, 22, 127, -26, 67, -45, -28, 16, 27, -119, -17,
+    -59, 22, -127, 12, -86, -59, -109, -31, -67, 127, 7, 93, 19, 127, -89, 12,
+    10, -29, 86, 22, 12, 96, 47, 33, 40, 92, 27, -54, 51, -57, -127, -28,
+    11, 20, 54, -55, 13, -127, 127, 18, -124, -11, -6, 127, 67, -54, -72, -48,
+    6, -45, -14, 127, -3, -74, -70, 40, -20, -27, -127, 100, -71, 107, 0, -34,
+    68, -118, 4, 44, 83, -99, -24, -33, 127, -1, -29, -78, 38, -97, -9, -127,
+    -37, 25, -49, 25, -34, 24, 14, -99, 33, -57, -30, -22, 127, -109, 20, -12,
+    -127, -33, -91, 55, -43, 43, 6, -41, -73, -67, -124, 51, -1, 46, 52, -19,
+    127, -57, 40, -60, -118, -82, -39, 69, -54, -41, 5, -25, 74, 59, -67, 99,
+    -12, 9, 101, -124, 104, 15, 26, -29, -48, -5, 87, 18, -48, 3, -127, 86,
+    2, 57, -123, -79, 41, 30, -21, -14, 89, -37, -63, -49, -28, 106, -127, 50,
+    -75, 36, -45, 76, -57, 67, 95, 96, -127, 17, 53, 116, 82, -118, 17, -20,
+    -89, 42, -24, -13, 127, 56, -25, -41, 18, -67, 52, -55, 17, 127, -110, 72,
+    70, -27, 24, 20, -101, -30, 65, 63, 60, 67, -62, -127, -28, -44, -69, 53,
+    -94, 107, -37, 127, -125, 39, 57, -65, -60, 27, -9, -3, -85, 87, 65, -85,
+    4, 29, -119, 126, -22, 87, -83, 127, 86, 56, 52, -110, 37, 28, -124, -8,
+    -87, -110, 86, 36, 69, -68, -40, 127, 91, -88, 16, -8, 124, 5, -14, 60,
+    -116, -26, -124, 6, 5, -122, -4, -127, -62, 56, 79, 102, 15, 50, -86, -96,
+    -25, 96, 38, -29, -81, -1, -24, 31, -24, -60, 59, -127, -48, 25, 11, -71,
+    40, 23, 16, -71, 36, 93, -46, 69, 59, 96, -6, -53, 31, -123, -127, 78,
+    -7, 43, 117, 13, -14, 108, -53, 95, -93, 46, -121, 79, 127, 42, 93, 63,
+    63, 33, 30, 41, -17, 44, 17, -51, 21, 75, -127, -46, -14, -50, 30, -17,
+    -21, -19, -12, 20, -8, 66, -54, -111, -18, 12, -127, 27, 53, -108, -34, -17,
+    -15, -96, -32, -41, 102, 127, 10, 11, 90, 89, -18, 23, 5, 7, -64, 116,
+    -9, 2, -127, -64, -52, -2, -58, 55, -112, -7, -96, -2, 34, -84, -107, 94,
+    8, 118, -116, 1, -67, -112, -39, 89, -55, -127, -100, -31, -31, -19, -25, -35,
+    -54, -69, -124, -83, 14, 32, -11, -95, 26, -127, -17, 6, 62, -11, 38, -37,
+    -11, -61, 33, -2, 95, -26, 8, 127, -24, 77, -103, -1, -51, -88, 35, 75,
+    -42, 13, 75, -45, 64, -67, 24, 44, -109, 38, 6, 8, -127, 48, -90, -83,
+    102, 7, -29, -104, 55, 127, 69, 24, -89, -92, -3, -51, -5, 46, -61, -2,
+    -109, 2, 32, -29, -104, 44, 14, -51, 105, 81, 19, 113, 76, -127, -23, -59,
+    -107, 87, -70, -24, -66, 12, -1, 1, -101, 82, -65, 114, 12, 11, 14, -127,
+    28, 36, 127, 67, 98, 78, 92, 81, -127, -71, -127, 127, -4, -91, -41, -11,
+    -8, -69, 49, -42, 2, 103, 89, 96, -127, 83, -9, -100, 86, -4, 83, 44,
+    -32, -63, 7, 51, -7, 27, 124, 45, 127, -121, 65, 75, 38, 37, -127, -34,
+    55, -40, -40, -127, 57, -89, 77, 2, 1, 34, 92, 9, 92, 79, 84, -83,
+    93, -17, 36, -2, -70, -22, 18, -30, -101, 73, -53, 125, 112, 13, -41, 127,
+    54, -47, -69, 28, -82, 82, -30, 46, -86, -98, 27, 86, 7, 17, 22, -17,
+    -24, 43, -25, 9, -60, -21, -7, -57, 23, -84, -3, 22, 96, 90, -54, -100,
+    -22, -16, -4, 127, -26, -46, 24, 55, 50, -22, 18, -30, 40, -127, -55, -86,
+    36, 31, 34, -28, -14, -41, -127, 14, 19, 37, -27, -77, -85, 127, -9, -3,
+    18, -57, -74, -40, 77, 72, -121, 70, -32, -127, 20, -68, -35, 48, 98, 2,
+    -77, -127, -45, 67, 87, -92, 49, 1, -5, -127, 113, -98, -127, -86, -127, -11,
+    1, 30, -15, -48, 127, -127, -3, 24, -58, 36, -25, -50, -127, 30, -46, -27,
+    -2, 4, 1, 72, 38, -125, -42, -8, -55, 94, -64, 32, -51, -5, -115, 127,
+    -90, 85, -127, -39, -113, -51, -4, -127, 108, 6, 67, 82, 7, -41, -27, 99,
+    -34, 29, 29, 77, 9, -63, -77, 26, -48, 90, -12, -65, -127, 0, 9, -109,
+    -67, 35, 88, 15, 15, 12, 31, -64, 46, -43, 37, 56, -70, 24, -80, -127,
+    45, 26, -45, -31, 99, 31, -58, 53, 59, 12, -46, -56, -78, 59, 34, 75,
+    -33, 70, -68, -58, -52, -43, -28, -30, 7, 24, -38, -17, -127, 61, -35, 24,
+    -47, -39, 26, 26, 83, 25, -66, 35, 12, -7, 127, 42, -6, -74, -21, 27,
+    71, -113, 66, 32, -16, 55, 101, 20, 38, 35, 22, -31, -27, 7, -87, -25,
+    22, 127, 32, -8, 34, 91, -8, -9, -26, -7, -101, 6, 106, 43, 27, -2,
+    -33, 34, -7, -24, 20, 16, -127, 24, 33, -12, 47, 29, 23, 44, 57, -8,
+    63, -27, 7, 43, -4, 7, -34, 19, -14, -127, -15, -51, -91, -2, -34, 64,
+    33, 53, -16, -26, -35, 56, -60, -94, -92, -8, 32, -14, -5, -13, 12, -51,
+    -127, 49, -77, 47, -14, -69, -76, -61, 10, -61, -39, 12, 61, -30, 59, 40,
+    -92, -33, 50, 92, -3, 37, -17, 89, 94, -2, 61, -24, -13, 22, 127, -52,
+    3, 33, 90, 15, 72, 30, -75, -83, -87, -93, -19, 49, 33, -1, 66, -103,
+    -42, 48, 37, -75, -19, 23, 84, -9, 65, -82, -50, -14, -46, 21, 42, 34,
+    -12, -127, 96, 7, 20, -1, 63, 47, 34, -93, 15, 46, 22, -65, -54, 10,
+    43, 14, 42, -74, -6, -90, -42, 59, -98, 17, -127, 10, 57, 80, 3, -7,
+    29, 1, 19, 30, -73, 55, 15, -5, -12, -21, 44, 7, -22, 47, 22, -61,
+    -15, 98, 41, 85, -73, -2, 66, 127, -21, -115, -98, -54, 67, 63, -19, -25,
+    105, -27, -31, -49, 43, 70, 116, -124, -40, -55, 31, 21, 56, -84, -127, -42,
+    25, 127, -126, -7, -17, -44, -90, 66, 15, 3, 52, -31, -24, -64, 45, -79,
+    -53, 28, -26, 82, -1, -68, 62, 56, -14, -58, -55, -47, -14, 47, 74, -84,
+    48, -63, -127, -58, -80, 86, -90, 13, -65, -85, -41, -13, 10, -88, -9, -47,
+    -63, -127, -111, 72, 109, 55, 55, -112, -8, -60, -85, -2, 100, -102, 73, 86,
+    78, -49, -64, 69, 29, -74, 47, 47, 13, -61, -1, -56, -71, -59, -67, -18,
+    -80, -2, 58, 36, 6, -3, -9, 127, -81, -32, 25, 28, -44, -81, 41, 51,
+    -85, 67, 54, -74, -53, 64, -65, -3, -86, -81, 127, 56, -114, -9, -44, 42,
+    -5, -50, -1, -108, 90, 67, 83, 51, -41, -47, -37, -126, -103, -80, 4, -127,
+    -18, -65, -25, -32, 35, 20, -41, -53, -59, -69, -29, -69, -55, -90, -117, -23,
+    32, 39, -127, -9, 16, -67, 2, -18, -34, 10, 58, -59, 10, 21, 32, 8,
+    -27, -23, 39, 5, -21, -48, 41, 17, 22, -15, -1, 33, 50, -67, -48, 41,
+    -81, 127, 38, -10, 78, 26, 0, -21, 52, 106, 79, 74, 45, 5, 12, 8,
+    35, 56, -31, 27, 127, 48, 27, 23, 43, 92, 72, 32, 81, -59, -24, -72,
+    35, -27, -97, 67, 111, -62, 3, -31, 22, -61, -22, -54, -32, -18, -33, -7,
+    96, 76, 30, -91, -53, -96, 76, -32, -81, -23, -63, 40, 28, -127, 30, 0,
+    -104, -89, 81, -56, -42, 86, 19, 13, 49, 89, -70, 88, 22, 22, -127, -51,
+    -94, 31, -24, -74, -68, 24, 32, -77, -7, -10, -2, 28, 61, -52, -2, 24,
+    -100, -77, 105, 1, 40, 23, -48, 39, -68, -113, -58, -37, 127, 3, 7, 95,
+    -22, -77, 56, -28, 63, -44, 85, -98, 27, -3, -39, 53, 56, -8, 37, 127,
+    -109, -25, -31, 59, 4, -20, 83, 54, -22, -78, 61, -80, -103, -50, 26, 24,
+    -23, 45, 24, 72, -127, -82, -31, -106, -56, -52, 56, -45, -69, -31, 91, -92,
+    15, 22, 3, 38, -38, -23, 127, 27, -59, -35, 33, -2, 8, 7, 9, 10,
+    69, -26, 45, -97, -79, -70, 15, -73, 17, -62, 15, -20, -65, 98, 21, 80,
+    -64, 9, 16, -21, -98, 63, -127, 6, 84, 18, -85, 19, 5, 20, 42, 9,
+    69, 67, -21, -127, -22, -84, -5, -31, -7, -75, -8, 61, 29, 72, 10, -2,
+    -16, -18, 32, -32, -44, -89, -94, -11, -23, -21, -125, -39, 64, -64, 62, 11,
+    35, -71, 62, 31, 11, -9, 3, 25, 58, 11, 103, -57, 32, -46, -122, -127,
+    -1, -127, -28, 54, -99, -41, -85, -45, 12, -15, -9, 48, 2, -29, -98, -121,
+    -96, -24, 116, 29, 46, 5, -55, 25, 123, -127, 15, -19, 9, -61, -89, 26,
+    120, 63, -103, 23, -127, -127, -48, 16, 10, 127, 127, 115, -26, -57, -127, 1,
+    -23, 5, 21, 120, 95, 20, 0, -1, 127, 20, 41, -25, -25, -127, -127, -74,
+    -7, 127, -105, -29, 24, 20, 46, 46, -6, -33, 94, -55, -48, -60, 44, -83,
+    40, 34, 20, 66, -42, 59, -60, 23, 45, 28, 57, -127, -103, -40, -97, 52,
+    127, 72, -127, -80, 30, -44, 68, -110, -111, 104, 122, -51, -30, -25, 77, -99,
+    102, 38, 65, 121, 99, 53, -35, 41, -4, -68, 16, -65, 72, 6, -55, -8,
+    93, 44, -80, -53, -101, -83, -115, 24, 10, 103, -113, 42, -18, -91, -99, -22,
+    -127, -127, -19, 69, 3, -45, -53, -127, 86, -44, -1, -59, -5, 20, -43, -76,
+    -31, 74, -107, 23, 15, -42, -19, 5, -4, -6, -46, -10, -14, 49, 6, -13,
+    68, 32, -27, 45, -110, -10, -54, -127, -42, 51, 42, -77, -60, -24, -46, 50,
+    105, 45, -118, -102, 57, -10, -33, -40, -127, 69, -46, -127, -94, 5, 99, -58,
+    74, 2, 45, 87, 96, 1, -64, 12, 61, -45, 97, -19, 23, 1, -79, 62,
+    127, 74, -97, 56, -77, -38, -127, -25, -1, 100, -101, 118, 127, 12, -66, -75,
+    29, -52, -95, 127, 127, -127, -127, -90, -27, -45, 104, -24, -35, -85, -87, -127,
+    12, 111, -94, 27, 22, -90, 6, 45, -3, -60, -36, 53, 103, 127, 37, -127,
+    93, 71, -127, 91, -88, 10, -111, 48, -114, 33, 127, 31, -127, 20, -55, -1,
+    126, 61, -119, -127, 30, -62, -58, -127, -97, 52, -18, -63, -37, 86, 68, -65,
+    3, 1, 27, 102, 63, 38, -44, 111, 115, 59, 79, -32, -114, 49, -77, 94,
+    -2, 69, -122, -63, -39, -47, 78, 62, 14, 30, 13, -54, -58, -101, 38, -26,
+    11, -107, 56, -57, -32, -19, 127, -30, 69, 99, 83, -25, 84, 58, -125, -12,
+    -58, 9, -87, -8, 25, 86, -10, 61, -32, 68, 72, -50, -88, -31, 127, 27,
+    102, -35, 82, -30, -66, 73, 118, -61, 73, 38, 84, -71, 21, -6, -61, -96,
+    -87, 54, -121, -14, -73, -16, 53, -72, 93, 41, 0, 28, -106, -69, 127, 50,
+    53, -23, 45, -17, 4, 106, 102, 5, 81, 88, 104, -73, -84, -74, -100, -21,
+    -27, 34, -127, -50, -55, 83, -46, -79, -90, 69, 15, 11, 31, -18, 125, 85,
+    101, -34, 48, -52, -104, 50, 100, -45, 71, 127, 82, -52, -5, -6, -83, 13,
+    -21, -10, -102, 21, -33, 84, -17, -21, 8, 58, 10, -69, -62, -74, 83, 74,
+    -25, 49, 79, -32, -30, 85, 85, -68, 88, 40, 79, -86, 102, -88, 15, -42,
+    -57, 57, -127, -26, 22, 82, 90, -19, 21, 25, 61, 90, -97, 16, 70, 5,
+    60, 4, 93, -38, 3, 35, 19, -43, 5, -43, -35, -4, -70, -66, 59, -30,
+    39, -66, 127, 16, 30, -8, 2, -22, 11, -25, -51, -38, -15, 18, -39, -87,
+    -48, 49, -57, 95, -74, 0, -6, 26, 67, 49, 77, -96, 70, -44, -103, -31,
+    -24, 1, -102, 48, -116, 14, -23, 65, -53, 39, 127, -63, -82, -30, -14, 66,
+    -29, 48, 27, -22, -56, 75, 57, -51, 0, -34, -23, 29, -34, 14, 46, -11,
+    34, -89, 127, 89, -21, -42, -13, -66, -13, -15, -33, 3, -42, 4, -19, -62,
+    -2, 22, -50, 83, -37, 22, -2, 35, -4, -36, -28, 51, -68, -26, 46, -19,
+    31, -74, 127, -22, 34, -31, 3, -48, 42, -9, -43, -12, -11, 25, -33, -73,
+    -1, -13, -42, 86, -45, -6, -3, 24, -2, -32, -32, 21, -37, -76, 51, 7,
+    30, -81, 127, -22, 20, -39, -59, 26, -20, -19, -25, 1, -39, 19, -29, -79,
+    -20, -65, -21, 97, -46, 24, 5, 21, 6, -63, -27, 29, -87, 52, 44, 40,
+    32, -76, 127, -87, -29, -31, 14, 85, 54, -12, -48, 1, -8, 5, -23, -60,
+    -6, -120, -39, 98, -19, 46, 1, 25, 31, -60, 2, 44, -58, 21, 61, 17,
+    8, -60, 104, -39, -23, -74, -56, -25, 55, -20, -7, 5, 4, -1, -30, -73,
+    -44, 55, -34, 127, -59, 12, -25, 10, -9, -14, -14, 1, -47, -35, 66, -18,
+    22, -72, 127, 22, 51, -30, -61, -2, -46, -19, -25, 16, -26, 26, -29, -65,
+    -15, -10, -41, 56, -38, -13, -9, 46, 101, 89, 55, -50, -28, -76, 19, 0,
+    -32, 10, -124, 83, -45, 66, 63, 122, -23, 78, 60, 59, 10, 28, 127, 59,
+    49, 25, 105, -53, -31, 17, -13, 14, 50, 43, 112, -78, -27, -47, -80, -1,
+    -94, 1, -127, -37, 42, -13, 61, 28, -28, 65, -6, 22, -57, 39, 103, 67,
+    55, -13, 1, -18, -9, -11, 57, -12, 90, 90, 118, -5, 80, -85, -116, 10,
+    -54, 6, -117, -28, 61, 114, 10, 7, -5, 57, 97, -15, -127, 5, 102, 53,
+    -9, 16, -73, -42, 4, -21, 126, -84, -6, -45, -34, -16, -51, -50, 49, -51,
+    41, -83, 127, 21, 32, -10, -30, -25, 14, -24, -42, 20, -43, 5, -34, -77,
+    -14, -48, -37, 91, -48, 53, 1, 23, 94, 122, 127, 16, 46, -88, -74, 113,
+    -13, -34, -99, 10, 52, -9, 54, 73, 71, 67, 76, 74, -31, -76, 106, 63,
+    50, -50, 44, -65, 28, 22, 6, -40, 74, 86, 38, -77, -56, 10, -99, 14,
+    -11, 26, -73, -35, -81, 5, -36, 58, 22, 32, 11, -86, -63, 1, 54, -7,
+    77, 29, 33, -24, -22, -29, 127, 5, 61, 85, 39, -43, 53, -18, -87, -2,
+    14, -30, -86, -50, -86, 74, 61, 19, -46, 63, 12, -78, 8, 62, 65, 12,
+    61, 48, -66, -48, 1, -21, 127, -73, 55, 39, 86, -127, -33, -82, -90, 34,
+    -100, -19, -105, -37, 74, 22, 66, 4, 44, 73, 97, -6, -105, 20, 100, 3,
+    67, 44, 92, -6, 37, -18, -4, 17, 52, 87, 65, -127, -2, 2, -44, 51,
+    -13, 8, -73, -24, 61, -8, 84, -31, 60, 33, 94, 26, -3, -11, 25, 53,
+    -33, 67, 14, -30, 31, -27, -21, -18, -2, -28, -32, -16, -29, -68, 58, 11,
+    36, -83, 127, 1, 11, -24, -77, -14, -11, -21, -16, -4, -39, 15, -27, -86,
+    -24, -11, -38, 91, -63, 9, -1, 21, 74, 109, 127, -30, -25, 31, -77, -29,
+    -120, 42, -93, -58, 9, 9, -58, -85, 37, 79, -3, 73, -22, -12, 104, 73,
+    111, -81, 74, -42, -6, 84, 110, -34, 62, 107, 43, -95, -100, 48, -127, 4,
+    5, 33, -99, -16, -78, -15, 64, -67, -60, 52, 24, -51, -98, -83, 110, 11,
+    6, -20, -4, -35, 50, 57, 88, -35, 0, -45, -20, 30, -37, 23, 44, 34,
+    55, -95, 127, 11, 32, -40, -12, 61, 56, -12, -35, -1, -5, -11, -35, -49,
+    -36, 1, -43, 90, -79, -5, -2, 25, 73, 37, 87, -52, -97, -57, -127, -42,
+    -12, 46, -110, -39, -101, 8, -2, 70, -24, 56, 105, -88, 4, 43, 76, 31,
+    82, -80, 8, -45, -88, 94, 75, -94, -12, -57, -35, 14, -34, -61, 57, -69,
+    39, -83, 127, 88, -18, -1, 5, -54, 2, -23, -37, 10, -53, 9, -25, -80,
+    6, -53, -39, 107, -32, 57, 0, 24, 0, -35, -30, 18, -39, -57, 52, -20,
+    35, -82, 127, 51, 29, -32, -42, -64, -35, -19, -25, 9, -43, 4, -32, -86,
+    -12, 8, -33, 87, -53, 20, -2, 21, -11, -39, -35, -25, -40, -99, 56, 3,
+    37, -75, 127, 53, 3, 12, -25, 59, 68, -23, -37, -16, -34, -27, -32, -89,
+    -7, -81, -53, 98, -51, 25, -2, 21, 31, -15, 60, -41, -30, -65, -68, -16,
+    -45, 11, -108, -30, -25, 61, -42, -4, 34, 35, 127, -59, -45, 22, 38, -30,
+    7, 16, -1, -18, 23, 76, 103, -56, 88, 124, 80, 12, -65, 98, -109, 50,
+    -101, 3, -119, -94, -72, -19, 5, -59, 27, 75, 23, -25, -42, -63, 115, 52,
+    85, -47, 76, -6, 18, -7, 127, -20, 11, -30, -26, 13, -60, 38, 48, -5,
+    50, -93, 127, 44, 13, -40, -36, 14, -29, -16, -31, 5, -10, 8, -32, -56,
+    -32, 14, -33, 91, -81, 27, -6, 25, 60, 83, 92, -24, 65, -38, -73, 4,
+    14, 50, -127, -38, -90, 4, -63, 41, -6, 87, 58, -85, -111, -72, 81, -39,
+    98, -30, 73, -80, -10, 28, 121, -117, 78, 81, 115, -29, 26, -9, -51, 65,
+    -6, -5, -114, -58, 78, 119, 17, -30, 75, 75, 80, 56, -58, -27, 127, -16,
+    91, -78, 78, -70, -5, -27, 59, -52, 70, 32, 89, -127, 7, -21, -117, 65,
+    -29, -18, -122, -39, 24, 42, 81, 71, -117, 38, 2, -17, -91, -52, 74, 66,
+    -8, -62, 33, -30, -54, 38, 58, -61, 92, 101, 86, -86, -86, -107, -108, -27,
+    -19, 29, -86, 30, 5, 14, -79, -42, -91, 49, 53, 31, -1, -4, 25, 61,
+    48, -84, 9, -51, -65, 45, 127, -6, 82, 113, 105, -85, -39, 25, -70, -56,
+    -76, 36, -127, 43, -20, 40, 35, -83, 11, 47, -20, -58, -34, -65, 42, 46,
+    40, 63, -9, -27, 49, 73, 111, -61, 92, 103, 96, -127, -34, -21, -120, 59,
+    -20, 42, -117, -71, -116, 97, -35, -125, -91, 51, -26, -36, 29, 39, 30, 58,
+    45, -25, -55, -43, -38, -15, 125, -60, 70, 101, 46, -127, -41, -23, -109, -8,
+    -56, 8, -113, 35, 76, 39, 94, -47, -15, 70, 120, 5, -71, 20, 86, 64,
+    43, 65, 26, -23, 8, 2, 13, -21, 68, 92, 72, -127, 15, 61, -21, -1,
+    -33, 31, -92, 2, 3, 51, -11, -50, 114, 52, 104, 49, -76, -11, 98, 28,
+    30, 27, 62, -42, 49, 62, 16, -35, -6, -50, -30, 43, -51, -46, 62, -10,
+    21, -82, 127, -15, 14, 7, -21, -37, -33, -10, -22, 21, -36, 27, -33, -84,
+    0, -67, -47, 96, -4, 27, -2, 26, -7, -42, -31, 33, -51, -65, 47, 1,
+    34, -74, 127, 35, -15, -54, -4, -60, -68, -20, -42, -5, -26, 2, -26, -76,
+    -27, 34, -52, 79, -48, 20, -2, 30, 105, 60, 60, 9, 46, 63, -89, -33,
+    -21, -24, -36, -34, -24, 105, -29, -3, 50, 20, -33, -61, 14, 3, -45, 78,
+    1, 65, 38, -34, 80, 48, 127, -40, 71, 82, 127, -95, 89, -6, -84, -41,
+    -102, 63, -54, 21, -13, 105, -86, 33, -25, 65, 29, -44, 51, 9, 75, 29,
+    62, 76, -24, -59, -8, 88, 125, -102, -3, -37, -32, 56, -24, -98, 64, 10,
+    32, -68, 127, 40, 26, -41, -31, 11, -17, -21, -14, 7, -56, -4, -29, -103,
+    9, -76, -51, 88, -33, 15, -5, 16, 83, 82, 67, -1, -39, 15, -53, -10,
+    -18, 55, -121, 9, 56, 82, 83, 70, -32, 40, -48, -58, -46, -95, -15, 1,
+    35, -54, 57, -28, 53, 68, 127, -98, -46, -6, -100, -53, -45, -60, 121, -13,
+    80, 114, 48, 68, 76, 49, -23, -12, -86, 35, -9, -55, -75, -79, -13, 83,
+    -60, -113, 66, -35, 22, 84, 121, -46, -66, 104, -36, -67, -84, -48, -88, -41,
+    26, -2, 97, 127, -2, -33, 84, -90, 33, 114, 78, 82, 106, 59, -88, 78,
+    -50, -45, -77, -38, 3, -30, 104, 111, 95, -96, 109, 63, 10, 64, 66, -89,
+    83, 39, -43, 88, -94, -78, -65, 56, 71, -18, 96, 77, 61, 30, 99, 81,
+    105, 103, -75, -22, 94, 112, -54, 62, 42, 18, -25, 9, -18, -100, -60, -96,
+    -67, -4, -29, 35, 40, -105, -73, 18, -59, -56, 14, -102, -50, -110, -87, -51,
+    9, -71, 29, -77, -5, -41, -10, -77, 0, 7, 35, -10, -69, 16, 26, -101,
+    -23, -7, 20, -37, -64, -39, -46, -97,
+};
+
+static const int32_t graph_biases[] = {
+    170, 2571, -2172, -1804, 117, 1434, 1836, -851,
+    1607, -899, -658, 710, 1741, -224, -394, 1354,
+    -1019, -1399, -2232, -477, -580, 2843, -692, -316,
+    2802, 5, 4053, -1263, -3997, 1165, 6466, 4614,
+    847, -175, 3432, -2246, -1468, 1301, 1721, 155,
+    -3484, 9136, 4199, -1344, -6463, -597, 4493, -5248,
+    7487, 7569, 8339, -2349, 5849, -73, 175, 5471,
+    1045, -241, -579, 2555, -3374, 5239, 553, -1642,
+    1272, 3418, 1236, -2759, -2279, -1120, -751, -689,
+    885, 3153, 571, -1817, 4075, -463, 21, 171,
+    -2571, -149, 3245, -5630, -183, -2472, 4228, 417,
+    -2501, -396, 2427, -4368, 2996, 19, 8586, -676,
+    2776, -120, 17737, 3789, -7824, -6479, 4882, 7171,
+    -389, -2417, 9648, 453, 47, 6287, 4273, 4724,
+    -3272, 2422, -3588, 5239, 2841, 3519, 7724, -1549,
+    -4720, -7905, 17852, 1702, 329, 4182, 3038, -343,
+    -271, -5301, 116, -874, 163, -1612, -2121, 10939,
+    -4166, -1662, 954, -6143, -5380, -283, 9115, 753,
+    483, -3260, -1312, 1341, -181, -3191, 2158, 3641,
+    -656, 321, 1968, -474, 579, 1641, -5471, 2067,
+    -906, 1899, -3218, 2269, 196, 2074, -129, 2770,
+    -3604, 2831, -696, 4184, 166, 1323, 2613, 3824,
+    -1444, -341, 2982, -3521, 3863, 683, -684, 3706,
+    830, -2312, -28, 1708, -3806, -2732, 1248, -2365,
+    -2184, 2814, -3466,
+};
+
+static const int32_t graph_multipliers[] = {
+    1244122582, 1887948562, 1643120239, 1617488549, 1173747719, 1498308458, 1829410577,
+};
+
+static const int8_t graph_shifts[] = {
+    -6, -7, -7, -7, -6, -7, -7,
+};
+
+// h, w, c, type, zero point, scale, arena offset
+static const GraphTensor graph_tensors[] = {
+    {65, 10, 1, TYPE_INT8, 58, 0.6634234189987183f, 2640}, // input
+    {33, 5, 16, TYPE_INT8, -128, 1.0f, 0}, // conv
+    {33, 5, 16, TYPE_INT8, -128, 1.0f, 3968}, // b1_dw
+    {33, 5, 24, TYPE_INT8, -128, 1.0f, 0}, // b1_pw
+    {33, 5, 24, TYPE_INT8, -128, 1.0f, 5280}, // b2_dw
+    {33, 5, 32, TYPE_INT8, -128, 1.0f, 0}, // b2_pw
+    {33, 5, 32, TYPE_INT8, -128, 1.0f, 7920}, // b3_dw
+    {33, 5, 48, TYPE_INT8, -128, 1.0f, 0}, // b3_pw
+    {1, 1, 48, TYPE_INT8, -128, 1.0f, 7920}, // pool
+    {1, 1, 3, TYPE_FLOAT32, 0, 1.0f, 0}, // logits
+    {1, 1, 3, TYPE_FLOAT32, 0, 1.0f, 16}, // probabilities
+};
+
+// op, activation, kernel h/w, stride h/w, pad top/left, per-channel, weight
+// bits, input, output, weight/bias/quant offsets, output scale
+static const GraphNode graph_nodes[] = {
+    {OP_CONV2D, ACT_RELU, 3, 3, 2, 2, 1, 0, 0, 8, 0, 1, 0, 0, 0, 0.0f},
+    {OP_DEPTHWISE, ACT_RELU, 3, 3, 1, 1, 1, 1, 0, 8, 1, 2, 144, 16, 1, 0.0f},
+    {OP_POINTWISE, ACT_RELU, 1, 1, 1, 1, 0, 0, 0, 8, 2, 3, 288, 32, 2, 0.0f},
+    {OP_DEPTHWISE, ACT_RELU, 3, 3, 1, 1, 1, 1, 0, 8, 3, 4, 672, 56, 3, 0.0f},
+    {OP_POINTWISE, ACT_RELU, 1, 1, 1, 1, 0, 0, 0, 8, 4, 5, 888, 80, 4, 0.0f},
+    {OP_DEPTHWISE, ACT_RELU, 3, 3, 1, 1, 1, 1, 0, 8, 5, 6, 1656, 112, 5, 0.0f},
+    {OP_POINTWISE, ACT_RELU, 1, 1, 1, 1, 0, 0, 0, 8, 6, 7, 1944, 144, 6, 0.0f},
+    {OP_AVGPOOL, ACT_NONE, 1, 1, 1, 1, 0, 0, 0, 8, 7, 8, 3480, 192, 7, 0.0f},
+    {OP_FULLY_CONNECTED, ACT_NONE, 1, 1, 1, 1, 0, 0, 0, 8, 8, 9, 3480, 192, 7, 7.2191e-05f},
+    {OP_SOFTMAX, ACT_NONE, 1, 1, 1, 1, 0, 0, 0, 8, 9, 10, 3624, 195, 7, 0.0f},
+};
+
+const GraphModel model_graph = {
+    "ds_cnn_tiny_v2",
+    graph_tensors, 11,
+    graph_nodes, 10,
+    0, 10,
+    graph_weights, graph_biases, graph_multipliers, graph_shifts,
+    MODEL_GRAPH_ARENA_SIZE,
+    true, // Placeholder activation scales
+};
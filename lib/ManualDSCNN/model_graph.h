@@ -0,0 +1,8 @@
+// Generated by tools/model_converter.py from model_weights.h. Do not edit.
+#pragma once
+#include "Graph.h"
+
+// Bytes of activation arena one window needs (tensor offsets are planned).
+#define MODEL_GRAPH_ARENA_SIZE 13200
+
+extern const GraphModel model_graph;
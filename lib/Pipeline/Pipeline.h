@@ -0,0 +1,121 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Compile-time composed processing chains (header only).
+//
+// A stage is a plain type with the shapes it takes and makes:
+//
+//   struct Gain {
+//       typedef HopBlock Input;
+//       typedef HopBlock Output;
+//       template<typename Next>
+//       void push(Input& in, PipelineContext& context, Next& next) {
+//           ... ; next.push(in, context); // zero or more times
+//       }
+//   };
+//
+// Pipeline<A, B, C> holds one of each by value and hands A's output to B
+// and B's to C through direct, inlinable calls: no virtual dispatch, no
+// queues. A stage owns the block it produces, so every inter-stage buffer
+// is a statically sized member allocated with the pipeline, written once
+// and read in place; stages that work in place (Input == Output) forward
+// the block they were given and cost no buffer at all. Adjacent stages
+// whose shapes differ do not compile.
+//
+// The first stage may be a source (Input = NoInput, with pull() instead of
+// push()); the last is a sink, which simply never calls next.
+
+// Fixed-shape block passed between stages.
+template<typename T, size_t N>
+struct Block {
+    typedef T Element;
+    static constexpr size_t length = N;
+    T data[N];
+};
+
+// Input of a source stage.
+struct NoInput {};
+
+// Per-run state that travels with the data rather than belonging to one
+// stage.
+struct PipelineContext {
+    uint64_t samples; // Audio position of the data being pushed
+    bool voice;       // Latest voice-activity verdict (true without a gate)
+
+    PipelineContext() : samples(0), voice(true) {}
+};
+
+// Terminates the chain behind the sink.
+struct PipelineEnd {
+    template<typename T>
+    void push(T&, PipelineContext&) {}
+};
+
+template<typename... Stages>
+class Pipeline;
+
+template<size_t I, typename P>
+struct PipelineStage;
+
+template<typename Last>
+class Pipeline<Last> {
+public:
+    typedef typename Last::Input Input;
+    typedef Last Head;
+    static constexpr size_t size = 1;
+
+    void push(Input& in, PipelineContext& context) { head_.push(in, context, end_); }
+    // Sources only: produce one block and run it through the chain.
+    bool pull(PipelineContext& context) { return head_.pull(context, end_); }
+
+    template<size_t I>
+    typename PipelineStage<I, Pipeline>::Type& stage() { return PipelineStage<I, Pipeline>::get(*this); }
+
+private:
+    template<size_t, typename> friend struct PipelineStage;
+    Last head_;
+    PipelineEnd end_;
+};
+
+template<typename First, typename Second, typename... Rest>
+class Pipeline<First, Second, Rest...> {
+public:
+    typedef Pipeline<Second, Rest...> Tail;
+    typedef typename First::Input Input;
+    typedef First Head;
+    static constexpr size_t size = 1 + Tail::size;
+
+    static_assert(std::is_same<typename First::Output, typename Tail::Input>::value,
+                  "pipeline: a stage's Output must be the next stage's Input");
+
+    void push(Input& in, PipelineContext& context) { head_.push(in, context, tail_); }
+    bool pull(PipelineContext& context) { return head_.pull(context, tail_); }
+
+    // The I-th stage, for configuration (bind engines, set thresholds).
+    template<size_t I>
+    typename PipelineStage<I, Pipeline>::Type& stage() { return PipelineStage<I, Pipeline>::get(*this); }
+
+private:
+    template<size_t, typename> friend struct PipelineStage;
+    First head_;
+    Tail tail_;
+};
+
+template<typename P>
+struct PipelineStage<0, P> {
+    typedef typename P::Head Type;
+    static Type& get(P& pipeline) { return pipeline.head_; }
+};
+
+template<size_t I, typename P>
+struct PipelineStage {
+    static_assert(I < P::size, "pipeline: stage index out of range");
+    typedef typename PipelineStage<I - 1, typename P::Tail>::Type Type;
+    static Type& get(P& pipeline) { return PipelineStage<I - 1, typename P::Tail>::get(pipeline.tail_); }
+};
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef PIPELINE_STAGES_H
+#define PIPELINE_STAGES_H
+
+#include <cstring>
+#include "Pipeline.h"
+#include "AudioCapture.h"
+#include "AudioProcessor.h"
+#include "Beamformer.h"
+#include "VoiceActivity.h"
+#include "Model.h"
+
+// The detector's building blocks as pipeline stages (lib/Pipeline/Pipeline.h),
+// each a thin wrapper over the same code WakeWordDetector runs:
+//
+//   CaptureSource    NoInput          -> CaptureBlock    AudioCapture::capture
+//   BeamformStage<C> C-channel hop    -> HopBlock        Beamformer: delay-and-sum to one channel
+//   ConditionStage   HopBlock         -> HopBlock        AudioCapture::condition, in place
+//   VadStage         HopBlock         -> HopBlock        VoiceActivity, in place; sets context.voice
+//   FramingStage     HopBlock         -> FrameBlock      30 ms frames every 15 ms
+//   MfccStage        FrameBlock       -> CoefficientBlock
+//   WindowStage<H>   CoefficientBlock -> WindowBlock     every H frames once KWS_FRAMES are in
+//   ModelStage       WindowBlock      -> PosteriorBlock  ManualDSCNN, skipped while !context.voice
+//   PosteriorStage   PosteriorBlock   -> Detection       threshold + cooldown, as Model::decide()
+//   CallbackSink     Detection        -> Detection       reports, then passes on
+//
+// The gate decides on whole hops, so it may open up to one frame earlier
+// than the detector's (which decides at the frame the window is due).
+
+typedef Block<int16_t, DETECTOR_HOP_SAMPLES> HopBlock;
+// One hop from every microphone, interleaved; a HopBlock with one.
+typedef Block<int16_t, DETECTOR_HOP_SAMPLES * AUDIO_CAPTURE_CHANNELS> CaptureBlock;
+typedef Block<int16_t, KWS_FRAME_SAMPLES> FrameBlock;
+typedef Block<int8_t, KWS_NUM_MFCC> CoefficientBlock;
+typedef Block<int8_t, KWS_FRAMES * KWS_NUM_MFCC> WindowBlock; // Oldest frame first
+typedef Block<float, KWS_NUM_CLASSES> PosteriorBlock;
+
+struct Detection {
+    uint64_t sample; // Audio position of the triggering window's end
+    int label;
+    float score;
+};
+
+typedef void (*DetectionHandler)(const Detection& detection, void* context);
+
+class CaptureSource {
+public:
+    typedef NoInput Input;
+    typedef CaptureBlock Output;
+
+    CaptureSource() : capture_(nullptr) {}
+    void bind(AudioCapture& capture) { capture_ = &capture; }
+
+    // Blocks for one hop of audio; false when capture fails.
+    template<typename Next>
+    bool pull(PipelineContext& context, Next& next) {
+        if (!capture_ || !capture_->capture(hop_.data, DETECTOR_HOP_SAMPLES)) return false;
+        next.push(hop_, context);
+        return true;
+    }
+
+private:
+    AudioCapture* capture_;
+    CaptureBlock hop_;
+};
+
+// Several microphones down to the one channel the rest of the chain takes.
+// Output runs BEAMFORMER_LATENCY samples behind the capture.
+template<int Channels>
+class BeamformStage {
+public:
+    typedef Block<int16_t, DETECTOR_HOP_SAMPLES * Channels> Input;
+    typedef HopBlock Output;
+
+    BeamformStage() : beamformer_(Channels) {}
+    const Beamformer& beamformer() const { return beamformer_; }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        beamformer_.process(in.data, DETECTOR_HOP_SAMPLES, out_.data);
+        next.push(out_, context);
+    }
+
+private:
+    static_assert(Channels >= 1 && Channels <= BEAMFORMER_MAX_CHANNELS, "BeamformStage: channel count");
+    Beamformer beamformer_;
+    HopBlock out_;
+};
+
+class ConditionStage {
+public:
+    typedef HopBlock Input;
+    typedef HopBlock Output;
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        AudioCapture::condition(in.data, DETECTOR_HOP_SAMPLES);
+        next.push(in, context);
+    }
+};
+
+class VadStage {
+public:
+    typedef HopBlock Input;
+    typedef HopBlock Output;
+
+    void configure(const VadConfig& config) { gate_.configure(config); }
+    const VoiceActivity& gate() const { return gate_; }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        gate_.update(in.data, DETECTOR_HOP_SAMPLES);
+        context.voice = gate_.active();
+        next.push(in, context);
+    }
+
+private:
+    VoiceActivity gate_;
+};
+
+// Owns the audio position: context.samples is where each frame ends.
+class FramingStage {
+public:
+    typedef HopBlock Input;
+    typedef FrameBlock Output;
+
+    FramingStage() : fill_(0), samples_(0) {}
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        size_t used = 0;
+        while (used < DETECTOR_HOP_SAMPLES) {
+            size_t take = KWS_FRAME_SAMPLES - fill_;
+            if (take > DETECTOR_HOP_SAMPLES - used) take = DETECTOR_HOP_SAMPLES - used;
+            memcpy(frame_.data + fill_, in.data + used, take * sizeof(int16_t));
+            fill_ += take;
+            used += take;
+            samples_ += take;
+            if (fill_ < KWS_FRAME_SAMPLES) break;
+
+            context.samples = samples_;
+            next.push(frame_, context);
+            // Frames overlap: keep the tail for the next one.
+            memmove(frame_.data, frame_.data + KWS_STRIDE_SAMPLES,
+                    (KWS_FRAME_SAMPLES - KWS_STRIDE_SAMPLES) * sizeof(int16_t));
+            fill_ = KWS_FRAME_SAMPLES - KWS_STRIDE_SAMPLES;
+        }
+    }
+
+private:
+    FrameBlock frame_;
+    size_t fill_;
+    uint64_t samples_;
+};
+
+class MfccStage {
+public:
+    typedef FrameBlock Input;
+    typedef CoefficientBlock Output;
+
+    MfccStage() : scratch_("frames", storage_, sizeof(storage_)) {
+        quant_.scale = ManualDSCNN::inputScale();
+        quant_.zero_point = ManualDSCNN::inputZeroPoint();
+    }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        AudioProcessor::computeFrame(in.data, quant_, scratch_, coefficients_.data);
+        next.push(coefficients_, context);
+    }
+
+private:
+    FrontendQuant quant_;
+    alignas(16) uint8_t storage_[MFCC_SCRATCH_SIZE];
+    Arena scratch_;
+    CoefficientBlock coefficients_;
+};
+
+// The model's sliding input; a window is due every HopFrames frames.
+template<int HopFrames = DETECTOR_HOP_FRAMES>
+class WindowStage {
+    static_assert(HopFrames >= 1 && HopFrames <= KWS_FRAMES, "WindowStage: hop must be 1..KWS_FRAMES frames");
+
+public:
+    typedef CoefficientBlock Input;
+    typedef WindowBlock Output;
+
+    WindowStage() : head_(0), frames_seen_(0), since_window_(0) { memset(history_, 0, sizeof(history_)); }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        memcpy(history_ + head_ * KWS_NUM_MFCC, in.data, KWS_NUM_MFCC);
+        head_ = (head_ + 1) % KWS_FRAMES;
+        frames_seen_++;
+        if (++since_window_ < HopFrames || frames_seen_ < KWS_FRAMES) return;
+        since_window_ = 0;
+        const size_t tail = (size_t)(KWS_FRAMES - head_) * KWS_NUM_MFCC;
+        memcpy(window_.data, history_ + head_ * KWS_NUM_MFCC, tail);
+        memcpy(window_.data + tail, history_, (size_t)head_ * KWS_NUM_MFCC);
+        next.push(window_, context);
+    }
+
+private:
+    int8_t history_[KWS_FRAMES * KWS_NUM_MFCC];
+    int head_;
+    uint32_t frames_seen_;
+    int since_window_;
+    WindowBlock window_;
+};
+
+class ModelStage {
+public:
+    typedef WindowBlock Input;
+    typedef PosteriorBlock Output;
+
+    ModelStage() : engine_(nullptr), inferences_(0), skipped_(0) {}
+    // An initialized engine; it must not be running for anyone else meanwhile.
+    void bind(ManualDSCNN& engine) { engine_ = &engine; }
+    uint32_t inferences() const { return inferences_; }
+    uint32_t skipped() const { return skipped_; }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        if (!context.voice) {
+            skipped_++;
+            return;
+        }
+        if (!engine_ || !engine_->infer(in.data, posteriors_.data)) return;
+        inferences_++;
+        next.push(posteriors_, context);
+    }
+
+private:
+    ManualDSCNN* engine_;
+    uint32_t inferences_;
+    uint32_t skipped_;
+    PosteriorBlock posteriors_;
+};
+
+class PosteriorStage {
+public:
+    typedef PosteriorBlock Input;
+    typedef Detection Output;
+
+    PosteriorStage()
+        : threshold_(KWS_TRIGGER_THRESHOLD), label_(KWS_LABEL_MARVIN_IDX),
+          cooldown_samples_((uint64_t)DETECTION_COOLDOWN_MS * KWS_SAMPLE_RATE_HZ / 1000), has_detected_(false) {}
+    void setThreshold(float threshold) { threshold_ = threshold; }
+    void setLabel(int label) { label_ = label; }
+    void setCooldownMs(uint32_t ms) { cooldown_samples_ = (uint64_t)ms * KWS_SAMPLE_RATE_HZ / 1000; }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        if (in.data[label_] <= threshold_) return;
+        if (has_detected_ && context.samples - detection_.sample <= cooldown_samples_) return;
+        has_detected_ = true;
+        detection_.sample = context.samples;
+        detection_.label = label_;
+        detection_.score = in.data[label_];
+        next.push(detection_, context);
+    }
+
+private:
+    float threshold_;
+    int label_;
+    uint64_t cooldown_samples_;
+    bool has_detected_;
+    Detection detection_;
+};
+
+class CallbackSink {
+public:
+    typedef Detection Input;
+    typedef Detection Output;
+
+    CallbackSink() : handler_(nullptr), context_(nullptr), count_(0) {}
+    void setHandler(DetectionHandler handler, void* context) {
+        handler_ = handler;
+        context_ = context;
+    }
+    uint32_t count() const { return count_; }
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        count_++;
+        if (handler_) handler_(in, context_);
+        next.push(in, context);
+    }
+
+private:
+    DetectionHandler handler_;
+    void* context_;
+    uint32_t count_;
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "KeywordBank.h"
+#include <Arduino.h>
+#include <cmath>
+#include "Trace.h"
+#include "Logger.h"
+
+void KeywordTrack::reset() {
+    for (int i = 0; i < DSCNN_MAX_CLASSES; i++) posteriors[i] = 0.0f;
+    last_detection_sample = 0;
+    inference_count = 0;
+    detection_count = 0;
+    has_detected = false;
+}
+
+KeywordBank::KeywordBank() : count_(0) {}
+
+int KeywordBank::add(const KeywordSpec& spec, const ManualDSCNN& engine, const FrontendQuant& frontend) {
+    if (count_ == KWS_MAX_KEYWORDS) {
+        Serial.printf("❌ Keyword %s: all %d keyword slots taken\n", spec.name, KWS_MAX_KEYWORDS);
+        return -1;
+    }
+    const uint8_t stride = spec.stride_hops;
+    if (stride == 0 || stride > KWS_MAX_KEYWORD_STRIDE || (stride & (stride - 1))) {
+        Serial.printf("❌ Keyword %s: stride %u is not a power of two up to %d hops\n", spec.name,
+                      (unsigned)stride, KWS_MAX_KEYWORD_STRIDE);
+        return -1;
+    }
+    if (!spec.graph || !engine.acceptsGraph(*spec.graph)) return -1;
+    const GraphModel& graph = *spec.graph;
+    const GraphTensor& input = graph.tensors[graph.input];
+    const GraphTensor& output = graph.tensors[graph.output];
+    const int classes = output.h * output.w * output.c;
+    if (spec.label < 0 || spec.label >= classes) {
+        Serial.printf("❌ Keyword %s: label %d, model has %d classes\n", spec.name, spec.label, classes);
+        return -1;
+    }
+
+    Entry& entry = entries_[count_];
+    entry.spec = spec;
+    entry.frames = input.h;
+    entry.macs = graphMacs(graph);
+    entry.cooldown_samples = (uint64_t)spec.cooldown_ms * KWS_SAMPLE_RATE_HZ / 1000;
+    entry.phase = 0;
+    // Models trained on the same features but quantized on their own data
+    // see the shared codes through a table instead of a second front end.
+    entry.requantize = input.scale != frontend.scale || input.zero_point != frontend.zero_point;
+    for (int code = -128; code < 128; code++) {
+        const float real = (code - frontend.zero_point) * frontend.scale;
+        long q = lroundf(real / input.scale) + input.zero_point;
+        entry.requant[code + 128] = (int8_t)(q < -128 ? -128 : q > 127 ? 127 : q);
+    }
+    count_++;
+    stagger();
+    Serial.printf("✅ Keyword %s: model %s, %d frames, %u MACs every %u hops (phase %u)\n", spec.name,
+                  graph.name, entry.frames, (unsigned)entry.macs, (unsigned)stride, (unsigned)entry.phase);
+    return count_ - 1;
+}
+
+// Greedy, biggest model first: each takes the phase that keeps the busiest
+// hop of the KWS_MAX_KEYWORD_STRIDE-hop cycle lowest (then the emptiest
+// hops). Every stride divides the cycle, so it repeats exactly. The
+// built-in model runs every hop and adds the same cost to all of them.
+void KeywordBank::stagger() {
+    int order[KWS_MAX_KEYWORDS];
+    for (int k = 0; k < count_; k++) {
+        int at = k;
+        while (at > 0 && entries_[order[at - 1]].macs < entries_[k].macs) {
+            order[at] = order[at - 1];
+            at--;
+        }
+        order[at] = k;
+    }
+
+    uint64_t load[KWS_MAX_KEYWORD_STRIDE] = {};
+    for (int i = 0; i < count_; i++) {
+        Entry& entry = entries_[order[i]];
+        const int stride = entry.spec.stride_hops;
+        uint64_t best_peak = UINT64_MAX, best_sum = UINT64_MAX;
+        for (int phase = 0; phase < stride; phase++) {
+            uint64_t peak = 0, sum = 0;
+            for (int hop = 0; hop < KWS_MAX_KEYWORD_STRIDE; hop++) {
+                uint64_t cost = load[hop];
+                if (hop % stride == phase) {
+                    sum += cost;
+                    cost += entry.macs;
+                }
+                if (cost > peak) peak = cost;
+            }
+            if (peak < best_peak || (peak == best_peak && sum < best_sum)) {
+                best_peak = peak;
+                best_sum = sum;
+                entry.phase = (uint8_t)phase;
+            }
+        }
+        for (int hop = entry.phase; hop < KWS_MAX_KEYWORD_STRIDE; hop += stride) load[hop] += entry.macs;
+    }
+}
+
+uint32_t KeywordBank::peakMacs() const {
+    uint32_t peak = 0;
+    for (uint32_t hop = 0; hop < KWS_MAX_KEYWORD_STRIDE; hop++) {
+        uint32_t cost = 0;
+        for (int k = 0; k < count_; k++) {
+            if (due(k, hop)) cost += entries_[k].macs;
+        }
+        if (cost > peak) peak = cost;
+    }
+    return peak;
+}
+
+bool KeywordBank::infer(int k, const StreamState& stream, Workspace& workspace, KeywordTrack& track) const {
+    TRACE_SPAN("keyword.infer");
+    const Entry& entry = entries_[k];
+    int8_t features[KWS_FRAMES * KWS_NUM_MFCC];
+    AudioProcessor::copyFeatures(stream.features, features);
+    // The newest frames, oldest first, as the keyword was trained on.
+    int8_t* window = features + (KWS_FRAMES - entry.frames) * KWS_NUM_MFCC;
+    if (entry.requantize) {
+        for (int i = 0; i < entry.frames * KWS_NUM_MFCC; i++) window[i] = entry.requant[window[i] + 128];
+    }
+    if (!workspace.engine.inferGraph(*entry.spec.graph, window, track.posteriors)) {
+        return false;
+    }
+    track.inference_count++;
+    LOG_VERBOSE("Keyword %s: %.3f", entry.spec.name, track.posteriors[entry.spec.label]);
+    return true;
+}
+
+bool KeywordBank::decide(int k, const StreamState& stream, KeywordTrack& track) const {
+    const Entry& entry = entries_[k];
+    if (track.posteriors[entry.spec.label] <= entry.spec.threshold) return false;
+    if (track.has_detected && stream.samples_processed - track.last_detection_sample <= entry.cooldown_samples) {
+        return false;
+    }
+    track.detection_count++;
+    track.last_detection_sample = stream.samples_processed;
+    track.has_detected = true;
+    TRACE_INSTANT("keyword");
+    return true;
+}
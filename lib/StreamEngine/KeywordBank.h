@@ -0,0 +1,87 @@
+#ifndef KEYWORD_BANK_H
+#define KEYWORD_BANK_H
+
+#include <cstdint>
+#include "Model.h"
+
+// Keyword models a detector runs beside its built-in one.
+#define KWS_MAX_KEYWORDS 4
+// Longest keyword cadence, in detector hops; also the length of the
+// schedule stagger() plans over. Cadences are powers of two up to this.
+#define KWS_MAX_KEYWORD_STRIDE 8
+
+// One extra keyword (or command) network. The graph is interpreted on the
+// detector's own engine, so it needs the graph backend and must fit the
+// arena the built-in model was sized for.
+struct KeywordSpec {
+    const char* name;
+    const GraphModel* graph; // e.g. from tools/model_converter.py --symbol; must outlive the bank
+    int label;               // Output class that is the keyword
+    float threshold;
+    uint32_t cooldown_ms;
+    uint8_t stride_hops;     // Evaluated every Nth detector hop: 1, 2, 4 or 8
+};
+
+// Per-stream state of one keyword: its latest posteriors and its cooldown
+// clock (on the stream's samples_processed, like StreamState).
+struct KeywordTrack {
+    float posteriors[DSCNN_MAX_CLASSES];
+    uint64_t last_detection_sample;
+    uint32_t inference_count;
+    uint32_t detection_count;
+    bool has_detected;
+
+    void reset();
+};
+
+// Keyword models that share a stream's front end. Features are computed
+// once per hop into StreamState::features; each keyword reads the newest
+// frames its input holds (a shorter window than KWS_FRAMES is fine) and is
+// requantized through a table when its input scale differs from the front
+// end's. Each has its own threshold, cooldown and cadence, and the phases
+// of the cadences are staggered so the models' cost is spread over hops
+// instead of landing on the same one. Immutable once set up, like Model.
+class KeywordBank {
+public:
+    KeywordBank();
+
+    // Returns the keyword's index, or -1 when `engine` cannot run the graph,
+    // the label or cadence is out of range, or the bank is full. Restaggers
+    // every keyword.
+    int add(const KeywordSpec& spec, const ManualDSCNN& engine, const FrontendQuant& frontend);
+    int count() const { return count_; }
+    const KeywordSpec& spec(int k) const { return entries_[k].spec; }
+    int windowFrames(int k) const { return entries_[k].frames; }
+    uint32_t macs(int k) const { return entries_[k].macs; }
+    uint8_t phase(int k) const { return entries_[k].phase; }
+    // Keyword k runs on hops with hop % stride == phase.
+    bool due(int k, uint32_t hop) const {
+        return (hop & (entries_[k].spec.stride_hops - 1)) == entries_[k].phase;
+    }
+    // Keyword MACs of the busiest hop of the schedule.
+    uint32_t peakMacs() const;
+
+    // Infers keyword k on the stream's feature window; false on failure.
+    bool infer(int k, const StreamState& stream, Workspace& workspace, KeywordTrack& track) const;
+    // Threshold and cooldown on the track's latest posteriors; true on a
+    // trigger.
+    bool decide(int k, const StreamState& stream, KeywordTrack& track) const;
+
+private:
+    struct Entry {
+        KeywordSpec spec;
+        int frames;
+        uint32_t macs;
+        uint64_t cooldown_samples;
+        uint8_t phase;
+        bool requantize;
+        int8_t requant[256]; // Front-end code + 128 -> keyword input code
+    };
+
+    void stagger();
+
+    Entry entries_[KWS_MAX_KEYWORDS];
+    int count_;
+};
+
+#endif
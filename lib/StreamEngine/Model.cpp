@@ -0,0 +1,107 @@
+#include "Model.h"
+#include <cstring>
+#include "Trace.h"
+#include "Logger.h"
+
+void StreamState::reset() {
+    features.reset();
+    for (int i = 0; i < KWS_NUM_CLASSES; i++) posteriors[i] = 0.0f;
+    samples_processed = 0;
+    last_detection_sample = 0;
+    inference_count = 0;
+    detection_count = 0;
+    frames_since_inference = 0;
+    has_detected = false;
+}
+
+StreamState::StreamState() : id(0) {
+    reset();
+}
+
+Workspace::Workspace() : mfcc("mfcc", mfcc_storage, sizeof(mfcc_storage)) {}
+
+bool Workspace::init() {
+    return engine.init();
+}
+
+Model::Model()
+    : threshold_(KWS_TRIGGER_THRESHOLD),
+      cooldown_samples_((uint64_t)DETECTION_COOLDOWN_MS * KWS_SAMPLE_RATE_HZ / 1000) {
+    frontend_.scale = ManualDSCNN::inputScale();
+    frontend_.zero_point = ManualDSCNN::inputZeroPoint();
+}
+
+bool Model::feed(StreamState& stream, Workspace& workspace, const int16_t*& samples, size_t& count) const {
+    while (count > 0) {
+        // At most one frame per step, so the cadence check sees every frame.
+        size_t take = stream.features.samplesToNextFrame();
+        if (take > count) take = count;
+        int frames = AudioProcessor::process(stream.features, frontend_, workspace.mfcc, samples, take);
+        samples += take;
+        count -= take;
+        stream.samples_processed += take;
+        stream.frames_since_inference += frames;
+        if (stream.features.ready() && stream.frames_since_inference >= DETECTOR_HOP_FRAMES) {
+            stream.frames_since_inference = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Model::infer(StreamState& stream, Workspace& workspace) const {
+    int8_t features[KWS_FRAMES * KWS_NUM_MFCC];
+    AudioProcessor::copyFeatures(stream.features, features);
+    if (!workspace.engine.infer(features, stream.posteriors)) {
+        return false;
+    }
+    stream.inference_count++;
+    LOG_VERBOSE("DSCNN: marvin %.3f, unknown %.3f, silence %.3f",
+                stream.posteriors[0], stream.posteriors[1], stream.posteriors[2]);
+    return true;
+}
+
+bool Model::inferBatch(StreamState* const* streams, int count, Workspace& workspace) const {
+    int8_t features[DSCNN_MAX_BATCH][KWS_FRAMES * KWS_NUM_MFCC];
+    const int8_t* inputs[DSCNN_MAX_BATCH];
+    float posteriors[DSCNN_MAX_BATCH][KWS_NUM_CLASSES];
+    for (int first = 0; first < count; first += DSCNN_MAX_BATCH) {
+        const int n = count - first < DSCNN_MAX_BATCH ? count - first : DSCNN_MAX_BATCH;
+        for (int b = 0; b < n; b++) {
+            AudioProcessor::copyFeatures(streams[first + b]->features, features[b]);
+            inputs[b] = features[b];
+        }
+        if (!workspace.engine.predictBatch(inputs, n, posteriors[0])) {
+            return false;
+        }
+        for (int b = 0; b < n; b++) {
+            StreamState& stream = *streams[first + b];
+            memcpy(stream.posteriors, posteriors[b], sizeof(stream.posteriors));
+            stream.inference_count++;
+        }
+    }
+    return true;
+}
+
+bool Model::decide(StreamState& stream) const {
+    if (stream.posteriors[KWS_LABEL_MARVIN_IDX] <= threshold_) return false;
+    if (stream.has_detected && stream.samples_processed - stream.last_detection_sample <= cooldown_samples_) {
+        return false;
+    }
+    stream.detection_count++;
+    stream.last_detection_sample = stream.samples_processed;
+    stream.has_detected = true;
+    TRACE_INSTANT("wake_word");
+    return true;
+}
+
+int Model::process(StreamState& stream, Workspace& workspace, const int16_t* samples, size_t count,
+                   DetectionCallback on_detection, void* context) const {
+    int triggers = 0;
+    while (feed(stream, workspace, samples, count)) {
+        if (!infer(stream, workspace) || !decide(stream)) continue;
+        triggers++;
+        if (on_detection) on_detection(stream, context);
+    }
+    return triggers;
+}
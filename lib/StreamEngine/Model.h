@@ -0,0 +1,53 @@
+#ifndef MODEL_H
+#define MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include "StreamState.h"
+#include "env.h"
+
+// Inference runs every DETECTOR_HOP_FRAMES feature frames (60 ms).
+#define DETECTOR_HOP_FRAMES 4
+#define DETECTOR_HOP_SAMPLES (DETECTOR_HOP_FRAMES * KWS_STRIDE_SAMPLES)
+
+// Called for every trigger with the stream that fired; posteriors and
+// last_detection_sample describe the detection.
+typedef void (*DetectionCallback)(const StreamState& stream, void* context);
+
+// The immutable half of a detector: front-end quantization, inference
+// cadence and trigger policy. Weights and front-end tables are read-only
+// globals, so one Model serves every stream in the process and all of its
+// methods are const and thread-safe for distinct (stream, workspace) pairs.
+class Model {
+public:
+    Model();
+
+    void setThreshold(float threshold) { threshold_ = threshold; }
+    float threshold() const { return threshold_; }
+    const FrontendQuant& frontend() const { return frontend_; }
+    uint64_t cooldownSamples() const { return cooldown_samples_; }
+
+    // Pipeline steps, for callers that time them separately:
+    // feed() consumes samples (advancing `samples`/`count`) until an
+    // inference is due and returns true, or returns false once the input is
+    // used up. Inference is scheduled per frame, so results do not depend on
+    // how the audio is chunked.
+    bool feed(StreamState& stream, Workspace& workspace, const int16_t*& samples, size_t& count) const;
+    bool infer(StreamState& stream, Workspace& workspace) const;
+    // infer() for several streams that are all due, in one batched pass.
+    bool inferBatch(StreamState* const* streams, int count, Workspace& workspace) const;
+    // Threshold and cooldown on the latest posteriors; true on a trigger.
+    bool decide(StreamState& stream) const;
+
+    // All of the above over a block of audio. Returns the number of
+    // triggers, each also reported to `on_detection` when given.
+    int process(StreamState& stream, Workspace& workspace, const int16_t* samples, size_t count,
+                DetectionCallback on_detection = nullptr, void* context = nullptr) const;
+
+private:
+    FrontendQuant frontend_;
+    float threshold_;
+    uint64_t cooldown_samples_;
+};
+
+#endif
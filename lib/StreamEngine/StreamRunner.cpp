@@ -0,0 +1,236 @@
+#include "StreamRunner.h"
+#include <chrono>
+#include <cstring>
+#include <new>
+#include "Logger.h"
+
+StreamRunner::StreamRunner(const Model& model, size_t max_streams, unsigned workers,
+                           DetectionCallback on_detection, void* context)
+    : model_(model), on_detection_(on_detection), context_(context), on_idle_(nullptr), idle_context_(nullptr),
+      slots_(nullptr),
+      max_streams_(max_streams), stream_count_(0), max_batch_(DSCNN_MAX_BATCH), batch_wait_us_(0),
+      active_(0), stopping_(false) {
+    slots_ = new (std::nothrow) Slot[max_streams];
+    if (!slots_) {
+        LOG_ERROR("❌ StreamRunner: no memory for %u streams", (unsigned)max_streams);
+        max_streams_ = 0;
+    }
+    // Workspaces register arenas, which must happen on one thread: here.
+    for (unsigned i = 0; i < workers; i++) {
+        workspaces_.push_back(new Workspace());
+    }
+}
+
+StreamRunner::~StreamRunner() {
+    stop();
+    for (Workspace* workspace : workspaces_) delete workspace;
+    delete[] slots_;
+}
+
+void StreamRunner::setBatching(int max_batch, uint32_t wait_us) {
+    max_batch_ = max_batch < 1 ? 1 : max_batch > DSCNN_MAX_BATCH ? DSCNN_MAX_BATCH : max_batch;
+    batch_wait_us_ = wait_us;
+}
+
+void StreamRunner::setIdleCallback(IdleCallback on_idle, void* context) {
+    on_idle_ = on_idle;
+    idle_context_ = context;
+}
+
+bool StreamRunner::start() {
+    if (!threads_.empty()) return true;
+    for (Workspace* workspace : workspaces_) {
+        if (!workspace->init()) return false;
+    }
+    stopping_ = false;
+    for (unsigned i = 0; i < workspaces_.size(); i++) {
+        threads_.emplace_back(&StreamRunner::workerLoop, this, i);
+    }
+    LOG_INFO("🧵 StreamRunner: %u workers, %u stream slots of %u bytes, batch %d",
+             (unsigned)workspaces_.size(), (unsigned)max_streams_, (unsigned)sizeof(Slot), max_batch_);
+    return true;
+}
+
+void StreamRunner::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+    threads_.clear();
+}
+
+int StreamRunner::addStream() {
+    int stream;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            stream = free_.back();
+            free_.pop_back();
+        } else if (stream_count_ < max_streams_) {
+            stream = (int)stream_count_++;
+        } else {
+            return -1;
+        }
+    }
+    Slot& slot = slots_[stream];
+    slot.state.reset();
+    slot.state.id = (uint32_t)stream;
+    slot.write_index.store(0);
+    slot.read_index.store(0);
+    slot.scheduled.store(false);
+    slot.removing = false;
+    return stream;
+}
+
+void StreamRunner::removeStream(int stream) {
+    Slot& slot = slots_[stream];
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Idle means nothing queued or running and nothing left unread (a
+    // worker unschedules briefly before requeueing leftover audio).
+    idle_.wait(lock, [&slot]() {
+        return !slot.scheduled.load() && slot.write_index.load() == slot.read_index.load();
+    });
+    slot.removing = false;
+    free_.push_back(stream);
+}
+
+bool StreamRunner::tryRemoveStream(int stream) {
+    Slot& slot = slots_[stream];
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot.scheduled.load() || slot.write_index.load() != slot.read_index.load()) {
+        slot.removing = true; // release() reports it idle
+        return false;
+    }
+    slot.removing = false;
+    free_.push_back(stream);
+    return true;
+}
+
+size_t StreamRunner::push(int stream, const int16_t* samples, size_t count) {
+    Slot& slot = slots_[stream];
+    uint32_t write = slot.write_index.load(std::memory_order_relaxed);
+    uint32_t read = slot.read_index.load(std::memory_order_acquire);
+    size_t space = STREAM_RING_SAMPLES - (write - read);
+    if (count > space) count = space;
+
+    size_t start = write & (STREAM_RING_SAMPLES - 1);
+    size_t first = count < STREAM_RING_SAMPLES - start ? count : STREAM_RING_SAMPLES - start;
+    memcpy(slot.ring + start, samples, first * sizeof(int16_t));
+    memcpy(slot.ring, samples + first, (count - first) * sizeof(int16_t));
+    slot.write_index.store(write + (uint32_t)count, std::memory_order_release);
+
+    if (count > 0 && !slot.scheduled.exchange(true)) schedule(stream);
+    return count;
+}
+
+void StreamRunner::schedule(int stream) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(stream);
+        active_++;
+    }
+    ready_.notify_one();
+}
+
+void StreamRunner::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return active_ == 0; });
+}
+
+void StreamRunner::workerLoop(unsigned worker) {
+    Workspace& workspace = *workspaces_[worker];
+    int streams[DSCNN_MAX_BATCH];
+    while (true) {
+        int count = collect(streams);
+        if (count == 0) return;
+        runStreams(streams, count, workspace);
+    }
+}
+
+int StreamRunner::collect(int* streams) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+    int count = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(batch_wait_us_);
+    while (count < max_batch_) {
+        if (queue_.empty()) {
+            if (count > 0 && (batch_wait_us_ == 0 || stopping_)) break;
+            if (!ready_.wait_until(lock, deadline, [this]() { return stopping_ || !queue_.empty(); })) break;
+            if (queue_.empty()) break;
+        }
+        streams[count++] = queue_.front();
+        queue_.pop_front();
+    }
+    return count;
+}
+
+bool StreamRunner::advance(Slot& slot, Workspace& workspace, uint32_t write) {
+    uint32_t read = slot.read_index.load(std::memory_order_relaxed);
+    bool due = false;
+    while (read != write && !due) {
+        // Contiguous run up to the end of the ring.
+        size_t start = read & (STREAM_RING_SAMPLES - 1);
+        size_t count = write - read;
+        if (count > STREAM_RING_SAMPLES - start) count = STREAM_RING_SAMPLES - start;
+        const int16_t* samples = slot.ring + start;
+        size_t left = count;
+        due = model_.feed(slot.state, workspace, samples, left);
+        read += (uint32_t)(count - left);
+    }
+    slot.read_index.store(read, std::memory_order_release);
+    return due;
+}
+
+void StreamRunner::runStreams(const int* streams, int count, Workspace& workspace) {
+    // Only the audio present now is processed; later pushes requeue.
+    uint32_t write[DSCNN_MAX_BATCH];
+    for (int i = 0; i < count; i++) {
+        write[i] = slots_[streams[i]].write_index.load(std::memory_order_acquire);
+    }
+
+    // Each round advances every stream to its next inference point and
+    // runs the windows that came due as one batch.
+    while (true) {
+        StreamState* due[DSCNN_MAX_BATCH];
+        int ready = 0;
+        for (int i = 0; i < count; i++) {
+            Slot& slot = slots_[streams[i]];
+            if (advance(slot, workspace, write[i])) due[ready++] = &slot.state;
+        }
+        if (ready == 0) break;
+        if (!model_.inferBatch(due, ready, workspace)) continue;
+        for (int i = 0; i < ready; i++) {
+            if (model_.decide(*due[i]) && on_detection_) on_detection_(*due[i], context_);
+        }
+    }
+
+    for (int i = 0; i < count; i++) release(streams[i]);
+}
+
+void StreamRunner::release(int stream) {
+    Slot& slot = slots_[stream];
+    // Unschedule, then recheck: a push that raced with the store below saw
+    // scheduled == true and left its samples to us. Requeue behind the
+    // other streams rather than keep this worker.
+    slot.scheduled.store(false);
+    if (slot.write_index.load(std::memory_order_acquire) != slot.read_index.load(std::memory_order_relaxed) &&
+        !slot.scheduled.exchange(true)) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(stream);
+        }
+        ready_.notify_one();
+        return;
+    }
+
+    bool removing;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_--;
+        removing = slot.removing;
+        idle_.notify_all();
+    }
+    if (removing && on_idle_) on_idle_(stream, idle_context_);
+}
@@ -0,0 +1,116 @@
+#ifndef STREAM_RUNNER_H
+#define STREAM_RUNNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Model.h"
+
+// Samples buffered per stream between the producer and the workers
+// (128 ms, a little over two hops). Power of two.
+#define STREAM_RING_SAMPLES 2048
+
+// Reports that a stream waiting in tryRemoveStream() has gone idle.
+typedef void (*IdleCallback)(int stream, void* context);
+
+// Runs many independent audio streams against one shared Model on a pool of
+// worker threads (gateway deployments watching dozens of channels).
+//
+// Streams live in one contiguous, cache-aligned array sized at construction;
+// each costs its StreamState plus its input ring (~5.8 KB). Workers each own
+// a Workspace, so activation and FFT scratch scales with cores, not streams.
+// A stream is scheduled on at most one worker at a time, which keeps its
+// samples in order; independent streams spread across all workers.
+//
+// A worker takes up to `max_batch` queued streams at once and runs the
+// windows that come due together through one batched DS-CNN pass. With a
+// wait budget it holds a partial batch up to that long for more streams,
+// trading bounded extra latency for throughput.
+//
+// push() is wait-free and may be called from any thread, but each stream
+// must have a single producer.
+class StreamRunner {
+public:
+    // `on_detection` runs on a worker thread.
+    StreamRunner(const Model& model, size_t max_streams, unsigned workers,
+                 DetectionCallback on_detection = nullptr, void* context = nullptr);
+    ~StreamRunner();
+    StreamRunner(const StreamRunner&) = delete;
+    StreamRunner& operator=(const StreamRunner&) = delete;
+
+    // Before start(). Defaults: DSCNN_MAX_BATCH streams, no waiting.
+    void setBatching(int max_batch, uint32_t wait_us);
+    // Before start(). `on_idle` runs on a worker thread.
+    void setIdleCallback(IdleCallback on_idle, void* context);
+    bool start();
+    void stop();
+
+    // Returns the new stream's index, or -1 when all slots are taken.
+    // Indices of removed streams are reused.
+    int addStream();
+    // The caller must have stopped pushing to it. Blocks until the workers
+    // are done with its audio; no callbacks for it arrive after this.
+    void removeStream(int stream);
+    // removeStream() for event loops: frees the stream and returns true if
+    // the workers are done with it. Otherwise returns false and the idle
+    // callback fires once they are; call again then.
+    bool tryRemoveStream(int stream);
+    size_t streamCount() const { return stream_count_ - free_.size(); }
+    unsigned workerCount() const { return (unsigned)workspaces_.size(); }
+
+    // Queues samples for a stream; returns how many fit (the rest is the
+    // caller's back-pressure to handle).
+    size_t push(int stream, const int16_t* samples, size_t count);
+    // Blocks until every sample pushed so far has been processed.
+    void drain();
+
+    // Only stable after drain() (workers update it in place).
+    const StreamState& stream(int index) const { return slots_[index].state; }
+    static size_t bytesPerStream() { return sizeof(Slot); }
+
+private:
+    struct alignas(64) Slot {
+        StreamState state;
+        std::atomic<uint32_t> write_index;   // Producer
+        std::atomic<uint32_t> read_index;    // Worker
+        std::atomic<bool> scheduled;
+        bool removing;                      // In tryRemoveStream(); guarded by mutex_
+        int16_t ring[STREAM_RING_SAMPLES];
+    };
+
+    void schedule(int stream);
+    void workerLoop(unsigned worker);
+    // Takes up to max_batch_ queued streams; false when stopping.
+    int collect(int* streams);
+    void runStreams(const int* streams, int count, Workspace& workspace);
+    bool advance(Slot& slot, Workspace& workspace, uint32_t write);
+    void release(int stream);
+
+    const Model& model_;
+    DetectionCallback on_detection_;
+    void* context_;
+    IdleCallback on_idle_;
+    void* idle_context_;
+    Slot* slots_;
+    size_t max_streams_;
+    size_t stream_count_;               // Slots handed out so far
+    std::vector<int> free_;             // Removed slots, reused first
+    int max_batch_;
+    uint32_t batch_wait_us_;
+    std::vector<Workspace*> workspaces_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable ready_;     // Work queued or stopping
+    std::condition_variable idle_;      // A stream went idle
+    std::deque<int> queue_;
+    size_t active_;                     // Streams queued or running
+    bool stopping_;
+};
+
+#endif
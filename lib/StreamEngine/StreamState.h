@@ -0,0 +1,47 @@
+#ifndef STREAM_STATE_H
+#define STREAM_STATE_H
+
+#include <cstdint>
+#include "AudioProcessor.h"
+#include "ManualDSCNN.h"
+
+// Everything one audio stream needs between hops (~1.7 KB): the frame
+// window, the int8 feature history, the inference cadence, the cooldown
+// clock and the latest posteriors. One contiguous block, cache-line aligned
+// so streams packed in an array never share a line between workers.
+//
+// The DS-CNN itself is recomputed over the whole feature window each hop:
+// its first convolution has stride 2 and "same" padding, so activations of
+// a shifted window do not line up with the previous ones and there is no
+// per-stream convolution state worth carrying.
+struct alignas(64) StreamState {
+    StreamState();
+
+    FeatureState features;
+    float posteriors[KWS_NUM_CLASSES];
+    // Cooldown runs on the audio clock, so replayed audio triggers exactly
+    // as it would live.
+    uint64_t samples_processed;
+    uint64_t last_detection_sample;
+    uint32_t inference_count;
+    uint32_t detection_count;
+    uint16_t frames_since_inference;
+    bool has_detected;
+    uint32_t id;    // Owner's stream number (StreamRunner slot); kept by reset()
+
+    void reset();
+};
+
+// Per-worker scratch: DS-CNN activations and FFT buffers. Only live during
+// a call, so one workspace serves any number of streams, one at a time.
+// Construct on a single thread (arenas register themselves globally).
+struct Workspace {
+    Workspace();
+    bool init();
+
+    ManualDSCNN engine;
+    alignas(16) uint8_t mfcc_storage[MFCC_SCRATCH_SIZE];
+    Arena mfcc;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "Adpcm.h"
+#include <cstring>
+
+namespace {
+
+const int16_t kSteps[ADPCM_MAX_INDEX + 1] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,
+    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,
+    544,   598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,
+    9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+const int8_t kIndexAdjust[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+inline int32_t clampSample(int32_t value) {
+    return value > 32767 ? 32767 : value < -32768 ? -32768 : value;
+}
+
+inline int clampIndex(int index) {
+    return index < 0 ? 0 : index > ADPCM_MAX_INDEX ? ADPCM_MAX_INDEX : index;
+}
+
+// Every step of the decoder precomputed: the magnitude each 3-bit code adds
+// at each step index (at most 15/8 of 32767, so 16 bits) and the index that
+// follows. 2 KB, built on first use.
+struct DecodeTables {
+    uint16_t delta[ADPCM_MAX_INDEX + 1][8];
+    uint8_t next[ADPCM_MAX_INDEX + 1][8];
+
+    DecodeTables() {
+        for (int index = 0; index <= ADPCM_MAX_INDEX; index++) {
+            const int32_t step = kSteps[index];
+            for (int code = 0; code < 8; code++) {
+                int32_t delta = step >> 3;
+                if (code & 4) delta += step;
+                if (code & 2) delta += step >> 1;
+                if (code & 1) delta += step >> 2;
+                this->delta[index][code] = (uint16_t)delta;
+                next[index][code] = (uint8_t)clampIndex(index + kIndexAdjust[code]);
+            }
+        }
+    }
+};
+
+const DecodeTables& decodeTables() {
+    static const DecodeTables instance;
+    return instance;
+}
+
+inline int32_t advance(const DecodeTables& tables, int32_t predictor, unsigned& index, unsigned nibble) {
+    const int32_t delta = tables.delta[index][nibble & 7];
+    index = tables.next[index][nibble & 7];
+    return clampSample(nibble & 8 ? predictor - delta : predictor + delta);
+}
+
+// Nibble of sample s >= 1.
+inline unsigned nibbleAt(const uint8_t* data, size_t s) {
+    return (data[(s - 1) / 2] >> ((s - 1) & 1 ? 4 : 0)) & 15;
+}
+
+inline uint8_t encodeSample(int32_t sample, int32_t& predictor, int& index) {
+    int32_t step = kSteps[index];
+    int32_t difference = sample - predictor;
+    uint8_t nibble = 0;
+    if (difference < 0) {
+        nibble = 8;
+        difference = -difference;
+    }
+    // The decoder's delta, built bit by bit as the code is chosen.
+    int32_t delta = step >> 3;
+    if (difference >= step) {
+        nibble |= 4;
+        difference -= step;
+        delta += step;
+    }
+    step >>= 1;
+    if (difference >= step) {
+        nibble |= 2;
+        difference -= step;
+        delta += step;
+    }
+    step >>= 1;
+    if (difference >= step) {
+        nibble |= 1;
+        delta += step;
+    }
+    predictor = clampSample(nibble & 8 ? predictor - delta : predictor + delta);
+    index = clampIndex(index + kIndexAdjust[nibble & 7]);
+    return nibble;
+}
+
+inline void put16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+inline void put32(uint8_t* out, uint32_t value) {
+    put16(out, (uint16_t)value);
+    put16(out + 2, (uint16_t)(value >> 16));
+}
+
+} // namespace
+
+void Adpcm::encodeBlock(const int16_t* samples, uint8_t& index, uint8_t* block) {
+    int32_t predictor = samples[0];
+    int step_index = clampIndex(index);
+    put16(block, (uint16_t)samples[0]);
+    block[2] = (uint8_t)step_index;
+    block[3] = 0;
+    uint8_t* data = block + ADPCM_BLOCK_HEADER;
+    for (int s = 1; s < ADPCM_BLOCK_SAMPLES; s += 2) {
+        const uint8_t low = encodeSample(samples[s], predictor, step_index);
+        const uint8_t high = encodeSample(samples[s + 1], predictor, step_index);
+        data[(s - 1) / 2] = (uint8_t)(low | high << 4);
+    }
+    index = (uint8_t)step_index;
+}
+
+void Adpcm::decode(const uint8_t* block, size_t first, size_t count, int16_t* out) {
+    const size_t end = first + count;
+    if (count == 0 || end > ADPCM_BLOCK_SAMPLES) return;
+    const DecodeTables& tables = decodeTables();
+    const uint8_t* data = block + ADPCM_BLOCK_HEADER;
+    int32_t predictor = (int16_t)(block[0] | block[1] << 8);
+    unsigned index = block[2] > ADPCM_MAX_INDEX ? ADPCM_MAX_INDEX : block[2];
+    if (first == 0) *out++ = (int16_t)predictor;
+
+    size_t s = 1;
+    for (; s < first; s++) predictor = advance(tables, predictor, index, nibbleAt(data, s));
+    if (s < end && !(s & 1)) { // A high nibble first
+        predictor = advance(tables, predictor, index, nibbleAt(data, s++));
+        *out++ = (int16_t)predictor;
+    }
+    // Whole bytes, low nibble then high.
+    for (; s + 1 < end; s += 2) {
+        const unsigned byte = data[(s - 1) / 2];
+        predictor = advance(tables, predictor, index, byte & 15);
+        *out++ = (int16_t)predictor;
+        predictor = advance(tables, predictor, index, byte >> 4);
+        *out++ = (int16_t)predictor;
+    }
+    if (s < end) *out = (int16_t)advance(tables, predictor, index, nibbleAt(data, s));
+}
+
+void Adpcm::decodeBlockReference(const uint8_t* block, int16_t* out) {
+    int32_t predictor = (int16_t)(block[0] | block[1] << 8);
+    int index = clampIndex(block[2]);
+    out[0] = (int16_t)predictor;
+    for (size_t s = 1; s < ADPCM_BLOCK_SAMPLES; s++) {
+        const unsigned nibble = nibbleAt(block + ADPCM_BLOCK_HEADER, s);
+        const int32_t step = kSteps[index];
+        int32_t delta = step >> 3;
+        if (nibble & 4) delta += step;
+        if (nibble & 2) delta += step >> 1;
+        if (nibble & 1) delta += step >> 2;
+        predictor = clampSample(nibble & 8 ? predictor - delta : predictor + delta);
+        index = clampIndex(index + kIndexAdjust[nibble & 7]);
+        out[s] = (int16_t)predictor;
+    }
+}
+
+size_t Adpcm::wavHeader(uint8_t* header, uint32_t sample_rate, uint32_t samples, uint32_t blocks) {
+    const uint32_t data_bytes = blocks * ADPCM_BLOCK_BYTES;
+    memcpy(header, "RIFF", 4);
+    put32(header + 4, ADPCM_WAV_HEADER_BYTES - 8 + data_bytes);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    put32(header + 16, 20);
+    put16(header + 20, 0x11); // IMA ADPCM
+    put16(header + 22, 1);
+    put32(header + 24, sample_rate);
+    put32(header + 28, (uint32_t)((uint64_t)sample_rate * ADPCM_BLOCK_BYTES / ADPCM_BLOCK_SAMPLES));
+    put16(header + 32, ADPCM_BLOCK_BYTES);
+    put16(header + 34, 4);
+    put16(header + 36, 2);
+    put16(header + 38, ADPCM_BLOCK_SAMPLES);
+    memcpy(header + 40, "fact", 4);
+    put32(header + 44, 4);
+    put32(header + 48, samples);
+    memcpy(header + 52, "data", 4);
+    put32(header + 56, data_bytes);
+    return ADPCM_WAV_HEADER_BYTES;
+}
+
+AdpcmEncoder::AdpcmEncoder() {
+    reset();
+}
+
+void AdpcmEncoder::reset() {
+    count_ = 0;
+    index_ = 0;
+}
+
+size_t AdpcmEncoder::encode(const int16_t* samples, size_t count, uint8_t* out) {
+    size_t blocks = 0;
+    while (count > 0) {
+        if (count_ == 0 && count >= ADPCM_BLOCK_SAMPLES) { // Straight from the input
+            Adpcm::encodeBlock(samples, index_, out + blocks++ * ADPCM_BLOCK_BYTES);
+            samples += ADPCM_BLOCK_SAMPLES;
+            count -= ADPCM_BLOCK_SAMPLES;
+            continue;
+        }
+        const size_t take = ADPCM_BLOCK_SAMPLES - count_ < count ? ADPCM_BLOCK_SAMPLES - count_ : count;
+        memcpy(pending_ + count_, samples, take * sizeof(int16_t));
+        count_ += take;
+        samples += take;
+        count -= take;
+        if (count_ == ADPCM_BLOCK_SAMPLES) {
+            Adpcm::encodeBlock(pending_, index_, out + blocks++ * ADPCM_BLOCK_BYTES);
+            count_ = 0;
+        }
+    }
+    return blocks;
+}
+
+size_t AdpcmEncoder::flush(uint8_t* out) {
+    if (count_ == 0) return 0;
+    for (size_t i = count_; i < ADPCM_BLOCK_SAMPLES; i++) pending_[i] = pending_[count_ - 1];
+    Adpcm::encodeBlock(pending_, index_, out);
+    count_ = 0;
+    return 1;
+}
@@ -0,0 +1,57 @@
+#ifndef ADPCM_H
+#define ADPCM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// IMA-ADPCM, 4 bits a sample, in the block layout of WAV format 0x11 (mono):
+// a 4-byte header (the first sample, little endian, then the step index and
+// a zero byte) followed by two samples per byte, low nibble first. Every
+// block starts from its header alone, so any block decodes on its own and a
+// run of them is random access at block granularity.
+#define ADPCM_BLOCK_BYTES 256
+#define ADPCM_BLOCK_HEADER 4
+#define ADPCM_BLOCK_SAMPLES (1 + 2 * (ADPCM_BLOCK_BYTES - ADPCM_BLOCK_HEADER)) // 505
+#define ADPCM_MAX_INDEX 88
+#define ADPCM_WAV_HEADER_BYTES 60 // RIFF, fmt (with samples per block), fact and data headers
+
+class Adpcm {
+public:
+    // Encodes one block of ADPCM_BLOCK_SAMPLES. `index` is the step index
+    // to start from and is left where the block ends, so consecutive blocks
+    // of a stream keep adapting; any value decodes.
+    static void encodeBlock(const int16_t* samples, uint8_t& index, uint8_t* block);
+    // Samples [first, first + count) of a block, table-driven.
+    static void decode(const uint8_t* block, size_t first, size_t count, int16_t* out);
+    static void decodeBlock(const uint8_t* block, int16_t* out) { decode(block, 0, ADPCM_BLOCK_SAMPLES, out); }
+    // The specification's arithmetic, one step at a time; decode() must
+    // match it bit for bit.
+    static void decodeBlockReference(const uint8_t* block, int16_t* out);
+    // Header of a mono WAV of `blocks` blocks holding `samples` samples
+    // (the last block padded). Returns ADPCM_WAV_HEADER_BYTES.
+    static size_t wavHeader(uint8_t* header, uint32_t sample_rate, uint32_t samples, uint32_t blocks);
+};
+
+// Streaming encoder: any number of samples in, whole blocks out as they
+// fill.
+class AdpcmEncoder {
+public:
+    AdpcmEncoder();
+    void reset();
+    // Writes each block completed by `samples` to `out` (room for
+    // (pending() + count) / ADPCM_BLOCK_SAMPLES blocks); returns how many.
+    size_t encode(const int16_t* samples, size_t count, uint8_t* out);
+    // Writes the partial block, padded with its last sample; returns 0 when
+    // nothing is pending, else 1. The stream carries on with a fresh block.
+    size_t flush(uint8_t* out);
+    // Samples of the block being filled, not yet encoded.
+    size_t pending() const { return count_; }
+    const int16_t* pendingSamples() const { return pending_; }
+
+private:
+    int16_t pending_[ADPCM_BLOCK_SAMPLES];
+    size_t count_;
+    uint8_t index_;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "AdpcmHistory.h"
+#include <cstring>
+
+AdpcmHistory::AdpcmHistory(uint8_t* storage, size_t blocks) : storage_(storage), blocks_(blocks) {
+    reset();
+}
+
+void AdpcmHistory::reset() {
+    written_ = 0;
+    encoder_.reset();
+}
+
+void AdpcmHistory::append(const int16_t* samples, size_t count) {
+    // One block at a time, so each lands in its own slot of the ring.
+    while (count > 0) {
+        const size_t room = ADPCM_BLOCK_SAMPLES - encoder_.pending();
+        const size_t take = count < room ? count : room;
+        encoder_.encode(samples, take, storage_ + (size_t)(encoded() % blocks_) * ADPCM_BLOCK_BYTES);
+        written_ += take;
+        samples += take;
+        count -= take;
+    }
+}
+
+uint64_t AdpcmHistory::begin() const {
+    const uint64_t blocks = encoded();
+    return (blocks > blocks_ ? blocks - blocks_ : 0) * ADPCM_BLOCK_SAMPLES;
+}
+
+bool AdpcmHistory::read(uint64_t from, uint64_t to, int16_t* out) const {
+    if (from < begin() || from > to || to > end()) return false;
+    const uint64_t whole = encoded() * ADPCM_BLOCK_SAMPLES;
+    while (from < to) {
+        const uint64_t index = from / ADPCM_BLOCK_SAMPLES;
+        const size_t offset = (size_t)(from % ADPCM_BLOCK_SAMPLES);
+        const size_t left = ADPCM_BLOCK_SAMPLES - offset;
+        const size_t count = to - from < left ? (size_t)(to - from) : left;
+        if (from < whole) Adpcm::decode(block(index), offset, count, out);
+        else memcpy(out, encoder_.pendingSamples() + offset, count * sizeof(int16_t));
+        from += count;
+        out += count;
+    }
+    return true;
+}
+
+size_t AdpcmHistory::copyLatest(size_t samples, uint8_t* out, uint64_t& start) const {
+    const uint64_t held = end() - begin();
+    const uint64_t from = end() - (samples < held ? samples : held);
+    size_t copied = 0;
+    for (uint64_t index = from / ADPCM_BLOCK_SAMPLES; index < encoded(); index++) {
+        memcpy(out + copied++ * ADPCM_BLOCK_BYTES, block(index), ADPCM_BLOCK_BYTES);
+    }
+    AdpcmEncoder tail = encoder_; // Leaves the stream's encoder as it is
+    copied += tail.flush(out + copied * ADPCM_BLOCK_BYTES);
+    start = from / ADPCM_BLOCK_SAMPLES * ADPCM_BLOCK_SAMPLES;
+    return copied;
+}
@@ -0,0 +1,51 @@
+#ifndef ADPCM_HISTORY_H
+#define ADPCM_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Adpcm.h"
+
+// The compressed counterpart of AudioHistory: the latest `blocks` IMA-ADPCM
+// blocks of one stream, plus the block being filled, in storage the owner
+// provides (blocks * ADPCM_BLOCK_BYTES). It holds four times the audio of an
+// AudioHistory of the same size. Blocks are aligned to stream positions
+// counted from reset(), so a read only decodes the blocks it touches. The
+// block being filled is read back exactly, as it has not been encoded yet.
+//
+// Not thread-safe: one task writes and reads.
+class AdpcmHistory {
+public:
+    AdpcmHistory(uint8_t* storage, size_t blocks);
+    AdpcmHistory(const AdpcmHistory&) = delete;
+    AdpcmHistory& operator=(const AdpcmHistory&) = delete;
+
+    // Empties the history and restarts positions at 0.
+    void reset();
+    // Encodes `samples` in; the oldest block leaves as each new one fills.
+    void append(const int16_t* samples, size_t count);
+
+    // Positions [begin(), end()) are held.
+    uint64_t begin() const;
+    uint64_t end() const { return written_; }
+    // Whole blocks kept, in samples; the block being filled comes on top.
+    size_t capacity() const { return blocks_ * ADPCM_BLOCK_SAMPLES; }
+    // Decodes [from, to) into `out`. False unless begin() <= from <= to <= end().
+    bool read(uint64_t from, uint64_t to, int16_t* out) const;
+    // Copies the blocks that cover the latest `samples` (at most all that is
+    // held) to `out`, which has room for samples / ADPCM_BLOCK_SAMPLES + 2
+    // blocks. The block being filled is encoded on the way out, padded.
+    // Returns the block count; the first block starts at stream position
+    // `start`, and end() - start of the samples are real.
+    size_t copyLatest(size_t samples, uint8_t* out, uint64_t& start) const;
+
+private:
+    uint64_t encoded() const { return written_ / ADPCM_BLOCK_SAMPLES; } // Whole blocks so far
+    const uint8_t* block(uint64_t index) const { return storage_ + (size_t)(index % blocks_) * ADPCM_BLOCK_BYTES; }
+
+    uint8_t* storage_;
+    size_t blocks_;
+    uint64_t written_;
+    AdpcmEncoder encoder_;
+};
+
+#endif
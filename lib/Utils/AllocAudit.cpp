@@ -0,0 +1,99 @@
+#include "AllocAudit.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Plain integers so that touching them never allocates.
+thread_local uint32_t audit_depth = 0;
+thread_local uint32_t audited_allocations = 0;
+thread_local size_t audited_bytes = 0;
+
+} // namespace
+
+AllocAudit::Scope::Scope() : start_allocations_(audited_allocations), start_bytes_(audited_bytes) {
+    audit_depth++;
+}
+
+AllocAudit::Scope::~Scope() {
+    audit_depth--;
+}
+
+uint32_t AllocAudit::Scope::allocations() const {
+    return audited_allocations - start_allocations_;
+}
+
+size_t AllocAudit::Scope::bytes() const {
+    return audited_bytes - start_bytes_;
+}
+
+void AllocAudit::noteAllocation(size_t size) {
+    if (audit_depth == 0) return;
+    audited_allocations++;
+    audited_bytes += size;
+}
+
+#if ALLOC_AUDIT
+
+#if !defined(ARDUINO) && defined(__GLIBC__)
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+    AllocAudit::noteAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    AllocAudit::noteAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    AllocAudit::noteAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+}
+
+// malloc above already counts; operator new only has to reach it.
+#define AUDIT_NEW(size) ((void)0)
+
+#else
+
+#define AUDIT_NEW(size) AllocAudit::noteAllocation(size)
+
+#endif
+
+void* operator new(size_t size) {
+    AUDIT_NEW(size);
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    AUDIT_NEW(size);
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    AUDIT_NEW(size);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    AUDIT_NEW(size);
+    return malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+#endif // ALLOC_AUDIT
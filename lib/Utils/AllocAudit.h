@@ -0,0 +1,42 @@
+#ifndef ALLOC_AUDIT_H
+#define ALLOC_AUDIT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Allocation auditing for the zero-heap detection path. Build with
+// -DALLOC_AUDIT=1 to compile the hooks: global operator new/delete on every
+// target, plus malloc/calloc/realloc on glibc hosts (which also covers the
+// native heap_caps_* shim). Only allocations made by the thread that opened
+// an AllocAudit::Scope are counted, so background tasks don't add noise.
+//
+//   AllocAudit::Scope audit;
+//   detector.detect();
+//   TEST_ASSERT_EQUAL_UINT32(0, audit.allocations());
+
+#ifndef ALLOC_AUDIT
+#define ALLOC_AUDIT 0
+#endif
+
+class AllocAudit {
+public:
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        uint32_t allocations() const;
+        size_t bytes() const;
+
+    private:
+        uint32_t start_allocations_;
+        size_t start_bytes_;
+    };
+
+    static bool enabled() { return ALLOC_AUDIT != 0; }
+    static void noteAllocation(size_t size);
+};
+
+#endif
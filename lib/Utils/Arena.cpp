@@ -0,0 +1,31 @@
+#include "Arena.h"
+
+Arena* Arena::head_ = nullptr;
+
+Arena::Arena(const char* name, void* storage, size_t capacity)
+    : name_(name), storage_(static_cast<uint8_t*>(storage)), capacity_(capacity),
+      used_(0), high_water_(0), failures_(0), next_(head_) {
+    head_ = this;
+}
+
+Arena::~Arena() {
+    for (Arena** link = &head_; *link; link = &(*link)->next_) {
+        if (*link == this) {
+            *link = next_;
+            break;
+        }
+    }
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(storage_);
+    uintptr_t start = (base + used_ + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t end = (size_t)(start - base) + size;
+    if (end > capacity_) {
+        failures_++;
+        return nullptr;
+    }
+    used_ = end;
+    if (used_ > high_water_) high_water_ = used_;
+    return reinterpret_cast<void*>(start);
+}
@@ -0,0 +1,62 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Bump allocator over storage the owner provides (a static or member array
+// sized at compile time), so steady-state processing never touches the heap.
+// Every arena registers itself by name; the health check walks the list to
+// report per-subsystem high-water marks.
+class Arena {
+public:
+    typedef size_t Marker;
+
+    Arena(const char* name, void* storage, size_t capacity);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Returns nullptr (and counts a failure) when the arena is exhausted.
+    void* allocate(size_t size, size_t alignment = 8);
+    template<typename T>
+    T* allocateArray(size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+    Marker mark() const { return used_; }
+    void rewind(Marker marker) { if (marker <= used_) used_ = marker; }
+    void reset() { used_ = 0; }
+
+    const char* name() const { return name_; }
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return used_; }
+    size_t highWater() const { return high_water_; }
+    uint32_t failures() const { return failures_; }
+
+    static const Arena* first() { return head_; }
+    const Arena* next() const { return next_; }
+
+private:
+    const char* name_;
+    uint8_t* storage_;
+    size_t capacity_;
+    size_t used_;
+    size_t high_water_;
+    uint32_t failures_;
+    Arena* next_;
+    static Arena* head_;
+};
+
+// Releases everything allocated in a scope, e.g. per-call scratch buffers.
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : arena_(arena), marker_(arena.mark()) {}
+    ~ArenaScope() { arena_.rewind(marker_); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena_;
+    Arena::Marker marker_;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#include "AudioHistory.h"
+#include <cstring>
+
+AudioHistory::AudioHistory(int16_t* storage, size_t capacity) : storage_(storage), capacity_(capacity) {
+    reset();
+}
+
+void AudioHistory::reset() {
+    write_ = 0;
+    held_ = 0;
+    written_ = 0;
+}
+
+int16_t* AudioHistory::reserve(size_t count) {
+    if (count > capacity_) return nullptr;
+    if (capacity_ - write_ < count) {
+        write_ = 0;
+        held_ = 0;
+    }
+    if (held_ > capacity_ - count) held_ = capacity_ - count;
+    return storage_ + write_;
+}
+
+void AudioHistory::commit(size_t count) {
+    write_ = (write_ + count) % capacity_;
+    written_ += count;
+    held_ = held_ + count < capacity_ ? held_ + count : capacity_;
+}
+
+void AudioHistory::append(const int16_t* samples, size_t count) {
+    if (count > capacity_) {
+        written_ += count - capacity_;
+        samples += count - capacity_;
+        count = capacity_;
+    }
+    const size_t tail = capacity_ - write_ < count ? capacity_ - write_ : count;
+    memcpy(storage_ + write_, samples, tail * sizeof(int16_t));
+    memcpy(storage_, samples + tail, (count - tail) * sizeof(int16_t));
+    commit(count);
+}
+
+bool AudioHistory::view(uint64_t from, uint64_t to, AudioSpans& spans) const {
+    if (from < begin() || from > to || to > end()) return false;
+    const size_t count = (size_t)(to - from);
+    const size_t index = (write_ + capacity_ - (size_t)(written_ - from)) % capacity_;
+    spans.start = from;
+    spans.first = storage_ + index;
+    spans.first_count = capacity_ - index < count ? capacity_ - index : count;
+    spans.second_count = count - spans.first_count;
+    spans.second = spans.second_count ? storage_ : nullptr;
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef AUDIO_HISTORY_H
+#define AUDIO_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// A run of history in place: at most two contiguous pieces, because the
+// ring wraps at most once. `second` continues `first`.
+struct AudioSpans {
+    uint64_t start; // Stream position of first[0]
+    const int16_t* first;
+    size_t first_count;
+    const int16_t* second; // nullptr when the run does not wrap
+    size_t second_count;
+
+    size_t count() const { return first_count + second_count; }
+};
+
+// The latest `capacity` samples of one stream, in storage the owner
+// provides (a member array sized at compile time). Samples are addressed by
+// stream position, counted from reset().
+//
+// Producers either append() a copy or write in place: reserve() hands out
+// the next contiguous run of storage and commit() publishes it. With a
+// capacity that is a multiple of the producer's block size every block is
+// contiguous, so capture can DMA straight into history and readers get
+// views of it instead of copies. A view stays valid until the ring comes
+// round again, capacity - (reserved block) samples later.
+//
+// Not thread-safe: one task writes and reads.
+class AudioHistory {
+public:
+    AudioHistory(int16_t* storage, size_t capacity);
+    AudioHistory(const AudioHistory&) = delete;
+    AudioHistory& operator=(const AudioHistory&) = delete;
+
+    // Empties the history and restarts positions at 0.
+    void reset();
+    // Room for `count` <= capacity samples at the write position. The
+    // oldest samples it overlaps leave the history at once. If the run
+    // would wrap (only after append()s of another size), the history is
+    // emptied and writing restarts at the front; positions carry on.
+    int16_t* reserve(size_t count);
+    // Publishes `count` samples written to the last reserve().
+    void commit(size_t count);
+    // Copies `count` samples in; only the last `capacity` are kept.
+    void append(const int16_t* samples, size_t count);
+
+    // Positions [begin(), end()) are held.
+    uint64_t begin() const { return written_ - held_; }
+    uint64_t end() const { return written_; }
+    size_t capacity() const { return capacity_; }
+    // False unless begin() <= from <= to <= end().
+    bool view(uint64_t from, uint64_t to, AudioSpans& spans) const;
+
+private:
+    int16_t* storage_;
+    size_t capacity_;
+    size_t write_; // Storage index of end()
+    size_t held_;
+    uint64_t written_;
+};
+
+#endif
@@ -0,0 +1,128 @@
+#include "DualCore.h"
+
+DualCore::DualCore()
+    : job_(nullptr), context_(nullptr), running_(false), stopping_(false)
+#ifdef ARDUINO
+      , helper_(nullptr), caller_(nullptr)
+#else
+      , generation_(0), completed_(0)
+#endif
+{}
+
+DualCore::~DualCore() {
+    stop();
+}
+
+#ifdef ARDUINO
+
+bool DualCore::start(int core, int priority) {
+    if (running_) return true;
+    stopping_ = false;
+    if (xTaskCreatePinnedToCore(helperTask, "DualCore", 3072, this, priority, &helper_, core) != pdPASS) {
+        return false;
+    }
+    running_ = true;
+    return true;
+}
+
+void DualCore::stop() {
+    if (!running_) return;
+    stopping_ = true;
+    caller_ = xTaskGetCurrentTaskHandle();
+    xTaskNotifyGive(helper_);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Helper acknowledges, then deletes itself
+    running_ = false;
+    helper_ = nullptr;
+}
+
+void DualCore::helperTask(void* self) {
+    static_cast<DualCore*>(self)->helperLoop();
+    vTaskDelete(NULL);
+}
+
+void DualCore::helperLoop() {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (stopping_) {
+            xTaskNotifyGive(caller_);
+            return;
+        }
+        job_(context_, 1, 2);
+        xTaskNotifyGive(caller_);
+    }
+}
+
+void DualCore::run(Job job, void* context) {
+    if (!running_) {
+        job(context, 0, 1);
+        return;
+    }
+    job_ = job;
+    context_ = context;
+    caller_ = xTaskGetCurrentTaskHandle();
+    xTaskNotifyGive(helper_);
+    job(context, 0, 2);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+#else
+
+bool DualCore::start(int, int) { // One std::thread; no core or priority to pin
+    if (running_) return true;
+    stopping_ = false;
+    generation_ = 0;
+    completed_ = 0;
+    helper_ = std::thread(&DualCore::helperLoop, this);
+    running_ = true;
+    return true;
+}
+
+void DualCore::stop() {
+    if (!running_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    helper_.join();
+    running_ = false;
+}
+
+void DualCore::helperLoop() {
+    uint32_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+        job_(context_, 1, 2);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completed_ = seen;
+        }
+        done_.notify_one();
+    }
+}
+
+void DualCore::run(Job job, void* context) {
+    if (!running_) {
+        job(context, 0, 1);
+        return;
+    }
+    uint32_t generation;
+    {
+        // The mutex publishes job_ and context_ to the helper with the generation.
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = job;
+        context_ = context;
+        generation = ++generation_;
+    }
+    wake_.notify_one();
+    job(context, 0, 2);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return completed_ == generation; });
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef DUAL_CORE_H
+#define DUAL_CORE_H
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Fork/join over two cores for splitting one piece of work in half: run()
+// executes part 0 on the calling task and part 1 on a helper, and returns
+// once both are done, which doubles as the barrier between dependent steps.
+//
+// On the device the helper is a FreeRTOS task pinned to the other core and
+// the hand-off is a pair of task notifications. On the host it is a thread
+// handed each job through a generation counter under a mutex; the helper and
+// the caller each block on a condition variable, so neither burns a CPU the
+// other half (or another stream's worker) could use.
+//
+// run() is for one caller at a time. Without start() it runs the whole job
+// inline as a single part.
+class DualCore {
+public:
+    typedef void (*Job)(void* context, int part, int parts);
+
+    DualCore();
+    ~DualCore();
+    DualCore(const DualCore&) = delete;
+    DualCore& operator=(const DualCore&) = delete;
+
+    // `core` pins the helper on the device (ignored on the host).
+    bool start(int core, int priority);
+    void stop();
+    bool running() const { return running_; }
+
+    void run(Job job, void* context);
+
+    // Half-open range [begin, end) of `count` items for `part` of `parts`.
+    static void split(int count, int part, int parts, int& begin, int& end) {
+        begin = count * part / parts;
+        end = count * (part + 1) / parts;
+    }
+
+private:
+    void helperLoop();
+
+    Job job_;
+    void* context_;
+    bool running_;
+    std::atomic<bool> stopping_;
+#ifdef ARDUINO
+    static void helperTask(void* self);
+    TaskHandle_t helper_;
+    TaskHandle_t caller_;
+#else
+    std::thread helper_;
+    std::mutex mutex_;
+    std::condition_variable wake_; // Helper: new generation or stopping
+    std::condition_variable done_; // Caller: helper finished the generation
+    uint32_t generation_;          // Guarded by mutex_, like completed_
+    uint32_t completed_;
+#endif
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "LatencyHistogram.h"
+
+static const uint32_t SUB_BUCKETS = 1u << LATENCY_SUB_BUCKET_BITS;
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint32_t micros) {
+    if (micros >= LATENCY_MAX_US) return LATENCY_BUCKETS - 1;
+    if (micros < SUB_BUCKETS) return micros;
+    int msb = 31 - __builtin_clz(micros);
+    int shift = msb - LATENCY_SUB_BUCKET_BITS;
+    return ((size_t)(shift + 1) << LATENCY_SUB_BUCKET_BITS) + (micros >> shift) - SUB_BUCKETS;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) return (uint32_t)index;
+    uint32_t shift = (uint32_t)(index >> LATENCY_SUB_BUCKET_BITS) - 1;
+    uint32_t sub = (uint32_t)(index & (SUB_BUCKETS - 1)) + SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint32_t micros) {
+    counts_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    uint32_t seen = max_.load(std::memory_order_relaxed);
+    while (micros > seen && !max_.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < LATENCY_BUCKETS; i++) counts_[i].store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const {
+    LatencySnapshot snap = {};
+    snap.max_us = max_.load(std::memory_order_relaxed);
+
+    // Count from the buckets themselves so the percentiles are consistent
+    // with each other even if record() runs concurrently.
+    uint32_t total = 0;
+    for (size_t i = 0; i < LATENCY_BUCKETS; i++) total += counts_[i].load(std::memory_order_relaxed);
+    snap.count = total;
+    if (total == 0) return snap;
+
+    // Nearest-rank percentiles: the first bucket whose cumulative count
+    // reaches ceil(p * total).
+    const uint32_t percents[3] = {50, 90, 99};
+    uint32_t* results[3] = {&snap.p50_us, &snap.p90_us, &snap.p99_us};
+    int next = 0;
+    uint32_t seen = 0;
+    uint64_t weighted = 0;
+    for (size_t i = 0; i < LATENCY_BUCKETS && seen < total; i++) {
+        uint32_t n = counts_[i].load(std::memory_order_relaxed);
+        if (n == 0) continue;
+        uint32_t upper = bucketUpperBound(i);
+        uint32_t lower = i == 0 ? 0 : bucketUpperBound(i - 1) + 1;
+        weighted += (uint64_t)n * ((lower + upper) / 2);
+        seen += n;
+        while (next < 3 && (uint64_t)seen * 100 >= (uint64_t)total * percents[next]) {
+            *results[next++] = upper;
+        }
+    }
+    snap.mean_us = (uint32_t)(weighted / total);
+
+    // Bucket bounds can overshoot the true maximum; never report past it.
+    if (snap.max_us) {
+        if (snap.p50_us > snap.max_us) snap.p50_us = snap.max_us;
+        if (snap.p90_us > snap.max_us) snap.p90_us = snap.max_us;
+        if (snap.p99_us > snap.max_us) snap.p99_us = snap.max_us;
+    }
+    return snap;
+}
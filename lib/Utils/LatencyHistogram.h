@@ -0,0 +1,51 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-memory log-linear (HDR-style) latency histogram in microseconds.
+//
+// Values below 2^LATENCY_SUB_BUCKET_BITS get one bucket each; every power of
+// two above that is split into 2^LATENCY_SUB_BUCKET_BITS linear sub-buckets,
+// so any recorded value is reported within 1/16 (~6%) of its true size.
+// Values at or above LATENCY_MAX_US land in the top bucket; the exact
+// maximum is tracked separately.
+//
+// record() is lock-free (relaxed atomic increments) and safe to call from
+// the detection task while another task takes snapshots. A snapshot taken
+// mid-record may be one sample behind, which is fine for monitoring.
+
+#define LATENCY_SUB_BUCKET_BITS 4
+#define LATENCY_MAX_BITS 24                 // 2^24 us = 16.7 s
+#define LATENCY_MAX_US (1u << LATENCY_MAX_BITS)
+#define LATENCY_BUCKETS ((LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS + 1) << LATENCY_SUB_BUCKET_BITS)
+
+struct LatencySnapshot {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t mean_us;   // from bucket midpoints
+};
+
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint32_t micros);
+    void reset();
+    LatencySnapshot snapshot() const;
+
+    // Highest value that maps to the same bucket (what percentiles report).
+    static uint32_t bucketUpperBound(size_t index);
+    static size_t bucketIndex(uint32_t micros);
+
+private:
+    std::atomic<uint32_t> counts_[LATENCY_BUCKETS];
+    std::atomic<uint32_t> max_;
+};
+
+#endif
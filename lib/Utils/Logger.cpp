@@ -1,18 +1,301 @@
 #include "Logger.h"
+#include <atomic>
 #include <cstdio>
+#include "MpscQueue.h"
 
-int Logger::debugLevel_ = 0;
+#ifdef ARDUINO
+#include <Arduino.h>
+#define LOG_QUEUE_COUNT 2   // one per core
+#else
+#include <chrono>
+#include <thread>
+#define LOG_QUEUE_COUNT 1
+#endif
+
+int Logger::debugLevel_ = LOG_LEVEL;
+
+static MpscQueue<LogRecord, LOG_QUEUE_DEPTH> log_queues[LOG_QUEUE_COUNT];
+static std::atomic<uint32_t> dropped_records(0);
+static bool compact_output = false;
+
+static const char* const LEVEL_TAGS[] = {"", "E", "I", "V"};
+static const int MAX_SENT_IDS = 128;
+static const void* sent_ids[MAX_SENT_IDS];
+static int sent_id_count = 0;
+
+static void emitLine(const char* line) {
+#ifdef ARDUINO
+    Serial.println(line);
+#else
+    fputs(line, stdout);
+    fputc('\n', stdout);
+#endif
+}
 
 void Logger::init(int level) {
-    debugLevel_ = level;
+    debugLevel_ = level < LOG_LEVEL ? level : LOG_LEVEL;
 }
 
 void Logger::log(int level, const char* format, ...) {
-    if (level >= debugLevel_) {
+    if (level <= debugLevel_) {
         va_list args;
         va_start(args, format);
         vprintf(format, args);
         va_end(args);
         printf("\n");
     }
-}
\ No newline at end of file
+}
+
+uint32_t Logger::nowMs() {
+#ifdef ARDUINO
+    return millis();
+#else
+    static const auto start = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+#endif
+}
+
+void Logger::enqueue(const LogRecord& record) {
+#ifdef ARDUINO
+    int queue = xPortGetCoreID();
+#else
+    int queue = 0;
+#endif
+    if (!log_queues[queue].push(record)) {
+        dropped_records.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::setCompactOutput(bool compact) {
+    compact_output = compact;
+    sent_id_count = 0;
+    if (compact) {
+        char header[32];
+        snprintf(header, sizeof(header), "LOG-COMPACT v1 ptr=%u", (unsigned)sizeof(void*));
+        emitLine(header);
+    }
+}
+
+uint32_t Logger::droppedCount() {
+    return dropped_records.load(std::memory_order_relaxed);
+}
+
+namespace {
+
+struct ArgCursor {
+    const LogRecord& record;
+    uint8_t index;
+    uint8_t word;
+
+    bool next(LogArgType& type, uint64_t& bits) {
+        if (index >= record.arg_count) return false;
+        type = (LogArgType)((record.arg_types >> (2 * index)) & 0x3);
+        uint8_t words = (type == LOG_ARG_INT64 || (type == LOG_ARG_POINTER && sizeof(void*) > 4)) ? 2 : 1;
+        bits = record.args[word];
+        if (words == 2) bits |= (uint64_t)record.args[word + 1] << 32;
+        index++;
+        word += words;
+        return true;
+    }
+};
+
+// Re-creates the printf output one conversion at a time, feeding snprintf the
+// argument width the format expects rather than the width that was captured.
+int formatRecord(const LogRecord& record, char* out, size_t capacity) {
+    ArgCursor cursor = {record, 0, 0};
+    size_t len = 0;
+    const char* p = record.format;
+    auto room = [&]() { return len < capacity ? capacity - len : 0; };
+
+    while (*p && len + 1 < capacity) {
+        if (*p != '%') {
+            out[len++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[len++] = '%';
+            p += 2;
+            continue;
+        }
+
+        char spec[24];
+        size_t spec_len = 0;
+        spec[spec_len++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && spec_len < sizeof(spec) - 4) {
+            spec[spec_len++] = *p++;
+        }
+        while (*p && strchr("hlLqjzt", *p)) p++;  // Length comes from the captured type
+        char conversion = *p ? *p++ : 'd';
+
+        LogArgType type;
+        uint64_t bits;
+        if (!cursor.next(type, bits)) {
+            len += snprintf(out + len, room(), "?");
+            continue;
+        }
+        int64_t as_int = type == LOG_ARG_INT32 ? (int64_t)(int32_t)bits : (int64_t)bits;
+        float as_float;
+        uint32_t float_bits = (uint32_t)bits;
+        memcpy(&as_float, &float_bits, sizeof(as_float));
+        if (type == LOG_ARG_FLOAT) as_int = (int64_t)as_float;
+
+        int written = 0;
+        if (strchr("di", conversion)) {
+            spec[spec_len++] = 'l';
+            spec[spec_len++] = 'l';
+            spec[spec_len++] = conversion;
+            spec[spec_len] = '\0';
+            written = snprintf(out + len, room(), spec, (long long)as_int);
+        } else if (strchr("uxXo", conversion)) {
+            unsigned long long value = type == LOG_ARG_INT32 ? (unsigned long long)(uint32_t)bits
+                                                             : (unsigned long long)as_int;
+            spec[spec_len++] = 'l';
+            spec[spec_len++] = 'l';
+            spec[spec_len++] = conversion;
+            spec[spec_len] = '\0';
+            written = snprintf(out + len, room(), spec, value);
+        } else if (strchr("fFeEgGaA", conversion)) {
+            spec[spec_len++] = conversion;
+            spec[spec_len] = '\0';
+            double value = type == LOG_ARG_FLOAT ? (double)as_float : (double)as_int;
+            written = snprintf(out + len, room(), spec, value);
+        } else if (conversion == 'c') {
+            spec[spec_len++] = 'c';
+            spec[spec_len] = '\0';
+            written = snprintf(out + len, room(), spec, (int)as_int);
+        } else if (conversion == 's' && type == LOG_ARG_POINTER) {
+            spec[spec_len++] = 's';
+            spec[spec_len] = '\0';
+            const char* str = (const char*)(uintptr_t)bits;
+            written = snprintf(out + len, room(), spec, str ? str : "(null)");
+        } else {
+            written = snprintf(out + len, room(), "%p", (void*)(uintptr_t)bits);
+        }
+        if (written > 0) len += (size_t)written;
+    }
+    if (len >= capacity) len = capacity - 1;
+    out[len] = '\0';
+    return (int)len;
+}
+
+// Bit i set when argument i is consumed by a %s conversion.
+uint8_t stringArgMask(const char* format) {
+    uint8_t mask = 0;
+    int index = 0;
+    for (const char* p = format; *p && index < 8; p++) {
+        if (*p != '%') continue;
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+        p++;
+        while (*p && strchr("-+ #0123456789.hlLqjzt", *p)) p++;
+        if (!*p) break;
+        if (*p == 's') mask |= (uint8_t)(1u << index);
+        index++;
+    }
+    return mask;
+}
+
+bool markSent(const void* id) {
+    for (int i = 0; i < sent_id_count; i++) {
+        if (sent_ids[i] == id) return false;
+    }
+    if (sent_id_count < MAX_SENT_IDS) sent_ids[sent_id_count++] = id;
+    return true;
+}
+
+void emitCompact(const LogRecord& record) {
+    char line[160];
+    if (markSent(record.format)) {
+        snprintf(line, sizeof(line), "F %lx ", (unsigned long)(uintptr_t)record.format);
+        size_t prefix = strlen(line);
+        strncpy(line + prefix, record.format, sizeof(line) - prefix - 1);
+        line[sizeof(line) - 1] = '\0';
+        emitLine(line);
+    }
+
+    // String arguments are sent once per pointer, like format strings.
+    uint8_t string_args = stringArgMask(record.format);
+    ArgCursor cursor = {record, 0, 0};
+    LogArgType type;
+    uint64_t bits;
+    while (cursor.next(type, bits)) {
+        const char* str = (const char*)(uintptr_t)bits;
+        bool is_string = string_args & (1u << (cursor.index - 1));
+        if (type != LOG_ARG_POINTER || !is_string || !str || !markSent(str)) continue;
+        snprintf(line, sizeof(line), "S %lx %s", (unsigned long)(uintptr_t)str, str);
+        emitLine(line);
+    }
+
+    int len = snprintf(line, sizeof(line), "L %u %lu %lx %x", record.level, (unsigned long)record.timestamp_ms,
+                       (unsigned long)(uintptr_t)record.format, record.arg_types | (record.arg_count << 16));
+    for (uint8_t i = 0; i < cursor.word && len < (int)sizeof(line); i++) {
+        len += snprintf(line + len, sizeof(line) - len, " %lx", (unsigned long)record.args[i]);
+    }
+    emitLine(line);
+}
+
+} // namespace
+
+int Logger::drain() {
+    static uint32_t reported_drops = 0;
+    int drained = 0;
+    LogRecord record;
+    char line[192];
+
+    for (int queue = 0; queue < LOG_QUEUE_COUNT; queue++) {
+        while (log_queues[queue].pop(record)) {
+            if (compact_output) {
+                emitCompact(record);
+            } else {
+                int prefix = snprintf(line, sizeof(line), "[%lu][%s] ", (unsigned long)record.timestamp_ms,
+                                      LEVEL_TAGS[record.level & 0x3]);
+                formatRecord(record, line + prefix, sizeof(line) - prefix);
+                emitLine(line);
+            }
+            drained++;
+        }
+    }
+
+    uint32_t drops = droppedCount();
+    if (drops != reported_drops) {
+        snprintf(line, sizeof(line), "⚠️ Logger dropped %lu records", (unsigned long)(drops - reported_drops));
+        emitLine(line);
+        reported_drops = drops;
+    }
+    return drained;
+}
+
+#ifdef ARDUINO
+
+static void logDrainTask(void* pvParameters) {
+    while (true) {
+        Logger::drain();
+        vTaskDelay(20 / portTICK_PERIOD_MS);
+    }
+}
+
+void Logger::startTask() {
+    static TaskHandle_t drain_task = nullptr;
+    if (drain_task) return;
+    xTaskCreatePinnedToCore(logDrainTask, "LogDrainTask", 4096, NULL, 1, &drain_task, 0);
+}
+
+#else
+
+void Logger::startTask() {
+    static bool started = false;
+    if (started) return;
+    started = true;
+    std::thread([]() {
+        while (true) {
+            Logger::drain();
+            fflush(stdout);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }).detach();
+}
+
+#endif
@@ -3,14 +3,135 @@
 
 #include <cstdarg>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Log levels follow DEBUG_LEVEL in env.h: 0=Off, 1=Error, 2=Info, 3=Verbose.
+#define LOG_LEVEL_NONE    0
+#define LOG_LEVEL_ERROR   1
+#define LOG_LEVEL_INFO    2
+#define LOG_LEVEL_VERBOSE 3
+
+// Compile-time ceiling (set with -DLOG_LEVEL=n). Statements above it expand to
+// nothing, arguments included.
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_QUEUE_DEPTH
+#define LOG_QUEUE_DEPTH 64        // records per core, power of two
+#endif
+
+#define LOG_MAX_ARG_WORDS 8
+
+// Deferred logging for the detection path. A LOG_* call copies the format
+// string pointer and its raw arguments into a lock-free per-core queue; the
+// low-priority task started by Logger::startTask() does the formatting and the
+// serial I/O. %s arguments must point at strings that outlive the record
+// (literals, esp_err_to_name(), ...).
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) Logger::write(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) Logger::write(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#define LOG_VERBOSE(format, ...) Logger::write(LOG_LEVEL_VERBOSE, format, ##__VA_ARGS__)
+#else
+#define LOG_VERBOSE(format, ...) ((void)0)
+#endif
+
+enum LogArgType : uint8_t {
+    LOG_ARG_INT32 = 0,
+    LOG_ARG_INT64 = 1,
+    LOG_ARG_FLOAT = 2,
+    LOG_ARG_POINTER = 3
+};
+
+struct LogRecord {
+    const char* format;          // doubles as the message ID
+    uint32_t timestamp_ms;
+    uint8_t level;
+    uint8_t arg_count;
+    uint16_t arg_types;          // LogArgType, 2 bits per argument
+    uint32_t args[LOG_MAX_ARG_WORDS];
+};
 
 class Logger {
 public:
-    static void init(int level = 0); // Default argument set to 0 (all logs)
-    static void log(int level, const char* format, ...);
+    static void init(int level = LOG_LEVEL); // Runtime filter, at most LOG_LEVEL
+    static void log(int level, const char* format, ...); // Synchronous, for setup code
+
+    template<typename... Args>
+    static void write(uint8_t level, const char* format, Args... args) {
+        if (level > debugLevel_) return;
+        LogRecord record;
+        record.format = format;
+        record.timestamp_ms = nowMs();
+        record.level = level;
+        record.arg_count = 0;
+        record.arg_types = 0;
+        uint8_t words = 0;
+        int expand[] = {0, (pack(record, words, args), 0)...};
+        (void)expand;
+        (void)words;
+        enqueue(record);
+    }
+
+    // Starts the low-priority drain task (core 0 on the ESP32).
+    static void startTask();
+    // Formats and emits everything queued so far; returns the record count.
+    static int drain();
+    // Compact mode emits "F"/"L" hex lines for tools/log_decoder.py instead of
+    // formatted text; each format string crosses the wire once.
+    static void setCompactOutput(bool compact);
+    static uint32_t droppedCount();
 
 private:
     static int debugLevel_;
+
+    static uint32_t nowMs();
+    static void enqueue(const LogRecord& record);
+
+    static void addArg(LogRecord& record, uint8_t& words, LogArgType type, const void* value, uint8_t size) {
+        uint8_t needed = (size + 3) / 4;
+        if (record.arg_count >= 8 || words + needed > LOG_MAX_ARG_WORDS) return;
+        memcpy(&record.args[words], value, size);
+        words += needed;
+        record.arg_types |= (uint16_t)(type << (2 * record.arg_count));
+        record.arg_count++;
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    pack(LogRecord& record, uint8_t& words, T value) {
+        if (sizeof(T) > 4) {
+            int64_t wide = (int64_t)value;
+            addArg(record, words, LOG_ARG_INT64, &wide, 8);
+        } else {
+            int32_t narrow = (int32_t)value;
+            addArg(record, words, LOG_ARG_INT32, &narrow, 4);
+        }
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    pack(LogRecord& record, uint8_t& words, T value) {
+        float narrow = (float)value;
+        addArg(record, words, LOG_ARG_FLOAT, &narrow, 4);
+    }
+
+    template<typename T>
+    static void pack(LogRecord& record, uint8_t& words, T* value) {
+        const void* pointer = value;
+        addArg(record, words, LOG_ARG_POINTER, &pointer, sizeof(pointer));
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Bounded lock-free multi-producer/single-consumer queue (per-cell sequence
+// numbers, after Vyukov). Producers never block: push() fails when the queue
+// is full. Several tasks on one core may push concurrently; exactly one task
+// may pop.
+template<typename T, size_t N>
+class MpscQueue {
+    static_assert((N & (N - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() : head_(0), tail_(0) {
+        for (size_t i = 0; i < N; i++) {
+            cells_[i].sequence.store((uint32_t)i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(const T& item) {
+        uint32_t pos = head_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & (N - 1)];
+            uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = item;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint32_t pos = tail_;
+        Cell& cell = cells_[pos & (N - 1)];
+        uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+        if ((int32_t)(seq - (pos + 1)) < 0) return false;
+        item = cell.data;
+        cell.sequence.store(pos + (uint32_t)N, std::memory_order_release);
+        tail_ = pos + 1;
+        return true;
+    }
+
+    size_t capacity() const { return N; }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        T data;
+    };
+
+    Cell cells_[N];
+    std::atomic<uint32_t> head_;
+    uint32_t tail_;
+};
@@ -0,0 +1,153 @@
+#include "Trace.h"
+
+#if ENABLE_TRACE
+
+#include <cstring>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+Trace::Lane Trace::lanes_[TRACE_MAX_LANES];
+std::atomic<bool> Trace::enabled_(true);
+
+static const int MAX_TRACE_NAMES = 64;
+
+namespace {
+
+struct LaneWindow {
+    uint32_t start;
+    uint32_t count;
+};
+
+// Records still held by a lane: the newest TRACE_BUFFER_RECORDS at most.
+LaneWindow laneWindow(uint32_t head) {
+    uint32_t count = head < TRACE_BUFFER_RECORDS ? head : TRACE_BUFFER_RECORDS;
+    return {head - count, count};
+}
+
+int internName(const char** names, int& name_count, const char* name) {
+    for (int i = 0; i < name_count; i++) {
+        if (names[i] == name) return i;
+    }
+    if (name_count >= MAX_TRACE_NAMES) return -1;
+    names[name_count] = name;
+    return name_count++;
+}
+
+} // namespace
+
+void Trace::clear() {
+    for (int lane = 0; lane < TRACE_MAX_LANES; lane++) {
+        lanes_[lane].head.store(0, std::memory_order_relaxed);
+    }
+}
+
+#ifdef ARDUINO
+
+void Trace::dump(Print& out) {
+    bool was_enabled = isEnabled();
+    setEnabled(false);
+
+    const char* names[MAX_TRACE_NAMES];
+    int name_count = 0;
+
+    out.printf("TRACE-BEGIN v1 lanes=%d ts_bits=32 ts_hz=%lu\n", TRACE_MAX_LANES,
+               (unsigned long)getCpuFrequencyMhz() * 1000000UL);
+    for (int lane = 0; lane < TRACE_MAX_LANES; lane++) {
+        LaneWindow window = laneWindow(lanes_[lane].head.load(std::memory_order_relaxed));
+        for (uint32_t i = 0; i < window.count; i++) {
+            const TraceRecord& rec = lanes_[lane].records[(window.start + i) & (TRACE_BUFFER_RECORDS - 1)];
+            int before = name_count;
+            int id = internName(names, name_count, rec.name);
+            if (id < 0) continue;
+            if (id == before) out.printf("N %d %s\n", id, rec.name);
+            out.printf("R %d %08lx %c %d\n", lane, (unsigned long)rec.timestamp, rec.type, id);
+        }
+    }
+    out.println("TRACE-END");
+
+    setEnabled(was_enabled);
+}
+
+#else
+
+trace_ts_t Trace::hostNowNs() {
+    return (trace_ts_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned Trace::hostLane() {
+    static std::atomic<unsigned> next_lane(0);
+    thread_local unsigned lane = next_lane.fetch_add(1, std::memory_order_relaxed) % TRACE_MAX_LANES;
+    return lane;
+}
+
+void Trace::dump(FILE* out) {
+    bool was_enabled = isEnabled();
+    setEnabled(false);
+
+    const char* names[MAX_TRACE_NAMES];
+    int name_count = 0;
+
+    fprintf(out, "TRACE-BEGIN v1 lanes=%d ts_bits=64 ts_hz=1000000000\n", TRACE_MAX_LANES);
+    for (int lane = 0; lane < TRACE_MAX_LANES; lane++) {
+        LaneWindow window = laneWindow(lanes_[lane].head.load(std::memory_order_relaxed));
+        for (uint32_t i = 0; i < window.count; i++) {
+            const TraceRecord& rec = lanes_[lane].records[(window.start + i) & (TRACE_BUFFER_RECORDS - 1)];
+            int before = name_count;
+            int id = internName(names, name_count, rec.name);
+            if (id < 0) continue;
+            if (id == before) fprintf(out, "N %d %s\n", id, rec.name);
+            fprintf(out, "R %d %016llx %c %d\n", lane, (unsigned long long)rec.timestamp, rec.type, id);
+        }
+    }
+    fprintf(out, "TRACE-END\n");
+
+    setEnabled(was_enabled);
+}
+
+bool Trace::writeChromeJson(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) return false;
+
+    bool was_enabled = isEnabled();
+    setEnabled(false);
+
+    // Timestamps are rebased on the earliest record so the JSON stays small.
+    trace_ts_t origin = ~(trace_ts_t)0;
+    for (int lane = 0; lane < TRACE_MAX_LANES; lane++) {
+        LaneWindow window = laneWindow(lanes_[lane].head.load(std::memory_order_relaxed));
+        if (window.count == 0) continue;
+        trace_ts_t first = lanes_[lane].records[window.start & (TRACE_BUFFER_RECORDS - 1)].timestamp;
+        if (first < origin) origin = first;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first_event = true;
+    for (int lane = 0; lane < TRACE_MAX_LANES; lane++) {
+        LaneWindow window = laneWindow(lanes_[lane].head.load(std::memory_order_relaxed));
+        int depth = 0;
+        for (uint32_t i = 0; i < window.count; i++) {
+            const TraceRecord& rec = lanes_[lane].records[(window.start + i) & (TRACE_BUFFER_RECORDS - 1)];
+            // Ends whose begin was overwritten by the ring would confuse the viewer.
+            if (rec.type == TRACE_EVENT_END && depth == 0) continue;
+            if (rec.type == TRACE_EVENT_BEGIN) depth++;
+            if (rec.type == TRACE_EVENT_END) depth--;
+            fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%d%s}",
+                    first_event ? "" : ",\n", rec.name, rec.type,
+                    (rec.timestamp - origin) / 1000.0, lane,
+                    rec.type == TRACE_EVENT_INSTANT ? ",\"s\":\"t\"" : "");
+            first_event = false;
+        }
+    }
+    fprintf(out, "\n]}\n");
+    fclose(out);
+
+    setEnabled(was_enabled);
+    return true;
+}
+
+#endif // ARDUINO
+
+#endif // ENABLE_TRACE
@@ -0,0 +1,153 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Span/instant tracing into per-core rings of compact binary records.
+//
+// Build with -DENABLE_TRACE=1 to enable. When disabled every TRACE_* macro
+// expands to nothing and Trace.cpp compiles to an empty unit, so there is no
+// code, no RAM and no timestamp read left in the firmware.
+//
+//   void AudioProcessor::computeFFT(...) {
+//       TRACE_SPAN("fft");          // begin now, end at scope exit
+//       ...
+//       TRACE_INSTANT("wake_word"); // zero-length marker
+//   }
+//
+// Names must be string literals (or otherwise live forever): only the pointer
+// is stored. Recording an event is one timestamp read, one atomic increment
+// and a 12-byte store on the ESP32.
+
+#ifndef ENABLE_TRACE
+#define ENABLE_TRACE 0
+#endif
+
+#if ENABLE_TRACE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+#ifndef TRACE_BUFFER_RECORDS
+#define TRACE_BUFFER_RECORDS 512   // per core, must be a power of two
+#endif
+
+#ifndef TRACE_MAX_LANES
+#ifdef ARDUINO
+#define TRACE_MAX_LANES 2          // one lane per core
+#else
+#define TRACE_MAX_LANES 8          // one lane per thread on the host
+#endif
+#endif
+
+static_assert((TRACE_BUFFER_RECORDS & (TRACE_BUFFER_RECORDS - 1)) == 0,
+              "TRACE_BUFFER_RECORDS must be a power of two");
+
+enum TraceEventType : uint8_t {
+    TRACE_EVENT_BEGIN = 'B',
+    TRACE_EVENT_END = 'E',
+    TRACE_EVENT_INSTANT = 'i'
+};
+
+#ifdef ARDUINO
+typedef uint32_t trace_ts_t;       // CCOUNT, wraps every ~18 s at 240 MHz
+#else
+typedef uint64_t trace_ts_t;       // steady clock nanoseconds
+#endif
+
+struct TraceRecord {
+    trace_ts_t timestamp;
+    const char* name;
+    uint8_t type;
+};
+
+class Trace {
+public:
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void clear();
+
+    // Raw dump: a header, the name table and every record as hex lines between
+    // TRACE-BEGIN / TRACE-END markers. tools/trace_to_chrome.py turns it into
+    // Chrome trace-event JSON. Recording is paused while dumping.
+#ifdef ARDUINO
+    static void dump(Print& out);
+#else
+    static void dump(FILE* out);
+    // Host builds write Chrome/Perfetto JSON directly.
+    static bool writeChromeJson(const char* path);
+#endif
+
+    static inline void record(uint8_t type, const char* name) {
+        if (!enabled_.load(std::memory_order_relaxed)) return;
+        Lane& lane = lanes_[currentLane()];
+        uint32_t index = lane.head.fetch_add(1, std::memory_order_relaxed);
+        TraceRecord& rec = lane.records[index & (TRACE_BUFFER_RECORDS - 1)];
+        rec.timestamp = now();
+        rec.name = name;
+        rec.type = type;
+    }
+
+    static inline trace_ts_t now() {
+#if defined(ARDUINO) && defined(__XTENSA__)
+        uint32_t ccount;
+        __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+        return ccount;
+#elif defined(ARDUINO)
+        return ESP.getCycleCount();
+#else
+        return hostNowNs();
+#endif
+    }
+
+private:
+    struct Lane {
+        std::atomic<uint32_t> head;
+        TraceRecord records[TRACE_BUFFER_RECORDS];
+    };
+
+    static inline unsigned currentLane() {
+#ifdef ARDUINO
+        return xPortGetCoreID();
+#else
+        return hostLane();
+#endif
+    }
+
+#ifndef ARDUINO
+    static trace_ts_t hostNowNs();
+    static unsigned hostLane();
+#endif
+
+    static Lane lanes_[TRACE_MAX_LANES];
+    static std::atomic<bool> enabled_;
+};
+
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name_(name) { Trace::record(TRACE_EVENT_BEGIN, name_); }
+    ~TraceSpan() { Trace::record(TRACE_EVENT_END, name_); }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(name)
+#define TRACE_INSTANT(name) Trace::record(TRACE_EVENT_INSTANT, name)
+
+#else
+
+#define TRACE_SPAN(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+
+#endif // ENABLE_TRACE
+
+#endif
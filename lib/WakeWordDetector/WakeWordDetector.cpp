@@ -5,130 +5,470 @@
 #include "esp_task_wdt.h"
 #include "esp_heap_caps.h"
 #include <Arduino.h>
+#include "Trace.h"
+#include "Logger.h"
 
-WakeWordDetector::WakeWordDetector() 
-    : audio_capture(nullptr), audio_processor(nullptr), dscnn(nullptr), 
-      detection_count(0), last_detection_time(0), confidence_threshold(0.1f) {
-    memset(audio_buffer, 0, MAX_AUDIO_BUFFER_SIZE * sizeof(int16_t));
-}
+static_assert(MFCC_NUM_FRAMES * MFCC_NUM_COEFFS == KWS_FRAMES * KWS_NUM_MFCC,
+              "env.h feature shape must match the model input in frontend_params.h");
 
-WakeWordDetector::~WakeWordDetector() {
-    cleanup();
+WakeWordDetector::WakeWordDetector()
+    :
+#if AUDIO_CAPTURE_CHANNELS > 1
+      beamformer(AUDIO_CAPTURE_CHANNELS),
+#endif
+      hop_index(0), fired_keywords(0), initialized(false), history(history_storage, DETECTOR_PREROLL_SAMPLES),
+#if DETECTOR_ARCHIVE_MS > 0
+      archive(archive_storage, DETECTOR_ARCHIVE_BLOCKS),
+#endif
+      consumer(nullptr), consumer_context(nullptr), streaming(false), streamed_to(0), detection_count(0),
+      inferences_due(0), inferences_skipped(0), noise_floor(0), voice_gate(false), bench_ready(false),
+      snapshot_ready(false),
+      recording_ready(false), recording_held(false) {
+    memset(history_storage, 0, sizeof(history_storage));
+    memset(&bench, 0, sizeof(bench));
+    tuning.threshold = model.threshold();
+    tuning.stride_hops = 1;
+    tuning.vad_enabled = DETECTOR_VAD != 0;
+    tuning.vad = vad.config();
+    resetStream();
 }
 
-void WakeWordDetector::cleanup() {
-    if (audio_capture) {
-        delete audio_capture;
-        audio_capture = nullptr;
-    }
-    if (audio_processor) {
-        delete audio_processor;
-        audio_processor = nullptr;
-    }
-    if (dscnn) {
-        delete dscnn;
-        dscnn = nullptr;
-    }
+void WakeWordDetector::publishGate() {
+    noise_floor.store(vad.noiseFloor(), std::memory_order_relaxed);
+    voice_gate.store(tuning.vad_enabled, std::memory_order_relaxed);
 }
 
+WakeWordDetector::~WakeWordDetector() {}
+
 bool WakeWordDetector::init() {
     Serial.println("🧠 Initializing wake word detector...");
-    cleanup(); // Ensure clean state
+    initialized = false;
     esp_task_wdt_reset();
 
-    Serial.printf("Heap before allocations: %u bytes\n", esp_get_free_heap_size());
+    Serial.printf("Heap before init: %u bytes\n", esp_get_free_heap_size());
 
-    audio_capture = new AudioCapture();
-    if (!audio_capture) {
-        Serial.println("❌ Failed to create AudioCapture");
-        return false;
-    }
-    Serial.println("✅ Audio capture created");
-    esp_task_wdt_reset();
-
-    if (!audio_capture->init()) {
+    if (!audio_capture.init()) {
         Serial.println("❌ Audio capture initialization failed");
-        cleanup();
         return false;
     }
     Serial.println("✅ Audio capture initialized");
     esp_task_wdt_reset();
 
-    audio_processor = new AudioProcessor();
-    if (!audio_processor) {
-        Serial.println("❌ Failed to create AudioProcessor");
-        cleanup();
+    if (!initPipeline()) {
         return false;
     }
-    Serial.println("✅ Audio processor created");
-    esp_task_wdt_reset();
 
-    dscnn = new ManualDSCNN();
-    if (!dscnn) {
-        Serial.println("❌ Failed to create ManualDSCNN");
-        cleanup();
-        return false;
-    }
-    Serial.println("🧠 Initializing ManualDSCNN...");
-    esp_task_wdt_reset();
+    Serial.printf("Heap after init: %u bytes\n", esp_get_free_heap_size());
+    Serial.println("🎉 Wake word detector fully initialized");
+    return true;
+}
 
-    if (!dscnn->init()) {
+bool WakeWordDetector::initPipeline() {
+    initialized = false;
+    if (!workspace.init()) {
         Serial.println("❌ ManualDSCNN initialization failed");
-        cleanup();
         return false;
     }
     Serial.println("✅ DSCNN model initialized");
+#if DSCNN_DUAL_CORE
+    // detect() runs on core 1; capture is DMA, so core 0 is mostly idle.
+    workspace.engine.enableDualCore(0, 5);
+#endif
     esp_task_wdt_reset();
 
-    Serial.printf("Heap after allocations: %u bytes\n", esp_get_free_heap_size());
-    Serial.println("🎉 Wake word detector fully initialized");
+    keywords = KeywordBank();
+    resetStream();
+    initialized = true;
+    return true;
+}
+
+void WakeWordDetector::resetStream() {
+    stream.reset();
+    for (int k = 0; k < KWS_MAX_KEYWORDS; k++) tracks[k].reset();
+    hop_index = 0;
+    fired_keywords = 0;
+    vad.reset();
+    publishGate();
+    history.reset();
+#if DETECTOR_ARCHIVE_MS > 0
+    archive.reset();
+#endif
+    streaming = false;
+    streamed_to = 0;
+}
+
+int WakeWordDetector::addKeyword(const KeywordSpec& spec) {
+    if (!initialized) {
+        LOG_ERROR("⚠️ Detector components not initialized");
+        return -1;
+    }
+    const int k = keywords.add(spec, workspace.engine, model.frontend());
+    if (k < 0) return -1;
+    tracks[k].reset();
+    Serial.printf("✅ Keyword %d: %s, busiest hop %u keyword MACs\n", k + 1, spec.name,
+                  (unsigned)keywords.peakMacs());
+    return k + 1;
+}
+
+const char* WakeWordDetector::getKeywordName(int id) const {
+    if (id == 0) return "marvin"; // KWS_LABEL_MARVIN_IDX of the built-in model
+    return id > 0 && id <= keywords.count() ? keywords.spec(id - 1).name : "?";
+}
+
+void WakeWordDetector::setAudioConsumer(AudioConsumer next, void* context) {
+    consumer = next;
+    consumer_context = context;
+    streaming = false;
+}
+
+void WakeWordDetector::setVoiceGate(bool enabled) {
+    tuning.vad_enabled = enabled;
+    vad.reset();
+    publishGate();
+}
+
+void WakeWordDetector::tune(const DetectorTuning& next) {
+    const VadConfig& old = tuning.vad;
+    const bool gate_changed = next.vad_enabled != tuning.vad_enabled || next.vad.noise_floor != old.noise_floor ||
+                              next.vad.onset_ratio != old.onset_ratio || next.vad.zcr_threshold != old.zcr_threshold;
+    tuning = next;
+    if (tuning.stride_hops < 1) tuning.stride_hops = 1;
+    if (tuning.stride_hops > DETECTOR_MAX_STRIDE) tuning.stride_hops = DETECTOR_MAX_STRIDE;
+    model.setThreshold(tuning.threshold);
+    if (gate_changed) vad.configure(tuning.vad);
+    publishGate();
+}
+
+bool WakeWordDetector::post(const DetectorRequest& request) {
+    return requests.push(request);
+}
+
+bool WakeWordDetector::takeBench(DetectorBench& result) {
+    if (!bench_ready.load(std::memory_order_acquire)) return false;
+    result = bench;
+    bench_ready.store(false, std::memory_order_release);
+    return true;
+}
+
+bool WakeWordDetector::takeSnapshot(DetectorTuning& result) {
+    if (!snapshot_ready.load(std::memory_order_acquire)) return false;
+    result = snapshot;
+    snapshot_ready.store(false, std::memory_order_release);
+    return true;
+}
+
+void WakeWordDetector::takeSnapshotNow() {
+    snapshot = tuning;
+    // Once the gate has seen more than its hangover, its floor is measured
+    // rather than the configured guess.
+    if (tuning.vad_enabled && vad.frames() > VAD_HANGOVER_FRAMES) snapshot.vad.noise_floor = vad.noiseFloor();
+    snapshot_ready.store(true, std::memory_order_release);
+}
+
+bool WakeWordDetector::takeRecording(DetectorRecording& result) {
+    if (!recording_ready.load(std::memory_order_acquire)) return false;
+    result = recording;
+    recording_ready.store(false, std::memory_order_relaxed);
     return true;
 }
 
+void WakeWordDetector::releaseRecording() {
+    recording_held.store(false, std::memory_order_release);
+}
+
+void WakeWordDetector::recordNow() {
+    if (recording_held.load(std::memory_order_acquire)) return; // The last one is still being read
+    recording_held.store(true, std::memory_order_relaxed);
+    recording.blocks = recording_storage;
+#if DETECTOR_ARCHIVE_MS > 0
+    recording.block_count = archive.copyLatest(DETECTOR_RECORD_SAMPLES, recording_storage, recording.start);
+    recording.samples = (uint32_t)(archive.end() - recording.start);
+#else
+    // The pre-roll stays raw for zero-copy consumers; only the copy is
+    // compressed.
+    const uint64_t held = history.end() - history.begin();
+    const uint64_t from = history.end() - (held < DETECTOR_RECORD_SAMPLES ? held : DETECTOR_RECORD_SAMPLES);
+    AudioSpans spans;
+    history.view(from, history.end(), spans);
+    AdpcmEncoder& encoder = record_encoder;
+    encoder.reset();
+    size_t blocks = encoder.encode(spans.first, spans.first_count, recording_storage);
+    blocks += encoder.encode(spans.second, spans.second_count, recording_storage + blocks * ADPCM_BLOCK_BYTES);
+    blocks += encoder.flush(recording_storage + blocks * ADPCM_BLOCK_BYTES);
+    recording.block_count = blocks;
+    recording.start = from;
+    recording.samples = (uint32_t)(history.end() - from);
+#endif
+    recording_ready.store(true, std::memory_order_release);
+}
+
+const AdpcmHistory* WakeWordDetector::getArchive() const {
+#if DETECTOR_ARCHIVE_MS > 0
+    return &archive;
+#else
+    return nullptr;
+#endif
+}
+
+void WakeWordDetector::serviceRequests() {
+    DetectorRequest request;
+    while (requests.pop(request)) {
+        switch (request.type) {
+        case DETECTOR_REQUEST_TUNE:
+            tune(request.tuning);
+            break;
+        case DETECTOR_REQUEST_BENCH:
+            runBench(request.repetitions);
+            break;
+        case DETECTOR_REQUEST_RESET_STATS:
+            resetStats();
+            break;
+        case DETECTOR_REQUEST_SNAPSHOT:
+            takeSnapshotNow();
+            break;
+        case DETECTOR_REQUEST_RECORD:
+            recordNow();
+            break;
+        }
+    }
+}
+
+// Times each stage on copies of the live data (the last hop, the current
+// feature state and window), so the stream itself is left untouched. Audio
+// arriving meanwhile is lost to the DMA ring, like any other stall.
+void WakeWordDetector::runBench(uint16_t repetitions) {
+    if (repetitions < 1) repetitions = 1;
+    if (repetitions > DETECTOR_BENCH_MAX_REPETITIONS) repetitions = DETECTOR_BENCH_MAX_REPETITIONS;
+    TRACE_SPAN("bench");
+    int16_t* hop = bench_scratch.hop;
+    FeatureState& features = bench_scratch.features;
+    int8_t* window = bench_scratch.window;
+    VoiceActivity& gate = bench_scratch.gate;
+    gate.configure(tuning.vad);
+    AudioProcessor::copyFeatures(stream.features, window);
+    AudioSpans last = {};
+    const uint64_t from = history.end() > DETECTOR_HOP_SAMPLES ? history.end() - DETECTOR_HOP_SAMPLES : 0;
+    history.view(from < history.begin() ? history.begin() : from, history.end(), last);
+
+    uint32_t total[5] = {};
+    for (uint16_t r = 0; r < repetitions; r++) {
+        memset(hop, 0, sizeof(bench_scratch.hop));
+        memcpy(hop, last.first, last.first_count * sizeof(int16_t));
+        if (last.second) memcpy(hop + last.first_count, last.second, last.second_count * sizeof(int16_t));
+        features = stream.features;
+        uint32_t t = micros();
+        AudioCapture::condition(hop, DETECTOR_HOP_SAMPLES);
+        uint32_t now = micros();
+        total[0] += now - t;
+        t = now;
+        AudioProcessor::process(features, model.frontend(), workspace.mfcc, hop, DETECTOR_HOP_SAMPLES);
+        now = micros();
+        total[1] += now - t;
+        t = now;
+        gate.update(hop, DETECTOR_HOP_SAMPLES);
+        now = micros();
+        total[2] += now - t;
+        t = now;
+        workspace.engine.infer(window, bench_scratch.posteriors);
+        now = micros();
+        total[3] += now - t;
+        t = now;
+        for (int k = 0; k < keywords.count(); k++) {
+            bench_scratch.track = tracks[k];
+            keywords.infer(k, stream, workspace, bench_scratch.track);
+        }
+        total[4] += micros() - t;
+        esp_task_wdt_reset();
+    }
+
+    bench.repetitions = repetitions;
+    bench.condition_us = total[0] / repetitions;
+    bench.features_us = total[1] / repetitions;
+    bench.vad_us = total[2] / repetitions;
+    bench.inference_us = total[3] / repetitions;
+    bench.keywords_us = total[4] / repetitions;
+    bench_ready.store(true, std::memory_order_release);
+}
+
 bool WakeWordDetector::detect() {
-    if (!audio_capture || !audio_processor || !dscnn) {
-        Serial.println("⚠️ Detector components not initialized");
+    TRACE_SPAN("detect");
+    if (!initialized) {
+        LOG_ERROR("⚠️ Detector components not initialized");
         return false;
     }
 
-    size_t total_samples = 1000; // Match testAudioCapture
-    if (!audio_capture->read(audio_buffer, total_samples)) {
-        Serial.println("⚠️ Audio capture failed");
+    uint32_t hop_start = micros();
+    int16_t* hop = history.reserve(DETECTOR_HOP_SAMPLES);
+#if AUDIO_CAPTURE_CHANNELS > 1
+    int16_t* frames = capture_frames;
+#else
+    int16_t* frames = hop;
+#endif
+    if (!audio_capture.capture(frames, DETECTOR_HOP_SAMPLES)) {
+        LOG_ERROR("⚠️ Audio capture failed");
         return false;
     }
-    esp_task_wdt_reset();
+    uint32_t t = micros();
+    latency[STAGE_CAPTURE_WAIT].record(t - hop_start);
 
-    int8_t mfcc_output[MFCC_NUM_FRAMES * MFCC_NUM_COEFFS];
-    audio_processor->computeMFCC(audio_buffer, mfcc_output);
+#if AUDIO_CAPTURE_CHANNELS > 1
+    // Counted as conditioning: it runs ahead of the gain, on the same hop.
+    beamformer.process(frames, DETECTOR_HOP_SAMPLES, hop);
+#endif
+    AudioCapture::condition(hop, DETECTOR_HOP_SAMPLES);
+    history.commit(DETECTOR_HOP_SAMPLES);
+    latency[STAGE_CONDITIONING].record(micros() - t);
     esp_task_wdt_reset();
 
-    float confidence = dscnn->predict(mfcc_output);
-    bool detected = confidence > confidence_threshold;
+    bool fired = process(hop, DETECTOR_HOP_SAMPLES);
+    latency[STAGE_HOP].record(micros() - hop_start);
+    return fired;
+}
 
-    if (detected && (millis() - last_detection_time) > DETECTION_COOLDOWN_MS) {
-        detection_count++;
-        last_detection_time = millis();
-        return true;
+bool WakeWordDetector::processAudio(const int16_t* samples, size_t count) {
+    if (!initialized) {
+        LOG_ERROR("⚠️ Detector components not initialized");
+        return false;
+    }
+    history.append(samples, count);
+    return process(samples, count);
+}
+
+bool WakeWordDetector::process(const int16_t* samples, size_t count) {
+
+    // The Model steps are timed individually; a hop normally holds exactly
+    // one inference, but any chunking works. The gate measures the same
+    // samples feed() consumed, so its verdict is current when one is due.
+    // Keywords due on the hop run right after the built-in model, on the
+    // same features.
+#if DETECTOR_ARCHIVE_MS > 0
+    archive.append(samples, count);
+#endif
+    serviceRequests();
+    bool fired = false;
+    uint64_t detection_sample = 0;
+    fired_keywords = 0;
+    while (count > 0) {
+        uint32_t t = micros();
+        const int16_t* consumed = samples;
+        bool due = model.feed(stream, workspace, samples, count);
+        if (tuning.vad_enabled) {
+            vad.update(consumed, samples - consumed);
+            noise_floor.store(vad.noiseFloor(), std::memory_order_relaxed);
+        }
+        uint32_t stage_end = micros();
+        latency[STAGE_FEATURES].record(stage_end - t);
+        if (!due) break;
+        t = stage_end;
+
+        const uint32_t hop = hop_index++;
+        const bool primary_due = hop % tuning.stride_hops == 0;
+        int runs = primary_due ? 1 : 0;
+        for (int k = 0; k < keywords.count(); k++) {
+            if (keywords.due(k, hop)) runs++;
+        }
+        if (runs == 0) continue;
+        inferences_due.fetch_add(runs, std::memory_order_relaxed);
+        if (tuning.vad_enabled && !vad.active()) {
+            inferences_skipped.fetch_add(runs, std::memory_order_relaxed);
+            continue;
+        }
+
+        bool primary = primary_due && model.infer(stream, workspace);
+        bool keyword_ran[KWS_MAX_KEYWORDS] = {};
+        for (int k = 0; k < keywords.count(); k++) {
+            keyword_ran[k] = keywords.due(k, hop) && keywords.infer(k, stream, workspace, tracks[k]);
+        }
+        stage_end = micros();
+        latency[STAGE_INFERENCE].record(stage_end - t);
+        t = stage_end;
+
+        if (!fired) detection_sample = stream.samples_processed;
+        if (primary && model.decide(stream)) {
+            detection_count.fetch_add(1, std::memory_order_relaxed);
+            fired_keywords |= 1u;
+            fired = true;
+        }
+        for (int k = 0; k < keywords.count(); k++) {
+            if (keyword_ran[k] && keywords.decide(k, stream, tracks[k])) {
+                detection_count.fetch_add(1, std::memory_order_relaxed);
+                fired_keywords |= 1u << (k + 1);
+                fired = true;
+            }
+        }
+        latency[STAGE_POSTPROCESS].record(micros() - t);
     }
-    return false;
+    if (consumer) handOff(fired, detection_sample);
+    return fired;
+}
+
+// The history holds every sample process() has seen (the hop included), so
+// a detection's pre-roll and the stream after it come from the same ring,
+// back to back.
+void WakeWordDetector::handOff(bool fired, uint64_t detection_sample) {
+    if (!fired && !streaming) return;
+    AudioEvent event = {};
+    event.type = fired ? AUDIO_EVENT_DETECTION : AUDIO_EVENT_STREAM;
+    if (fired) {
+        event.keywords = fired_keywords;
+        event.keyword_end = detection_sample;
+        event.keyword_start = detection_sample > KWS_WINDOW_SAMPLES ? detection_sample - KWS_WINDOW_SAMPLES : 0;
+    }
+    // A consumer that is already streaming carries on where it was, unless
+    // the ring came round first.
+    uint64_t from = history.begin();
+    if (streaming && streamed_to > from) from = streamed_to;
+    else if (streaming) event.skipped = from - streamed_to;
+    if (!fired && from == history.end()) return;
+    history.view(from, history.end(), event.audio);
+    streamed_to = history.end();
+    TRACE_SPAN("handoff");
+    streaming = consumer(event, consumer_context);
+}
+
+void WakeWordDetector::getStats(DetectorStats& stats) const {
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        stats.stages[i] = latency[i].snapshot();
+    }
+    stats.detections = detection_count.load(std::memory_order_relaxed);
+    stats.inferences_due = inferences_due.load(std::memory_order_relaxed);
+    stats.inferences_skipped = inferences_skipped.load(std::memory_order_relaxed);
+    stats.noise_floor = noise_floor.load(std::memory_order_relaxed);
+    stats.voice_gate = voice_gate.load(std::memory_order_relaxed);
+}
+
+void WakeWordDetector::resetStats() {
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        latency[i].reset();
+    }
+    inferences_due.store(0, std::memory_order_relaxed);
+    inferences_skipped.store(0, std::memory_order_relaxed);
+}
+
+const char* WakeWordDetector::stageName(int stage) {
+    static const char* const names[STAGE_COUNT] = {
+        "capture", "condition", "features", "inference", "postproc", "hop"
+    };
+    return stage >= 0 && stage < STAGE_COUNT ? names[stage] : "?";
 }
 
 void WakeWordDetector::setThreshold(float threshold) {
-    confidence_threshold = threshold;
+    tuning.threshold = threshold;
+    model.setThreshold(threshold);
 }
 
 float WakeWordDetector::getThreshold() const {
-    return confidence_threshold;
+    return model.threshold();
 }
 
 int WakeWordDetector::getDetectionCount() const {
-    return detection_count;
+    return detection_count.load(std::memory_order_relaxed);
 }
 
 void WakeWordDetector::resetDetectionCount() {
-    detection_count = 0;
+    detection_count.store(0, std::memory_order_relaxed);
 }
 
 bool WakeWordDetector::isInitialized() const {
-    return audio_capture && audio_processor && dscnn;
+    return initialized;
 }
\ No newline at end of file
@@ -1,33 +1,287 @@
 #ifndef WAKEWORDDETECTOR_H
 #define WAKEWORDDETECTOR_H
+#include <atomic>
 #include "AudioCapture.h"
-#include "AudioProcessor.h"
-#include "ManualDSCNN.h"
+#include "AdpcmHistory.h"
+#include "AudioHistory.h"
+#include "Beamformer.h"
+#include "Model.h"
+#include "KeywordBank.h"
+#include "LatencyHistogram.h"
+#include "MpscQueue.h"
+#include "VoiceActivity.h"
 #include "env.h"
 
+// 1 = skip inference while the voice-activity gate sees only noise (features
+// are still computed, so the window is complete when speech starts).
+#ifndef DETECTOR_VAD
+#define DETECTOR_VAD 1
+#endif
+
+// Audio kept for detection consumers (setAudioConsumer), rounded up to
+// whole hops. The ring doubles as the capture buffer, so at least one hop.
+#ifndef DETECTOR_PREROLL_MS
+#define DETECTOR_PREROLL_MS 1500
+#endif
+#define DETECTOR_PREROLL_HOPS \
+    ((DETECTOR_PREROLL_MS * KWS_SAMPLE_RATE_HZ / 1000 + DETECTOR_HOP_SAMPLES - 1) / DETECTOR_HOP_SAMPLES)
+#define DETECTOR_PREROLL_SAMPLES \
+    ((DETECTOR_PREROLL_HOPS > 0 ? DETECTOR_PREROLL_HOPS : 1) * DETECTOR_HOP_SAMPLES)
+
+// Optional compressed history of the conditioned stream (getArchive()), in
+// whole IMA-ADPCM blocks; 0 keeps none. It holds four times the audio of the
+// raw pre-roll per byte: 10 s takes 81 KB.
+#ifndef DETECTOR_ARCHIVE_MS
+#define DETECTOR_ARCHIVE_MS 0
+#endif
+#define DETECTOR_ARCHIVE_BLOCKS \
+    ((DETECTOR_ARCHIVE_MS * KWS_SAMPLE_RATE_HZ / 1000 + ADPCM_BLOCK_SAMPLES - 1) / ADPCM_BLOCK_SAMPLES)
+
+// Audio a debug recording covers (DETECTOR_REQUEST_RECORD): the latest of
+// the archive when there is one, else of the pre-roll.
+#ifndef DETECTOR_RECORD_MS
+#define DETECTOR_RECORD_MS DETECTOR_PREROLL_MS
+#endif
+#define DETECTOR_RECORD_SAMPLES (DETECTOR_RECORD_MS * KWS_SAMPLE_RATE_HZ / 1000)
+#define DETECTOR_RECORD_BLOCKS (DETECTOR_RECORD_SAMPLES / ADPCM_BLOCK_SAMPLES + 2)
+
+// Stages timed on every detect() call, in pipeline order.
+enum DetectorStage {
+    STAGE_CAPTURE_WAIT,   // Blocked on I2S DMA
+    STAGE_CONDITIONING,   // Gain
+    STAGE_FEATURES,       // MFCC
+    STAGE_INFERENCE,      // DS-CNN
+    STAGE_POSTPROCESS,    // Threshold + cooldown
+    STAGE_HOP,            // End to end, capture start to decision
+    STAGE_COUNT
+};
+
+struct DetectorStats {
+    LatencySnapshot stages[STAGE_COUNT];
+    int detections;
+    uint32_t inferences_due;     // Model runs the hops called for (built-in and keywords)
+    uint32_t inferences_skipped; // ... of which the gate skipped
+    uint32_t noise_floor;        // Mean square per frame
+    bool voice_gate;             // Gate enabled
+};
+
+// Parameters that can change while the detector runs. They are replaced as
+// a whole, between hops, so no inference sees half an update.
+struct DetectorTuning {
+    float threshold;
+    uint8_t stride_hops; // The built-in model runs on every Nth due hop (1..DETECTOR_MAX_STRIDE)
+    bool vad_enabled;
+    VadConfig vad;
+};
+
+#define DETECTOR_MAX_STRIDE 8
+#define DETECTOR_BENCH_MAX_REPETITIONS 50
+#define DETECTOR_REQUEST_QUEUE 4 // Power of two
+
+// In-place micro-benchmark of each stage on the live stream's data; mean
+// microseconds per call.
+struct DetectorBench {
+    uint16_t repetitions;
+    uint32_t condition_us; // Gain over one hop
+    uint32_t features_us;  // MFCC frames of one hop
+    uint32_t vad_us;       // Gate over one hop
+    uint32_t inference_us; // Built-in model on the current window
+    uint32_t keywords_us;  // Every added keyword model once
+};
+
+enum DetectorRequestType : uint8_t {
+    DETECTOR_REQUEST_TUNE,        // Replace the tuning
+    DETECTOR_REQUEST_BENCH,       // Run a DetectorBench
+    DETECTOR_REQUEST_RESET_STATS,
+    DETECTOR_REQUEST_SNAPSHOT,    // Copy the tuning, with the gate's learned floor
+    DETECTOR_REQUEST_RECORD       // Encode a DetectorRecording
+};
+
+struct DetectorRequest {
+    DetectorRequestType type;
+    uint16_t repetitions;  // DETECTOR_REQUEST_BENCH
+    DetectorTuning tuning; // DETECTOR_REQUEST_TUNE
+};
+
+// The latest DETECTOR_RECORD_MS of conditioned audio as IMA-ADPCM blocks
+// (Adpcm.h), in the detector's storage until releaseRecording().
+struct DetectorRecording {
+    const uint8_t* blocks;
+    size_t block_count;
+    uint64_t start;   // Stream position of the first block's first sample
+    uint32_t samples; // Real samples from `start`; the last block is padded
+};
+
+enum AudioEventType : uint8_t {
+    AUDIO_EVENT_DETECTION, // A keyword fired; audio is the pre-roll up to now
+    AUDIO_EVENT_STREAM     // Audio that followed the previous event
+};
+
+// What a consumer gets: views into the detector's history, valid for the
+// duration of the call (and until the ring comes round, about
+// DETECTOR_PREROLL_MS later). Positions are stream positions, the same
+// ones as StreamState::samples_processed.
+struct AudioEvent {
+    AudioEventType type;
+    uint32_t keywords;      // DETECTION: as getFiredKeywords()
+    uint64_t keyword_start; // DETECTION: the window the model fired on,
+    uint64_t keyword_end;   // [start, end); end is the first detection's position
+    AudioSpans audio;       // Starts where the previous event's audio ended, when streaming
+    // Streaming: samples lost between the previous event's audio and this
+    // one's, when the ring came round in between (a processAudio() chunk
+    // longer than DETECTOR_PREROLL_SAMPLES).
+    uint64_t skipped;
+};
+
+// Runs on the detector's task, after the hop's decisions. Returns true to
+// be handed the audio that follows, hop by hop, until it returns false.
+typedef bool (*AudioConsumer)(const AudioEvent& event, void* context);
+
+// Single-stream detector for the device: one microphone, one Model, one
+// StreamState and one Workspace. detect() captures one hop of audio per call.
+// Multi-stream hosts use StreamRunner over the same Model instead, and
+// products that need another chain compose one from lib/Pipeline.
+//
+// Further keyword models (addKeyword) share the stream's features and the
+// engine: each costs its network, run at its own cadence, never another
+// front end.
 class WakeWordDetector {
 public:
     WakeWordDetector();
     ~WakeWordDetector();
     bool init();
+    // Everything but the microphone, for replaying recorded audio.
+    bool initPipeline();
     bool detect();
+    // Runs already-conditioned audio through features, inference and the
+    // trigger logic, keeping a copy in the history. Returns true when the
+    // wake word or a keyword fires (getFiredKeywords() says which).
+    bool processAudio(const int16_t* samples, size_t count);
+    // After initPipeline(), which drops any added before. Returns the keyword's id (>= 1; 0 is the built-in
+    // wake word), or -1 when the model is rejected.
+    int addKeyword(const KeywordSpec& spec);
+    int getKeywordCount() const { return 1 + keywords.count(); }
+    const char* getKeywordName(int id) const;
+    const KeywordBank& getKeywordBank() const { return keywords; }
+    // Latest state of keyword `id` >= 1 (the built-in one is getStream()).
+    const KeywordTrack& getKeywordTrack(int id) const { return tracks[id - 1]; }
+    // Bit `id` set for every keyword that fired in the last processAudio().
+    uint32_t getFiredKeywords() const { return fired_keywords; }
+    // Starts a new stream: clears feature history and the cooldown.
+    void resetStream();
+    // Voice-activity gate (on by default with DETECTOR_VAD); disabling it
+    // runs every inference again.
+    void setVoiceGate(bool enabled);
+    bool voiceGateEnabled() const { return tuning.vad_enabled; }
+    const VoiceActivity& getVoiceActivity() const { return vad; }
     void setThreshold(float threshold);
     float getThreshold() const;
+    // From the task that runs the detector. Other tasks post() instead.
+    void tune(const DetectorTuning& tuning);
+    const DetectorTuning& getTuning() const { return tuning; }
+    // From any task: queued, and carried out by processAudio() before its
+    // next hop. False when the queue is full.
+    bool post(const DetectorRequest& request);
+    // From any task: the result of the last DETECTOR_REQUEST_BENCH, once.
+    bool takeBench(DetectorBench& bench);
+    // From any task: the result of the last DETECTOR_REQUEST_SNAPSHOT, once.
+    // A tuning that, applied at boot, resumes where this run is now.
+    bool takeSnapshot(DetectorTuning& snapshot);
+    // From any task: the result of the last DETECTOR_REQUEST_RECORD, once.
+    // Its blocks stay put until releaseRecording(); requests to record
+    // meanwhile are dropped.
+    bool takeRecording(DetectorRecording& recording);
+    void releaseRecording();
     int getDetectionCount() const;
     void resetDetectionCount();
     bool isInitialized() const;
-    AudioProcessor* getAudioProcessor() const { return audio_processor; }
-    int16_t* getAudioBuffer() { return audio_buffer; }
+    void getStats(DetectorStats& stats) const;
+    void resetStats();
+    static const char* stageName(int stage);
+    // Posteriors of the latest inference and how many have run.
+    const float* getLastProbabilities() const { return stream.posteriors; }
+    uint32_t getInferenceCount() const { return stream.inference_count; }
+    const StreamState& getStream() const { return stream; }
+    const Model& getModel() const { return model; }
+    // Hands detections and the audio around them to `consumer` (nullptr
+    // stops). From the task that runs the detector.
+    void setAudioConsumer(AudioConsumer consumer, void* context);
+    // Conditioned audio of the stream, the latest DETECTOR_PREROLL_SAMPLES.
+    const AudioHistory& getAudioHistory() const { return history; }
+    // The same audio further back, compressed; nullptr unless built with
+    // DETECTOR_ARCHIVE_MS. From the task that runs the detector.
+    const AdpcmHistory* getArchive() const;
 
 private:
-    AudioCapture* audio_capture;
-    AudioProcessor* audio_processor;
-    ManualDSCNN* dscnn;
-    int16_t audio_buffer[MAX_AUDIO_BUFFER_SIZE];
-    int detection_count;
-    unsigned long last_detection_time;
-    float confidence_threshold;
-    void cleanup();
+    // Copies runBench() works on, kept off the detector task's stack.
+    struct BenchScratch {
+        int16_t hop[DETECTOR_HOP_SAMPLES];
+        FeatureState features;
+        int8_t window[KWS_FRAMES * KWS_NUM_MFCC];
+        float posteriors[DSCNN_MAX_CLASSES];
+        VoiceActivity gate;
+        KeywordTrack track;
+    };
+
+    // Components live inside the detector (itself statically allocated), so
+    // nothing is taken from the heap after boot.
+    AudioCapture audio_capture;
+#if AUDIO_CAPTURE_CHANNELS > 1
+    // Interleaved capture, beamformed into the history.
+    int16_t capture_frames[DETECTOR_HOP_SAMPLES * AUDIO_CAPTURE_CHANNELS];
+    Beamformer beamformer;
+#endif
+    Model model;
+    Workspace workspace;
+    StreamState stream;
+    KeywordBank keywords;
+    KeywordTrack tracks[KWS_MAX_KEYWORDS];
+    uint32_t hop_index; // Due hops since resetStream(), for keyword cadences
+    uint32_t fired_keywords;
+    VoiceActivity vad;
+    DetectorTuning tuning;
+    bool initialized;
+    // detect() captures straight into the history, so the pre-roll costs no
+    // buffer besides itself and consumers read it in place.
+    int16_t history_storage[DETECTOR_PREROLL_SAMPLES];
+    AudioHistory history;
+#if DETECTOR_ARCHIVE_MS > 0
+    uint8_t archive_storage[DETECTOR_ARCHIVE_BLOCKS * ADPCM_BLOCK_BYTES];
+    AdpcmHistory archive;
+#endif
+    AudioConsumer consumer;
+    void* consumer_context;
+    bool streaming;       // The consumer asked for more
+    uint64_t streamed_to; // End of the audio it has been given
+    // What getStats() reads from other tasks: only the detector's task
+    // writes them, relaxed, like the latency histograms.
+    std::atomic<int> detection_count;
+    std::atomic<uint32_t> inferences_due;
+    std::atomic<uint32_t> inferences_skipped;
+    std::atomic<uint32_t> noise_floor; // vad.noiseFloor() as of the last hop
+    std::atomic<bool> voice_gate;      // tuning.vad_enabled
+    LatencyHistogram latency[STAGE_COUNT];
+    MpscQueue<DetectorRequest, DETECTOR_REQUEST_QUEUE> requests;
+    DetectorBench bench;
+    BenchScratch bench_scratch;
+    std::atomic<bool> bench_ready;
+    DetectorTuning snapshot;
+    std::atomic<bool> snapshot_ready;
+    uint8_t recording_storage[DETECTOR_RECORD_BLOCKS * ADPCM_BLOCK_BYTES];
+#if DETECTOR_ARCHIVE_MS == 0
+    AdpcmEncoder record_encoder; // Compresses the pre-roll copy
+#endif
+    DetectorRecording recording;
+    std::atomic<bool> recording_ready;
+    std::atomic<bool> recording_held; // Until releaseRecording()
+
+    bool process(const int16_t* samples, size_t count);
+    void handOff(bool fired, uint64_t detection_sample);
+    void serviceRequests();
+    void runBench(uint16_t repetitions);
+    void takeSnapshotNow();
+    void recordNow();
+    void publishGate();
 };
 
 #endif
\ No newline at end of file
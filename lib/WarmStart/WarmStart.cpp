@@ -0,0 +1,114 @@
+#include "WarmStart.h"
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <Arduino.h>
+#include <Preferences.h>
+#include "Logger.h"
+
+namespace {
+
+const uint32_t kMagic = 0x4D575331; // "MWS1"
+
+struct WarmRecord {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size; // sizeof(DetectorTuning) when written
+    DetectorTuning tuning;
+    uint32_t checksum; // FNV-1a over everything above
+};
+
+uint32_t checksum(const WarmRecord& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(WarmRecord, checksum); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// The same limits the console enforces, so a corrupt or foreign record can
+// never put the detector somewhere it could not be tuned to.
+bool plausible(const DetectorTuning& tuning) {
+    return std::isfinite(tuning.threshold) && tuning.threshold >= 0.0f && tuning.threshold <= 1.0f &&
+           tuning.stride_hops >= 1 && tuning.stride_hops <= DETECTOR_MAX_STRIDE &&
+           std::isfinite(tuning.vad.onset_ratio) && tuning.vad.onset_ratio >= 1.0f;
+}
+
+bool sameSettings(const DetectorTuning& a, const DetectorTuning& b) {
+    return a.threshold == b.threshold && a.stride_hops == b.stride_hops && a.vad_enabled == b.vad_enabled &&
+           a.vad.onset_ratio == b.vad.onset_ratio && a.vad.zcr_threshold == b.vad.zcr_threshold;
+}
+
+} // namespace
+
+WarmStart::WarmStart(WakeWordDetector& detector)
+    : detector_(detector), saved_(), have_saved_(false), pending_(false), last_poll_ms_(0), last_save_ms_(0) {}
+
+bool WarmStart::restore() {
+    WarmRecord record;
+    Preferences preferences;
+    if (!preferences.begin(WARM_START_NAMESPACE, true)) return false;
+    const size_t length = preferences.getBytes(WARM_START_KEY, &record, sizeof(record));
+    preferences.end();
+    last_poll_ms_ = last_save_ms_ = millis();
+    if (length == 0) {
+        LOG_INFO("🧊 Cold start: no warm state saved");
+        return false;
+    }
+    if (length != sizeof(record) || record.magic != kMagic || record.version != WARM_START_VERSION ||
+        record.size != sizeof(DetectorTuning) || record.checksum != checksum(record) || !plausible(record.tuning)) {
+        LOG_ERROR("⚠️ Warm state unreadable or from another build; starting cold");
+        return false;
+    }
+    detector_.tune(record.tuning);
+    saved_ = record.tuning;
+    have_saved_ = true;
+    LOG_INFO("♻️ Warm start: threshold %.3f, cadence %u, VAD %s, floor %u",
+             record.tuning.threshold, (unsigned)record.tuning.stride_hops, record.tuning.vad_enabled ? "on" : "off",
+             (unsigned)record.tuning.vad.noise_floor);
+    return true;
+}
+
+void WarmStart::poll() {
+    const uint32_t now = millis();
+    DetectorTuning snapshot;
+    if (pending_ && detector_.takeSnapshot(snapshot)) {
+        pending_ = false;
+        const bool changed = !have_saved_ || !sameSettings(snapshot, saved_);
+        const bool drifted = snapshot.vad.noise_floor != saved_.vad.noise_floor;
+        if (changed || (drifted && now - last_save_ms_ >= WARM_START_SAVE_MS)) save(snapshot);
+    }
+    if (!pending_ && now - last_poll_ms_ >= WARM_START_POLL_MS) {
+        DetectorRequest request = {};
+        request.type = DETECTOR_REQUEST_SNAPSHOT;
+        pending_ = detector_.post(request);
+        last_poll_ms_ = now;
+    }
+}
+
+bool WarmStart::save(const DetectorTuning& tuning) {
+    // Zeroed first so padding is deterministic and the checksum repeatable.
+    WarmRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = kMagic;
+    record.version = WARM_START_VERSION;
+    record.size = sizeof(DetectorTuning);
+    record.tuning = tuning;
+    record.checksum = checksum(record);
+
+    Preferences preferences;
+    if (!preferences.begin(WARM_START_NAMESPACE, false)) return false;
+    const bool ok = preferences.putBytes(WARM_START_KEY, &record, sizeof(record)) == sizeof(record);
+    preferences.end();
+    last_save_ms_ = millis();
+    if (!ok) {
+        LOG_ERROR("⚠️ Could not save warm state");
+        return false;
+    }
+    saved_ = tuning;
+    have_saved_ = true;
+    LOG_VERBOSE("💾 Warm state saved (floor %u)", (unsigned)tuning.vad.noise_floor);
+    return true;
+}
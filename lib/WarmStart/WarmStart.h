@@ -0,0 +1,44 @@
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include <cstddef>
+#include <cstdint>
+#include "WakeWordDetector.h"
+
+#define WARM_START_NAMESPACE "marvin" // NVS namespace (a file under .nvs/ natively)
+#define WARM_START_KEY "warm"
+#define WARM_START_VERSION 1
+#define WARM_START_POLL_MS 10000      // Between snapshots of the running detector
+#define WARM_START_SAVE_MS 600000     // Least time between writes for floor drift alone
+
+// Keeps the state a detector learns while it runs (the console's threshold,
+// cadence and gate settings, and the gate's measured noise floor) in NVS, so
+// a reboot resumes with it instead of relearning. The record is versioned
+// and checksummed; anything that does not validate is a cold start.
+//
+// Tuning changes are written at the next poll; the floor alone only every
+// WARM_START_SAVE_MS, which keeps flash wear to a few writes an hour.
+class WarmStart {
+public:
+    explicit WarmStart(WakeWordDetector& detector);
+
+    // After the detector is initialized, before its task starts (and before
+    // Console::begin(), which takes the tuning it leaves). False when there
+    // was nothing valid to restore.
+    bool restore();
+    // From a low-priority task, about once a second: requests a snapshot
+    // every WARM_START_POLL_MS and saves it when it is worth a write.
+    void poll();
+
+private:
+    bool save(const DetectorTuning& tuning);
+
+    WakeWordDetector& detector_;
+    DetectorTuning saved_; // As last restored or written
+    bool have_saved_;
+    bool pending_;         // A snapshot was requested and not yet taken
+    uint32_t last_poll_ms_;
+    uint32_t last_save_ms_;
+};
+
+#endif
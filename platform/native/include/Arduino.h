@@ -0,0 +1,81 @@
+#pragma once
+// Native (host) stand-in for the Arduino-ESP32 core: just enough of Print,
+// Serial, timing and the ESP object for the libraries in lib/ to build and
+// run on Linux.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// Arduino's min/max accept mixed argument types.
+template<typename A, typename B>
+inline typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; }
+template<typename A, typename B>
+inline typename std::common_type<A, B>::type max(A a, B b) { return a > b ? a : b; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+uint32_t getCpuFrequencyMhz();
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+    size_t println() { return write("\r\n"); }
+    template<typename T>
+    size_t println(T value) { size_t n = print(value); return n + println(); }
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud);
+    void end() {}
+    int available();       // non-blocking look at stdin
+    int read();            // -1 when nothing is pending
+    void flush();
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    uint32_t getFreeHeap() { return esp_get_free_heap_size(); }
+    uint32_t getMinFreeHeap() { return esp_get_minimum_free_heap_size(); }
+    uint32_t getHeapSize() { return NATIVE_HEAP_SIZE; }
+    void restart() { esp_restart(); }
+};
+
+extern EspClass ESP;
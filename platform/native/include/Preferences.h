@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// NVS stand-in: each key is a file <dir>/<namespace>.<key>, with <dir> from
+// $MARVIN_NVS_DIR (default .nvs, created on first write). Only the byte
+// accessors the firmware uses.
+class Preferences {
+public:
+    bool begin(const char* name, bool read_only = false);
+    void end();
+    size_t putBytes(const char* key, const void* value, size_t length);
+    size_t getBytes(const char* key, void* buffer, size_t max_length);
+    size_t getBytesLength(const char* key);
+    bool remove(const char* key);
+
+private:
+    std::string path(const char* key) const;
+
+    std::string name_;
+    bool open_ = false;
+    bool read_only_ = false;
+};
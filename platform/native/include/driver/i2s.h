@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+// I2S for the native build. Reads are served from a pluggable sample source:
+// by default the WAV named by $MARVIN_AUDIO_WAV (looped), otherwise silence.
+// A port installed as I2S_CHANNEL_FMT_RIGHT_LEFT delivers interleaved stereo
+// frames (a mono file feeds both slots), any other format the first channel.
+// Reads are paced at the configured sample rate unless real-time pacing is
+// switched off, so the detector sees the same blocking behaviour as on DMA.
+typedef enum { I2S_NUM_0 = 0, I2S_NUM_1 = 1, I2S_NUM_MAX } i2s_port_t;
+
+typedef enum {
+    I2S_MODE_MASTER = 1 << 0,
+    I2S_MODE_SLAVE = 1 << 1,
+    I2S_MODE_TX = 1 << 2,
+    I2S_MODE_RX = 1 << 3,
+} i2s_mode_t;
+
+typedef enum {
+    I2S_BITS_PER_SAMPLE_8BIT = 8,
+    I2S_BITS_PER_SAMPLE_16BIT = 16,
+    I2S_BITS_PER_SAMPLE_24BIT = 24,
+    I2S_BITS_PER_SAMPLE_32BIT = 32,
+} i2s_bits_per_sample_t;
+
+typedef enum {
+    I2S_CHANNEL_FMT_RIGHT_LEFT = 0,
+    I2S_CHANNEL_FMT_ALL_RIGHT,
+    I2S_CHANNEL_FMT_ALL_LEFT,
+    I2S_CHANNEL_FMT_ONLY_RIGHT,
+    I2S_CHANNEL_FMT_ONLY_LEFT,
+} i2s_channel_fmt_t;
+
+typedef enum {
+    I2S_COMM_FORMAT_STAND_I2S = 0x01,
+    I2S_COMM_FORMAT_STAND_MSB = 0x03,
+} i2s_comm_format_t;
+
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+#define I2S_PIN_NO_CHANGE (-1)
+
+typedef struct {
+    i2s_mode_t mode;
+    uint32_t sample_rate;
+    i2s_bits_per_sample_t bits_per_sample;
+    i2s_channel_fmt_t channel_format;
+    i2s_comm_format_t communication_format;
+    int intr_alloc_flags;
+    int dma_buf_count;
+    int dma_buf_len;
+    bool use_apll;
+    bool tx_desc_auto_clear;
+    int fixed_mclk;
+} i2s_config_t;
+
+typedef struct {
+    int bck_io_num;
+    int ws_io_num;
+    int data_out_num;
+    int data_in_num;
+} i2s_pin_config_t;
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* config, int queue_size, void* queue);
+esp_err_t i2s_driver_uninstall(i2s_port_t port);
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t* pins);
+esp_err_t i2s_start(i2s_port_t port);
+esp_err_t i2s_stop(i2s_port_t port);
+esp_err_t i2s_read(i2s_port_t port, void* dest, size_t size, size_t* bytes_read, TickType_t ticks_to_wait);
+
+// Native-only hooks. A source fills `samples` interleaved int16 values and
+// returns how many it produced; returning fewer ends the stream (silence
+// follows).
+typedef size_t (*native_i2s_source_t)(int16_t* samples, size_t count, void* context);
+void native_i2s_set_source(native_i2s_source_t source, void* context);
+void native_i2s_set_realtime(bool realtime);
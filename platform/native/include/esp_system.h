@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+
+// Simulated internal SRAM so heap reports on the host look like the device.
+#define NATIVE_HEAP_SIZE (320u * 1024u)
+
+uint32_t esp_get_free_heap_size();
+uint32_t esp_get_minimum_free_heap_size();
+[[noreturn]] void esp_restart();
@@ -0,0 +1,11 @@
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Watchdog stub: the host has no task watchdog, resets are only counted.
+esp_err_t esp_task_wdt_init(uint32_t timeout_s, bool panic);
+esp_err_t esp_task_wdt_add(TaskHandle_t task);
+esp_err_t esp_task_wdt_delete(TaskHandle_t task);
+esp_err_t esp_task_wdt_reset();
+uint32_t native_task_wdt_reset_count();
@@ -0,0 +1,23 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+// Tasks are std::threads. The "core" a task is pinned to is only recorded so
+// xPortGetCoreID() keeps per-core data structures apart.
+struct NativeTask;
+typedef NativeTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                                   void* parameters, UBaseType_t priority, TaskHandle_t* created_task,
+                                   BaseType_t core_id);
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                       void* parameters, UBaseType_t priority, TaskHandle_t* created_task);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+
+// Direct-to-task notifications, used as lightweight binary/counting semaphores.
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
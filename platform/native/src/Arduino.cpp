@@ -0,0 +1,94 @@
+#include "Arduino.h"
+#include <chrono>
+#include <cstdarg>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static const auto boot_time = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - boot_time).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - boot_time).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+uint32_t getCpuFrequencyMhz() {
+    return 240;
+}
+
+uint32_t EspClass::getCycleCount() {
+    // A 240 MHz-equivalent count derived from the steady clock, wrapping at
+    // 32 bits like CCOUNT.
+    uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - boot_time).count();
+    return (uint32_t)(ns * 240 / 1000);
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, len);
+
+    char* large = (char*)malloc(len + 1);
+    if (!large) return 0;
+    va_start(args, format);
+    vsnprintf(large, len + 1, format, args);
+    va_end(args);
+    size_t n = write((const uint8_t*)large, len);
+    free(large);
+    return n;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    (void)baud;
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+}
+
+int HardwareSerial::available() {
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN) ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+    if (!available()) return -1;
+    unsigned char c;
+    return ::read(STDIN_FILENO, &c, 1) == 1 ? c : -1;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
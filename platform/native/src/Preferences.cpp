@@ -0,0 +1,55 @@
+#include "Preferences.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+
+std::string Preferences::path(const char* key) const {
+    const char* dir = getenv("MARVIN_NVS_DIR");
+    return std::string(dir && *dir ? dir : ".nvs") + "/" + name_ + "." + key;
+}
+
+bool Preferences::begin(const char* name, bool read_only) {
+    name_ = name;
+    read_only_ = read_only;
+    open_ = true;
+    return true;
+}
+
+void Preferences::end() {
+    open_ = false;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (!open_ || read_only_) return 0;
+    const std::string file_path = path(key);
+    mkdir(file_path.substr(0, file_path.rfind('/')).c_str(), 0755);
+    // Written aside and renamed, so a crash never leaves half a value.
+    const std::string temporary = file_path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) return 0;
+    const bool ok = fwrite(value, 1, length, file) == length;
+    if (fclose(file) != 0 || !ok || rename(temporary.c_str(), file_path.c_str()) != 0) {
+        ::remove(temporary.c_str());
+        return 0;
+    }
+    return length;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    struct stat info;
+    return open_ && stat(path(key).c_str(), &info) == 0 ? (size_t)info.st_size : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t max_length) {
+    const size_t length = getBytesLength(key);
+    if (length == 0 || length > max_length) return 0;
+    FILE* file = fopen(path(key).c_str(), "rb");
+    if (!file) return 0;
+    const size_t n = fread(buffer, 1, length, file);
+    fclose(file);
+    return n == length ? length : 0;
+}
+
+bool Preferences::remove(const char* key) {
+    return open_ && !read_only_ && ::remove(path(key).c_str()) == 0;
+}
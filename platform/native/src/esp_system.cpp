@@ -0,0 +1,125 @@
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_task_wdt.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Each block carries its size in a header so frees can be accounted for.
+struct alignas(16) BlockHeader {
+    size_t size;
+};
+
+std::atomic<size_t> heap_in_use(0);
+std::atomic<size_t> heap_peak(0);
+std::atomic<uint32_t> wdt_resets(0);
+
+void noteAllocated(size_t size) {
+    size_t now = heap_in_use.fetch_add(size) + size;
+    size_t peak = heap_peak.load();
+    while (now > peak && !heap_peak.compare_exchange_weak(peak, now)) {}
+}
+
+} // namespace
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    if (heap_in_use.load() + size > NATIVE_HEAP_SIZE) return nullptr;
+    BlockHeader* block = (BlockHeader*)malloc(sizeof(BlockHeader) + size);
+    if (!block) return nullptr;
+    block->size = size;
+    noteAllocated(size);
+    return block + 1;
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    void* ptr = heap_caps_malloc(n * size, caps);
+    if (ptr) memset(ptr, 0, n * size);
+    return ptr;
+}
+
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+    if (!ptr) return heap_caps_malloc(size, caps);
+    BlockHeader* old_block = (BlockHeader*)ptr - 1;
+    void* fresh = heap_caps_malloc(size, caps);
+    if (!fresh) return nullptr;
+    memcpy(fresh, ptr, old_block->size < size ? old_block->size : size);
+    heap_caps_free(ptr);
+    return fresh;
+}
+
+void heap_caps_free(void* ptr) {
+    if (!ptr) return;
+    BlockHeader* block = (BlockHeader*)ptr - 1;
+    heap_in_use.fetch_sub(block->size);
+    free(block);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+    return NATIVE_HEAP_SIZE - heap_in_use.load();
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    (void)caps;
+    return NATIVE_HEAP_SIZE - heap_peak.load();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return heap_caps_get_free_size(caps);
+}
+
+uint32_t esp_get_free_heap_size() {
+    return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+}
+
+uint32_t esp_get_minimum_free_heap_size() {
+    return (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+}
+
+void esp_restart() {
+    fprintf(stderr, "esp_restart() called on the native build, exiting\n");
+    fflush(stdout);
+    exit(EXIT_FAILURE);
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        default: return "UNKNOWN ERROR";
+    }
+}
+
+esp_err_t esp_task_wdt_init(uint32_t timeout_s, bool panic) {
+    (void)timeout_s;
+    (void)panic;
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_add(TaskHandle_t task) {
+    (void)task;
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_delete(TaskHandle_t task) {
+    (void)task;
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_reset() {
+    wdt_resets.fetch_add(1, std::memory_order_relaxed);
+    return ESP_OK;
+}
+
+uint32_t native_task_wdt_reset_count() {
+    return wdt_resets.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,183 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct NativeTask {
+    std::string name;
+    BaseType_t core;
+    UBaseType_t priority;
+    std::mutex lock;
+    std::condition_variable notified;
+    uint32_t notification = 0;
+};
+
+struct NativeQueue {
+    size_t length;
+    size_t item_size;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex lock;
+    std::condition_variable changed;
+};
+
+namespace {
+
+struct NativeTaskExit {};
+
+thread_local NativeTask* current_task = nullptr;
+const auto tick_origin = std::chrono::steady_clock::now();
+
+template<typename Predicate>
+bool waitFor(std::unique_lock<std::mutex>& guard, std::condition_variable& cv, TickType_t ticks, Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(guard, ready);
+        return true;
+    }
+    return cv.wait_for(guard, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready);
+}
+
+} // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                                   void* parameters, UBaseType_t priority, TaskHandle_t* created_task,
+                                   BaseType_t core_id) {
+    (void)stack_depth;
+    NativeTask* task = new NativeTask();
+    task->name = name ? name : "";
+    task->core = core_id == tskNO_AFFINITY ? 0 : core_id;
+    task->priority = priority;
+    if (created_task) *created_task = task;
+
+    std::thread([task, function, parameters]() {
+        current_task = task;
+        try {
+            function(parameters);
+        } catch (const NativeTaskExit&) {
+        }
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                       void* parameters, UBaseType_t priority, TaskHandle_t* created_task) {
+    return xTaskCreatePinnedToCore(function, name, stack_depth, parameters, priority, created_task,
+                                   tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // Only self-deletion is supported: a std::thread cannot be killed.
+    if (task == nullptr || task == current_task) throw NativeTaskExit();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - tick_origin).count() / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    if (!current_task) {
+        // The main thread (setup()/loop(), test runners) gets a task lazily.
+        current_task = new NativeTask();
+        current_task->name = "main";
+        current_task->core = 0;
+        current_task->priority = 1;
+    }
+    return current_task;
+}
+
+BaseType_t xPortGetCoreID() {
+    return current_task ? current_task->core : 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> guard(task->lock);
+        task->notification++;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    NativeTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> guard(task->lock);
+    waitFor(guard, task->notified, ticks_to_wait, [task]() { return task->notification > 0; });
+    uint32_t value = task->notification;
+    if (value > 0) task->notification = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    NativeQueue* queue = new NativeQueue();
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    if (!waitFor(guard, queue->changed, ticks_to_wait,
+                 [queue]() { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + (bytes ? queue->item_size : 0));
+    guard.unlock();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks_to_wait) {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    if (!waitFor(guard, queue->changed, ticks_to_wait, [queue]() { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    if (buffer && queue->item_size) memcpy(buffer, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    guard.unlock();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    return (UBaseType_t)queue->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+    xQueueSend(mutex, nullptr, 0);
+    return mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait) {
+    return xQueueReceive(semaphore, nullptr, ticks_to_wait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return xQueueSend(semaphore, nullptr, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    vQueueDelete(semaphore);
+}
@@ -0,0 +1,164 @@
+#include "driver/i2s.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct NativeI2S {
+    bool installed = false;
+    bool running = false;
+    uint32_t sample_rate = 16000;
+    int channels = 1; // Interleaved per frame: 2 for I2S_CHANNEL_FMT_RIGHT_LEFT
+    uint64_t samples_delivered = 0; // Per channel
+    std::chrono::steady_clock::time_point started;
+};
+
+NativeI2S ports[I2S_NUM_MAX];
+native_i2s_source_t source = nullptr;
+void* source_context = nullptr;
+bool realtime = true;
+
+// Default source: $MARVIN_AUDIO_WAV (16-bit PCM), looped. Each frame gives
+// the port's channels from the file's first ones, the last repeated if the
+// file has fewer.
+struct WavLoop {
+    std::vector<int16_t> samples; // Interleaved
+    int file_channels = 1;
+    int port_channels = 1;
+    size_t frame = 0; // Next frame to deliver
+    int slot = 0;     // Next channel of it
+    bool loaded = false;
+};
+
+bool loadWav(const char* path, std::vector<int16_t>& out, int& out_channels) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    fclose(file);
+    if (bytes.size() < 12 || memcmp(bytes.data(), "RIFF", 4) || memcmp(bytes.data() + 8, "WAVE", 4)) return false;
+
+    uint16_t channels = 1, bits = 16;
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+        uint32_t size;
+        memcpy(&size, bytes.data() + offset + 4, 4);
+        const uint8_t* body = bytes.data() + offset + 8;
+        if (!memcmp(bytes.data() + offset, "fmt ", 4) && size >= 16) {
+            memcpy(&channels, body + 2, 2);
+            memcpy(&bits, body + 14, 2);
+        } else if (!memcmp(bytes.data() + offset, "data", 4)) {
+            if (bits != 16 || channels == 0) return false;
+            size_t frames = (size < bytes.size() - offset - 8 ? size : bytes.size() - offset - 8) / (2 * channels);
+            out.resize(frames * channels);
+            memcpy(out.data(), body, out.size() * sizeof(int16_t));
+            out_channels = channels;
+            return true;
+        }
+        offset += 8 + size + (size & 1);
+    }
+    return false;
+}
+
+size_t wavLoopSource(int16_t* samples, size_t count, void* context) {
+    WavLoop* loop = static_cast<WavLoop*>(context);
+    if (!loop->loaded) {
+        loop->loaded = true;
+        const char* path = getenv("MARVIN_AUDIO_WAV");
+        if (path && !loadWav(path, loop->samples, loop->file_channels)) fprintf(stderr, "native i2s: cannot read %s\n", path);
+    }
+    if (loop->samples.empty()) {
+        memset(samples, 0, count * sizeof(int16_t));
+        return count;
+    }
+    const size_t frames = loop->samples.size() / loop->file_channels;
+    for (size_t i = 0; i < count; i++) {
+        const int channel = loop->slot < loop->file_channels ? loop->slot : loop->file_channels - 1;
+        samples[i] = loop->samples[loop->frame * loop->file_channels + channel];
+        if (++loop->slot == loop->port_channels) {
+            loop->slot = 0;
+            loop->frame = (loop->frame + 1) % frames;
+        }
+    }
+    return count;
+}
+
+WavLoop default_loop;
+
+} // namespace
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* config, int queue_size, void* queue) {
+    (void)queue_size;
+    (void)queue;
+    if (port >= I2S_NUM_MAX || !config) return ESP_ERR_INVALID_ARG;
+    if (ports[port].installed) return ESP_ERR_INVALID_STATE;
+    ports[port] = NativeI2S();
+    ports[port].installed = true;
+    ports[port].sample_rate = config->sample_rate;
+    ports[port].channels = config->channel_format == I2S_CHANNEL_FMT_RIGHT_LEFT ? 2 : 1;
+    return ESP_OK;
+}
+
+esp_err_t i2s_driver_uninstall(i2s_port_t port) {
+    if (port >= I2S_NUM_MAX || !ports[port].installed) return ESP_ERR_INVALID_STATE;
+    ports[port].installed = false;
+    ports[port].running = false;
+    return ESP_OK;
+}
+
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t* pins) {
+    (void)pins;
+    return port < I2S_NUM_MAX && ports[port].installed ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t i2s_start(i2s_port_t port) {
+    if (port >= I2S_NUM_MAX || !ports[port].installed) return ESP_ERR_INVALID_STATE;
+    ports[port].running = true;
+    ports[port].samples_delivered = 0;
+    ports[port].started = std::chrono::steady_clock::now();
+    return ESP_OK;
+}
+
+esp_err_t i2s_stop(i2s_port_t port) {
+    if (port >= I2S_NUM_MAX || !ports[port].installed) return ESP_ERR_INVALID_STATE;
+    ports[port].running = false;
+    return ESP_OK;
+}
+
+esp_err_t i2s_read(i2s_port_t port, void* dest, size_t size, size_t* bytes_read, TickType_t ticks_to_wait) {
+    (void)ticks_to_wait;
+    if (bytes_read) *bytes_read = 0;
+    if (port >= I2S_NUM_MAX || !ports[port].running) return ESP_ERR_INVALID_STATE;
+    NativeI2S& i2s = ports[port];
+
+    size_t count = size / sizeof(int16_t);
+    int16_t* samples = static_cast<int16_t*>(dest);
+    default_loop.port_channels = i2s.channels;
+    size_t produced = source ? source(samples, count, source_context)
+                             : wavLoopSource(samples, count, &default_loop);
+    if (produced < count) memset(samples + produced, 0, (count - produced) * sizeof(int16_t));
+    i2s.samples_delivered += count / i2s.channels;
+
+    if (realtime) {
+        // Block until the "DMA" would have captured these samples.
+        auto due = i2s.started + std::chrono::microseconds(i2s.samples_delivered * 1000000ULL / i2s.sample_rate);
+        std::this_thread::sleep_until(due);
+    }
+    if (bytes_read) *bytes_read = count * sizeof(int16_t);
+    return ESP_OK;
+}
+
+void native_i2s_set_source(native_i2s_source_t new_source, void* context) {
+    source = new_source;
+    source_context = context;
+}
+
+void native_i2s_set_realtime(bool enabled) {
+    realtime = enabled;
+}
@@ -0,0 +1,10 @@
+// Arduino-style entry point for the native build: setup() once, then loop()
+// forever on the main thread. Weak so that test runners and host tools can
+// provide their own main().
+void setup();
+void loop();
+
+__attribute__((weak)) int main() {
+    setup();
+    for (;;) loop();
+}
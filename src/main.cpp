@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "WakeWordDetector.h"
-#include "AudioCapture.h"
+#include "ManualDSCNN.h"
+#include "Console.h"
 #include "AudioProcessor.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -9,78 +10,48 @@
 #include "esp_system.h"
 #include <cmath>
 #include "env.h"
+#include "Logger.h"
+#include "WarmStart.h"
 
+// Component self-tests run in a background task once detection is up;
+// 0 leaves them out of the boot entirely.
+#ifndef SELF_TEST_ON_BOOT
+#define SELF_TEST_ON_BOOT 1
+#endif
+#define SELF_TEST_DELAY_MS 2000
+
+static WakeWordDetector detector_instance;
+static Console console(detector_instance);
+static WarmStart warm_start(detector_instance);
 WakeWordDetector* detector = nullptr;
 TaskHandle_t wakeWordTaskHandle = nullptr;
 TaskHandle_t healthCheckTaskHandle = nullptr;
+TaskHandle_t consoleTaskHandle = nullptr;
+TaskHandle_t selfTestTaskHandle = nullptr;
 unsigned long last_health_check = 0;
 unsigned long system_start_time = 0;
+unsigned long boot_time = 0; // millis() when setup() began
 size_t min_free_heap = SIZE_MAX;
 
+// Checks the detector's own capture rather than opening I2S again: by the
+// time the self-test runs the detection task has been reading for a while.
 void testAudioCapture() {
     Serial.println("🔬 Testing AudioCapture integration...");
-    Serial.printf("Heap before test: %u bytes\n", esp_get_free_heap_size());
-    esp_task_wdt_reset();
-    
-    AudioCapture audio;
-    if (!audio.init()) {
-        Serial.println("❌ AudioCapture init failed");
+    DetectorStats stats;
+    detector->getStats(stats);
+    const LatencySnapshot& capture = stats.stages[STAGE_HOP];
+    if (capture.count == 0) {
+        Serial.println("❌ No audio captured since boot");
+        Serial.println("🔍 Check I2S pins (GPIO22=SCK, GPIO25=WS, GPIO26=SD, GND, 3.3V, L/R=GND)");
         return;
     }
-    Serial.println("✅ AudioCapture initialized");
-    esp_task_wdt_reset();
-    
-    int16_t test_buffer[1000];
-    bool read_success = false;
-    for (int attempt = 1; attempt <= 3; attempt++) {
-        Serial.printf("🔍 Read attempt %d/3\n", attempt);
-        vTaskDelay(1000 / portTICK_PERIOD_MS); // Delay to capture speech
-        if (audio.read(test_buffer, 1000)) {
-            read_success = true;
-            break;
-        }
-        Serial.println("⚠️ AudioCapture read failed, retrying...");
-        vTaskDelay(100 / portTICK_PERIOD_MS);
-        esp_task_wdt_reset();
-    }
-    
-    if (read_success) {
-        Serial.println("✅ AudioCapture read successful");
-        int non_zero_count = 0;
-        int max_amplitude = 0;
-        for (int i = 0; i < 1000; i++) {
-            if (test_buffer[i] != 0) {
-                non_zero_count++;
-                max_amplitude = max(max_amplitude, abs(test_buffer[i]));
-            }
-            if (i % 200 == 0) {
-                vTaskDelay(1 / portTICK_PERIOD_MS);
-                esp_task_wdt_reset();
-            }
-        }
-        if (non_zero_count > 0) {
-            Serial.printf("✅ Audio data detected (%d non-zero samples, max amplitude: %d)\n", 
-                         non_zero_count, max_amplitude);
-        } else {
-            Serial.println("⚠️ Audio data appears to be all zeros (check microphone wiring or environment)");
-        }
-        Serial.print("First 10 samples: ");
-        for (int i = 0; i < 10; i++) {
-            Serial.print(test_buffer[i]);
-            Serial.print(" ");
-            if (i % 5 == 0) {
-                vTaskDelay(1 / portTICK_PERIOD_MS);
-                esp_task_wdt_reset();
-            }
-        }
-        Serial.println();
+    Serial.printf("✅ AudioCapture delivered %u hops (p50 %u us end to end)\n", (unsigned)capture.count,
+                  (unsigned)capture.p50_us);
+    if (stats.noise_floor > 0) {
+        Serial.printf("✅ Audio data detected (noise floor rms %.0f)\n", sqrt((double)stats.noise_floor));
     } else {
-        Serial.println("❌ AudioCapture read failed after 3 attempts");
-        Serial.println("🔍 Check I2S pins (GPIO22=SCK, GPIO25=WS, GPIO26=SD, GND, 3.3V, L/R=GND)");
+        Serial.println("⚠️ Audio data appears to be all zeros (check microphone wiring or environment)");
     }
-    Serial.printf("Heap after test: %u bytes\n", esp_get_free_heap_size());
-    vTaskDelay(10 / portTICK_PERIOD_MS);
-    esp_task_wdt_reset();
 }
 
 void testAudioProcessor() {
@@ -88,28 +59,22 @@ void testAudioProcessor() {
     Serial.printf("Heap before test: %u bytes\n", esp_get_free_heap_size());
     esp_task_wdt_reset();
     
+    // Stream a 440 Hz tone through the front end one stride at a time, the
+    // way the detector feeds it.
+    AudioProcessor processor;
+    processor.setInputQuantization(ManualDSCNN::inputScale(), ManualDSCNN::inputZeroPoint());
+    int16_t chunk[KWS_STRIDE_SAMPLES];
     unsigned long start_time = millis();
-    int16_t* test_audio = (int16_t*)malloc(WINDOW_SIZE * sizeof(int16_t));
-    if (!test_audio) {
-        Serial.println("❌ Failed to allocate test_audio buffer");
-        esp_task_wdt_reset();
-        return;
-    }
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        test_audio[i] = (int16_t)(sin(2.0 * PI * 440.0 * i / 16000.0) * 10000);
-        if (i % 128 == 0) {
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-            esp_task_wdt_reset();
-        }
-    }
-    Serial.printf("Generated test audio in %lu ms\n", millis() - start_time);
-    esp_task_wdt_reset();
-    
     try {
         int8_t mfcc_output[MFCC_NUM_FRAMES * MFCC_NUM_COEFFS];
-        start_time = millis();
         Serial.println("Starting MFCC computation...");
-        AudioProcessor::computeMFCC(test_audio, mfcc_output);
+        for (int offset = 0; !processor.featuresReady(); offset += KWS_STRIDE_SAMPLES) {
+            for (int i = 0; i < KWS_STRIDE_SAMPLES; i++) {
+                chunk[i] = (int16_t)(sin(2.0 * PI * 440.0 * (offset + i) / KWS_SAMPLE_RATE_HZ) * 10000);
+            }
+            processor.processSamples(chunk, KWS_STRIDE_SAMPLES);
+        }
+        processor.copyFeatures(mfcc_output);
         Serial.printf("Computed MFCC in %lu ms\n", millis() - start_time);
         esp_task_wdt_reset();
         
@@ -141,49 +106,63 @@ void testAudioProcessor() {
     } catch (...) {
         Serial.println("❌ Exception in AudioProcessor test");
         Serial.printf("Heap after exception: %u bytes\n", esp_get_free_heap_size());
-        free(test_audio);
         esp_task_wdt_reset();
         esp_restart();
     }
     
-    free(test_audio);
     Serial.printf("Heap after test: %u bytes\n", esp_get_free_heap_size());
     esp_task_wdt_reset();
 }
 
+// Placeholder for the downstream stage: reports the handoff and lets go.
+bool onKeywordAudio(const AudioEvent& event, void*) {
+    LOG_INFO("🎙️ Keyword at samples %u-%u, %u samples of pre-roll from %u",
+             (unsigned)event.keyword_start, (unsigned)event.keyword_end, (unsigned)event.audio.count(),
+             (unsigned)event.audio.start);
+    return false;
+}
+
 void wakeWordTask(void* pvParameters) {
     if (!detector) {
         Serial.println("❌ Detector not initialized");
         vTaskDelete(NULL);
     }
 
+    // detect() blocks on the next hop of audio, so the loop runs at the
+    // capture rate without dropping samples between calls.
+    bool first_window = true;
     while (true) {
-        vTaskDelay(1000 / portTICK_PERIOD_MS); // Delay to capture speech
-        if (detector->detect()) {
-            Serial.printf("🎯 Wake word detected! Confidence: %.3f, Count: %d\n",
-                          detector->getThreshold(), detector->getDetectionCount());
-            esp_task_wdt_reset();
-        } else {
-            Serial.printf("No wake word detected, confidence: %.3f\n", detector->getThreshold());
+        const bool detected = detector->detect();
+        if (first_window && detector->getStream().features.ready()) {
+            // The earliest a detection can happen: one window of audio.
+            LOG_INFO("⏱️ First full window %u ms after boot", (unsigned)(millis() - boot_time));
+            first_window = false;
         }
-
-        int8_t mfcc_output[MFCC_NUM_FRAMES * MFCC_NUM_COEFFS];
-        AudioProcessor* processor = detector->getAudioProcessor();
-        int16_t* buffer = detector->getAudioBuffer();
-        if (processor && buffer) {
-            processor->computeMFCC(buffer, mfcc_output);
-            Serial.print("Wake word MFCC (first 10): ");
-            for (int i = 0; i < 10; i++) {
-                Serial.print((int)mfcc_output[i]);
-                Serial.print(" ");
-                vTaskDelay(1 / portTICK_PERIOD_MS);
-                esp_task_wdt_reset();
+        if (detected) {
+            const uint32_t fired = detector->getFiredKeywords();
+            if (fired & 1u) {
+                LOG_INFO("🎯 Wake word detected! Confidence: %.3f, Count: %d",
+                         detector->getLastProbabilities()[KWS_LABEL_MARVIN_IDX], detector->getDetectionCount());
+            }
+            for (int id = 1; id < detector->getKeywordCount(); id++) {
+                if (!(fired & (1u << id))) continue;
+                const KeywordTrack& track = detector->getKeywordTrack(id);
+                LOG_INFO("🎯 Keyword %s detected! Confidence: %.3f, Count: %u", detector->getKeywordName(id),
+                         track.posteriors[detector->getKeywordBank().spec(id - 1).label],
+                         (unsigned)track.detection_count);
             }
-            Serial.println();
-        } else {
-            Serial.println("❌ AudioProcessor or audio_buffer not available");
         }
-        vTaskDelay(DETECTION_COOLDOWN_MS / portTICK_PERIOD_MS);
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+        const StreamState& stream = detector->getStream();
+        if (stream.features.ready()) {
+            int8_t mfcc_output[MFCC_NUM_FRAMES * MFCC_NUM_COEFFS];
+            AudioProcessor::copyFeatures(stream.features, mfcc_output);
+            LOG_VERBOSE("Wake word MFCC (first 8): %d %d %d %d %d %d %d %d",
+                        mfcc_output[0], mfcc_output[1], mfcc_output[2], mfcc_output[3],
+                        mfcc_output[4], mfcc_output[5], mfcc_output[6], mfcc_output[7]);
+        }
+#endif
         esp_task_wdt_reset();
     }
 }
@@ -194,50 +173,78 @@ void healthCheckTask(void* pvParameters) {
         if (current_time - last_health_check >= 10000) {
             min_free_heap = min(min_free_heap, esp_get_free_heap_size());
             Serial.printf("💗 Health check: Heap free: %u bytes, Min heap: %u bytes, Uptime: %lu ms\n",
-                          esp_get_free_heap_size(), min_free_heap, current_time - system_start_time);
+                          esp_get_free_heap_size(), (unsigned)min_free_heap, current_time - system_start_time);
+            if (detector) Console::printStats(*detector);
             last_health_check = current_time;
             esp_task_wdt_reset();
         }
+        warm_start.poll();
         vTaskDelay(1000 / portTICK_PERIOD_MS);
     }
 }
 
+#if SELF_TEST_ON_BOOT
+// Low priority on the other core, after detection has started, so the tests
+// never delay the first window.
+void selfTestTask(void*) {
+    vTaskDelay(SELF_TEST_DELAY_MS / portTICK_PERIOD_MS);
+    Serial.println("🧪 Running component tests...");
+    testAudioCapture();
+    testAudioProcessor();
+    Serial.println("🧪 Component tests completed");
+    selfTestTaskHandle = nullptr;
+    vTaskDelete(NULL);
+}
+#endif
+
 void setup() {
+    boot_time = millis();
     Serial.begin(115200);
+    Logger::init(DEBUG_LEVEL);
+    Logger::startTask();
     Serial.println("\n🚀 Marvin-3 Wake Word Detection System");
     Serial.println("=====================================");
-    Serial.println("🧪 Running component tests...");
-    
-    testAudioCapture();
-    testAudioProcessor();
-    Serial.println("🧪 Component tests completed\n");
-    esp_task_wdt_reset();
 
     Serial.println("⚙️ Configuring watchdog timer...");
     esp_task_wdt_init(15, true);
     esp_task_wdt_add(NULL);
     
-    Serial.println("🧠 Initializing wake word detector...");
-    detector = new WakeWordDetector();
-    if (!detector || !detector->init()) {
+    // init() starts I2S before it builds the model, so the DMA buffers are
+    // filling while the rest initializes.
+    detector = &detector_instance;
+    if (!detector->init()) {
         Serial.println("❌ Wake word detector initialization failed");
+        if (ManualDSCNN::refusesBuiltinModel()) {
+            // A restart would refuse the same model again: stay up (loop()
+            // keeps the watchdog fed) so the log can be read.
+            Serial.println("🛑 Not restarting: flash a build with a converted .tflite model");
+            return;
+        }
         esp_restart();
     }
     Serial.println("✅ Wake word detector initialized");
+    warm_start.restore();
     Serial.printf("🎯 Using detection threshold: %.3f\n", detector->getThreshold());
-    Serial.printf("Heap after detector init: %u bytes\n", esp_get_free_heap_size());
+    detector->setAudioConsumer(onKeywordAudio, nullptr);
     
     system_start_time = millis();
     min_free_heap = esp_get_free_heap_size();
-    Serial.printf("📊 Initial heap: %u bytes\n", min_free_heap);
+    xTaskCreatePinnedToCore(wakeWordTask, "WakeWordTask", 8192, NULL, 5, &wakeWordTaskHandle, 1);
+    Serial.printf("🎤 Listening for 'marvin' %lu ms after boot\n", system_start_time - boot_time);
+    Serial.printf("📊 Initial heap: %u bytes\n", (unsigned)min_free_heap);
     Serial.printf("⚡ CPU frequency: %u MHz\n", getCpuFrequencyMhz());
-    Serial.println("🎤 Listening for 'marvin'...");
     Serial.println("=====================================");
-    
-    xTaskCreatePinnedToCore(wakeWordTask, "WakeWordTask", 8192, NULL, 5, &wakeWordTaskHandle, 1);
-    Serial.println("🎤 Wake word detection task started");
+
     xTaskCreatePinnedToCore(healthCheckTask, "HealthCheckTask", 4096, NULL, 1, &healthCheckTaskHandle, 0);
     Serial.println("💗 Health monitoring task started");
+    // Tuning changes reach the detection task as requests between hops; the
+    // console starts from the restored tuning.
+    console.begin();
+    xTaskCreatePinnedToCore(Console::task, "ConsoleTask", 4096, &console, 1, &consoleTaskHandle, 0);
+    Serial.println("⌨️ Console started (type help)");
+#if SELF_TEST_ON_BOOT
+    xTaskCreatePinnedToCore(selfTestTask, "SelfTestTask", 8192, NULL, 1, &selfTestTaskHandle, 0);
+#endif
 }
 
 void loop() {
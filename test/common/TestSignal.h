@@ -0,0 +1,36 @@
+#ifndef TEST_SIGNAL_H
+#define TEST_SIGNAL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Deterministic test audio for every suite: one LCG (the Numerical Recipes
+// constants) behind all the noise, so suites differ only in their seeds and
+// a run always sees the same samples. Include as "../common/TestSignal.h".
+class TestSignal {
+public:
+    explicit TestSignal(uint32_t seed) : state_(seed) {}
+
+    // The generator's full 32-bit state after one step.
+    uint32_t next() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return state_;
+    }
+    // Its top 24 bits, for picking indices and bytes.
+    uint32_t bits() { return next() >> 8; }
+    // Uniform in [0, 1).
+    double uniform() { return bits() / 16777216.0; }
+    // Uniform in [-1, 1).
+    float noise() { return ((int32_t)(next() >> 16) - 32768) / 32768.0f; }
+    // One sample of white noise, uniform in [-2048, 2048): rms about 1200,
+    // the level of a quiet room after the capture gain.
+    int16_t noiseSample() { return (int16_t)(((int32_t)(next() >> 16) - 32768) / 16); }
+    void noiseHop(int16_t* out, size_t count) {
+        for (size_t i = 0; i < count; i++) out[i] = noiseSample();
+    }
+
+private:
+    uint32_t state_;
+};
+
+#endif
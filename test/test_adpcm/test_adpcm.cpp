@@ -0,0 +1,195 @@
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "AdpcmHistory.h"
+#include "WakeWordDetector.h"
+#include "../common/TestSignal.h"
+
+static TestSignal test_signal(7);
+
+// Voice-band tones with a little noise, like conditioned speech.
+static int16_t sampleAt(uint64_t position) {
+    const double t = (double)position / KWS_SAMPLE_RATE_HZ;
+    const double tone = 6000.0 * sin(2 * M_PI * 220.0 * t) + 3000.0 * sin(2 * M_PI * 1330.0 * t) +
+                        1500.0 * sin(2 * M_PI * 3100.0 * t);
+    return (int16_t)(tone + (double)(int32_t)(test_signal.bits() % 801) - 400.0);
+}
+
+static double snrDb(const int16_t* clean, const int16_t* coded, size_t count) {
+    double signal = 0.0, error = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        signal += (double)clean[i] * clean[i];
+        error += ((double)coded[i] - clean[i]) * ((double)coded[i] - clean[i]);
+    }
+    return 10.0 * log10(signal / (error + 1.0));
+}
+
+// Random blocks, any header: the table path and the specification agree,
+// whole or from any sample on.
+void test_table_decoder_matches_reference() {
+    uint8_t block[ADPCM_BLOCK_BYTES];
+    int16_t reference[ADPCM_BLOCK_SAMPLES];
+    int16_t decoded[ADPCM_BLOCK_SAMPLES];
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < ADPCM_BLOCK_BYTES; i++) block[i] = (uint8_t)test_signal.bits();
+        block[2] = (uint8_t)(round % 100); // Past ADPCM_MAX_INDEX too
+        Adpcm::decodeBlockReference(block, reference);
+        Adpcm::decodeBlock(block, decoded);
+        TEST_ASSERT_EQUAL_INT16_ARRAY(reference, decoded, ADPCM_BLOCK_SAMPLES);
+
+        const size_t first = test_signal.bits() % ADPCM_BLOCK_SAMPLES;
+        const size_t count = 1 + test_signal.bits() % (ADPCM_BLOCK_SAMPLES - first);
+        Adpcm::decode(block, first, count, decoded);
+        TEST_ASSERT_EQUAL_INT16_ARRAY(reference + first, decoded, count);
+    }
+}
+
+// Chunking does not change the encoding, and the decoded stream keeps the
+// signal well above the quantization noise.
+void test_stream_encodes_and_decodes() {
+    const size_t blocks = 12;
+    std::vector<int16_t> clean(blocks * ADPCM_BLOCK_SAMPLES);
+    for (size_t i = 0; i < clean.size(); i++) clean[i] = sampleAt(i);
+
+    std::vector<uint8_t> whole(blocks * ADPCM_BLOCK_BYTES), chunked(whole.size());
+    AdpcmEncoder encoder;
+    TEST_ASSERT_EQUAL_UINT32(blocks, encoder.encode(clean.data(), clean.size(), whole.data()));
+    encoder.reset();
+    size_t written = 0;
+    for (size_t done = 0; done < clean.size();) {
+        const size_t count = std::min<size_t>(1 + test_signal.bits() % 700, clean.size() - done);
+        written += encoder.encode(clean.data() + done, count, chunked.data() + written * ADPCM_BLOCK_BYTES);
+        done += count;
+    }
+    TEST_ASSERT_EQUAL_UINT32(blocks, written);
+    TEST_ASSERT_EQUAL_UINT32(0, encoder.pending());
+    TEST_ASSERT_EQUAL_MEMORY(whole.data(), chunked.data(), whole.size());
+
+    std::vector<int16_t> decoded(clean.size());
+    for (size_t b = 0; b < blocks; b++) {
+        Adpcm::decodeBlock(&whole[b * ADPCM_BLOCK_BYTES], &decoded[b * ADPCM_BLOCK_SAMPLES]);
+        TEST_ASSERT_EQUAL_INT16(clean[b * ADPCM_BLOCK_SAMPLES], decoded[b * ADPCM_BLOCK_SAMPLES]); // Header sample
+    }
+    TEST_ASSERT_GREATER_THAN(20, (int)snrDb(clean.data(), decoded.data(), clean.size()));
+}
+
+// Reads anywhere in the held range decode exactly what the blocks hold, and
+// the block being filled reads back raw.
+void test_history_reads_any_range() {
+    const size_t kept = 4;
+    static uint8_t storage[kept * ADPCM_BLOCK_BYTES];
+    AdpcmHistory history(storage, kept);
+    const size_t total = 10 * ADPCM_BLOCK_SAMPLES + 123;
+    std::vector<int16_t> clean(total);
+    for (size_t i = 0; i < total; i++) clean[i] = sampleAt(i);
+    for (size_t done = 0; done < total; done += DETECTOR_HOP_SAMPLES / 4) {
+        history.append(&clean[done], std::min<size_t>(DETECTOR_HOP_SAMPLES / 4, total - done));
+    }
+    TEST_ASSERT_EQUAL_UINT32(total, history.end());
+    TEST_ASSERT_EQUAL_UINT32(6 * ADPCM_BLOCK_SAMPLES, history.begin());
+
+    // What a single encoder makes of the same stream.
+    std::vector<uint8_t> blocks(11 * ADPCM_BLOCK_BYTES);
+    AdpcmEncoder encoder;
+    size_t count = encoder.encode(clean.data(), total, blocks.data());
+    count += encoder.flush(&blocks[count * ADPCM_BLOCK_BYTES]);
+    TEST_ASSERT_EQUAL_UINT32(11, count);
+    std::vector<int16_t> expected(11 * ADPCM_BLOCK_SAMPLES);
+    for (size_t b = 0; b < 11; b++) {
+        Adpcm::decodeBlock(&blocks[b * ADPCM_BLOCK_BYTES], &expected[b * ADPCM_BLOCK_SAMPLES]);
+    }
+    memcpy(&expected[10 * ADPCM_BLOCK_SAMPLES], &clean[10 * ADPCM_BLOCK_SAMPLES], 123 * sizeof(int16_t));
+
+    std::vector<int16_t> out(total);
+    for (int round = 0; round < 100; round++) {
+        const uint64_t from = history.begin() + test_signal.bits() % (history.end() - history.begin());
+        const uint64_t to = from + test_signal.bits() % (history.end() - from + 1);
+        TEST_ASSERT_TRUE(history.read(from, to, out.data()));
+        if (to > from) TEST_ASSERT_EQUAL_INT16_ARRAY(&expected[from], out.data(), to - from);
+    }
+    TEST_ASSERT_FALSE(history.read(history.begin() - 1, history.end(), out.data()));
+
+    // The latest blocks, the partial one encoded as the single encoder did.
+    std::vector<uint8_t> latest(3 * ADPCM_BLOCK_BYTES);
+    uint64_t start = 0;
+    TEST_ASSERT_EQUAL_UINT32(2, history.copyLatest(ADPCM_BLOCK_SAMPLES, latest.data(), start));
+    TEST_ASSERT_EQUAL_UINT32(9 * ADPCM_BLOCK_SAMPLES, start);
+    TEST_ASSERT_EQUAL_MEMORY(&blocks[9 * ADPCM_BLOCK_BYTES], latest.data(), 2 * ADPCM_BLOCK_BYTES);
+    TEST_ASSERT_EQUAL_UINT32(total, history.end()); // Untouched
+}
+
+static WakeWordDetector detector;
+
+// A recording posted from another task comes back compressed, once, and
+// stays put until released.
+void test_detector_records_compressed() {
+    TEST_ASSERT_TRUE(detector.initPipeline());
+    detector.setVoiceGate(false);
+    std::vector<int16_t> clean;
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    for (int h = 0; h < 40; h++) {
+        for (int i = 0; i < DETECTOR_HOP_SAMPLES; i++) hop[i] = sampleAt(clean.size() + i);
+        clean.insert(clean.end(), hop, hop + DETECTOR_HOP_SAMPLES);
+        if (h == 38) {
+            DetectorRequest request = {};
+            request.type = DETECTOR_REQUEST_RECORD;
+            TEST_ASSERT_TRUE(detector.post(request));
+        }
+        detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    }
+
+    DetectorRecording recording;
+    TEST_ASSERT_TRUE(detector.takeRecording(recording));
+    TEST_ASSERT_FALSE(detector.takeRecording(recording));
+    const uint64_t end = 39 * DETECTOR_HOP_SAMPLES; // Before the last hop
+    // From the pre-roll, exactly; from the archive, whole blocks.
+    const uint32_t wanted = DETECTOR_ARCHIVE_MS > 0 || DETECTOR_RECORD_SAMPLES < DETECTOR_PREROLL_SAMPLES
+                                ? DETECTOR_RECORD_SAMPLES
+                                : DETECTOR_PREROLL_SAMPLES;
+    TEST_ASSERT_TRUE(recording.samples >= wanted);
+    TEST_ASSERT_TRUE(recording.samples < wanted + (DETECTOR_ARCHIVE_MS > 0 ? ADPCM_BLOCK_SAMPLES : 1));
+    TEST_ASSERT_EQUAL_UINT32(end - recording.samples, recording.start);
+    TEST_ASSERT_EQUAL_UINT32((recording.samples + ADPCM_BLOCK_SAMPLES - 1) / ADPCM_BLOCK_SAMPLES,
+                             recording.block_count);
+
+    std::vector<int16_t> decoded(recording.block_count * ADPCM_BLOCK_SAMPLES);
+    for (size_t b = 0; b < recording.block_count; b++) {
+        Adpcm::decodeBlock(recording.blocks + b * ADPCM_BLOCK_BYTES, &decoded[b * ADPCM_BLOCK_SAMPLES]);
+    }
+    TEST_ASSERT_GREATER_THAN(20, (int)snrDb(&clean[recording.start], decoded.data(), recording.samples));
+
+    // Held: another request is dropped until the dump is released.
+    DetectorRequest request = {};
+    request.type = DETECTOR_REQUEST_RECORD;
+    TEST_ASSERT_TRUE(detector.post(request));
+    detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    TEST_ASSERT_FALSE(detector.takeRecording(recording));
+    detector.releaseRecording();
+    TEST_ASSERT_TRUE(detector.post(request));
+    detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    TEST_ASSERT_TRUE(detector.takeRecording(recording));
+    detector.releaseRecording();
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_table_decoder_matches_reference);
+    RUN_TEST(test_stream_encodes_and_decodes);
+    RUN_TEST(test_history_reads_any_range);
+    RUN_TEST(test_detector_records_compressed);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
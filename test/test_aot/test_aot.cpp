@@ -0,0 +1,79 @@
+#include <unity.h>
+#include <cstring>
+#include "ManualDSCNN.h"
+#include "model_aot.h"
+#include "frontend_params.h"
+#include "../common/TestSignal.h"
+
+// The generated model_aot.cpp must agree bit for bit with the graph
+// interpreter (the reference engine) on every window, batched or not.
+
+static const int WINDOW_BYTES = KWS_FRAMES * KWS_NUM_MFCC;
+
+static ManualDSCNN reference;
+alignas(16) static int8_t arena[DSCNN_MAX_BATCH * MODEL_AOT_ARENA_SIZE];
+
+// Random, saturated and constant windows, so padding, clamping and the
+// zero-point folding are all exercised.
+static void fillWindow(int index, int8_t* window) {
+    TestSignal values(977u * (uint32_t)(index + 1));
+    for (int i = 0; i < WINDOW_BYTES; i++) {
+        int value = (int)(values.next() >> 24) - 128;
+        switch (index % 4) {
+        case 1: value = value / 8 + MODEL_AOT_INPUT_ZERO_POINT; break;
+        case 2: value = (i / KWS_NUM_MFCC) % 2 ? 127 : -128; break;
+        case 3: value = MODEL_AOT_INPUT_ZERO_POINT; break;
+        }
+        window[i] = (int8_t)value;
+    }
+}
+
+void test_aot_matches_interpreter() {
+    TEST_ASSERT_TRUE(reference.init());
+    DualCore inline_only;
+    int8_t window[WINDOW_BYTES];
+    for (int round = 0; round < 16; round++) {
+        fillWindow(round, window);
+        const int8_t* input = window;
+        float expected[KWS_NUM_CLASSES], actual[KWS_NUM_CLASSES];
+        TEST_ASSERT_TRUE(reference.infer(window, expected));
+        model_aot_run(&input, 1, arena, actual, inline_only);
+        TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(expected));
+    }
+}
+
+void test_aot_batch_and_dual_core_match_interpreter() {
+    static int8_t windows[DSCNN_MAX_BATCH][WINDOW_BYTES];
+    const int8_t* inputs[DSCNN_MAX_BATCH];
+    for (int b = 0; b < DSCNN_MAX_BATCH; b++) {
+        fillWindow(100 + b, windows[b]);
+        inputs[b] = windows[b];
+    }
+    float expected[DSCNN_MAX_BATCH][KWS_NUM_CLASSES], actual[DSCNN_MAX_BATCH][KWS_NUM_CLASSES];
+    TEST_ASSERT_TRUE(reference.predictBatch(inputs, DSCNN_MAX_BATCH, expected[0]));
+
+    DualCore split;
+    TEST_ASSERT_TRUE(split.start(0, 5));
+    model_aot_run(inputs, DSCNN_MAX_BATCH, arena, actual[0], split);
+    split.stop();
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(expected));
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_aot_matches_interpreter);
+    RUN_TEST(test_aot_batch_and_dual_core_match_interpreter);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
@@ -0,0 +1,69 @@
+#include <unity.h>
+#include "AudioCapture.h"
+
+static AudioCapture capture;
+
+void test_capture_delivers_requested_samples() {
+    TEST_ASSERT_TRUE(capture.init());
+    int16_t buffer[960];
+    TEST_ASSERT_TRUE(capture.capture(buffer, 960));
+}
+
+void test_quiet_input_is_amplified() {
+    int16_t buffer[4] = {100, -200, 300, -400};
+    AudioCapture::condition(buffer, 4);
+    TEST_ASSERT_EQUAL_INT16(3200, buffer[0]);
+    TEST_ASSERT_EQUAL_INT16(-12800, buffer[3]);
+}
+
+void test_gain_saturates_instead_of_wrapping() {
+    int16_t buffer[3] = {4000, -4000, 10};
+    AudioCapture::condition(buffer, 3); // Peak below 5000: gain 16
+    TEST_ASSERT_EQUAL_INT16(32767, buffer[0]);
+    TEST_ASSERT_EQUAL_INT16(-32768, buffer[1]);
+    TEST_ASSERT_EQUAL_INT16(160, buffer[2]);
+}
+
+#ifndef ARDUINO
+#include "driver/i2s.h"
+
+static size_t rampSource(int16_t* samples, size_t count, void* context) {
+    int16_t* next = static_cast<int16_t*>(context);
+    for (size_t i = 0; i < count; i++) samples[i] = (*next)++;
+    return count;
+}
+
+void test_capture_reads_from_the_native_source() {
+    int16_t next = 0;
+    native_i2s_set_source(rampSource, &next);
+    native_i2s_set_realtime(false);
+    int16_t buffer[320];
+    TEST_ASSERT_TRUE(capture.capture(buffer, 320));
+    for (int i = 0; i < 320; i++) TEST_ASSERT_EQUAL_INT16(i, buffer[i]);
+    native_i2s_set_source(nullptr, nullptr);
+    native_i2s_set_realtime(true);
+}
+#endif
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_capture_delivers_requested_samples);
+    RUN_TEST(test_quiet_input_is_amplified);
+    RUN_TEST(test_gain_saturates_instead_of_wrapping);
+#ifndef ARDUINO
+    RUN_TEST(test_capture_reads_from_the_native_source);
+#endif
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
@@ -0,0 +1,115 @@
+#include <unity.h>
+#include <cmath>
+#include "Beamformer.h"
+#include "../common/TestSignal.h"
+
+#define TEST_HOPS 30
+#define TEST_HOP 960
+#define TEST_TONES 48
+
+// A broadband source as a sum of tones across the mel band, so any
+// fractional delay of it is exact.
+struct Source {
+    double frequency[TEST_TONES];
+    double phase[TEST_TONES];
+    TestSignal values;
+
+    Source() : values(7) {
+        for (int i = 0; i < TEST_TONES; i++) {
+            frequency[i] = 150.0 + 3700.0 * values.uniform();
+            phase[i] = 6.283185307 * values.uniform();
+        }
+    }
+    // Signal at (fractional) sample time t.
+    double at(double t) const {
+        double sum = 0.0;
+        for (int i = 0; i < TEST_TONES; i++) sum += sin(6.283185307 * frequency[i] * t / KWS_SAMPLE_RATE_HZ + phase[i]);
+        return sum * 3000.0 / sqrt((double)TEST_TONES);
+    }
+    double noise() {
+        return (values.uniform() + values.uniform() + values.uniform() - 1.5) * 2000.0;
+    }
+};
+
+static Beamformer beamformer;
+static int16_t interleaved[TEST_HOP * BEAMFORMER_MAX_CHANNELS];
+static int16_t output[TEST_HOP];
+
+// Channel c hears the source delays[c] samples late, plus its own noise.
+// Returns the output SNR (dB) over the last hops, against the source
+// BEAMFORMER_LATENCY samples behind channel 0; `input_snr` gets channel 0's.
+static double run(int channels, const double* delays, double noise_gain, double& input_snr) {
+    Source source;
+    beamformer.configure(channels);
+    double signal = 0.0, error = 0.0, input_error = 0.0;
+    for (int h = 0; h < TEST_HOPS; h++) {
+        for (int i = 0; i < TEST_HOP; i++) {
+            const double t = (double)h * TEST_HOP + i;
+            for (int c = 0; c < channels; c++) {
+                interleaved[i * channels + c] = (int16_t)lrint(source.at(t - delays[c]) + noise_gain * source.noise());
+            }
+        }
+        beamformer.process(interleaved, TEST_HOP, output);
+        if (h < TEST_HOPS / 2) continue; // Converging
+        for (int i = 0; i < TEST_HOP; i++) {
+            const double t = (double)h * TEST_HOP + i;
+            const double clean = source.at(t - delays[0] - BEAMFORMER_LATENCY);
+            signal += clean * clean;
+            error += (output[i] - clean) * (output[i] - clean);
+            const double heard = source.at(t - delays[0]);
+            input_error += (interleaved[i * channels] - heard) * (interleaved[i * channels] - heard);
+        }
+    }
+    input_snr = 10.0 * log10(signal / input_error);
+    return 10.0 * log10(signal / error);
+}
+
+// A pair with a fractional delay: GCC-PHAT finds it and the aligned sum
+// beats either microphone on its own.
+void test_pair_finds_fractional_delay() {
+    const double delays[2] = {0.0, 2.4};
+    double input_snr;
+    const double snr = run(2, delays, 1.0, input_snr);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 2.4f, beamformer.delay(1));
+    TEST_ASSERT_TRUE(beamformer.coherence(1) > BEAMFORMER_MIN_COHERENCE);
+    TEST_ASSERT_TRUE(snr > input_snr + 2.0);
+
+    // Silence leaves the steering where it was.
+    for (int i = 0; i < 2 * TEST_HOP; i++) interleaved[i] = 0;
+    for (int h = 0; h < 5; h++) beamformer.process(interleaved, TEST_HOP, output);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 2.4f, beamformer.delay(1));
+}
+
+// Every channel is steered against channel 0, leading or lagging.
+void test_array_steers_each_channel() {
+    const double delays[4] = {1.0, -2.0, 4.6, 1.0 + BEAMFORMER_MAX_LAG - 1};
+    double input_snr;
+    const double snr = run(4, delays, 0.5, input_snr);
+    for (int c = 1; c < 4; c++) TEST_ASSERT_FLOAT_WITHIN(0.3f, (float)(delays[c] - delays[0]), beamformer.delay(c));
+    TEST_ASSERT_TRUE(snr > input_snr + 4.0); // 6 dB at best for four
+
+    // One channel is passed through untouched.
+    beamformer.configure(1);
+    for (int i = 0; i < TEST_HOP; i++) interleaved[i] = (int16_t)(i * 31 - 9000);
+    beamformer.process(interleaved, TEST_HOP, output);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(interleaved, output, TEST_HOP);
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pair_finds_fractional_delay);
+    RUN_TEST(test_array_steers_each_channel);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
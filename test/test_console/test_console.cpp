@@ -0,0 +1,104 @@
+#include <unity.h>
+#include <cstring>
+#include "Console.h"
+#include "../common/TestSignal.h"
+
+static TestSignal test_signal(99);
+
+static WakeWordDetector detector;
+static Console console(detector);
+
+static void type(const char* text) {
+    console.feed(text, strlen(text));
+}
+
+static void startDetector() {
+    TEST_ASSERT_TRUE(detector.initPipeline());
+    detector.setVoiceGate(false);
+    detector.setThreshold(KWS_TRIGGER_THRESHOLD);
+    DetectorTuning tuning = detector.getTuning();
+    tuning.stride_hops = 1;
+    detector.tune(tuning);
+    console.begin();
+}
+
+// Commands arrive in arbitrary pieces and only take effect at the next hop.
+void test_tuning_applies_between_hops() {
+    startDetector();
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    type("thresh");
+    type("old 0.2");
+    type("5\r\nthreshold 7\n");
+    TEST_ASSERT_EQUAL_FLOAT(KWS_TRIGGER_THRESHOLD, detector.getThreshold());
+    test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+    detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, detector.getThreshold()); // "threshold 7" was rejected
+
+    type("vad on\nvad onset 6.5\nbogus\n");
+    test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+    detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    TEST_ASSERT_TRUE(detector.voiceGateEnabled());
+    TEST_ASSERT_EQUAL_FLOAT(6.5f, detector.getVoiceActivity().config().onset_ratio);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, detector.getThreshold());
+}
+
+void test_cadence_thins_inference() {
+    startDetector();
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    for (int h = 0; h < 24; h++) { // Fill the window
+        test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+        detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    }
+    type("cadence 4\n");
+    test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+    detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    const uint32_t before = detector.getInferenceCount();
+    for (int h = 0; h < 40; h++) {
+        test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+        detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, detector.getInferenceCount() - before);
+}
+
+// The bench runs on copies: the live stream must come out unchanged.
+void test_bench_leaves_the_stream_alone() {
+    startDetector();
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    for (int h = 0; h < 24; h++) {
+        test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+        detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    }
+    const StreamState before = detector.getStream();
+    DetectorBench bench;
+    TEST_ASSERT_FALSE(detector.takeBench(bench));
+    type("bench 3\n");
+    detector.processAudio(hop, 0);
+    TEST_ASSERT_TRUE(detector.takeBench(bench));
+    TEST_ASSERT_FALSE(detector.takeBench(bench));
+    TEST_ASSERT_EQUAL_UINT32(3, bench.repetitions);
+    TEST_ASSERT_TRUE(bench.inference_us > 0);
+    const StreamState& after = detector.getStream();
+    TEST_ASSERT_EQUAL_MEMORY(&before.features, &after.features, sizeof(FeatureState));
+    TEST_ASSERT_EQUAL_MEMORY(before.posteriors, after.posteriors, sizeof(before.posteriors));
+    TEST_ASSERT_EQUAL_UINT32(before.inference_count, after.inference_count);
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tuning_applies_between_hops);
+    RUN_TEST(test_cadence_thins_inference);
+    RUN_TEST(test_bench_leaves_the_stream_alone);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
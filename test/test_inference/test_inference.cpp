@@ -2,19 +2,148 @@
 #include "ManualDSCNN.h"
 #include "frontend_params.h"
 
+static ManualDSCNN model;
+
+void test_infer_requires_init() {
+    ManualDSCNN uninitialized;
+    int8_t input[KWS_FRAMES * KWS_NUM_MFCC] = {0};
+    float output[KWS_NUM_CLASSES];
+    TEST_ASSERT_FALSE(uninitialized.infer(input, output));
+}
+
 void test_inference_shape() {
+    TEST_ASSERT_TRUE(model.init());
     int8_t input[KWS_FRAMES * KWS_NUM_MFCC] = {0};
     float output[KWS_NUM_CLASSES];
-    ManualDSCNN::infer(input, output);
+    TEST_ASSERT_TRUE(model.infer(input, output));
+    float total = 0.0f;
     for (int i = 0; i < KWS_NUM_CLASSES; i++) {
-        TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, output[i]);  // Placeholder
+        TEST_ASSERT_TRUE(output[i] >= 0.0f && output[i] <= 1.0f);
+        total += output[i];
     }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, total);
 }
 
-void setup() {
+void test_inference_is_deterministic() {
+    int8_t input[KWS_FRAMES * KWS_NUM_MFCC];
+    for (int i = 0; i < KWS_FRAMES * KWS_NUM_MFCC; i++) input[i] = (int8_t)((i * 37) % 256 - 128);
+    float first[KWS_NUM_CLASSES], second[KWS_NUM_CLASSES];
+    TEST_ASSERT_TRUE(model.infer(input, first));
+    TEST_ASSERT_TRUE(model.infer(input, second));
+    for (int i = 0; i < KWS_NUM_CLASSES; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(first[i], second[i]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, first[KWS_LABEL_MARVIN_IDX], model.predict(input));
+}
+
+void test_batch_matches_single_inference() {
+    const int count = DSCNN_MAX_BATCH + 2; // Also crosses a batch split
+    static int8_t inputs[DSCNN_MAX_BATCH + 2][KWS_FRAMES * KWS_NUM_MFCC];
+    const int8_t* pointers[DSCNN_MAX_BATCH + 2];
+    for (int b = 0; b < count; b++) {
+        for (int i = 0; i < KWS_FRAMES * KWS_NUM_MFCC; i++) inputs[b][i] = (int8_t)((i * (7 + 6 * b)) % 256 - 128);
+        pointers[b] = inputs[b];
+    }
+    float batched[DSCNN_MAX_BATCH + 2][KWS_NUM_CLASSES];
+    TEST_ASSERT_TRUE(model.predictBatch(pointers, count, batched[0]));
+    for (int b = 0; b < count; b++) {
+        float single[KWS_NUM_CLASSES];
+        TEST_ASSERT_TRUE(model.infer(inputs[b], single));
+        for (int k = 0; k < KWS_NUM_CLASSES; k++) TEST_ASSERT_EQUAL_FLOAT(single[k], batched[b][k]);
+    }
+}
+
+void test_dual_core_matches_single_core() {
+    ManualDSCNN split;
+    TEST_ASSERT_TRUE(split.init());
+    TEST_ASSERT_TRUE(split.enableDualCore(0, 5));
+    int8_t input[KWS_FRAMES * KWS_NUM_MFCC];
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < KWS_FRAMES * KWS_NUM_MFCC; i++) input[i] = (int8_t)((i * (11 + round)) % 256 - 128);
+        float expected[KWS_NUM_CLASSES], actual[KWS_NUM_CLASSES];
+        TEST_ASSERT_TRUE(model.infer(input, expected));
+        TEST_ASSERT_TRUE(split.infer(input, actual));
+        for (int k = 0; k < KWS_NUM_CLASSES; k++) TEST_ASSERT_EQUAL_FLOAT(expected[k], actual[k]);
+    }
+    split.disableDualCore();
+}
+
+#if !DSCNN_BACKEND_AOT
+// Two copies of the built-in graph whose convolution weights are clamped to
+// int4 range: one keeps them as int8, the other packs two per byte. The
+// packed kernels must unpack every nibble, sign included, to the same value.
+static GraphNode wide_nodes[32], packed_nodes[32];
+static int8_t wide_weights[8192], packed_weights[8192];
+static ManualDSCNN wide_engine, packed_engine;
+
+void test_int4_weights_match_unpacked() {
+    const GraphModel& base = model.graph();
+    TEST_ASSERT_TRUE(base.node_count <= 32);
+    GraphModel wide = base, packed = base;
+    uint32_t wide_used = 0, packed_used = 0;
+    for (int n = 0; n < base.node_count; n++) {
+        const GraphNode& node = base.nodes[n];
+        const uint32_t count = graphWeightCount(base, node);
+        const bool narrow = node.op == OP_CONV2D || node.op == OP_DEPTHWISE || node.op == OP_POINTWISE;
+        TEST_ASSERT_TRUE(wide_used + count <= sizeof(wide_weights) && packed_used + count <= sizeof(packed_weights));
+        wide_nodes[n] = packed_nodes[n] = node;
+        wide_nodes[n].weights = wide_used;
+        packed_nodes[n].weights = packed_used;
+        for (uint32_t i = 0; i < count; i++) {
+            int w = base.weights[node.weights + i];
+            if (narrow) w = w < -8 ? -8 : w > 7 ? 7 : w;
+            wide_weights[wide_used + i] = (int8_t)w;
+            if (!narrow) {
+                packed_weights[packed_used + i] = (int8_t)w;
+            } else if (i & 1) {
+                packed_weights[packed_used + i / 2] |= (int8_t)(w << 4);
+            } else {
+                packed_weights[packed_used + i / 2] = (int8_t)(w & 0xF);
+            }
+        }
+        if (narrow) packed_nodes[n].weight_bits = 4;
+        wide_used += count;
+        packed_used += graphWeightBytes(base, packed_nodes[n]);
+    }
+    wide.nodes = wide_nodes;
+    wide.weights = wide_weights;
+    packed.nodes = packed_nodes;
+    packed.weights = packed_weights;
+    TEST_ASSERT_TRUE(wide_engine.init(wide));
+    TEST_ASSERT_TRUE(packed_engine.init(packed));
+
+    int8_t input[KWS_FRAMES * KWS_NUM_MFCC];
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < KWS_FRAMES * KWS_NUM_MFCC; i++) input[i] = (int8_t)((i * (13 + 2 * round)) % 256 - 128);
+        float expected[KWS_NUM_CLASSES], actual[KWS_NUM_CLASSES];
+        TEST_ASSERT_TRUE(wide_engine.infer(input, expected));
+        TEST_ASSERT_TRUE(packed_engine.infer(input, actual));
+        for (int k = 0; k < KWS_NUM_CLASSES; k++) TEST_ASSERT_EQUAL_FLOAT(expected[k], actual[k]);
+    }
+}
+#endif
+
+int runTests() {
     UNITY_BEGIN();
+    RUN_TEST(test_infer_requires_init);
     RUN_TEST(test_inference_shape);
-    UNITY_END();
+    RUN_TEST(test_inference_is_deterministic);
+    RUN_TEST(test_batch_matches_single_inference);
+    RUN_TEST(test_dual_core_matches_single_core);
+#if !DSCNN_BACKEND_AOT
+    RUN_TEST(test_int4_weights_match_unpacked);
+#endif
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
 }
 
-void loop() {}
\ No newline at end of file
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
@@ -0,0 +1,126 @@
+#include <unity.h>
+#include "WakeWordDetector.h"
+#include "model_graph.h"
+#include "../common/TestSignal.h"
+
+// Extra keywords run on the detector's own features and engine. The tree
+// ships one network, so the built-in graph stands in for every keyword.
+
+static TestSignal test_signal(4242);
+
+static KeywordSpec keyword(const char* name, float threshold, uint32_t cooldown_ms, uint8_t stride) {
+    return KeywordSpec{name, &model_graph, KWS_LABEL_MARVIN_IDX, threshold, cooldown_ms, stride};
+}
+
+static WakeWordDetector detector;
+
+static void startDetector() {
+    TEST_ASSERT_TRUE(detector.initPipeline());
+    detector.setVoiceGate(false);
+}
+
+#if DSCNN_BACKEND_AOT
+void test_keywords_need_the_interpreter() {
+    startDetector();
+    TEST_ASSERT_EQUAL_INT(-1, detector.addKeyword(keyword("twin", 0.5f, 0, 1)));
+}
+#else
+void test_keyword_sees_the_shared_features() {
+    startDetector();
+    const int id = detector.addKeyword(keyword("twin", 2.0f, 0, 1));
+    TEST_ASSERT_EQUAL_INT(1, id);
+    TEST_ASSERT_EQUAL_INT(-1, detector.addKeyword(keyword("odd", 0.5f, 0, 3)));
+    KeywordSpec bad_label = keyword("bad", 0.5f, 0, 1);
+    bad_label.label = KWS_NUM_CLASSES;
+    TEST_ASSERT_EQUAL_INT(-1, detector.addKeyword(bad_label));
+
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    for (int h = 0; h < 40; h++) {
+        test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+        detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+        const KeywordTrack& track = detector.getKeywordTrack(id);
+        TEST_ASSERT_EQUAL_UINT32(detector.getInferenceCount(), track.inference_count);
+        TEST_ASSERT_EQUAL_MEMORY(detector.getLastProbabilities(), track.posteriors, KWS_NUM_CLASSES * sizeof(float));
+    }
+    TEST_ASSERT_TRUE(detector.getInferenceCount() > 0);
+}
+
+void test_cadences_are_staggered() {
+    WakeWordDetector& d = detector;
+    startDetector(); // Drops the previous test's keywords
+    const int a = d.addKeyword(keyword("even", 2.0f, 0, 2));
+    const int b = d.addKeyword(keyword("odd", 2.0f, 0, 2));
+    const int c = d.addKeyword(keyword("rare", 2.0f, 0, 4));
+    const KeywordBank& bank = d.getKeywordBank();
+    TEST_ASSERT_TRUE(bank.phase(a - 1) != bank.phase(b - 1));
+    // Two models every other hop and one every fourth: no hop needs more
+    // than two.
+    TEST_ASSERT_EQUAL_UINT32(2 * graphMacs(model_graph), bank.peakMacs());
+
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    uint32_t before[4] = {};
+    for (int h = 0; h < 32; h++) {
+        test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+        const uint32_t primary = d.getInferenceCount();
+        d.processAudio(hop, DETECTOR_HOP_SAMPLES);
+        if (d.getInferenceCount() == primary) continue;
+        int ran = 0;
+        for (int id = a; id <= c; id++) {
+            if (d.getKeywordTrack(id).inference_count != before[id]) ran++;
+            before[id] = d.getKeywordTrack(id).inference_count;
+        }
+        TEST_ASSERT_TRUE(ran >= 1 && ran <= 2);
+    }
+    TEST_ASSERT_EQUAL_UINT32(before[a], before[b]);
+    TEST_ASSERT_TRUE(before[c] * 2 <= before[a] + 1 && before[c] * 2 + 2 >= before[a]);
+}
+
+void test_threshold_and_cooldown_are_per_keyword() {
+    startDetector();
+    detector.setThreshold(2.0f); // Built-in model never fires
+    const int always = detector.addKeyword(keyword("always", -1.0f, 1000, 1));
+    const int never = detector.addKeyword(keyword("never", 2.0f, 0, 1));
+
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    int last_fire = -1, fires = 0;
+    for (int h = 0; h < 80; h++) {
+        test_signal.noiseHop(hop, DETECTOR_HOP_SAMPLES);
+        const bool fired = detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+        TEST_ASSERT_EQUAL(fired, detector.getFiredKeywords() != 0);
+        TEST_ASSERT_FALSE(detector.getFiredKeywords() & ((1u << never) | 1u));
+        if (detector.getFiredKeywords() & (1u << always)) {
+            // 1000 ms is 16.7 hops: every 17th hop once the window is full.
+            if (last_fire >= 0) TEST_ASSERT_EQUAL_INT(17, h - last_fire);
+            last_fire = h;
+            fires++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(fires, (int)detector.getKeywordTrack(always).detection_count);
+    TEST_ASSERT_TRUE(fires >= 3);
+    detector.setThreshold(KWS_TRIGGER_THRESHOLD);
+}
+#endif
+
+int runTests() {
+    UNITY_BEGIN();
+#if DSCNN_BACKEND_AOT
+    RUN_TEST(test_keywords_need_the_interpreter);
+#else
+    RUN_TEST(test_keyword_sees_the_shared_features);
+    RUN_TEST(test_cadences_are_staggered);
+    RUN_TEST(test_threshold_and_cooldown_are_per_keyword);
+#endif
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
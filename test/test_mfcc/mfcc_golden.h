@@ -0,0 +1,81 @@
+#ifndef MFCC_GOLDEN_H
+#define MFCC_GOLDEN_H
+
+// Generated by tools/mfcc_reference.py, do not edit. tf.signal MFCCs of
+// 8000 sin(440 Hz) + 3000 sin(1370 Hz) + TestSignal(3).noiseSample(): 30 ms frames every 15 ms,
+// 512-point FFT, 40 mel bands over 20-4000 Hz, quantized with the scale
+// and zero point below.
+
+#define MFCC_GOLDEN_SEED 3
+#define MFCC_GOLDEN_SCALE 0.04f
+#define MFCC_GOLDEN_ZERO_POINT -20
+
+static const int8_t mfcc_golden[65 * 10] = {
+    82, -73, -52, -55, -58, -78, -39, 32, 34, -1,
+    93, -74, -48, -43, -60, -98, -62, 4, 9, 2,
+    71, -80, -43, -28, -30, -111, -51, 25, 28, 15,
+    105, -76, -31, -48, -52, -80, -40, 18, 24, -8,
+    79, -73, -41, -58, -56, -102, -26, 16, 15, -6,
+    82, -71, -41, -41, -55, -89, -25, 42, 36, 12,
+    92, -54, -15, -43, -51, -95, -42, 47, 28, -5,
+    68, -61, -44, -55, -76, -87, -39, 44, 16, -9,
+    96, -64, -32, -48, -49, -85, -28, 34, 27, -6,
+    59, -72, -56, -57, -59, -106, -69, 37, 28, -24,
+    87, -75, -50, -55, -62, -67, -34, 20, 20, -5,
+    65, -76, -40, -69, -65, -78, -26, 38, 36, -5,
+    77, -81, -43, -53, -66, -78, -43, 19, 35, 2,
+    70, -78, -50, -47, -58, -89, -42, 15, 43, 18,
+    71, -80, -26, -44, -63, -94, -36, 40, 26, -12,
+    81, -66, -41, -63, -53, -83, -26, 34, 25, 1,
+    53, -66, -17, -21, -50, -100, -73, 28, 42, 1,
+    60, -84, -46, -55, -61, -77, -40, 35, 30, 2,
+    68, -96, -57, -45, -57, -86, -45, 34, 56, 8,
+    73, -82, -47, -36, -63, -87, -43, 38, 42, 13,
+    90, -75, -47, -50, -41, -94, -62, 10, 36, -13,
+    74, -69, -54, -58, -59, -94, -43, 26, 14, 3,
+    103, -59, -36, -55, -59, -86, -38, 24, 16, 0,
+    81, -71, -41, -47, -62, -99, -37, 27, 18, -4,
+    93, -58, -46, -28, -50, -100, -37, 21, 26, -15,
+    85, -72, -33, -38, -77, -101, -40, 20, 4, -18,
+    72, -74, -52, -49, -51, -83, -38, 20, 21, 17,
+    91, -66, -33, -50, -47, -82, -34, 35, 34, 1,
+    78, -60, -58, -71, -66, -90, -45, 27, 16, -10,
+    65, -74, -55, -54, -49, -91, -41, 42, 30, -15,
+    82, -65, -54, -63, -57, -98, -54, 35, 21, -2,
+    91, -55, -10, -63, -53, -80, -39, 36, 14, -10,
+    76, -70, -43, -48, -49, -79, -43, 42, 26, 1,
+    58, -78, -42, -46, -65, -100, -42, 33, 25, 1,
+    68, -73, -33, -37, -47, -91, -31, 27, 28, -14,
+    62, -71, -33, -38, -55, -96, -41, 26, 24, 11,
+    68, -76, -43, -55, -69, -105, -44, 39, 15, -6,
+    83, -65, -29, -47, -49, -82, -46, 35, 21, -3,
+    96, -59, -32, -49, -40, -100, -38, 31, 19, -3,
+    59, -68, -18, -43, -67, -80, -38, 35, 31, -18,
+    82, -62, -33, -51, -50, -82, -27, 25, 15, -8,
+    81, -66, -55, -65, -54, -107, -44, 9, 28, 6,
+    111, -62, -36, -39, -54, -85, -38, 19, 11, 6,
+    92, -65, -56, -61, -65, -99, -40, 23, 24, -10,
+    55, -83, -32, -65, -64, -116, -40, 27, 9, -1,
+    78, -60, -34, -44, -58, -95, -55, 37, 2, -6,
+    92, -65, -44, -44, -53, -75, -34, 26, 34, 11,
+    81, -65, -54, -50, -44, -104, -64, 10, 17, 12,
+    87, -66, -43, -63, -47, -96, -38, 33, 19, 2,
+    85, -80, -54, -53, -75, -99, -54, 19, 38, -2,
+    106, -70, -39, -53, -41, -82, -53, 28, 21, 7,
+    80, -55, -25, -48, -55, -98, -40, 29, 12, -5,
+    72, -81, -38, -55, -27, -83, -31, 37, 40, 19,
+    110, -51, -33, -31, -53, -80, -31, 31, 18, -13,
+    108, -58, -34, -15, -37, -85, -44, 36, 27, 8,
+    99, -58, -29, -39, -60, -89, -49, 10, 18, -13,
+    82, -55, -57, -76, -53, -82, -39, 28, 23, -4,
+    72, -80, -51, -46, -66, -99, -40, 25, 22, 4,
+    89, -69, -37, -52, -52, -77, -41, 41, 26, -2,
+    77, -74, -42, -49, -52, -71, -43, 43, 32, 0,
+    51, -82, -32, -38, -60, -117, -52, 30, 25, 4,
+    71, -59, -35, -65, -60, -90, -45, 21, 15, -13,
+    96, -77, -27, -39, -59, -70, -39, 30, 28, -2,
+    64, -75, -40, -53, -53, -91, -30, 37, 24, 7,
+    88, -51, -35, -60, -48, -101, -59, 37, 22, -1,
+};
+
+#endif
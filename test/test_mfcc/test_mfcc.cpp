@@ -0,0 +1,124 @@
+#include <unity.h>
+#include <cmath>
+#include <cstring>
+#include "AudioProcessor.h"
+#include "ManualDSCNN.h"
+#include "mfcc_golden.h"
+#include "../common/TestSignal.h"
+
+static int16_t audio[KWS_WINDOW_SAMPLES];
+static AudioProcessor processor;
+
+static void fillTone(float hz, float amplitude) {
+    for (int i = 0; i < KWS_WINDOW_SAMPLES; i++) {
+        audio[i] = (int16_t)(amplitude * sinf(2.0f * 3.14159265f * hz * i / KWS_SAMPLE_RATE_HZ));
+    }
+}
+
+void setUp() {
+    processor.setInputQuantization(ManualDSCNN::inputScale(), ManualDSCNN::inputZeroPoint());
+}
+
+void test_window_yields_exactly_one_model_input() {
+    fillTone(440.0f, 8000.0f);
+    processor.reset();
+    int frames = processor.processSamples(audio, KWS_WINDOW_SAMPLES - 1);
+    TEST_ASSERT_EQUAL_INT(KWS_FRAMES - 1, frames);
+    TEST_ASSERT_FALSE(processor.featuresReady());
+    TEST_ASSERT_EQUAL_INT(1, processor.processSamples(audio + KWS_WINDOW_SAMPLES - 1, 1));
+    TEST_ASSERT_TRUE(processor.featuresReady());
+}
+
+void test_streaming_matches_one_shot() {
+    fillTone(1000.0f, 6000.0f);
+    int8_t one_shot[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.computeMFCC(audio, one_shot);
+
+    processor.reset();
+    for (size_t offset = 0, chunk = 1; offset < KWS_WINDOW_SAMPLES; offset += chunk, chunk = chunk * 3 % 401 + 1) {
+        size_t count = chunk < KWS_WINDOW_SAMPLES - offset ? chunk : KWS_WINDOW_SAMPLES - offset;
+        processor.processSamples(audio + offset, count);
+    }
+    int8_t streamed[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.copyFeatures(streamed);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(one_shot, streamed, KWS_FRAMES * KWS_NUM_MFCC);
+}
+
+void test_history_keeps_the_latest_frames() {
+    // KWS_WINDOW_SAMPLES is a whole number of strides, so after two windows
+    // the history must hold exactly the second one.
+    fillTone(300.0f, 8000.0f);
+    static int16_t first[KWS_WINDOW_SAMPLES];
+    memcpy(first, audio, sizeof(first));
+    fillTone(2500.0f, 3000.0f);
+    int8_t expected[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.computeMFCC(audio, expected);
+
+    processor.reset();
+    processor.processSamples(first, KWS_WINDOW_SAMPLES);
+    processor.processSamples(audio, KWS_WINDOW_SAMPLES);
+    int8_t features[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.copyFeatures(features);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(expected, features, KWS_FRAMES * KWS_NUM_MFCC);
+}
+
+// The signal tools/mfcc_reference.py runs through its tf.signal model.
+static void fillGolden() {
+    TestSignal noise(MFCC_GOLDEN_SEED);
+    for (int i = 0; i < KWS_WINDOW_SAMPLES; i++) {
+        double t = 2.0 * 3.14159265358979323846 * i / KWS_SAMPLE_RATE_HZ;
+        audio[i] = (int16_t)(8000.0 * sin(440.0 * t) + 3000.0 * sin(1370.0 * t) + noise.noiseSample());
+    }
+}
+
+// float against the reference's double: a coefficient on a rounding
+// boundary may land one step away, but no further and not often.
+void test_matches_the_tf_signal_reference() {
+    fillGolden();
+    processor.setInputQuantization(MFCC_GOLDEN_SCALE, MFCC_GOLDEN_ZERO_POINT);
+    int8_t features[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.computeMFCC(audio, features);
+    int off_by_one = 0;
+    for (int i = 0; i < KWS_FRAMES * KWS_NUM_MFCC; i++) {
+        TEST_ASSERT_INT_WITHIN_MESSAGE(1, mfcc_golden[i], features[i], "coefficient differs from tf.signal");
+        if (features[i] != mfcc_golden[i]) off_by_one++;
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(KWS_FRAMES * KWS_NUM_MFCC / 100, off_by_one);
+}
+
+void test_silence_is_constant_and_quieter_than_a_tone() {
+    memset(audio, 0, sizeof(audio));
+    int8_t silence[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.computeMFCC(audio, silence);
+    for (int f = 1; f < KWS_FRAMES; f++) {
+        TEST_ASSERT_EQUAL_INT8_ARRAY(silence, silence + f * KWS_NUM_MFCC, KWS_NUM_MFCC);
+    }
+
+    fillTone(440.0f, 8000.0f);
+    int8_t tone[KWS_FRAMES * KWS_NUM_MFCC];
+    processor.computeMFCC(audio, tone);
+    // Coefficient 0 tracks log energy.
+    TEST_ASSERT_TRUE(tone[KWS_NUM_MFCC * 10] > silence[0]);
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_window_yields_exactly_one_model_input);
+    RUN_TEST(test_streaming_matches_one_shot);
+    RUN_TEST(test_history_keeps_the_latest_frames);
+    RUN_TEST(test_silence_is_constant_and_quieter_than_a_tone);
+    RUN_TEST(test_matches_the_tf_signal_reference);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
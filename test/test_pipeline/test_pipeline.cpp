@@ -0,0 +1,124 @@
+#include <unity.h>
+#include <vector>
+#include "Stages.h"
+#include "../common/TestSignal.h"
+
+// A composed pipeline must compute exactly what the shared Model does over
+// the same audio: same windows, same posteriors, same triggers.
+
+static TestSignal test_signal(7);
+
+static void noiseHop(HopBlock& hop, int h) {
+    for (int i = 0; i < DETECTOR_HOP_SAMPLES; i++) {
+        const int noise = test_signal.noiseSample();
+        const int tone = (h / 10) % 2 ? (int)(4000 * sinf(0.3f * (h * DETECTOR_HOP_SAMPLES + i))) : 0;
+        hop.data[i] = (int16_t)(noise + tone);
+    }
+}
+
+// Copies the posteriors on their way to the trigger logic.
+struct Recorder {
+    typedef PosteriorBlock Input;
+    typedef PosteriorBlock Output;
+
+    std::vector<float> posteriors;
+
+    template<typename Next>
+    void push(Input& in, PipelineContext& context, Next& next) {
+        posteriors.insert(posteriors.end(), in.data, in.data + KWS_NUM_CLASSES);
+        next.push(in, context);
+    }
+};
+
+static void collect(const Detection& detection, void* context) {
+    static_cast<std::vector<uint64_t>*>(context)->push_back(detection.sample);
+}
+
+// Every stage in one chain, microphone to sink: the block shapes must line up.
+#if AUDIO_CAPTURE_CHANNELS > 1
+typedef Pipeline<CaptureSource, BeamformStage<AUDIO_CAPTURE_CHANNELS>, ConditionStage, VadStage, FramingStage,
+                 MfccStage, WindowStage<>, ModelStage, PosteriorStage, CallbackSink> FullPipeline;
+#else
+typedef Pipeline<CaptureSource, ConditionStage, VadStage, FramingStage, MfccStage, WindowStage<>, ModelStage,
+                 PosteriorStage, CallbackSink> FullPipeline;
+#endif
+static_assert(FullPipeline::size == 9 + (AUDIO_CAPTURE_CHANNELS > 1), "the full chain must compose");
+
+typedef Pipeline<FramingStage, MfccStage, WindowStage<>, ModelStage, Recorder, PosteriorStage, CallbackSink>
+    ReplayPipeline;
+
+static Workspace workspace;
+static ReplayPipeline pipeline;
+
+void test_pipeline_matches_the_model() {
+    TEST_ASSERT_TRUE(workspace.init());
+    pipeline.stage<3>().bind(workspace.engine);
+    pipeline.stage<5>().setThreshold(0.0f); // Cooldown decides when it fires
+    std::vector<uint64_t> fired;
+    pipeline.stage<6>().setHandler(collect, &fired);
+
+    Model model;
+    model.setThreshold(0.0f);
+    StreamState stream;
+    std::vector<float> expected_posteriors;
+    std::vector<uint64_t> expected_fired;
+
+    PipelineContext context;
+    HopBlock hop;
+    for (int h = 0; h < 120; h++) {
+        noiseHop(hop, h);
+        const int16_t* samples = hop.data;
+        size_t count = DETECTOR_HOP_SAMPLES;
+        while (model.feed(stream, workspace, samples, count)) {
+            TEST_ASSERT_TRUE(model.infer(stream, workspace));
+            expected_posteriors.insert(expected_posteriors.end(), stream.posteriors,
+                                       stream.posteriors + KWS_NUM_CLASSES);
+            if (model.decide(stream)) expected_fired.push_back(stream.samples_processed);
+        }
+        pipeline.push(hop, context);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(stream.inference_count, pipeline.stage<3>().inferences());
+    TEST_ASSERT_EQUAL_UINT32(expected_posteriors.size(), pipeline.stage<4>().posteriors.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected_posteriors.data(), pipeline.stage<4>().posteriors.data(),
+                             expected_posteriors.size() * sizeof(float));
+    TEST_ASSERT_TRUE(expected_fired.size() >= 3);
+    TEST_ASSERT_EQUAL_UINT32(expected_fired.size(), fired.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected_fired.data(), fired.data(), fired.size() * sizeof(uint64_t));
+    TEST_ASSERT_EQUAL_UINT32(fired.size(), pipeline.stage<6>().count());
+}
+
+// Cadence and gating are properties of the composition.
+void test_cadence_and_gate_compose() {
+    static Pipeline<VadStage, FramingStage, MfccStage, WindowStage<8>, ModelStage> sparse;
+    sparse.stage<4>().bind(workspace.engine);
+    PipelineContext context;
+    HopBlock hop;
+    for (int h = 0; h < 100; h++) {
+        noiseHop(hop, h < 50 || h >= 60 ? 0 : 10); // A tone at 3-3.6 s, else noise
+        sparse.push(hop, context);
+    }
+    const ModelStage& model = sparse.stage<4>();
+    // 100 hops complete 399 frames: windows at frames 65, 73, ... 393.
+    TEST_ASSERT_EQUAL_UINT32(42, model.inferences() + model.skipped());
+    TEST_ASSERT_TRUE(model.skipped() > 0 && model.inferences() > 0);
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pipeline_matches_the_model);
+    RUN_TEST(test_cadence_and_gate_compose);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
@@ -0,0 +1,177 @@
+#include <unity.h>
+#include <vector>
+#include "WakeWordDetector.h"
+
+// Every sample says where it is in the stream, so a view can be checked
+// against the position it claims.
+static int16_t sampleAt(uint64_t position) {
+    return (int16_t)((position * 37) % 8000) - 4000;
+}
+
+struct Received {
+    AudioEventType type;
+    uint32_t keywords;
+    uint64_t keyword_start;
+    uint64_t keyword_end;
+    uint64_t start;
+    size_t count;
+    uint64_t skipped;
+    bool wrapped;
+    bool intact;
+};
+
+struct Consumer {
+    std::vector<Received> events;
+    size_t stream_hops; // STREAM events wanted after each detection
+    size_t left;
+};
+
+static bool consume(const AudioEvent& event, void* context) {
+    Consumer& consumer = *static_cast<Consumer*>(context);
+    Received r = {event.type, event.keywords, event.keyword_start, event.keyword_end, event.audio.start,
+                  event.audio.count(), event.skipped, event.audio.second != nullptr, true};
+    for (size_t i = 0; i < event.audio.count(); i++) {
+        const int16_t s = i < event.audio.first_count ? event.audio.first[i]
+                                                      : event.audio.second[i - event.audio.first_count];
+        if (s != sampleAt(event.audio.start + i)) r.intact = false;
+    }
+    consumer.events.push_back(r);
+    if (event.type == AUDIO_EVENT_DETECTION) consumer.left = consumer.stream_hops;
+    return consumer.left-- > 0;
+}
+
+static WakeWordDetector detector;
+
+// A detection hands over the whole pre-roll, then the stream follows from
+// the same ring without a gap until the consumer lets go.
+void test_detection_hands_off_preroll_then_stream() {
+    TEST_ASSERT_TRUE(detector.initPipeline());
+    detector.setVoiceGate(false);
+    detector.setThreshold(-1.0f); // Every window fires; the cooldown spaces them
+    Consumer consumer = {};
+    consumer.stream_hops = 5;
+    detector.setAudioConsumer(consume, &consumer);
+
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    uint64_t position = 0;
+    for (int h = 0; h < 60; h++) {
+        for (int i = 0; i < DETECTOR_HOP_SAMPLES; i++) hop[i] = sampleAt(position + i);
+        position += DETECTOR_HOP_SAMPLES;
+        detector.processAudio(hop, DETECTOR_HOP_SAMPLES);
+    }
+
+    // The first window is complete 16.5 hops in: all of it is pre-roll.
+    TEST_ASSERT_EQUAL_UINT32(2 * (1 + consumer.stream_hops), consumer.events.size());
+    const Received& first = consumer.events[0];
+    TEST_ASSERT_EQUAL(AUDIO_EVENT_DETECTION, first.type);
+    TEST_ASSERT_EQUAL_UINT32(1u, first.keywords);
+    TEST_ASSERT_EQUAL_UINT32(KWS_WINDOW_SAMPLES, first.keyword_end);
+    TEST_ASSERT_EQUAL_UINT32(0, first.keyword_start);
+    TEST_ASSERT_EQUAL_UINT32(0, first.start);
+    TEST_ASSERT_EQUAL_UINT32(17 * DETECTOR_HOP_SAMPLES, first.count);
+
+    uint64_t end = first.start + first.count;
+    for (size_t i = 1; i <= consumer.stream_hops; i++) {
+        const Received& next = consumer.events[i];
+        TEST_ASSERT_EQUAL(AUDIO_EVENT_STREAM, next.type);
+        TEST_ASSERT_EQUAL_UINT32(end, next.start);
+        TEST_ASSERT_EQUAL_UINT32(DETECTOR_HOP_SAMPLES, next.count);
+        TEST_ASSERT_EQUAL_UINT32(0, next.skipped);
+        end = next.start + next.count;
+    }
+
+    // After the cooldown: a full ring that has wrapped, ending at the hop.
+    const Received& second = consumer.events[1 + consumer.stream_hops];
+    TEST_ASSERT_EQUAL(AUDIO_EVENT_DETECTION, second.type);
+    TEST_ASSERT_TRUE(second.keyword_end > first.keyword_end + DETECTION_COOLDOWN_MS * KWS_SAMPLE_RATE_HZ / 1000);
+    TEST_ASSERT_EQUAL_UINT32(second.keyword_end - KWS_WINDOW_SAMPLES, second.keyword_start);
+    TEST_ASSERT_EQUAL_UINT32(DETECTOR_PREROLL_SAMPLES, second.count);
+    TEST_ASSERT_TRUE(second.keyword_end <= second.start + second.count);
+    TEST_ASSERT_TRUE(second.keyword_end + DETECTOR_HOP_SAMPLES > second.start + second.count);
+    for (size_t i = 0; i < consumer.events.size(); i++) TEST_ASSERT_TRUE(consumer.events[i].intact);
+    TEST_ASSERT_TRUE(second.wrapped);
+    detector.setAudioConsumer(nullptr, nullptr);
+}
+
+// A chunk longer than the ring overwrites audio the consumer has not had;
+// the event says how much.
+void test_oversized_chunk_reports_gap() {
+    TEST_ASSERT_TRUE(detector.initPipeline());
+    detector.setVoiceGate(false);
+    detector.setThreshold(-1.0f);
+    Consumer consumer = {};
+    consumer.stream_hops = 100;
+    detector.setAudioConsumer(consume, &consumer);
+
+    static int16_t chunk[DETECTOR_PREROLL_SAMPLES + 3 * DETECTOR_HOP_SAMPLES];
+    uint64_t position = 0;
+    for (int h = 0; h < 20; h++) { // Past the first detection: streaming
+        for (int i = 0; i < DETECTOR_HOP_SAMPLES; i++) chunk[i] = sampleAt(position + i);
+        position += DETECTOR_HOP_SAMPLES;
+        detector.processAudio(chunk, DETECTOR_HOP_SAMPLES);
+    }
+    TEST_ASSERT_FALSE(consumer.events.empty());
+    const size_t length = sizeof(chunk) / sizeof(chunk[0]);
+    for (size_t i = 0; i < length; i++) chunk[i] = sampleAt(position + i);
+    position += length;
+    detector.processAudio(chunk, length);
+
+    const Received& last = consumer.events.back();
+    TEST_ASSERT_EQUAL_UINT32(3 * DETECTOR_HOP_SAMPLES, last.skipped);
+    TEST_ASSERT_EQUAL_UINT32(position - DETECTOR_PREROLL_SAMPLES, last.start);
+    TEST_ASSERT_EQUAL_UINT32(DETECTOR_PREROLL_SAMPLES, last.count);
+    TEST_ASSERT_TRUE(last.intact);
+    detector.setAudioConsumer(nullptr, nullptr);
+}
+
+// In-place writes keep positions exact when the ring has to realign.
+void test_reserve_keeps_positions() {
+    static int16_t storage[2 * DETECTOR_HOP_SAMPLES];
+    AudioHistory history(storage, 2 * DETECTOR_HOP_SAMPLES);
+    int16_t samples[2 * DETECTOR_HOP_SAMPLES];
+    for (int i = 0; i < 2 * DETECTOR_HOP_SAMPLES; i++) samples[i] = sampleAt(i);
+
+    history.append(samples, 2 * DETECTOR_HOP_SAMPLES);
+    int16_t* slot = history.reserve(DETECTOR_HOP_SAMPLES); // Overwrites the oldest hop
+    TEST_ASSERT_EQUAL_UINT32(DETECTOR_HOP_SAMPLES, history.begin());
+    for (int i = 0; i < DETECTOR_HOP_SAMPLES; i++) slot[i] = sampleAt(2 * DETECTOR_HOP_SAMPLES + i);
+    history.commit(DETECTOR_HOP_SAMPLES);
+
+    AudioSpans spans;
+    TEST_ASSERT_FALSE(history.view(0, history.end(), spans));
+    TEST_ASSERT_TRUE(history.view(history.begin(), history.end(), spans));
+    TEST_ASSERT_EQUAL_UINT32(DETECTOR_HOP_SAMPLES, spans.first_count);
+    TEST_ASSERT_EQUAL_UINT32(DETECTOR_HOP_SAMPLES, spans.second_count);
+    TEST_ASSERT_EQUAL(sampleAt(DETECTOR_HOP_SAMPLES), spans.first[0]);
+    TEST_ASSERT_EQUAL(sampleAt(2 * DETECTOR_HOP_SAMPLES), spans.second[0]);
+
+    // Half a hop out of step: the next slot would wrap, so history restarts.
+    history.append(samples, DETECTOR_HOP_SAMPLES / 2);
+    const uint64_t end = history.end();
+    history.reserve(DETECTOR_HOP_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(end, history.begin());
+    history.commit(DETECTOR_HOP_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(end + DETECTOR_HOP_SAMPLES, history.end());
+    TEST_ASSERT_TRUE(history.view(end, history.end(), spans));
+    TEST_ASSERT_NULL(spans.second);
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_detection_hands_off_preroll_then_stream);
+    RUN_TEST(test_oversized_chunk_reports_gap);
+    RUN_TEST(test_reserve_keeps_positions);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
@@ -0,0 +1,137 @@
+#include <unity.h>
+#include <cmath>
+#include <vector>
+#include "../common/TestSignal.h"
+
+// tools/host/common is not a library the test build links; compile the one
+// source under test into the suite.
+#include "../../tools/host/common/Resampler.cpp"
+
+static const double PI_D = 3.14159265358979323846;
+static const uint32_t RATES[] = {44100, 48000};
+
+static std::vector<int16_t> tone(uint32_t rate, double hz, double amplitude, size_t count) {
+    std::vector<int16_t> samples(count);
+    for (size_t i = 0; i < count; i++) samples[i] = (int16_t)lround(amplitude * sin(2.0 * PI_D * hz * i / rate));
+    return samples;
+}
+
+// The whole stream through one process() call, then the tail.
+static std::vector<int16_t> oneShot(Resampler& resampler, const std::vector<int16_t>& in) {
+    resampler.reset();
+    std::vector<int16_t> out(resampler.maxOutput(in.size() + RESAMPLER_TAPS));
+    size_t produced = resampler.process(in.data(), in.size(), out.data());
+    produced += resampler.flush(RESAMPLER_TAPS, out.data() + produced);
+    out.resize(produced);
+    return out;
+}
+
+static double rms(const std::vector<int16_t>& samples, size_t begin, size_t end) {
+    double sum = 0.0;
+    for (size_t i = begin; i < end; i++) sum += (double)samples[i] * samples[i];
+    return sqrt(sum / (end - begin));
+}
+
+void test_block_splits_do_not_change_the_output() {
+    TestSignal test_signal(11);
+    std::vector<int16_t> in(20000);
+    for (int16_t& v : in) v = (int16_t)(test_signal.noise() * 20000.0f);
+    for (uint32_t rate : RATES) {
+        Resampler resampler;
+        TEST_ASSERT_TRUE(resampler.configure(rate, 16000));
+        const std::vector<int16_t> expected = oneShot(resampler, in);
+
+        resampler.reset();
+        std::vector<int16_t> out(expected.size() + in.size());
+        size_t produced = 0;
+        for (size_t offset = 0; offset < in.size();) {
+            // 1 sample up to several filter lengths, so blocks end inside and
+            // beyond the K-1 samples of history.
+            size_t count = 1 + test_signal.bits() % 300;
+            if (count > in.size() - offset) count = in.size() - offset;
+            produced += resampler.process(in.data() + offset, count, out.data() + produced);
+            offset += count;
+        }
+        produced += resampler.flush(RESAMPLER_TAPS, out.data() + produced);
+        TEST_ASSERT_EQUAL_UINT32(expected.size(), produced);
+        TEST_ASSERT_EQUAL_INT16_ARRAY(expected.data(), out.data(), expected.size());
+    }
+}
+
+void test_seek_resumes_the_same_stream() {
+    TestSignal test_signal(12);
+    std::vector<int16_t> in(20000);
+    for (int16_t& v : in) v = (int16_t)(test_signal.noise() * 20000.0f);
+    for (uint32_t rate : RATES) {
+        Resampler resampler;
+        TEST_ASSERT_TRUE(resampler.configure(rate, 16000));
+        const std::vector<int16_t> expected = oneShot(resampler, in);
+        const uint64_t targets[] = {0, 1, 7, 160, 3001, 5000};
+        for (uint64_t target : targets) {
+            const uint64_t from = resampler.seek(target);
+            TEST_ASSERT_TRUE(from <= target * rate / 16000);
+            std::vector<int16_t> out(resampler.maxOutput(in.size() - from));
+            const size_t produced = resampler.process(in.data() + from, in.size() - from, out.data());
+            TEST_ASSERT_TRUE(produced > 1000);
+            TEST_ASSERT_EQUAL_INT16_ARRAY(expected.data() + target, out.data(), 1000);
+        }
+    }
+}
+
+// Output n lines up with input time n / 16000 s, so a passband tone must
+// come out as the same sine sampled at 16 kHz.
+void test_passband_tones_come_through_unchanged() {
+    const double tones[] = {440.0, 1000.0, 3500.0};
+    for (uint32_t rate : RATES) {
+        Resampler resampler;
+        TEST_ASSERT_TRUE(resampler.configure(rate, 16000));
+        for (double hz : tones) {
+            const std::vector<int16_t> out = oneShot(resampler, tone(rate, hz, 16000.0, rate));
+            double error = 0.0;
+            const size_t begin = RESAMPLER_TAPS, end = 15000; // Away from both edges
+            for (size_t n = begin; n < end; n++) {
+                const double ideal = 16000.0 * sin(2.0 * PI_D * hz * n / 16000.0);
+                error += (out[n] - ideal) * (out[n] - ideal);
+            }
+            const double error_db = 20.0 * log10(sqrt(error / (end - begin)) / (16000.0 / sqrt(2.0)));
+            TEST_ASSERT_TRUE(error_db < -75.0); // 2 LSB rms at this level
+        }
+    }
+}
+
+// Above the 8 kHz output Nyquist rate a tone has nowhere to go but an alias.
+// The stopband starts about a tenth of the input rate above the -6 dB point
+// (7.2 kHz), so these sit past the transition band.
+void test_stopband_tones_do_not_alias() {
+    const double tones[] = {10500.0, 12500.0, 15000.0};
+    for (uint32_t rate : RATES) {
+        Resampler resampler;
+        TEST_ASSERT_TRUE(resampler.configure(rate, 16000));
+        for (double hz : tones) {
+            const std::vector<int16_t> out = oneShot(resampler, tone(rate, hz, 16000.0, rate));
+            const double level_db = 20.0 * log10(rms(out, RESAMPLER_TAPS, 15000) / (16000.0 / sqrt(2.0)));
+            TEST_ASSERT_TRUE(level_db < -75.0);
+        }
+    }
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_block_splits_do_not_change_the_output);
+    RUN_TEST(test_seek_resumes_the_same_stream);
+    RUN_TEST(test_passband_tones_come_through_unchanged);
+    RUN_TEST(test_stopband_tones_do_not_alias);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
@@ -0,0 +1,163 @@
+#include <unity.h>
+#include <cmath>
+#include "VoiceActivity.h"
+#include "WakeWordDetector.h"
+#include "../common/TestSignal.h"
+
+// Conditioned audio as the detector sees it: steady noise at rms ~200,
+// a voiced "word" (150 Hz harmonics, ~22 dB up), quiet hiss bursts and hum.
+
+static const float PI_F = 3.14159265f;
+
+static TestSignal test_signal(12345);
+
+static void room(int16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) out[i] = (int16_t)(350.0f * test_signal.noise());
+}
+
+static void voiced(int16_t* out, size_t count, size_t offset) {
+    for (size_t i = 0; i < count; i++) {
+        float t = (float)(offset + i) / KWS_SAMPLE_RATE_HZ;
+        float v = 0.0f;
+        for (int h = 1; h <= 6; h++) v += sinf(2.0f * PI_F * 150.0f * h * t) / h;
+        out[i] = (int16_t)(3000.0f * v + 350.0f * test_signal.noise());
+    }
+}
+
+static void feedFrames(VoiceActivity& gate, void (*source)(int16_t*, size_t), int frames) {
+    int16_t frame[KWS_STRIDE_SAMPLES];
+    for (int f = 0; f < frames; f++) {
+        source(frame, KWS_STRIDE_SAMPLES);
+        gate.update(frame, KWS_STRIDE_SAMPLES);
+    }
+}
+
+void test_gate_closes_on_steady_noise() {
+    VoiceActivity gate;
+    TEST_ASSERT_TRUE(gate.active()); // Open until the floor is known
+    feedFrames(gate, room, VAD_HANGOVER_FRAMES + 1);
+    TEST_ASSERT_FALSE(gate.active());
+    feedFrames(gate, room, 400); // 6 s
+    TEST_ASSERT_FALSE(gate.active());
+    TEST_ASSERT_EQUAL_UINT32(0, gate.speechFrames());
+}
+
+void test_gate_opens_on_first_voiced_frame_and_holds() {
+    VoiceActivity gate;
+    feedFrames(gate, room, 2 * VAD_HANGOVER_FRAMES);
+    TEST_ASSERT_FALSE(gate.active());
+
+    int16_t frame[KWS_STRIDE_SAMPLES];
+    voiced(frame, KWS_STRIDE_SAMPLES, 0);
+    gate.update(frame, KWS_STRIDE_SAMPLES / 2); // Frames may span calls
+    TEST_ASSERT_FALSE(gate.active());
+    gate.update(frame + KWS_STRIDE_SAMPLES / 2, KWS_STRIDE_SAMPLES / 2);
+    TEST_ASSERT_TRUE(gate.active());
+
+    // Hangover: open for exactly one model window after the last speech.
+    feedFrames(gate, room, VAD_HANGOVER_FRAMES - 1);
+    TEST_ASSERT_TRUE(gate.active());
+    feedFrames(gate, room, 1);
+    TEST_ASSERT_FALSE(gate.active());
+}
+
+static void hiss(int16_t* out, size_t count) {
+    // High-pass noise (first difference), ~4.5 dB over the room: only the
+    // zero-crossing rule can call it speech.
+    for (size_t i = 0; i < count; i++) {
+        static float last = 0.0f;
+        float n = test_signal.noise();
+        out[i] = (int16_t)(330.0f * (n - last) + 350.0f * test_signal.noise() * 0.3f);
+        last = n;
+    }
+}
+
+static void hum(int16_t* out, size_t count) {
+    static size_t offset = 0;
+    for (size_t i = 0; i < count; i++, offset++) {
+        out[i] = (int16_t)(460.0f * sinf(2.0f * PI_F * 100.0f * offset / KWS_SAMPLE_RATE_HZ) + 100.0f * test_signal.noise());
+    }
+}
+
+void test_fricative_rule_uses_zero_crossings() {
+    VoiceActivity gate(VadConfig{0, 4.0f, 100});
+    feedFrames(gate, room, 2 * VAD_HANGOVER_FRAMES);
+    const uint32_t floor = gate.noiseFloor();
+
+    feedFrames(gate, hum, 1);
+    TEST_ASSERT_TRUE(gate.lastEnergy() > 2 * floor && gate.lastEnergy() < 4 * floor);
+    TEST_ASSERT_FALSE(gate.active());
+
+    feedFrames(gate, room, 4);
+    feedFrames(gate, hiss, 1);
+    TEST_ASSERT_TRUE(gate.lastEnergy() > 2 * floor && gate.lastEnergy() < 4 * floor);
+    TEST_ASSERT_TRUE(gate.lastCrossings() >= 100);
+    TEST_ASSERT_TRUE(gate.active());
+}
+
+// The gated detector must run every inference whose window holds the word,
+// with the same posteriors as an ungated one, and skip the rest.
+static WakeWordDetector gated, ungated;
+
+void test_detector_skips_only_quiet_inferences() {
+    TEST_ASSERT_TRUE(gated.initPipeline());
+    TEST_ASSERT_TRUE(ungated.initPipeline());
+    gated.setVoiceGate(true);
+    ungated.setVoiceGate(false);
+
+    const int hops_per_second = KWS_SAMPLE_RATE_HZ / DETECTOR_HOP_SAMPLES;
+    const int word_start = 4 * hops_per_second, word_hops = 10; // 0.6 s at t = 4 s
+    const int total = 10 * hops_per_second;
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    int mismatches = 0, missed = 0;
+    for (int h = 0; h < total; h++) {
+        if (h >= word_start && h < word_start + word_hops) {
+            voiced(hop, DETECTOR_HOP_SAMPLES, h * DETECTOR_HOP_SAMPLES);
+        } else {
+            room(hop, DETECTOR_HOP_SAMPLES);
+        }
+        uint32_t before = gated.getInferenceCount();
+        gated.processAudio(hop, DETECTOR_HOP_SAMPLES);
+        ungated.processAudio(hop, DETECTOR_HOP_SAMPLES);
+        bool ran = gated.getInferenceCount() != before;
+        // The window ending with this hop still holds some of the word.
+        const int window_start = (h + 1) * DETECTOR_HOP_SAMPLES - KWS_WINDOW_SAMPLES;
+        bool word_in_window = h >= word_start && window_start < (word_start + word_hops) * DETECTOR_HOP_SAMPLES;
+        if (word_in_window && ungated.getStream().features.ready() && !ran) missed++;
+        if (ran) {
+            for (int k = 0; k < KWS_NUM_CLASSES; k++) {
+                if (gated.getLastProbabilities()[k] != ungated.getLastProbabilities()[k]) mismatches++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, missed);
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+
+    DetectorStats stats;
+    gated.getStats(stats);
+    TEST_ASSERT_EQUAL_UINT32(ungated.getInferenceCount(), stats.inferences_due);
+    TEST_ASSERT_EQUAL_UINT32(stats.inferences_due - gated.getInferenceCount(), stats.inferences_skipped);
+    // Quiet for all but ~1.6 s of 10 s, the first second included.
+    TEST_ASSERT_TRUE(stats.inferences_skipped * 10 > stats.inferences_due * 6);
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gate_closes_on_steady_noise);
+    RUN_TEST(test_gate_opens_on_first_voiced_frame_and_holds);
+    RUN_TEST(test_fricative_rule_uses_zero_crossings);
+    RUN_TEST(test_detector_skips_only_quiet_inferences);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
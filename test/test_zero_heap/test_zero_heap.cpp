@@ -0,0 +1,49 @@
+#include <unity.h>
+#include "WakeWordDetector.h"
+#include "AllocAudit.h"
+#include "Arena.h"
+
+static WakeWordDetector detector;
+
+void test_detect_makes_no_heap_allocations() {
+    if (!AllocAudit::enabled()) {
+        TEST_IGNORE_MESSAGE("build with -DALLOC_AUDIT=1 to audit allocations");
+    }
+    TEST_ASSERT_TRUE(detector.init());
+    detector.detect(); // Warm-up: first-use statics, audio source priming
+
+    AllocAudit::Scope audit;
+    for (int i = 0; i < 20; i++) {
+        detector.detect();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, audit.allocations());
+}
+
+void test_arenas_stay_within_capacity() {
+    int arenas = 0;
+    for (const Arena* arena = Arena::first(); arena; arena = arena->next()) {
+        TEST_ASSERT_TRUE(arena->highWater() <= arena->capacity());
+        TEST_ASSERT_EQUAL_UINT32(0, arena->failures());
+        arenas++;
+    }
+    TEST_ASSERT_TRUE(arenas >= 2); // mfcc scratch + dscnn activations
+}
+
+int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_detect_makes_no_heap_allocations);
+    RUN_TEST(test_arenas_stay_within_capacity);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
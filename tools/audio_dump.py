@@ -0,0 +1,44 @@
+import sys
+from pathlib import Path
+
+
+def parse_audio_dumps(lines):
+    """Yield the WAV bytes of every AUDIO-BEGIN/AUDIO-END block written by the console's record command."""
+    data = None
+    expected = 0
+    for line in lines:
+        line = line.strip()
+        if line.startswith('AUDIO-BEGIN'):
+            fields = dict(f.split('=', 1) for f in line.split()[2:] if '=' in f)
+            expected = int(fields.get('bytes', '0'))
+            data = bytearray()
+            continue
+        if data is None:
+            continue
+        if line.startswith('AUDIO-END'):
+            if len(data) == expected:
+                yield bytes(data)
+            else:
+                print(f"Skipped a recording of {len(data)}/{expected} bytes (lines lost?)", file=sys.stderr)
+            data = None
+            continue
+        try:
+            data.extend(bytes.fromhex(line))
+        except ValueError:
+            pass  # Log lines from other tasks interleaved with the dump
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        print("Usage: python audio_dump.py <serial_log.txt> <output_dir>")
+        sys.exit(1)
+    out_dir = Path(sys.argv[2])
+    out_dir.mkdir(parents=True, exist_ok=True)
+    count = 0
+    for count, wav in enumerate(parse_audio_dumps(Path(sys.argv[1]).read_text(errors='replace').splitlines()), 1):
+        path = out_dir / f'recording_{count:03d}.wav'
+        path.write_bytes(wav)
+        print(f"Wrote {path} ({len(wav)} bytes, IMA-ADPCM)")
+    if count == 0:
+        print("No AUDIO-BEGIN block found")
+        sys.exit(1)
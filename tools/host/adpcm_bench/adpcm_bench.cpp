@@ -0,0 +1,150 @@
+// IMA-ADPCM codec throughput (lib/Utils/Adpcm.h) on real or synthetic
+// audio: the encoder, the reference decoder and the table-driven one, which
+// must agree bit for bit. Also reports the coding SNR and what the
+// compression buys in RAM and serial time.
+//
+//   pio run -e native_adpcm_bench
+//   .pio/build/native_adpcm_bench/program [recording.wav] [--rounds N] [--out coded.wav]
+//
+// Without a file, 60 s of tones and noise stand in. --out writes the
+// encoded audio as an IMA-ADPCM WAV, to listen to what the archive keeps.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Adpcm.h"
+#include "Logger.h"
+#include "WavSource.h"
+#include "frontend_params.h"
+
+#define BENCH_SERIAL_BAUD 115200 // Console dumps: hex, 10 bits on the wire per character
+
+struct Timing {
+    double best_ms;
+    double median_ms;
+};
+
+template <typename Run>
+static Timing measure(int rounds, Run run) {
+    std::vector<double> samples;
+    samples.reserve(rounds);
+    for (int r = 0; r < rounds; r++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return {samples.front(), samples[samples.size() / 2]};
+}
+
+static void report(const char* name, const Timing& timing, size_t samples) {
+    const double seconds = (double)samples / KWS_SAMPLE_RATE_HZ;
+    printf("   %-18s %9.3f ms %9.3f ms %9.1f Msamples/s %9.0fx real time\n", name, timing.best_ms, timing.median_ms,
+           samples / timing.best_ms / 1000.0, seconds * 1000.0 / timing.best_ms);
+}
+
+int main(int argc, char** argv) {
+    std::string path, out_path;
+    int rounds = 20;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--rounds") && i + 1 < argc) rounds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) out_path = argv[++i];
+        else if (argv[i][0] != '-' && path.empty()) path = argv[i];
+        else {
+            fprintf(stderr, "usage: %s [recording.wav] [--rounds N] [--out coded.wav]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rounds <= 0) rounds = 1;
+    Logger::init(LOG_LEVEL_ERROR);
+
+    std::vector<int16_t> pcm;
+    if (!path.empty()) {
+        WavSource wav;
+        if (!wav.open(path.c_str())) {
+            fprintf(stderr, "❌ %s: %s\n", path.c_str(), wav.error());
+            return 1;
+        }
+        pcm.resize(wav.frameCount());
+        pcm.resize(wav.read(pcm.data(), pcm.size()));
+    } else {
+        uint32_t seed = 12345;
+        pcm.resize(60 * KWS_SAMPLE_RATE_HZ);
+        for (size_t i = 0; i < pcm.size(); i++) {
+            seed = seed * 1664525u + 1013904223u;
+            const double t = (double)i / KWS_SAMPLE_RATE_HZ;
+            pcm[i] = (int16_t)(5000.0 * sin(2 * M_PI * 180.0 * t) * (1.0 + sin(2 * M_PI * 3.0 * t)) +
+                               2000.0 * sin(2 * M_PI * 2400.0 * t) + (double)(seed >> 20) - 2048.0);
+        }
+    }
+    const size_t blocks = (pcm.size() + ADPCM_BLOCK_SAMPLES - 1) / ADPCM_BLOCK_SAMPLES;
+    if (blocks == 0) {
+        fprintf(stderr, "❌ No audio\n");
+        return 1;
+    }
+    pcm.resize(blocks * ADPCM_BLOCK_SAMPLES, pcm.empty() ? 0 : pcm.back()); // As flush() pads
+    const size_t samples = pcm.size();
+
+    std::vector<uint8_t> coded(blocks * ADPCM_BLOCK_BYTES);
+    std::vector<int16_t> reference(samples), decoded(samples);
+    AdpcmEncoder encoder;
+    const Timing encode = measure(rounds, [&]() {
+        encoder.reset();
+        encoder.encode(pcm.data(), samples, coded.data());
+    });
+    const Timing decode_reference = measure(rounds, [&]() {
+        for (size_t b = 0; b < blocks; b++) {
+            Adpcm::decodeBlockReference(&coded[b * ADPCM_BLOCK_BYTES], &reference[b * ADPCM_BLOCK_SAMPLES]);
+        }
+    });
+    const Timing decode_table = measure(rounds, [&]() {
+        for (size_t b = 0; b < blocks; b++) {
+            Adpcm::decodeBlock(&coded[b * ADPCM_BLOCK_BYTES], &decoded[b * ADPCM_BLOCK_SAMPLES]);
+        }
+    });
+    if (reference != decoded) {
+        fprintf(stderr, "❌ Table decoder differs from the reference\n");
+        return 1;
+    }
+
+    double signal = 0.0, error = 0.0;
+    for (size_t i = 0; i < samples; i++) {
+        signal += (double)pcm[i] * pcm[i];
+        error += ((double)decoded[i] - pcm[i]) * ((double)decoded[i] - pcm[i]);
+    }
+    const double seconds = (double)samples / KWS_SAMPLE_RATE_HZ;
+    printf("🔊 %s: %.1f s, %zu blocks of %d samples\n", path.empty() ? "synthetic" : path.c_str(), seconds, blocks,
+           ADPCM_BLOCK_SAMPLES);
+    printf("   %-18s %12s %12s\n", "", "best", "median");
+    report("encode", encode, samples);
+    report("decode (reference)", decode_reference, samples);
+    report("decode (table)", decode_table, samples);
+    printf("   Table decoder %.2fx the reference, bit-exact\n", decode_reference.best_ms / decode_table.best_ms);
+    printf("📦 %zu -> %zu bytes (%.2f:1), SNR %.1f dB\n", samples * sizeof(int16_t), coded.size(),
+           (double)(samples * sizeof(int16_t)) / coded.size(), 10.0 * log10(signal / (error + 1.0)));
+    const double kb_per_second = (double)ADPCM_BLOCK_BYTES * KWS_SAMPLE_RATE_HZ / ADPCM_BLOCK_SAMPLES / 1024.0;
+    printf("   1 s of audio in %.1f KB instead of %.1f KB; a hex dump at %d baud takes %.1f s instead of %.1f s\n",
+           kb_per_second, KWS_SAMPLE_RATE_HZ * sizeof(int16_t) / 1024.0, BENCH_SERIAL_BAUD,
+           kb_per_second * 1024.0 * 2 * 10 / BENCH_SERIAL_BAUD,
+           KWS_SAMPLE_RATE_HZ * sizeof(int16_t) * 2 * 10.0 / BENCH_SERIAL_BAUD);
+
+    if (!out_path.empty()) {
+        uint8_t header[ADPCM_WAV_HEADER_BYTES];
+        Adpcm::wavHeader(header, KWS_SAMPLE_RATE_HZ, (uint32_t)samples, (uint32_t)blocks);
+        FILE* out = fopen(out_path.c_str(), "wb");
+        if (!out || fwrite(header, 1, sizeof(header), out) != sizeof(header) ||
+            fwrite(coded.data(), 1, coded.size(), out) != coded.size()) {
+            fprintf(stderr, "❌ Cannot write %s\n", out_path.c_str());
+            if (out) fclose(out);
+            return 1;
+        }
+        fclose(out);
+        printf("Wrote %s\n", out_path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "FeatureStore.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Model.h"
+
+static_assert(sizeof(FeatureStoreHeader) == 80, "FeatureStoreHeader is an on-disk layout");
+static_assert(sizeof(FeatureStoreEntry) == 40, "FeatureStoreEntry is an on-disk layout");
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + FEATURE_STORE_ALIGNMENT - 1) & ~(uint64_t)(FEATURE_STORE_ALIGNMENT - 1);
+}
+
+// The front end this build runs, as a store records it.
+static FeatureStoreHeader currentHeader(bool gain) {
+    FeatureStoreHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "KWSF", 4);
+    header.version = FEATURE_STORE_VERSION;
+    header.sample_rate = KWS_SAMPLE_RATE_HZ;
+    header.frame_samples = KWS_FRAME_SAMPLES;
+    header.stride_samples = KWS_STRIDE_SAMPLES;
+    header.frames = KWS_FRAMES;
+    header.coefficients = KWS_NUM_MFCC;
+    header.input_scale = ManualDSCNN::inputScale();
+    header.input_zero_point = ManualDSCNN::inputZeroPoint();
+    header.hop_samples = DETECTOR_HOP_SAMPLES;
+    header.flags = gain ? FEATURE_STORE_GAIN : 0;
+    header.window_stride = FEATURE_STORE_WINDOW_STRIDE;
+    return header;
+}
+
+uint64_t featureStoreHash(const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+FeatureStore::FeatureStore()
+    : mapping_(nullptr), mapping_size_(0), header_(nullptr), entries_(nullptr), strings_(nullptr),
+      windows_(nullptr), error_("not open") {}
+
+FeatureStore::~FeatureStore() {
+    close();
+}
+
+void FeatureStore::close() {
+    if (mapping_) munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    header_ = nullptr;
+    entries_ = nullptr;
+    strings_ = nullptr;
+    windows_ = nullptr;
+}
+
+bool FeatureStore::fail(const char* reason) {
+    close();
+    error_ = reason;
+    return false;
+}
+
+bool FeatureStore::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return fail("cannot open");
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(FeatureStoreHeader)) {
+        ::close(fd);
+        return fail("too short for a header");
+    }
+    mapping_size_ = (size_t)info.st_size;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        return fail("mmap failed");
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(mapping_);
+    const FeatureStoreHeader& header = *reinterpret_cast<const FeatureStoreHeader*>(bytes);
+    if (memcmp(header.magic, "KWSF", 4) != 0) return fail("not a feature store");
+    if (header.version != FEATURE_STORE_VERSION) return fail("unsupported feature store version");
+    if (header.window_stride < (uint32_t)header.frames * header.coefficients) return fail("bad window stride");
+    const uint64_t index_end = header.index_offset + (uint64_t)header.file_count * sizeof(FeatureStoreEntry);
+    const uint64_t windows_end = header.windows_offset + header.window_count * header.window_stride;
+    if (header.index_offset % FEATURE_STORE_ALIGNMENT || header.windows_offset % FEATURE_STORE_ALIGNMENT ||
+        index_end > header.strings_offset || header.strings_offset > header.windows_offset ||
+        windows_end != mapping_size_) {
+        return fail("sections do not match the file size");
+    }
+    header_ = &header;
+    entries_ = reinterpret_cast<const FeatureStoreEntry*>(bytes + header.index_offset);
+    strings_ = reinterpret_cast<const char*>(bytes + header.strings_offset);
+    windows_ = reinterpret_cast<const int8_t*>(bytes + header.windows_offset);
+
+    const uint64_t string_bytes = header.windows_offset - header.strings_offset;
+    for (uint32_t i = 0; i < header.file_count; i++) {
+        const FeatureStoreEntry& e = entries_[i];
+        if (e.path_offset >= string_bytes || !memchr(strings_ + e.path_offset, '\0', string_bytes - e.path_offset)) {
+            return fail("path outside the string table");
+        }
+        if (e.first_window + e.window_count > header.window_count) return fail("windows outside the file");
+        if (i > 0 && strcmp(this->path(entries_[i - 1]), this->path(e)) >= 0) return fail("index is not sorted");
+    }
+    // Evaluation walks each file's windows once, front to back.
+    madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+    error_ = nullptr;
+    return true;
+}
+
+bool FeatureStore::matches(bool gain) const {
+    FeatureStoreHeader expected = currentHeader(gain);
+    const FeatureStoreHeader& h = *header_;
+    return h.sample_rate == expected.sample_rate && h.frame_samples == expected.frame_samples &&
+           h.stride_samples == expected.stride_samples && h.frames == expected.frames &&
+           h.coefficients == expected.coefficients && h.input_scale == expected.input_scale &&
+           h.input_zero_point == expected.input_zero_point && h.hop_samples == expected.hop_samples &&
+           h.flags == expected.flags;
+}
+
+const FeatureStoreEntry* FeatureStore::find(const char* path) const {
+    uint32_t low = 0, high = header_->file_count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int order = strcmp(this->path(entries_[mid]), path);
+        if (order == 0) return &entries_[mid];
+        if (order < 0) low = mid + 1;
+        else high = mid;
+    }
+    return nullptr;
+}
+
+bool writeFeatureStore(const char* path, std::vector<FeatureFile>& files, bool gain, std::string& error) {
+    std::sort(files.begin(), files.end(), [](const FeatureFile& a, const FeatureFile& b) { return a.path < b.path; });
+
+    FeatureStoreHeader header = currentHeader(gain);
+    std::vector<FeatureStoreEntry> entries(files.size());
+    std::string strings;
+    for (size_t i = 0; i < files.size(); i++) {
+        const FeatureFile& file = files[i];
+        FeatureStoreEntry& e = entries[i];
+        e.content_hash = file.content_hash;
+        e.first_window = header.window_count;
+        e.first_sample = file.first_sample;
+        e.sample_count = file.sample_count;
+        e.window_count = file.window_count;
+        e.path_offset = (uint32_t)strings.size();
+        strings.append(file.path).push_back('\0');
+        header.window_count += file.window_count;
+    }
+    header.file_count = (uint32_t)files.size();
+    header.index_offset = alignUp(sizeof(header));
+    header.strings_offset = header.index_offset + entries.size() * sizeof(FeatureStoreEntry);
+    header.windows_offset = alignUp(header.strings_offset + strings.size());
+
+    const std::string temporary = std::string(path) + ".tmp";
+    FILE* out = fopen(temporary.c_str(), "wb");
+    if (!out) {
+        error = "cannot create " + temporary;
+        return false;
+    }
+    static const char padding[FEATURE_STORE_ALIGNMENT] = {};
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    ok = ok && fwrite(padding, header.index_offset - sizeof(header), 1, out) == 1;
+    ok = ok && (entries.empty() || fwrite(entries.data(), sizeof(FeatureStoreEntry), entries.size(), out) ==
+                                       entries.size());
+    ok = ok && fwrite(strings.data(), 1, strings.size(), out) == strings.size();
+    const size_t gap = header.windows_offset - header.strings_offset - strings.size();
+    ok = ok && (gap == 0 || fwrite(padding, gap, 1, out) == 1);
+    for (const FeatureFile& file : files) {
+        const size_t bytes = (size_t)file.window_count * FEATURE_STORE_WINDOW_STRIDE;
+        ok = ok && (bytes == 0 || fwrite(file.windows, bytes, 1, out) == 1);
+    }
+    ok = fclose(out) == 0 && ok;
+    if (!ok || rename(temporary.c_str(), path) != 0) {
+        remove(temporary.c_str());
+        error = "cannot write " + std::string(path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+#ifndef FEATURE_STORE_H
+#define FEATURE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AudioProcessor.h"
+
+// Front-end output for a whole WAV corpus in one file, written by
+// tools/host/feature_extract and mapped read-only by eval_runner
+// --features, which then only runs inference (host tools only).
+//
+// Layout (little endian; sections start on FEATURE_STORE_ALIGNMENT):
+//   header   FeatureStoreHeader
+//   index    one FeatureStoreEntry per file, sorted by path
+//   strings  NUL-terminated paths, relative to the corpus root
+//   windows  int8 [KWS_FRAMES][KWS_NUM_MFCC] each, window_stride bytes
+//            apart: every window the detector infers on while streaming
+//            the file, in order, one hop apart
+#define FEATURE_STORE_VERSION 1
+#define FEATURE_STORE_ALIGNMENT 64
+#define FEATURE_STORE_WINDOW_BYTES (KWS_FRAMES * KWS_NUM_MFCC)
+#define FEATURE_STORE_WINDOW_STRIDE ((FEATURE_STORE_WINDOW_BYTES + 15) & ~15)
+#define FEATURE_STORE_GAIN 1u // Flag: audio was conditioned (AudioCapture::condition)
+
+struct FeatureStoreHeader {
+    char magic[4]; // "KWSF"
+    uint32_t version;
+    // Front end the windows came from; a store from any other is stale.
+    uint32_t sample_rate;
+    uint16_t frame_samples, stride_samples;
+    uint16_t frames, coefficients;
+    float input_scale;
+    int32_t input_zero_point;
+    uint32_t hop_samples; // Audio between consecutive windows
+    uint32_t flags;
+    uint32_t window_stride;
+    uint32_t file_count;
+    uint32_t reserved;
+    uint64_t window_count;
+    uint64_t index_offset;
+    uint64_t strings_offset;
+    uint64_t windows_offset;
+};
+
+struct FeatureStoreEntry {
+    uint64_t content_hash; // featureStoreHash() of the file's PCM data
+    uint64_t first_window; // Index of the file's first window
+    uint64_t first_sample; // Audio position at which it is inferred
+    uint64_t sample_count; // Length of the file in samples
+    uint32_t window_count;
+    uint32_t path_offset;  // From strings_offset
+};
+
+// FNV-1a, 64 bit: decides whether a file changed since it was extracted.
+uint64_t featureStoreHash(const void* data, size_t bytes);
+
+// A corpus file's key in the index: its path below `root` as the directory
+// walk spells it, so extraction and evaluation agree however root is given.
+inline std::string featureStoreKey(const std::string& file, const std::string& root) {
+    size_t start = file.compare(0, root.size(), root) == 0 ? root.size() : 0;
+    while (start < file.size() && file[start] == '/') start++;
+    return file.substr(start);
+}
+
+// Read side: maps the whole store; entries, paths and windows point into
+// the mapping and stay valid until close().
+class FeatureStore {
+public:
+    FeatureStore();
+    ~FeatureStore();
+    FeatureStore(const FeatureStore&) = delete;
+    FeatureStore& operator=(const FeatureStore&) = delete;
+
+    // Maps and checks the file. On failure error() says why.
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+    const char* error() const { return error_; }
+
+    // Made by this build's front end, with (or without) input conditioning.
+    bool matches(bool gain) const;
+    const FeatureStoreHeader& header() const { return *header_; }
+    uint32_t fileCount() const { return header_->file_count; }
+    const FeatureStoreEntry& entry(uint32_t index) const { return entries_[index]; }
+    const char* path(const FeatureStoreEntry& entry) const { return strings_ + entry.path_offset; }
+    // The entry for a corpus-relative path, or nullptr.
+    const FeatureStoreEntry* find(const char* path) const;
+    const int8_t* window(uint64_t index) const {
+        return windows_ + index * header_->window_stride;
+    }
+
+private:
+    bool fail(const char* reason);
+
+    void* mapping_;
+    size_t mapping_size_;
+    const FeatureStoreHeader* header_;
+    const FeatureStoreEntry* entries_;
+    const char* strings_;
+    const int8_t* windows_;
+    const char* error_;
+};
+
+// One file's windows for writeFeatureStore(): `windows` points at
+// window_count windows FEATURE_STORE_WINDOW_STRIDE bytes apart, either in
+// `owned` or inside an open FeatureStore being carried over.
+struct FeatureFile {
+    std::string path; // Relative to the corpus root
+    uint64_t content_hash;
+    uint64_t first_sample;
+    uint64_t sample_count;
+    uint32_t window_count;
+    const int8_t* windows;
+    std::vector<int8_t> owned;
+};
+
+// Writes a complete store for `files` (any order) to `path`, through a
+// temporary file renamed into place, so readers never see half a store.
+bool writeFeatureStore(const char* path, std::vector<FeatureFile>& files, bool gain, std::string& error);
+
+#endif
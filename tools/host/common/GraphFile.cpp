@@ -0,0 +1,149 @@
+#include "GraphFile.h"
+#include <cstdio>
+#include <cstring>
+
+// Layout (little endian), see write_blob() in tools/model_converter.py:
+//   header  "KWSG", version, tensor count, node count, input, output,
+//           arena size, weight bytes, bias count, quant count, flags
+//           (u32 each; bit 0 = placeholder activation scales), name (32
+//           bytes, NUL padded)
+//   tensors h, w, c (u16), type (u8), pad, zero point (i32), scale (f32),
+//           arena offset (u32)
+//   nodes   op ... weight bits, input, output (12 x u8), weight/bias/quant
+//           offsets (u32), output scale (f32)
+//   then weights (int8, padded to 4), biases, multipliers (i32), shifts (i8)
+static const uint32_t GRAPH_FILE_VERSION = 2;
+static const size_t HEADER_BYTES = 76;
+static const size_t TENSOR_BYTES = 20;
+static const size_t NODE_BYTES = 28;
+static const uint32_t FLAG_PLACEHOLDER_SCALES = 1;
+
+static uint32_t readLe32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t readLe16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static float readFloat(const uint8_t* p) {
+    uint32_t bits = readLe32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+GraphFile::GraphFile() : model_(), name_(), error_("not loaded") {}
+
+bool GraphFile::fail(const char* reason) {
+    model_ = GraphModel();
+    error_ = reason;
+    return false;
+}
+
+bool GraphFile::load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return fail("cannot open");
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + got);
+    fclose(file);
+
+    if (bytes.size() < HEADER_BYTES || memcmp(bytes.data(), "KWSG", 4) != 0) return fail("not a .kwsg graph");
+    const uint8_t* header = bytes.data();
+    if (readLe32(header + 4) != GRAPH_FILE_VERSION) return fail("unsupported .kwsg version");
+    const uint32_t tensor_count = readLe32(header + 8);
+    const uint32_t node_count = readLe32(header + 12);
+    const uint32_t input = readLe32(header + 16);
+    const uint32_t output = readLe32(header + 20);
+    const uint32_t arena_size = readLe32(header + 24);
+    const uint32_t weight_bytes = readLe32(header + 28);
+    const uint32_t bias_count = readLe32(header + 32);
+    const uint32_t quant_count = readLe32(header + 36);
+    const uint32_t flags = readLe32(header + 40);
+    if (tensor_count == 0 || tensor_count > 255 || node_count == 0 || node_count > 255) return fail("bad counts");
+    if (input >= tensor_count || output >= tensor_count) return fail("bad input/output tensor");
+    const size_t expected = HEADER_BYTES + tensor_count * TENSOR_BYTES + node_count * NODE_BYTES + weight_bytes +
+                            (size_t)bias_count * 4 + (size_t)quant_count * 5;
+    if (bytes.size() != expected) return fail("size does not match the header");
+    memcpy(name_, header + 44, sizeof(name_) - 1);
+    name_[sizeof(name_) - 1] = '\0';
+
+    const uint8_t* p = header + HEADER_BYTES;
+    tensors_.resize(tensor_count);
+    for (GraphTensor& t : tensors_) {
+        t.h = readLe16(p);
+        t.w = readLe16(p + 2);
+        t.c = readLe16(p + 4);
+        t.type = p[6] ? TYPE_FLOAT32 : TYPE_INT8;
+        t.zero_point = (int32_t)readLe32(p + 8);
+        t.scale = readFloat(p + 12);
+        t.arena_offset = readLe32(p + 16);
+        p += TENSOR_BYTES;
+    }
+    nodes_.resize(node_count);
+    for (GraphNode& n : nodes_) {
+        n.op = (GraphOp)p[0];
+        n.activation = (GraphActivation)p[1];
+        n.kernel_h = p[2];
+        n.kernel_w = p[3];
+        n.stride_h = p[4];
+        n.stride_w = p[5];
+        n.pad_top = p[6];
+        n.pad_left = p[7];
+        n.per_channel = p[8];
+        n.weight_bits = p[9];
+        n.input = p[10];
+        n.output = p[11];
+        n.weights = readLe32(p + 12);
+        n.bias = readLe32(p + 16);
+        n.quant = readLe32(p + 20);
+        n.output_scale = readFloat(p + 24);
+        p += NODE_BYTES;
+    }
+    weights_.assign(reinterpret_cast<const int8_t*>(p), reinterpret_cast<const int8_t*>(p) + weight_bytes);
+    p += weight_bytes;
+    biases_.resize(bias_count);
+    for (int32_t& b : biases_) {
+        b = (int32_t)readLe32(p);
+        p += 4;
+    }
+    multipliers_.resize(quant_count);
+    for (int32_t& m : multipliers_) {
+        m = (int32_t)readLe32(p);
+        p += 4;
+    }
+    shifts_.assign(reinterpret_cast<const int8_t*>(p), reinterpret_cast<const int8_t*>(p) + quant_count);
+
+    model_.name = name_;
+    model_.tensors = tensors_.data();
+    model_.tensor_count = (uint8_t)tensor_count;
+    model_.nodes = nodes_.data();
+    model_.node_count = (uint8_t)node_count;
+    model_.input = (uint8_t)input;
+    model_.output = (uint8_t)output;
+    model_.weights = weights_.data();
+    model_.biases = biases_.data();
+    model_.multipliers = multipliers_.data();
+    model_.shifts = shifts_.data();
+    model_.arena_size = arena_size;
+    model_.placeholder_scales = (flags & FLAG_PLACEHOLDER_SCALES) != 0;
+
+    // Parameter ranges; shapes and op rules are checked by ManualDSCNN::init().
+    for (const GraphNode& n : nodes_) {
+        if (n.input >= tensor_count || n.output >= tensor_count) return fail("node tensor out of range");
+        if (n.weight_bits != 8 && n.weight_bits != 4) return fail("bad weight width");
+        const GraphTensor& out = tensors_[n.output];
+        const uint32_t weights = graphWeightBytes(model_, n);
+        const uint32_t biases = weights ? out.c : 0;
+        const uint32_t quant = (n.op == OP_CONV2D || n.op == OP_DEPTHWISE || n.op == OP_POINTWISE)
+                                   ? (n.per_channel ? out.c : 1) : 0;
+        if ((uint64_t)n.weights + weights > weight_bytes || (uint64_t)n.bias + biases > bias_count ||
+            (uint64_t)n.quant + quant > quant_count) {
+            return fail("node parameters outside the file");
+        }
+    }
+    error_ = nullptr;
+    return true;
+}
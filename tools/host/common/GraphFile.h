@@ -0,0 +1,39 @@
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include <cstdint>
+#include <vector>
+#include "Graph.h"
+
+// A model graph loaded at run time from a .kwsg file written by
+// tools/model_converter.py --blob (host tools only). Lets one binary
+// compare model variants, e.g. int4 mixes, without rebuilding.
+class GraphFile {
+public:
+    GraphFile();
+    GraphFile(const GraphFile&) = delete;
+    GraphFile& operator=(const GraphFile&) = delete;
+
+    // Reads and checks the whole file. On failure error() says why.
+    bool load(const char* path);
+
+    // Points into this object; valid while it lives and is not reloaded.
+    const GraphModel& model() const { return model_; }
+    uint32_t weightBytes() const { return (uint32_t)weights_.size(); }
+    const char* error() const { return error_; }
+
+private:
+    bool fail(const char* reason);
+
+    GraphModel model_;
+    char name_[32];
+    std::vector<GraphTensor> tensors_;
+    std::vector<GraphNode> nodes_;
+    std::vector<int8_t> weights_;
+    std::vector<int32_t> biases_;
+    std::vector<int32_t> multipliers_;
+    std::vector<int8_t> shifts_;
+    const char* error_;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef KWS_PROTOCOL_H
+#define KWS_PROTOCOL_H
+
+// Wire protocol of the host detection service (tools/host/kwsd).
+//
+// A client connects to the UNIX stream socket and writes raw 16 kHz mono
+// PCM16 (little endian), already conditioned, for as long as it likes; one
+// connection is one audio stream. The server answers with one text line per
+// detection:
+//
+//   WAKE <sample> <stream_ms> <score> <unix_ms>\n
+//
+// <sample> is the stream position (samples since connect) where the wake
+// word fired, <stream_ms> the same in milliseconds of audio, <score> the
+// marvin posterior and <unix_ms> the server's wall clock at the decision.
+// When a client writes faster than the workers keep up, the server stops
+// reading from it and the socket buffer fills: a blocking writer simply
+// waits. Events are only ever sent or dropped as whole lines; a client
+// that leaves them unread loses the newest ones.
+
+#define KWS_DEFAULT_SOCKET "/tmp/kwsd.sock"
+#define KWS_EVENT_MAX_LINE 96
+
+#endif
@@ -0,0 +1,87 @@
+#include "MappedWav.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint32_t readLe32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t readLe16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+MappedWav::MappedWav()
+    : mapping_(nullptr), mapping_size_(0), samples_(nullptr), frames_(0),
+      sample_rate_(0), channels_(0), error_("not open") {}
+
+MappedWav::~MappedWav() {
+    close();
+}
+
+void MappedWav::close() {
+    if (mapping_) munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    samples_ = nullptr;
+    frames_ = 0;
+    sample_rate_ = 0;
+    channels_ = 0;
+}
+
+bool MappedWav::fail(const char* reason) {
+    close();
+    error_ = reason;
+    return false;
+}
+
+bool MappedWav::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return fail("cannot open");
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < 12) {
+        ::close(fd);
+        return fail("too short for a RIFF header");
+    }
+    mapping_size_ = (size_t)info.st_size;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        return fail("mmap failed");
+    }
+    madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(mapping_);
+    if (memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0) return fail("not a RIFF/WAVE file");
+
+    bool have_format = false;
+    size_t offset = 12;
+    while (offset + 8 <= mapping_size_) {
+        const uint8_t* chunk = bytes + offset;
+        size_t size = readLe32(chunk + 4);
+        size_t body = offset + 8;
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (size < 16 || body + 16 > mapping_size_) return fail("truncated fmt chunk");
+            uint16_t format = readLe16(bytes + body);
+            channels_ = readLe16(bytes + body + 2);
+            sample_rate_ = readLe32(bytes + body + 4);
+            uint16_t bits = readLe16(bytes + body + 14);
+            // 0xFFFE is WAVE_FORMAT_EXTENSIBLE; accept it when it still holds 16-bit PCM.
+            if ((format != 1 && format != 0xFFFE) || bits != 16 || channels_ == 0) return fail("not 16-bit PCM");
+            have_format = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_format) return fail("data chunk before fmt chunk");
+            if (body + size > mapping_size_) size = mapping_size_ - body; // Truncated recording
+            samples_ = reinterpret_cast<const int16_t*>(bytes + body);
+            frames_ = size / (sizeof(int16_t) * channels_);
+            error_ = nullptr;
+            return true;
+        }
+        offset = body + size + (size & 1); // Chunks are word aligned
+    }
+    return fail("no data chunk");
+}
@@ -0,0 +1,40 @@
+#ifndef MAPPED_WAV_H
+#define MAPPED_WAV_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Read-only memory-mapped view of a PCM16 WAV file (host tools only).
+// Samples are read straight from the page cache; nothing is copied.
+class MappedWav {
+public:
+    MappedWav();
+    ~MappedWav();
+    MappedWav(const MappedWav&) = delete;
+    MappedWav& operator=(const MappedWav&) = delete;
+
+    // Maps the file and locates the fmt/data chunks. On failure error()
+    // says why and the object stays closed.
+    bool open(const char* path);
+    void close();
+
+    const int16_t* samples() const { return samples_; }
+    size_t frameCount() const { return frames_; }        // samples per channel
+    uint32_t sampleRate() const { return sample_rate_; }
+    uint16_t channels() const { return channels_; }
+    double seconds() const { return sample_rate_ ? (double)frames_ / sample_rate_ : 0.0; }
+    const char* error() const { return error_; }
+
+private:
+    bool fail(const char* reason);
+
+    void* mapping_;
+    size_t mapping_size_;
+    const int16_t* samples_;
+    size_t frames_;
+    uint32_t sample_rate_;
+    uint16_t channels_;
+    const char* error_;
+};
+
+#endif
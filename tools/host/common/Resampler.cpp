@@ -0,0 +1,125 @@
+#include "Resampler.h"
+#include <cstring>
+
+namespace {
+
+struct PrecomputedBank {
+    int up;
+    int down;
+    const int16_t* taps;
+};
+
+// Source rates the corpora and host captures use, converted to 16 kHz.
+// Others (22.05, 11.025, 96 kHz...) are designed in configure().
+const PrecomputedBank kBanks[] = {
+    {1, 3, &resamplerBank<1, 3>.taps[0][0]},         // 48 kHz
+    {160, 441, &resamplerBank<160, 441>.taps[0][0]}, // 44.1 kHz
+    {1, 2, &resamplerBank<1, 2>.taps[0][0]},         // 32 kHz
+    {2, 3, &resamplerBank<2, 3>.taps[0][0]},         // 24 kHz
+    {2, 1, &resamplerBank<2, 1>.taps[0][0]},         // 8 kHz
+};
+
+uint32_t greatestCommonDivisor(uint32_t a, uint32_t b) {
+    while (b) {
+        uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Fixed trip count and no aliasing: vectorized at -O2.
+inline int16_t dot(const int16_t* __restrict window, const int16_t* __restrict taps) {
+    int32_t acc = 1 << 14;
+    for (int j = 0; j < RESAMPLER_TAPS; j++) acc += (int32_t)window[j] * taps[j];
+    acc >>= 15;
+    return (int16_t)(acc > 32767 ? 32767 : acc < -32768 ? -32768 : acc);
+}
+
+} // namespace
+
+Resampler::Resampler() : up_(1), down_(1), bank_(nullptr) {
+    reset();
+}
+
+bool Resampler::configure(uint32_t from_rate, uint32_t to_rate) {
+    if (from_rate == 0 || to_rate == 0) return false;
+    const uint32_t divisor = greatestCommonDivisor(from_rate, to_rate);
+    if (to_rate / divisor > RESAMPLER_MAX_PHASES) return false;
+    up_ = (int)(to_rate / divisor);
+    down_ = (int)(from_rate / divisor);
+    bank_ = nullptr;
+    owned_.clear();
+    for (const PrecomputedBank& bank : kBanks) {
+        if (bank.up == up_ && bank.down == down_) bank_ = bank.taps;
+    }
+    if (!bank_ && !passthrough()) {
+        owned_.resize((size_t)up_ * RESAMPLER_TAPS);
+        for (int p = 0; p < up_; p++) resampler_design::designPhase(up_, down_, p, &owned_[(size_t)p * RESAMPLER_TAPS]);
+        bank_ = owned_.data();
+    }
+    reset();
+    return true;
+}
+
+void Resampler::reset() {
+    consumed_ = 0;
+    next_ = (resampler_design::prototypeLength(up_) - 1) / 2; // The prototype's centre
+    memset(history_, 0, sizeof(history_));
+}
+
+uint64_t Resampler::seek(uint64_t output) {
+    reset();
+    if (passthrough()) {
+        consumed_ = output;
+        return consumed_;
+    }
+    // Start at the oldest input of the output's window; the zeroed history
+    // only reaches windows before it.
+    next_ += output * down_;
+    const uint64_t newest = next_ / up_;
+    consumed_ = newest > RESAMPLER_TAPS - 1 ? newest - (RESAMPLER_TAPS - 1) : 0;
+    return consumed_;
+}
+
+int16_t Resampler::filter(const int16_t* window, uint32_t phase) const {
+    return dot(window, bank_ + (size_t)phase * RESAMPLER_TAPS);
+}
+
+size_t Resampler::process(const int16_t* in, size_t count, int16_t* out) {
+    if (passthrough()) {
+        memcpy(out, in, count * sizeof(int16_t));
+        consumed_ += count;
+        return count;
+    }
+    // Windows that start before this block read from history_, which is
+    // followed by the block's first K-1 samples; the rest read `in` directly.
+    const size_t keep = RESAMPLER_TAPS - 1;
+    const size_t edge = count < keep ? count : keep;
+    memcpy(history_ + keep, in, edge * sizeof(int16_t));
+
+    const uint64_t end = consumed_ + count;
+    size_t produced = 0;
+    for (uint64_t i = next_ / up_; i < end; i = next_ / up_) {
+        const int64_t first = (int64_t)(i - consumed_) - (int64_t)keep;
+        const int16_t* window = first >= 0 ? in + first : history_ + keep + first;
+        out[produced++] = filter(window, (uint32_t)(next_ % up_));
+        next_ += down_;
+    }
+
+    if (count >= keep) memcpy(history_, in + count - keep, keep * sizeof(int16_t));
+    else memmove(history_, history_ + count, keep * sizeof(int16_t));
+    consumed_ = end;
+    return produced;
+}
+
+size_t Resampler::flush(size_t count, int16_t* out) {
+    static const int16_t zeros[RESAMPLER_TAPS] = {};
+    size_t produced = 0;
+    while (count > 0) {
+        const size_t chunk = count < RESAMPLER_TAPS ? count : RESAMPLER_TAPS;
+        produced += process(zeros, chunk, out + produced);
+        count -= chunk;
+    }
+    return produced;
+}
@@ -0,0 +1,157 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Polyphase FIR sample-rate conversion by a rational ratio L:M (host tools
+// only). Conceptually the input is upsampled by L, low-passed below the
+// lower of the two Nyquist rates and decimated by M; the polyphase form
+// computes only the outputs that survive, RESAMPLER_TAPS multiply-adds each
+// (48 kHz -> 16 kHz is 1:3, 44.1 kHz -> 16 kHz is 160:441).
+//
+// The prototype is a Kaiser-windowed sinc. Its -6 dB point is at 90% of
+// the lower Nyquist rate and the transition band about a tenth of the input
+// rate wide, which keeps the front end's 20 Hz - 4 kHz mel range flat and
+// free of aliases. Banks for common rates are designed at compile time;
+// other rates run the same design when the resampler is configured.
+// Taps are Q15 and every phase sums to unity gain, so the inner loop is an
+// int16 dot product of fixed length that the compiler vectorizes.
+
+#define RESAMPLER_TAPS 48         // Per phase
+#define RESAMPLER_MAX_PHASES 1024 // L after reducing the ratio
+#define RESAMPLER_KAISER_BETA 8.0 // ~80 dB stopband
+
+namespace resampler_design {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double sine(double x) {
+    x -= 2.0 * kPi * (double)(long long)(x / (2.0 * kPi) + (x < 0 ? -0.5 : 0.5));
+    double term = x, sum = x;
+    for (int k = 1; k < 12; k++) {
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double root(double x) {
+    if (x <= 0.0) return 0.0;
+    double guess = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 60; i++) {
+        const double next = 0.5 * (guess + x / guess);
+        if (next == guess) break;
+        guess = next;
+    }
+    return guess;
+}
+
+// Modified Bessel function of the first kind, order 0.
+constexpr double besselI0(double x) {
+    double term = 1.0, sum = 1.0;
+    for (int k = 1; k < 40 && term > sum * 1e-17; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double kWindowScale = 1.0 / besselI0(RESAMPLER_KAISER_BETA);
+
+// Odd length K * L - 1 so the centre (the delay) falls on a sample; the
+// last slot of the bank is a zero tap.
+constexpr int prototypeLength(int up) {
+    return RESAMPLER_TAPS * up - 1;
+}
+
+// Tap n of the L:M prototype.
+constexpr double prototype(int up, int down, int n) {
+    const int length = prototypeLength(up);
+    if (n >= length) return 0.0;
+    const double cutoff = 0.45 / (up > down ? up : down); // Cycles per upsampled sample
+    const double x = 2.0 * cutoff * (n - (length - 1) / 2);
+    const double sinc = x == 0.0 ? 1.0 : sine(kPi * x) / (kPi * x);
+    const double r = 2.0 * n / (length - 1) - 1.0;
+    return sinc * besselI0(RESAMPLER_KAISER_BETA * root(1.0 - r * r)) * kWindowScale;
+}
+
+// Phase p of the bank in dot-product order: taps[j] weighs input i - (K-1) + j
+// for the output whose upsampled position is i * L + p.
+constexpr void designPhase(int up, int down, int p, int16_t* taps) {
+    double h[RESAMPLER_TAPS] = {};
+    double sum = 0.0;
+    for (int k = 0; k < RESAMPLER_TAPS; k++) {
+        h[k] = prototype(up, down, p + k * up);
+        sum += h[k];
+    }
+    for (int j = 0; j < RESAMPLER_TAPS; j++) {
+        const double q = h[RESAMPLER_TAPS - 1 - j] / sum * 32768.0;
+        const double rounded = q < 0 ? q - 0.5 : q + 0.5;
+        taps[j] = (int16_t)(rounded > 32767.0 ? 32767 : rounded < -32768.0 ? -32768 : (long)rounded);
+    }
+}
+
+} // namespace resampler_design
+
+// A bank designed at compile time; resamplerBank<160, 441> is 44.1 -> 16 kHz.
+template<int Up, int Down>
+struct ResamplerBank {
+    static_assert(Up >= 1 && Up <= RESAMPLER_MAX_PHASES && Down >= 1, "ResamplerBank: bad ratio");
+
+    int16_t taps[Up][RESAMPLER_TAPS];
+
+    constexpr ResamplerBank() : taps() {
+        for (int p = 0; p < Up; p++) resampler_design::designPhase(Up, Down, p, taps[p]);
+    }
+};
+
+template<int Up, int Down>
+constexpr ResamplerBank<Up, Down> resamplerBank{};
+
+// Streaming converter for one channel. Output sample n lines up with input
+// time n * M / L: the filter's delay is compensated, so the first outputs
+// need RESAMPLER_TAPS / 2 inputs of look-ahead and the stream's tail comes
+// out once flush() feeds the zeros beyond its end.
+class Resampler {
+public:
+    Resampler();
+
+    // False when the reduced ratio needs more than RESAMPLER_MAX_PHASES.
+    bool configure(uint32_t from_rate, uint32_t to_rate);
+    // Starts a new stream with the same ratio.
+    void reset();
+    // Repositions a stream so the next output is number `output`, exactly
+    // as a pass from the start would produce it. Returns the input index
+    // to feed from.
+    uint64_t seek(uint64_t output);
+
+    int up() const { return up_; }
+    int down() const { return down_; }
+    bool passthrough() const { return up_ == down_; }
+    // True when the bank came from the compile-time table.
+    bool precomputed() const { return owned_.empty(); }
+
+    // Upper bound on the outputs of one process() call.
+    size_t maxOutput(size_t count) const { return count * up_ / down_ + 1; }
+    // Consumes every input, writes the outputs that are now complete to
+    // `out` (room for maxOutput(count)) and returns how many.
+    size_t process(const int16_t* in, size_t count, int16_t* out);
+    // Feeds `count` zeros, e.g. RESAMPLER_TAPS to drain the tail.
+    size_t flush(size_t count, int16_t* out);
+
+private:
+    // Shared by both paths: `window` holds inputs i-K+1 .. i.
+    int16_t filter(const int16_t* window, uint32_t phase) const;
+
+    int up_;
+    int down_;
+    const int16_t* bank_; // [up_][RESAMPLER_TAPS]
+    std::vector<int16_t> owned_;
+    uint64_t consumed_;  // Inputs seen
+    uint64_t next_;      // Upsampled position of the next output
+    int16_t history_[2 * RESAMPLER_TAPS]; // Last K-1 inputs, then room to straddle a block edge
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "WavSource.h"
+#include <algorithm>
+#include <cstring>
+#include "frontend_params.h"
+
+// Lowest source rate whose maxOutput(kChunk) fits pending_.
+#define WAV_SOURCE_MIN_RATE (KWS_SAMPLE_RATE_HZ / 4)
+
+WavSource::WavSource()
+    : frames_(0), source_position_(0), delivered_(0), pending_count_(0), pending_read_(0), error_("not open") {}
+
+bool WavSource::open(const char* path) {
+    frames_ = 0;
+    if (!wav_.open(path)) {
+        error_ = wav_.error();
+        return false;
+    }
+    if (wav_.sampleRate() < WAV_SOURCE_MIN_RATE || !resampler_.configure(wav_.sampleRate(), KWS_SAMPLE_RATE_HZ)) {
+        wav_.close();
+        error_ = "unsupported sample rate";
+        return false;
+    }
+    frames_ = (size_t)(((uint64_t)wav_.frameCount() * resampler_.up() + resampler_.down() - 1) / resampler_.down());
+    rewind();
+    error_ = nullptr;
+    return true;
+}
+
+void WavSource::rewind() {
+    resampler_.reset();
+    source_position_ = 0;
+    delivered_ = 0;
+    pending_count_ = 0;
+    pending_read_ = 0;
+}
+
+void WavSource::seek(size_t position) {
+    rewind();
+    delivered_ = std::min(position, frames_);
+    source_position_ = (size_t)std::min<uint64_t>(resampler_.seek(delivered_), wav_.frameCount());
+}
+
+double WavSource::seconds() const {
+    return (double)frames_ / KWS_SAMPLE_RATE_HZ;
+}
+
+size_t WavSource::read(int16_t* out, size_t count) {
+    count = std::min(count, frames_ - delivered_);
+    const uint16_t channels = wav_.channels();
+    if (!resampled() && channels == 1) {
+        memcpy(out, wav_.samples() + delivered_, count * sizeof(int16_t));
+        delivered_ += count;
+        return count;
+    }
+
+    size_t done = 0;
+    while (done < count) {
+        if (pending_read_ == pending_count_) {
+            // Past the last frame the resampler is fed zeros to drain its tail.
+            const size_t take = std::min(kChunk, wav_.frameCount() - source_position_);
+            const int16_t* frames = wav_.samples() + source_position_ * channels;
+            for (size_t i = 0; i < take; i++) input_[i] = frames[i * channels];
+            pending_count_ = take ? resampler_.process(input_, take, pending_)
+                                  : resampler_.flush(RESAMPLER_TAPS, pending_);
+            pending_read_ = 0;
+            source_position_ += take;
+        }
+        const size_t n = std::min(count - done, pending_count_ - pending_read_);
+        memcpy(out + done, pending_ + pending_read_, n * sizeof(int16_t));
+        pending_read_ += n;
+        done += n;
+    }
+    delivered_ += done;
+    return done;
+}
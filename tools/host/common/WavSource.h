@@ -0,0 +1,50 @@
+#ifndef WAV_SOURCE_H
+#define WAV_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "MappedWav.h"
+#include "Resampler.h"
+
+// A PCM16 WAV file as the detector hears it: the first channel at
+// KWS_SAMPLE_RATE_HZ, whatever it was recorded at (host tools only).
+// 16 kHz files are read straight from the mapping; others go through a
+// Resampler, so every tool takes mixed corpora and 44.1/48 kHz captures.
+class WavSource {
+public:
+    WavSource();
+
+    // On failure error() says why (an unreadable file, or a rate the
+    // resampler cannot reach 16 kHz from).
+    bool open(const char* path);
+    // Copies up to `count` samples; fewer only at the end.
+    size_t read(int16_t* out, size_t count);
+    // Back to the first sample.
+    void rewind();
+    // To 16 kHz sample `position`; what follows is sample-exact with a read
+    // from the start, so a file can be split among readers.
+    void seek(size_t position);
+
+    size_t frameCount() const { return frames_; } // Samples at 16 kHz
+    double seconds() const;
+    uint32_t sourceRate() const { return wav_.sampleRate(); }
+    bool resampled() const { return !resampler_.passthrough(); }
+    const MappedWav& wav() const { return wav_; }
+    const char* error() const { return error_; }
+
+private:
+    static const size_t kChunk = 1024; // Source frames per resampler call
+
+    MappedWav wav_;
+    Resampler resampler_;
+    size_t frames_;
+    size_t source_position_; // Frames handed to the resampler
+    size_t delivered_;
+    int16_t input_[kChunk];
+    int16_t pending_[4 * kChunk + 1]; // maxOutput(kChunk) from 4 kHz up
+    size_t pending_count_;
+    size_t pending_read_;
+    const char* error_;
+};
+
+#endif
@@ -0,0 +1,167 @@
+// Inference latency of the two ManualDSCNN backends on the same windows:
+// the graph interpreter (model_graph.cpp) and the ahead-of-time compiled
+// model (model_aot.cpp). Checks they agree bit for bit, then reports the
+// best and median time per window for single windows and for full batches.
+// --dual-core adds both backends with every layer split across a helper
+// thread (DualCore), and the median time of each interpreted layer with and
+// without the split; it needs a host with a second core to show a speedup.
+//
+//   pio run -e native_dscnn_bench
+//   .pio/build/native_dscnn_bench/program [--rounds N] [--dual-core]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "ManualDSCNN.h"
+#include "model_aot.h"
+#include "Logger.h"
+
+static const int WINDOW_BYTES = KWS_FRAMES * KWS_NUM_MFCC;
+
+struct Timing {
+    double best_us;
+    double median_us;
+};
+
+static const char* const OP_NAMES[OP_COUNT] = {"conv2d", "depthwise", "pointwise", "avgpool", "dense",
+                                                "softmax"};
+
+// Per-node times of one interpreted window, from the layer observer's
+// callbacks: each node is charged the time since the previous one returned.
+struct LayerClock {
+    std::chrono::steady_clock::time_point last;
+    std::vector<std::vector<double>> us; // [node][round]
+};
+
+static void onLayer(int node, const GraphTensor&, const void*, int, void* context) {
+    LayerClock& clock = *static_cast<LayerClock*>(context);
+    auto now = std::chrono::steady_clock::now();
+    clock.us[node].push_back(std::chrono::duration<double, std::micro>(now - clock.last).count());
+    clock.last = now;
+}
+
+static std::vector<double> medians(std::vector<std::vector<double>>& us) {
+    std::vector<double> result;
+    for (std::vector<double>& samples : us) {
+        std::sort(samples.begin(), samples.end());
+        result.push_back(samples[samples.size() / 2]);
+    }
+    return result;
+}
+
+// Median time per node on each engine. The engines alternate window by
+// window, so clock drift and other load hit both alike.
+static void layerMedians(ManualDSCNN* engines[2], const int8_t* input, int rounds, std::vector<double> out[2]) {
+    LayerClock clocks[2];
+    float output[KWS_NUM_CLASSES];
+    for (int e = 0; e < 2; e++) {
+        clocks[e].us.resize(engines[e]->graph().node_count);
+        engines[e]->setLayerObserver(onLayer, &clocks[e]);
+    }
+    for (int r = 0; r < rounds; r++) {
+        for (int e = 0; e < 2; e++) {
+            clocks[e].last = std::chrono::steady_clock::now();
+            engines[e]->infer(input, output);
+        }
+    }
+    for (int e = 0; e < 2; e++) {
+        engines[e]->setLayerObserver(nullptr, nullptr);
+        out[e] = medians(clocks[e].us);
+    }
+}
+
+template <typename Run>
+static Timing measure(int rounds, int windows, Run run) {
+    std::vector<double> samples;
+    samples.reserve(rounds);
+    for (int r = 0; r < rounds; r++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                          windows);
+    }
+    std::sort(samples.begin(), samples.end());
+    return {samples.front(), samples[samples.size() / 2]};
+}
+
+int main(int argc, char** argv) {
+    int rounds = 2000;
+    bool dual_core = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--rounds") && i + 1 < argc) rounds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--dual-core")) dual_core = true;
+        else {
+            fprintf(stderr, "usage: %s [--rounds N] [--dual-core]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rounds <= 0) rounds = 1;
+    Logger::init(LOG_LEVEL_ERROR);
+
+    static ManualDSCNN interpreter;
+    if (!interpreter.init()) return 1;
+    DualCore inline_only; // Never started: every layer runs on the caller
+    std::vector<int8_t> arena_storage(DSCNN_MAX_BATCH * MODEL_AOT_ARENA_SIZE + 16);
+    int8_t* arena = reinterpret_cast<int8_t*>(((uintptr_t)arena_storage.data() + 15) & ~(uintptr_t)15);
+
+    std::vector<int8_t> windows(DSCNN_MAX_BATCH * WINDOW_BYTES);
+    uint32_t seed = 12345;
+    for (int8_t& v : windows) {
+        seed = seed * 1664525u + 1013904223u;
+        v = (int8_t)(seed >> 24);
+    }
+    const int8_t* inputs[DSCNN_MAX_BATCH];
+    for (int b = 0; b < DSCNN_MAX_BATCH; b++) inputs[b] = windows.data() + b * WINDOW_BYTES;
+
+    float expected[DSCNN_MAX_BATCH * KWS_NUM_CLASSES], actual[DSCNN_MAX_BATCH * KWS_NUM_CLASSES];
+    interpreter.predictBatch(inputs, DSCNN_MAX_BATCH, expected);
+    model_aot_run(inputs, DSCNN_MAX_BATCH, arena, actual, inline_only);
+    if (memcmp(expected, actual, sizeof(expected)) != 0) {
+        fprintf(stderr, "AOT output differs from the interpreter\n");
+        return 1;
+    }
+
+    printf("%s, %d rounds, microseconds per window\n", MODEL_AOT_NAME, rounds);
+    printf("%-12s %6s %10s %10s %8s\n", "backend", "batch", "best", "median", "speedup");
+    const int batches[] = {1, DSCNN_MAX_BATCH};
+    for (int batch : batches) {
+        Timing graph = measure(rounds, batch, [&] { interpreter.predictBatch(inputs, batch, expected); });
+        Timing aot = measure(rounds, batch, [&] { model_aot_run(inputs, batch, arena, actual, inline_only); });
+        printf("%-12s %6d %10.1f %10.1f\n", "interpreter", batch, graph.best_us, graph.median_us);
+        printf("%-12s %6d %10.1f %10.1f %7.2fx\n", "aot", batch, aot.best_us, aot.median_us,
+               graph.median_us / aot.median_us);
+        if (DSCNN_MAX_BATCH == 1) break;
+    }
+    if (!dual_core) return 0;
+
+    static ManualDSCNN split;
+    DualCore helper;
+    if (!split.init() || !split.enableDualCore(0, 0) || !helper.start(0, 0)) return 1;
+    split.predictBatch(inputs, DSCNN_MAX_BATCH, actual);
+    if (memcmp(expected, actual, sizeof(expected)) != 0) {
+        fprintf(stderr, "Split interpreter output differs from the single-core one\n");
+        return 1;
+    }
+    for (int batch : batches) {
+        Timing graph = measure(rounds, batch, [&] { split.predictBatch(inputs, batch, expected); });
+        Timing aot = measure(rounds, batch, [&] { model_aot_run(inputs, batch, arena, actual, helper); });
+        printf("%-12s %6d %10.1f %10.1f\n", "interp x2", batch, graph.best_us, graph.median_us);
+        printf("%-12s %6d %10.1f %10.1f\n", "aot x2", batch, aot.best_us, aot.median_us);
+        if (DSCNN_MAX_BATCH == 1) break;
+    }
+    ManualDSCNN* engines[2] = {&interpreter, &split};
+    std::vector<double> layers[2];
+    layerMedians(engines, inputs[0], rounds, layers);
+    const std::vector<double>& single = layers[0];
+    const std::vector<double>& halves = layers[1];
+    printf("\n%-4s %-10s %10s %10s %8s  (interpreter, one window, median us)\n", "node", "op", "single", "split",
+           "speedup");
+    for (size_t i = 0; i < single.size(); i++) {
+        printf("%-4zu %-10s %10.1f %10.1f %7.2fx\n", i, OP_NAMES[split.graph().nodes[i].op], single[i], halves[i],
+               single[i] / halves[i]);
+    }
+    return 0;
+}
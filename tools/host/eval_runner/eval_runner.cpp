@@ -0,0 +1,486 @@
+// Offline evaluation: streams a labelled WAV corpus through the production
+// front end, int8 DS-CNN and trigger logic (the shared Model, lib/StreamEngine)
+// on every core and reports accuracy, false accepts per hour and the ROC.
+//
+//   pio run -e native_eval
+//   .pio/build/native_eval/program <corpus_dir> [--labels data/labels.txt]
+//       [--threads N] [--threshold T] [--no-gain] [--roc roc.csv]
+//       [--graph variant.kwsg]... [--features features.kwsf]
+//
+// A file's class is the nearest enclosing directory named after a label in
+// labels.txt, falling back to the file name prefix (marvin_test.wav).
+// Files are PCM16 at any rate; the first channel is resampled to 16 kHz
+// (tools/host/common/WavSource.h).
+//
+// Each --graph (tools/model_converter.py --blob, e.g. with --int4) is run
+// over the same corpus after the built-in model, followed by a table
+// comparing weight precision, size and accuracy across them.
+//
+// --features maps a store written by tools/host/feature_extract over the same
+// corpus: files it lists skip the front end and only run inference, in
+// batches. The store is trusted, so re-extract after changing the corpus;
+// files missing from it, or a store from another front end or gain setting,
+// fall back to the WAVs.
+
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioCapture.h"
+#include "Model.h"
+#include "Logger.h"
+#include "WavSource.h"
+#include "GraphFile.h"
+#include "FeatureStore.h"
+
+namespace fs = std::filesystem;
+
+struct Options {
+    std::string corpus;
+    std::string labels_path = "data/labels.txt";
+    std::string roc_path;
+    std::string features_path;
+    std::vector<std::string> graphs;
+    unsigned threads = 0;
+    float threshold = KWS_TRIGGER_THRESHOLD;
+    bool gain = true;
+};
+
+struct ScorePoint {
+    uint64_t sample;   // Audio position of the inference
+    float score;       // Marvin posterior
+};
+
+struct FileJob {
+    std::string path;
+    std::string key; // Path below the corpus root, for the feature store
+    int label;
+    uintmax_t bytes;
+};
+
+struct FileResult {
+    bool ok = false;
+    const char* error = nullptr;
+    double seconds = 0.0;
+    float max_probability[KWS_NUM_CLASSES] = {};
+    std::vector<ScorePoint> trace;
+};
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s <corpus_dir> [--labels data/labels.txt] [--threads N] "
+                    "[--threshold T] [--no-gain] [--roc roc.csv] [--graph variant.kwsg]... "
+                    "[--features features.kwsf]\n", program);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--labels" && has_value) options.labels_path = argv[++i];
+        else if (arg == "--threads" && has_value) options.threads = (unsigned)atoi(argv[++i]);
+        else if (arg == "--threshold" && has_value) options.threshold = (float)atof(argv[++i]);
+        else if (arg == "--roc" && has_value) options.roc_path = argv[++i];
+        else if (arg == "--graph" && has_value) options.graphs.push_back(argv[++i]);
+        else if (arg == "--features" && has_value) options.features_path = argv[++i];
+        else if (arg == "--no-gain") options.gain = false;
+        else if (arg[0] != '-' && options.corpus.empty()) options.corpus = arg;
+        else return false;
+    }
+    return !options.corpus.empty();
+}
+
+static std::vector<std::string> loadLabels(const std::string& path) {
+    std::vector<std::string> labels;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (!line.empty()) labels.push_back(line);
+    }
+    return labels;
+}
+
+static int labelFor(const fs::path& file, const fs::path& root, const std::vector<std::string>& labels) {
+    for (fs::path dir = file.parent_path(); !dir.empty() && dir != root && dir != dir.parent_path();
+         dir = dir.parent_path()) {
+        auto it = std::find(labels.begin(), labels.end(), dir.filename().string());
+        if (it != labels.end()) return (int)(it - labels.begin());
+    }
+    std::string stem = file.stem().string();
+    std::string prefix = stem.substr(0, stem.find_first_of("_-."));
+    auto it = std::find(labels.begin(), labels.end(), prefix);
+    return it != labels.end() ? (int)(it - labels.begin()) : -1;
+}
+
+static void record(const float* posteriors, uint64_t sample, FileResult& result) {
+    for (int k = 0; k < KWS_NUM_CLASSES; k++) {
+        result.max_probability[k] = std::max(result.max_probability[k], posteriors[k]);
+    }
+    result.trace.push_back({sample, posteriors[KWS_LABEL_MARVIN_IDX]});
+}
+
+// Runs a file's stored windows through the engine, DSCNN_MAX_BATCH at a
+// time. The windows are one hop apart, as the stream would have made them.
+static void evaluateStored(const FeatureStore& store, const FeatureStoreEntry& entry, Workspace& workspace,
+                           FileResult& result) {
+    const int8_t* inputs[DSCNN_MAX_BATCH];
+    float posteriors[DSCNN_MAX_BATCH][KWS_NUM_CLASSES];
+    result.trace.reserve(entry.window_count);
+    for (uint32_t first = 0; first < entry.window_count; first += DSCNN_MAX_BATCH) {
+        const int n = (int)std::min<uint32_t>(DSCNN_MAX_BATCH, entry.window_count - first);
+        for (int b = 0; b < n; b++) inputs[b] = store.window(entry.first_window + first + b);
+        if (!workspace.engine.predictBatch(inputs, n, posteriors[0])) {
+            result.trace.clear();
+            result.error = "inference failed";
+            return;
+        }
+        for (int b = 0; b < n; b++) {
+            record(posteriors[b], entry.first_sample + (uint64_t)(first + b) * DETECTOR_HOP_SAMPLES, result);
+        }
+    }
+    result.seconds = (double)entry.sample_count / KWS_SAMPLE_RATE_HZ;
+    result.ok = true;
+}
+
+// Streams one file through the shared model one hop at a time, the same
+// cadence as detect() on the device, recording every inference. Files in
+// `store` (when given) start from their stored windows instead.
+static void evaluateFile(const Model& model, Workspace& workspace, const FeatureStore* store, const FileJob& job,
+                         bool gain, FileResult& result) {
+    const FeatureStoreEntry* entry = store ? store->find(job.key.c_str()) : nullptr;
+    if (entry) {
+        evaluateStored(*store, *entry, workspace, result);
+        return;
+    }
+
+    WavSource wav;
+    if (!wav.open(job.path.c_str())) {
+        result.error = wav.error();
+        return;
+    }
+
+    StreamState stream;
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    // Clips shorter than one model window are zero padded, as in training.
+    const size_t total = std::max(wav.frameCount(), (size_t)KWS_WINDOW_SAMPLES);
+    for (size_t position = 0; position < total; position += DETECTOR_HOP_SAMPLES) {
+        size_t count = std::min((size_t)DETECTOR_HOP_SAMPLES, total - position);
+        size_t available = wav.read(hop, count);
+        memset(hop + available, 0, (count - available) * sizeof(int16_t));
+        if (gain) AudioCapture::condition(hop, count);
+
+        const int16_t* samples = hop;
+        while (model.feed(stream, workspace, samples, count)) {
+            if (model.infer(stream, workspace)) record(stream.posteriors, stream.samples_processed, result);
+        }
+    }
+    result.seconds = wav.seconds();
+    result.ok = true;
+}
+
+// Same rule as Model::decide(): fire above the threshold,
+// then stay quiet for DETECTION_COOLDOWN_MS of audio.
+static int countTriggers(const std::vector<ScorePoint>& trace, float threshold) {
+    const uint64_t cooldown = (uint64_t)DETECTION_COOLDOWN_MS * KWS_SAMPLE_RATE_HZ / 1000;
+    int triggers = 0;
+    bool fired = false;
+    uint64_t last = 0;
+    for (const ScorePoint& point : trace) {
+        if (point.score > threshold && (!fired || point.sample - last > cooldown)) {
+            triggers++;
+            fired = true;
+            last = point.sample;
+        }
+    }
+    return triggers;
+}
+
+struct RocPoint {
+    float threshold;
+    double recall;          // Marvin files with at least one trigger
+    double false_per_hour;  // Triggers on non-marvin audio
+};
+
+static RocPoint rocAt(float threshold, const std::vector<FileJob>& jobs, const std::vector<FileResult>& results,
+                      double negative_hours) {
+    int positives = 0, hits = 0;
+    long false_accepts = 0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (!results[i].ok) continue;
+        int triggers = countTriggers(results[i].trace, threshold);
+        if (jobs[i].label == KWS_LABEL_MARVIN_IDX) {
+            positives++;
+            if (triggers > 0) hits++;
+        } else {
+            false_accepts += triggers;
+        }
+    }
+    RocPoint point;
+    point.threshold = threshold;
+    point.recall = positives ? (double)hits / positives : 0.0;
+    point.false_per_hour = negative_hours > 0.0 ? false_accepts / negative_hours : 0.0;
+    return point;
+}
+
+// A model run over the corpus: the built-in graph or a --graph file.
+struct Variant {
+    std::string name;
+    const GraphModel* graph; // nullptr = built-in
+    std::string bits;        // Weight width per layer, "8/4/4/..."
+    uint32_t weight_bytes;
+};
+
+struct Summary {
+    double accuracy[KWS_NUM_CLASSES];
+    RocPoint current;
+};
+
+static void describeWeights(const GraphModel& graph, Variant& variant) {
+    variant.bits.clear();
+    variant.weight_bytes = 0;
+    for (int i = 0; i < graph.node_count; i++) {
+        const GraphNode& node = graph.nodes[i];
+        uint32_t bytes = graphWeightBytes(graph, node);
+        if (!bytes) continue;
+        if (!variant.bits.empty()) variant.bits += "/";
+        variant.bits += std::to_string(node.weight_bits);
+        variant.weight_bytes += bytes;
+    }
+}
+
+// Runs every file through `variant` on `threads` workers.
+static bool runVariant(const Variant& variant, const Options& options, unsigned threads,
+                       const FeatureStore* store, const std::vector<FileJob>& jobs, std::vector<FileResult>& results, double& wall_seconds) {
+    // One immutable model for everyone; each worker owns only scratch
+    // (activations, FFT buffers), and each file gets a fresh StreamState.
+    // Workspaces are built here: arena registration is not thread-safe.
+    Model model;
+    model.setThreshold(options.threshold);
+    std::vector<std::unique_ptr<Workspace>> workspaces;
+    for (unsigned t = 0; t < threads; t++) {
+        workspaces.emplace_back(new Workspace());
+        Workspace& workspace = *workspaces.back();
+        if (!(variant.graph ? workspace.engine.init(*variant.graph) : workspace.init())) return false;
+    }
+
+    results.assign(jobs.size(), FileResult());
+    std::atomic<size_t> next_job(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = next_job.fetch_add(1); i < jobs.size(); i = next_job.fetch_add(1)) {
+                evaluateFile(model, *workspaces[t], store, jobs[i], options.gain, results[i]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// Prints accuracy, the confusion matrix and the ROC of one run. Only the
+// built-in model writes --roc.
+static Summary report(const Options& options, const std::vector<std::string>& labels,
+                      const std::vector<FileJob>& jobs, const std::vector<FileResult>& results, int unlabelled,
+                      unsigned threads, double wall_seconds, bool write_roc) {
+    Summary summary;
+
+    // Per-class accuracy: a file's prediction is the class with the highest
+    // posterior anywhere in the file.
+    int correct[KWS_NUM_CLASSES] = {}, total[KWS_NUM_CLASSES] = {};
+    int confusion[KWS_NUM_CLASSES][KWS_NUM_CLASSES] = {};
+    double audio_seconds = 0.0, negative_seconds = 0.0;
+    int skipped = 0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const FileResult& result = results[i];
+        if (!result.ok) {
+            fprintf(stderr, "⚠️ Skipped %s: %s\n", jobs[i].path.c_str(), result.error);
+            skipped++;
+            continue;
+        }
+        audio_seconds += result.seconds;
+        if (jobs[i].label != KWS_LABEL_MARVIN_IDX) negative_seconds += result.seconds;
+        int predicted = (int)(std::max_element(result.max_probability, result.max_probability + KWS_NUM_CLASSES) -
+                              result.max_probability);
+        total[jobs[i].label]++;
+        confusion[jobs[i].label][predicted]++;
+        if (predicted == jobs[i].label) correct[jobs[i].label]++;
+    }
+    for (int k = 0; k < KWS_NUM_CLASSES; k++) summary.accuracy[k] = total[k] ? 100.0 * correct[k] / total[k] : 0.0;
+
+    printf("\n📊 Evaluated %zu files (%d skipped, %d unlabelled) with %u threads\n",
+           jobs.size() - skipped, skipped, unlabelled, threads);
+    printf("   Audio %.2f h in %.2f s: %.4f audio-h per wall-s (%.0fx real time)\n", audio_seconds / 3600.0,
+           wall_seconds, audio_seconds / 3600.0 / wall_seconds, audio_seconds / wall_seconds);
+
+    printf("\nClass        files  accuracy  predicted as:");
+    for (const std::string& label : labels) printf(" %8s", label.c_str());
+    printf("\n");
+    for (int k = 0; k < KWS_NUM_CLASSES; k++) {
+        printf("%-10s %7d  %7.1f%%              ", labels[k].c_str(), total[k], summary.accuracy[k]);
+        for (int j = 0; j < KWS_NUM_CLASSES; j++) printf(" %8d", confusion[k][j]);
+        printf("\n");
+    }
+
+    double negative_hours = negative_seconds / 3600.0;
+    RocPoint current = rocAt(options.threshold, jobs, results, negative_hours);
+    summary.current = current;
+    printf("\nAt threshold %.3f: recall %.1f%%, %.2f false accepts/h over %.2f h of negative audio\n",
+           current.threshold, 100.0 * current.recall, current.false_per_hour, negative_hours);
+
+    FILE* roc_file = options.roc_path.empty() || !write_roc ? nullptr : fopen(options.roc_path.c_str(), "w");
+    if (roc_file) fprintf(roc_file, "threshold,recall,false_accepts_per_hour\n");
+    printf("\nthreshold  recall  FA/h\n");
+    const RocPoint* best = nullptr;
+    std::vector<RocPoint> curve;
+    for (int step = 0; step <= 100; step++) curve.push_back(rocAt(step / 100.0f, jobs, results, negative_hours));
+    for (const RocPoint& point : curve) {
+        if (roc_file) fprintf(roc_file, "%.2f,%.6f,%.6f\n", point.threshold, point.recall, point.false_per_hour);
+        int step = (int)lrintf(point.threshold * 100);
+        if (step % 5 == 0) {
+            printf("   %.2f   %5.1f%%  %8.2f\n", point.threshold, 100.0 * point.recall, point.false_per_hour);
+        }
+        if (!best && point.false_per_hour <= 1.0) best = &point;
+    }
+    if (roc_file) {
+        fclose(roc_file);
+        printf("ROC written to %s\n", options.roc_path.c_str());
+    }
+    if (best) {
+        printf("Lowest threshold with <= 1 false accept/h: %.2f (recall %.1f%%)\n", best->threshold,
+               100.0 * best->recall);
+    }
+    return summary;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    Logger::init(LOG_LEVEL_ERROR);
+    Logger::startTask();
+
+    std::vector<std::string> labels = loadLabels(options.labels_path);
+    if ((int)labels.size() != KWS_NUM_CLASSES) {
+        fprintf(stderr, "❌ %s lists %zu classes, the model has %d\n", options.labels_path.c_str(),
+                labels.size(), KWS_NUM_CLASSES);
+        return 1;
+    }
+
+    std::vector<FileJob> jobs;
+    int unlabelled = 0;
+    fs::path root(options.corpus);
+    std::error_code walk_error;
+    for (auto it = fs::recursive_directory_iterator(root, walk_error); !walk_error && it != fs::end(it);
+         it.increment(walk_error)) {
+        if (!it->is_regular_file()) continue;
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension != ".wav") continue;
+        int label = labelFor(it->path(), root, labels);
+        if (label < 0) {
+            unlabelled++;
+            continue;
+        }
+        const std::string path = it->path().string();
+        jobs.push_back({path, featureStoreKey(path, root.string()), label, it->file_size()});
+    }
+    if (walk_error) {
+        fprintf(stderr, "❌ Cannot walk %s: %s\n", options.corpus.c_str(), walk_error.message().c_str());
+        return 1;
+    }
+    // Longest files first so one big recording doesn't finish last on its own.
+    std::sort(jobs.begin(), jobs.end(), [](const FileJob& a, const FileJob& b) {
+        return a.bytes != b.bytes ? a.bytes > b.bytes : a.path < b.path;
+    });
+
+    FeatureStore features;
+    const FeatureStore* store = nullptr;
+    if (!options.features_path.empty()) {
+        if (!features.open(options.features_path.c_str())) {
+            fprintf(stderr, "❌ Cannot open %s: %s\n", options.features_path.c_str(), features.error());
+            return 1;
+        }
+        if (features.matches(options.gain)) {
+            store = &features;
+            size_t stored = 0;
+            for (const FileJob& job : jobs) stored += features.find(job.key.c_str()) != nullptr;
+            printf("🗃️ %s: %zu of %zu files from stored features\n", options.features_path.c_str(), stored,
+                   jobs.size());
+        } else {
+            fprintf(stderr, "⚠️ %s was made by a different front end or gain setting: reading WAVs\n",
+                    options.features_path.c_str());
+        }
+    }
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)std::max<size_t>(jobs.size(), 1)));
+
+    // The front end is quantized for the built-in model (Model), so every
+    // variant must take the same input tensor.
+    std::vector<std::unique_ptr<GraphFile>> graph_files;
+    std::vector<Variant> variants;
+    variants.push_back({"built-in", nullptr, "", 0});
+#if !DSCNN_BACKEND_AOT
+    variants.back().name = model_graph.name;
+    describeWeights(model_graph, variants.back());
+#endif
+    for (const std::string& path : options.graphs) {
+        graph_files.emplace_back(new GraphFile());
+        GraphFile& file = *graph_files.back();
+        if (!file.load(path.c_str())) {
+            fprintf(stderr, "❌ Cannot load %s: %s\n", path.c_str(), file.error());
+            return 1;
+        }
+        const GraphTensor& input = file.model().tensors[file.model().input];
+        if (input.scale != ManualDSCNN::inputScale() || input.zero_point != ManualDSCNN::inputZeroPoint()) {
+            fprintf(stderr, "❌ %s expects input scale %g, zero point %d; the front end makes %g, %d\n",
+                    path.c_str(), input.scale, (int)input.zero_point, ManualDSCNN::inputScale(),
+                    (int)ManualDSCNN::inputZeroPoint());
+            return 1;
+        }
+        Variant variant = {fs::path(path).filename().string(), &file.model(), "", 0};
+        describeWeights(file.model(), variant);
+        variants.push_back(variant);
+    }
+
+    std::vector<Summary> summaries;
+    for (const Variant& variant : variants) {
+        if (variants.size() > 1) {
+            printf("\n🧮 Model %s: weights %s bits, %u bytes\n", variant.name.c_str(), variant.bits.c_str(),
+                   (unsigned)variant.weight_bytes);
+        }
+        std::vector<FileResult> results;
+        double wall_seconds = 0.0;
+        if (!runVariant(variant, options, threads, store, jobs, results, wall_seconds)) return 1;
+        summaries.push_back(report(options, labels, jobs, results, unlabelled, threads, wall_seconds,
+                                   variant.graph == nullptr));
+    }
+
+    if (variants.size() > 1) {
+        printf("\n📊 Precision comparison at threshold %.3f\n", options.threshold);
+        printf("%-24s %-24s %8s", "model", "weight bits", "bytes");
+        for (const std::string& label : labels) printf(" %8s", label.c_str());
+        printf("   recall     FA/h\n");
+        for (size_t v = 0; v < variants.size(); v++) {
+            printf("%-24s %-24s %8u", variants[v].name.c_str(), variants[v].bits.c_str(),
+                   (unsigned)variants[v].weight_bytes);
+            for (int k = 0; k < KWS_NUM_CLASSES; k++) printf(" %7.1f%%", summaries[v].accuracy[k]);
+            printf("   %5.1f%% %8.2f\n", 100.0 * summaries[v].current.recall, summaries[v].current.false_per_hour);
+        }
+    }
+    Logger::drain();
+    return 0;
+}
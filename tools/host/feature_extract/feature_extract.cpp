@@ -0,0 +1,219 @@
+// Offline feature extraction: streams every WAV in a corpus through the
+// production front end (AudioProcessor, via the shared Model) on every core
+// and writes the windows the detector would infer on to one feature store
+// (tools/host/common/FeatureStore.h). eval_runner --features then maps the
+// store and only runs inference.
+//
+//   pio run -e native_feature_extract
+//   .pio/build/native_feature_extract/program <corpus_dir> [--out features.kwsf]
+//       [--threads N] [--no-gain]
+//
+// Runs are incremental: files whose PCM data hashes the same as in the
+// existing store keep their windows; only new and changed files are
+// extracted. A store made by a different front end is rebuilt from scratch.
+// --no-gain must match the eval_runner runs that will read the store.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioCapture.h"
+#include "Model.h"
+#include "Logger.h"
+#include "WavSource.h"
+#include "FeatureStore.h"
+
+namespace fs = std::filesystem;
+
+struct Options {
+    std::string corpus;
+    std::string out = "features.kwsf";
+    unsigned threads = 0;
+    bool gain = true;
+};
+
+struct ExtractJob {
+    std::string path;
+    std::string key;
+    uintmax_t bytes;
+};
+
+struct ExtractResult {
+    const char* error = nullptr;
+    bool reused = false;
+    FeatureFile file;
+};
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s <corpus_dir> [--out features.kwsf] [--threads N] [--no-gain]\n", program);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--out" && has_value) options.out = argv[++i];
+        else if (arg == "--threads" && has_value) options.threads = (unsigned)atoi(argv[++i]);
+        else if (arg == "--no-gain") options.gain = false;
+        else if (arg[0] != '-' && options.corpus.empty()) options.corpus = arg;
+        else return false;
+    }
+    return !options.corpus.empty();
+}
+
+// Streams one file the way eval_runner's evaluateFile() does and keeps a
+// copy of every window where it would run inference.
+static void extractFile(const Model& model, Workspace& workspace, WavSource& wav, bool gain,
+                        FeatureFile& file) {
+    StreamState stream;
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    // Clips shorter than one model window are zero padded, as in training.
+    const size_t total = std::max(wav.frameCount(), (size_t)KWS_WINDOW_SAMPLES);
+    file.owned.reserve((total / DETECTOR_HOP_SAMPLES + 1) * FEATURE_STORE_WINDOW_STRIDE);
+    for (size_t position = 0; position < total; position += DETECTOR_HOP_SAMPLES) {
+        size_t count = std::min((size_t)DETECTOR_HOP_SAMPLES, total - position);
+        size_t available = wav.read(hop, count);
+        memset(hop + available, 0, (count - available) * sizeof(int16_t));
+        if (gain) AudioCapture::condition(hop, count);
+
+        const int16_t* samples = hop;
+        while (model.feed(stream, workspace, samples, count)) {
+            if (file.window_count == 0) file.first_sample = stream.samples_processed;
+            const size_t offset = file.owned.size();
+            file.owned.resize(offset + FEATURE_STORE_WINDOW_STRIDE, 0);
+            AudioProcessor::copyFeatures(stream.features, &file.owned[offset]);
+            file.window_count++;
+        }
+    }
+    file.windows = file.owned.data();
+}
+
+static void processJob(const Model& model, Workspace& workspace, const FeatureStore* previous,
+                       const ExtractJob& job, bool gain, ExtractResult& result) {
+    WavSource wav;
+    if (!wav.open(job.path.c_str())) {
+        result.error = wav.error();
+        return;
+    }
+    FeatureFile& file = result.file;
+    file.path = job.key;
+    // The recording as stored; sample_count (at 16 kHz) tells rates apart.
+    const MappedWav& pcm = wav.wav();
+    file.content_hash = featureStoreHash(pcm.samples(), pcm.frameCount() * pcm.channels() * sizeof(int16_t));
+    file.first_sample = 0;
+    file.sample_count = wav.frameCount();
+    file.window_count = 0;
+    file.windows = nullptr;
+
+    const FeatureStoreEntry* old = previous ? previous->find(job.key.c_str()) : nullptr;
+    if (old && old->content_hash == file.content_hash && old->sample_count == file.sample_count) {
+        file.first_sample = old->first_sample;
+        file.window_count = old->window_count;
+        file.windows = previous->window(old->first_window);
+        result.reused = true;
+        return;
+    }
+    extractFile(model, workspace, wav, gain, file);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    Logger::init(LOG_LEVEL_ERROR);
+    Logger::startTask();
+
+    std::vector<ExtractJob> jobs;
+    const std::string root = fs::path(options.corpus).string();
+    std::error_code walk_error;
+    for (auto it = fs::recursive_directory_iterator(root, walk_error); !walk_error && it != fs::end(it);
+         it.increment(walk_error)) {
+        if (!it->is_regular_file()) continue;
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension != ".wav") continue;
+        const std::string path = it->path().string();
+        jobs.push_back({path, featureStoreKey(path, root), it->file_size()});
+    }
+    if (walk_error) {
+        fprintf(stderr, "❌ Cannot walk %s: %s\n", options.corpus.c_str(), walk_error.message().c_str());
+        return 1;
+    }
+    // Longest files first so one big recording doesn't finish last on its own.
+    std::sort(jobs.begin(), jobs.end(), [](const ExtractJob& a, const ExtractJob& b) {
+        return a.bytes != b.bytes ? a.bytes > b.bytes : a.path < b.path;
+    });
+
+    // The previous store stays mapped until the new one is written: reused
+    // windows are copied straight out of it.
+    FeatureStore previous;
+    const FeatureStore* reuse = nullptr;
+    if (previous.open(options.out.c_str())) {
+        if (previous.matches(options.gain)) reuse = &previous;
+        else printf("♻️ %s was made by a different front end: rebuilding\n", options.out.c_str());
+    }
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)std::max<size_t>(jobs.size(), 1)));
+
+    // Workspaces are built here: arena registration is not thread-safe.
+    // Only their front-end scratch is used; no engine is initialized.
+    Model model;
+    std::vector<std::unique_ptr<Workspace>> workspaces;
+    for (unsigned t = 0; t < threads; t++) workspaces.emplace_back(new Workspace());
+
+    std::vector<ExtractResult> results(jobs.size());
+    std::atomic<size_t> next_job(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = next_job.fetch_add(1); i < jobs.size(); i = next_job.fetch_add(1)) {
+                processJob(model, *workspaces[t], reuse, jobs[i], options.gain, results[i]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    const double extract_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<FeatureFile> files;
+    size_t reused = 0, extracted = 0, skipped = 0;
+    uint64_t windows = 0;
+    double audio_seconds = 0.0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        ExtractResult& result = results[i];
+        if (result.error) {
+            fprintf(stderr, "⚠️ Skipped %s: %s\n", jobs[i].path.c_str(), result.error);
+            skipped++;
+            continue;
+        }
+        (result.reused ? reused : extracted)++;
+        windows += result.file.window_count;
+        audio_seconds += (double)result.file.sample_count / KWS_SAMPLE_RATE_HZ;
+        files.push_back(std::move(result.file));
+    }
+    // Moving a FeatureFile keeps its vector's buffer, so `windows` still
+    // points at it.
+
+    std::string error;
+    if (!writeFeatureStore(options.out.c_str(), files, options.gain, error)) {
+        fprintf(stderr, "❌ %s\n", error.c_str());
+        return 1;
+    }
+    const double store_mb = (double)windows * FEATURE_STORE_WINDOW_STRIDE / (1024.0 * 1024.0);
+    printf("✅ %s: %zu files (%zu reused, %zu extracted, %zu skipped), %llu windows, %.1f MB\n",
+           options.out.c_str(), files.size(), reused, extracted, skipped, (unsigned long long)windows, store_mb);
+    printf("   Audio %.2f h, extracted in %.2f s with %u threads\n", audio_seconds / 3600.0, extract_seconds,
+           threads);
+    Logger::drain();
+    return 0;
+}
@@ -0,0 +1,240 @@
+// Load generator for the host detection service (tools/host/kwsd): N
+// clients each replay WAV files over their own connection and collect the
+// detection events.
+//
+//   pio run -e native_kws_loadgen
+//   .pio/build/native_kws_loadgen/program [--socket PATH] [--clients N] [--loops N]
+//       [--realtime] [file.wav | dir ...]          (default: data/test_samples)
+//
+// With --realtime every client paces itself at 1x and the report includes
+// detection latency: from sending the hop that completed the detection to
+// receiving its event. Without it clients send as fast as the server takes
+// the audio, which measures capacity.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "frontend_params.h"
+#include "KwsProtocol.h"
+#include "WavSource.h"
+
+namespace fs = std::filesystem;
+typedef std::chrono::steady_clock Clock;
+
+#define CHUNK_SAMPLES 960   // 60 ms, one detector hop
+
+struct Options {
+    std::string socket_path = KWS_DEFAULT_SOCKET;
+    int clients = 4;
+    int loops = 1;
+    bool realtime = false;
+    std::vector<std::string> inputs;
+};
+
+struct Sent {
+    uint64_t end_sample;
+    Clock::time_point time;
+};
+
+struct Received {
+    uint64_t sample;
+    float score;
+    Clock::time_point time;
+};
+
+struct ClientResult {
+    bool ok = false;
+    uint64_t samples = 0;
+    std::vector<Sent> sent;
+    std::vector<Received> events;
+};
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [--socket PATH] [--clients N] [--loops N] [--realtime] [file.wav | dir ...]\n",
+            program);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (!strcmp(arg, "--realtime")) options.realtime = true;
+        else if (!strcmp(arg, "--socket") && i + 1 < argc) options.socket_path = argv[++i];
+        else if (!strcmp(arg, "--clients") && i + 1 < argc) options.clients = atoi(argv[++i]);
+        else if (!strcmp(arg, "--loops") && i + 1 < argc) options.loops = atoi(argv[++i]);
+        else if (arg[0] == '-') return false;
+        else options.inputs.push_back(arg);
+    }
+    if (options.inputs.empty()) options.inputs.push_back("data/test_samples");
+    return options.clients > 0 && options.loops > 0;
+}
+
+// Readable files (any rate, resampled to 16 kHz on the way out); anything
+// else is reported and skipped.
+static std::vector<std::string> loadFiles(const std::vector<std::string>& inputs) {
+    std::vector<std::string> paths;
+    for (const std::string& input : inputs) {
+        std::error_code error;
+        if (fs::is_directory(input, error)) {
+            for (const auto& entry : fs::recursive_directory_iterator(input, error)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".wav") paths.push_back(entry.path().string());
+            }
+        } else {
+            paths.push_back(input);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<std::string> files;
+    for (const std::string& path : paths) {
+        WavSource wav;
+        if (!wav.open(path.c_str())) fprintf(stderr, "⚠️ %s: %s\n", path.c_str(), wav.error());
+        else files.push_back(path);
+    }
+    return files;
+}
+
+static int connectTo(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        bytes += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Reads event lines until the server closes the connection.
+static void readEvents(int fd, ClientResult& result) {
+    std::string pending;
+    char buffer[1024];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        Clock::time_point now = Clock::now();
+        pending.append(buffer, n);
+        size_t end;
+        while ((end = pending.find('\n')) != std::string::npos) {
+            unsigned long long sample, stream_ms, unix_ms;
+            float score;
+            if (sscanf(pending.c_str(), "WAKE %llu %llu %f %llu", &sample, &stream_ms, &score, &unix_ms) == 4) {
+                result.events.push_back({sample, score, now});
+            }
+            pending.erase(0, end + 1);
+        }
+    }
+}
+
+static void runClient(const Options& options, const std::vector<std::string>& files, int index,
+                      ClientResult& result) {
+    int fd = connectTo(options.socket_path);
+    if (fd < 0) {
+        fprintf(stderr, "❌ Client %d: cannot connect to %s\n", index, options.socket_path.c_str());
+        return;
+    }
+    std::thread reader(readEvents, fd, std::ref(result));
+
+    Clock::time_point start = Clock::now();
+    bool ok = true;
+    // Clients start at different files so the server sees a mix.
+    for (int loop = 0; loop < options.loops && ok; loop++) {
+        for (size_t f = 0; f < files.size() && ok; f++) {
+            // Each client reads (and resamples) its own copy.
+            WavSource wav;
+            if (!wav.open(files[(f + index) % files.size()].c_str())) continue;
+            int16_t chunk[CHUNK_SAMPLES];
+            size_t count;
+            while (ok && (count = wav.read(chunk, CHUNK_SAMPLES)) > 0) {
+                if (options.realtime) {
+                    std::this_thread::sleep_until(
+                        start + std::chrono::microseconds(result.samples * 1000000 / KWS_SAMPLE_RATE_HZ));
+                }
+                ok = sendAll(fd, chunk, count * sizeof(int16_t));
+                result.samples += count;
+                result.sent.push_back({result.samples, Clock::now()});
+            }
+        }
+    }
+    // Half-close: the server flushes the remaining events, then closes.
+    shutdown(fd, SHUT_WR);
+    reader.join();
+    close(fd);
+    result.ok = ok;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    std::vector<std::string> files = loadFiles(options.inputs);
+    if (files.empty()) {
+        fprintf(stderr, "❌ No usable WAV files\n");
+        return 1;
+    }
+
+    std::vector<ClientResult> results(options.clients);
+    std::vector<std::thread> clients;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < options.clients; i++) {
+        clients.emplace_back(runClient, std::cref(options), std::cref(files), i, std::ref(results[i]));
+    }
+    for (std::thread& client : clients) client.join();
+    double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint64_t samples = 0;
+    size_t events = 0;
+    int failed = 0;
+    std::vector<double> latencies_ms;
+    printf("client  audio s  events\n");
+    for (int i = 0; i < options.clients; i++) {
+        const ClientResult& result = results[i];
+        if (!result.ok) failed++;
+        samples += result.samples;
+        events += result.events.size();
+        printf("%6d  %7.1f  %6zu%s\n", i, (double)result.samples / KWS_SAMPLE_RATE_HZ, result.events.size(),
+               result.ok ? "" : "  (failed)");
+        for (const Received& event : result.events) {
+            // The hop whose samples completed the detection window.
+            auto sent = std::lower_bound(result.sent.begin(), result.sent.end(), event.sample,
+                                         [](const Sent& s, uint64_t sample) { return s.end_sample < sample; });
+            if (sent != result.sent.end()) {
+                latencies_ms.push_back(std::chrono::duration<double, std::milli>(event.time - sent->time).count());
+            }
+        }
+    }
+
+    double audio_seconds = (double)samples / KWS_SAMPLE_RATE_HZ;
+    printf("\n%d clients, %.1f s of audio in %.2f s wall (%.1fx real time), %zu detections\n", options.clients,
+           audio_seconds, wall, audio_seconds / wall, events);
+    if (options.realtime && !latencies_ms.empty()) {
+        std::sort(latencies_ms.begin(), latencies_ms.end());
+        auto percentile = [&](double p) { return latencies_ms[(size_t)(p * (latencies_ms.size() - 1))]; };
+        printf("Detection latency: p50 %.1f ms, p99 %.1f ms, max %.1f ms\n", percentile(0.5), percentile(0.99),
+               latencies_ms.back());
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,277 @@
+// Long-recording scan: finds every wake word in hours of field audio, using
+// every core, with the same detections a single streaming pass would make.
+//
+//   pio run -e native_scan
+//   .pio/build/native_scan/program recording.wav [more.wav ...]
+//       [--threads N] [--chunk-seconds 60] [--threshold T] [--no-gain]
+//       [--csv detections.csv] [--check]
+//
+// Each file is cut into chunks on hop boundaries. A chunk's worker starts
+// KWS_WINDOW_SAMPLES early (rounded up to hops) with a fresh StreamState:
+// the front end keeps no state beyond one window and inference follows the
+// frame clock, so from the chunk's first hop on every posterior matches the
+// streaming pass bit for bit. Workers take chunks from a shared counter
+// and keep only the inferences inside their chunk, so
+// the overlaps yield no duplicates. The merged score trace then goes through
+// Model::decide() in order, which applies the threshold and cooldown exactly
+// as the stream would have.
+//
+// --check also runs the plain sequential pass and compares the traces.
+// Files are PCM16 at any rate (tools/host/common/WavSource.h); the gate is
+// not modelled, every hop is scored.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioCapture.h"
+#include "Model.h"
+#include "Logger.h"
+#include "WavSource.h"
+
+// Hops a chunk is read ahead of its start: one model window.
+#define SCAN_WARMUP_HOPS ((KWS_WINDOW_SAMPLES + DETECTOR_HOP_SAMPLES - 1) / DETECTOR_HOP_SAMPLES)
+
+struct Options {
+    std::vector<std::string> files;
+    std::string csv_path;
+    unsigned threads = 0;
+    double chunk_seconds = 60.0;
+    float threshold = KWS_TRIGGER_THRESHOLD;
+    bool gain = true;
+    bool check = false;
+};
+
+struct ScorePoint {
+    uint64_t sample; // Audio position of the inference
+    float score;     // Marvin posterior
+};
+
+struct Chunk {
+    size_t file;
+    uint64_t begin; // Owned inferences: begin <= sample < end
+    uint64_t end;
+    std::vector<ScorePoint> trace;
+    bool ok = false;
+};
+
+struct ScanFile {
+    std::string path;
+    size_t samples = 0; // At 16 kHz, padded to one window
+    double seconds = 0.0;
+    const char* error = nullptr;
+    std::vector<ScorePoint> trace;
+};
+
+struct Detection {
+    uint64_t sample;
+    float score;
+};
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s <file.wav>... [--threads N] [--chunk-seconds S] [--threshold T] [--no-gain] "
+                    "[--csv detections.csv] [--check]\n", program);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--threads" && has_value) options.threads = (unsigned)atoi(argv[++i]);
+        else if (arg == "--chunk-seconds" && has_value) options.chunk_seconds = atof(argv[++i]);
+        else if (arg == "--threshold" && has_value) options.threshold = (float)atof(argv[++i]);
+        else if (arg == "--csv" && has_value) options.csv_path = argv[++i];
+        else if (arg == "--no-gain") options.gain = false;
+        else if (arg == "--check") options.check = true;
+        else if (arg[0] != '-') options.files.push_back(arg);
+        else return false;
+    }
+    return !options.files.empty() && options.chunk_seconds > 0.0;
+}
+
+// Streams [from, to) of the file through the model one hop at a time, as
+// detect() would, keeping inferences at or after `keep_from`. `from` must
+// be a hop boundary.
+static bool scanRange(const Model& model, Workspace& workspace, WavSource& wav, size_t samples, uint64_t from,
+                      uint64_t to, uint64_t keep_from, bool gain, std::vector<ScorePoint>& trace) {
+    StreamState stream;
+    stream.samples_processed = from;
+    wav.seek((size_t)from);
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    for (uint64_t position = from; position < to; position += DETECTOR_HOP_SAMPLES) {
+        // Files shorter than one window are zero padded, as in evaluation.
+        size_t count = (size_t)std::min<uint64_t>(DETECTOR_HOP_SAMPLES, samples - position);
+        size_t available = wav.read(hop, count);
+        memset(hop + available, 0, (count - available) * sizeof(int16_t));
+        if (gain) AudioCapture::condition(hop, count);
+
+        const int16_t* in = hop;
+        while (model.feed(stream, workspace, in, count)) {
+            if (!model.infer(stream, workspace)) return false;
+            if (stream.samples_processed >= keep_from) {
+                trace.push_back({stream.samples_processed, stream.posteriors[KWS_LABEL_MARVIN_IDX]});
+            }
+        }
+    }
+    return true;
+}
+
+// The trigger rule of the detector over a file's merged trace.
+static std::vector<Detection> decide(const Model& model, const std::vector<ScorePoint>& trace) {
+    std::vector<Detection> detections;
+    StreamState stream;
+    for (const ScorePoint& point : trace) {
+        stream.samples_processed = point.sample;
+        stream.posteriors[KWS_LABEL_MARVIN_IDX] = point.score;
+        if (model.decide(stream)) detections.push_back({point.sample, point.score});
+    }
+    return detections;
+}
+
+static std::string timestamp(uint64_t sample) {
+    const uint64_t ms = sample * 1000 / KWS_SAMPLE_RATE_HZ;
+    char text[32];
+    snprintf(text, sizeof(text), "%02u:%02u:%02u.%03u", (unsigned)(ms / 3600000), (unsigned)(ms / 60000 % 60),
+             (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000));
+    return text;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    Logger::init(LOG_LEVEL_ERROR);
+    Logger::startTask();
+
+    // Lengths first, so chunks can be cut before any audio is read.
+    std::vector<ScanFile> files(options.files.size());
+    for (size_t f = 0; f < files.size(); f++) {
+        files[f].path = options.files[f];
+        WavSource wav;
+        if (!wav.open(files[f].path.c_str())) {
+            files[f].error = wav.error();
+            continue;
+        }
+        files[f].samples = std::max(wav.frameCount(), (size_t)KWS_WINDOW_SAMPLES);
+        files[f].seconds = wav.seconds();
+    }
+
+    const uint64_t chunk_hops = std::max<uint64_t>(1, (uint64_t)(options.chunk_seconds * KWS_SAMPLE_RATE_HZ /
+                                                                 DETECTOR_HOP_SAMPLES));
+    const uint64_t chunk_samples = chunk_hops * DETECTOR_HOP_SAMPLES;
+    std::vector<Chunk> chunks;
+    for (size_t f = 0; f < files.size(); f++) {
+        for (uint64_t begin = 0; begin < files[f].samples; begin += chunk_samples) {
+            Chunk chunk;
+            chunk.file = f;
+            chunk.begin = begin;
+            chunk.end = std::min<uint64_t>(begin + chunk_samples, files[f].samples);
+            chunks.push_back(std::move(chunk));
+        }
+    }
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)std::max<size_t>(chunks.size(), 1)));
+
+    // One immutable model; each worker owns its scratch and reader.
+    // Workspaces are built here: arena registration is not thread-safe.
+    Model model;
+    model.setThreshold(options.threshold);
+    std::vector<std::unique_ptr<Workspace>> workspaces;
+    for (unsigned t = 0; t < threads; t++) {
+        workspaces.emplace_back(new Workspace());
+        if (!workspaces.back()->init()) return 1;
+    }
+
+    std::atomic<size_t> next_chunk(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            WavSource wav;
+            size_t open_file = SIZE_MAX;
+            for (size_t i = next_chunk.fetch_add(1); i < chunks.size(); i = next_chunk.fetch_add(1)) {
+                Chunk& chunk = chunks[i];
+                const ScanFile& file = files[chunk.file];
+                if (file.error) continue;
+                if (open_file != chunk.file && !wav.open(file.path.c_str())) continue;
+                open_file = chunk.file;
+                const uint64_t warmup = (uint64_t)SCAN_WARMUP_HOPS * DETECTOR_HOP_SAMPLES;
+                const uint64_t from = chunk.begin > warmup ? chunk.begin - warmup : 0;
+                chunk.ok = scanRange(model, *workspaces[t], wav, file.samples, from, chunk.end, chunk.begin,
+                                     options.gain, chunk.trace);
+                // An inference that lands exactly on the end is the next chunk's.
+                if (!chunk.trace.empty() && chunk.trace.back().sample >= chunk.end) chunk.trace.pop_back();
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Chunks are in file order, each in stream order.
+    for (const Chunk& chunk : chunks) {
+        ScanFile& file = files[chunk.file];
+        if (!chunk.ok && !file.error) file.error = "scan failed";
+        if (file.error) continue;
+        file.trace.insert(file.trace.end(), chunk.trace.begin(), chunk.trace.end());
+    }
+
+    FILE* csv = options.csv_path.empty() ? nullptr : fopen(options.csv_path.c_str(), "w");
+    if (!options.csv_path.empty() && !csv) {
+        fprintf(stderr, "❌ Cannot write %s\n", options.csv_path.c_str());
+        return 1;
+    }
+    if (csv) fprintf(csv, "file,time_s,sample,score\n");
+    double audio_seconds = 0.0;
+    size_t total_detections = 0;
+    int mismatches = 0;
+    for (ScanFile& file : files) {
+        if (file.error) {
+            fprintf(stderr, "⚠️ Skipped %s: %s\n", file.path.c_str(), file.error);
+            continue;
+        }
+        audio_seconds += file.seconds;
+        const std::vector<Detection> detections = decide(model, file.trace);
+        total_detections += detections.size();
+        printf("🔎 %s: %.1f min, %zu inferences, %zu detections\n", file.path.c_str(), file.seconds / 60.0,
+               file.trace.size(), detections.size());
+        for (const Detection& detection : detections) {
+            printf("   %s  %.3f\n", timestamp(detection.sample).c_str(), detection.score);
+            if (csv) {
+                fprintf(csv, "%s,%.3f,%llu,%.4f\n", file.path.c_str(), (double)detection.sample / KWS_SAMPLE_RATE_HZ,
+                        (unsigned long long)detection.sample, detection.score);
+            }
+        }
+
+        if (options.check) {
+            WavSource wav;
+            std::vector<ScorePoint> sequential;
+            bool same = wav.open(file.path.c_str()) &&
+                        scanRange(model, *workspaces[0], wav, file.samples, 0, file.samples, 0, options.gain,
+                                  sequential) &&
+                        sequential.size() == file.trace.size();
+            for (size_t i = 0; same && i < sequential.size(); i++) {
+                same = sequential[i].sample == file.trace[i].sample && sequential[i].score == file.trace[i].score;
+            }
+            printf("   %s sequential pass\n", same ? "✅ Identical to the" : "❌ Differs from the");
+            if (!same) mismatches++;
+        }
+    }
+    if (csv) {
+        fclose(csv);
+        printf("Detections written to %s\n", options.csv_path.c_str());
+    }
+
+    printf("\n📊 %zu detections in %.2f h of audio, %zu chunks on %u threads in %.2f s (%.0fx real time)\n",
+           total_detections, audio_seconds / 3600.0, chunks.size(), threads, wall_seconds,
+           audio_seconds / wall_seconds);
+    Logger::drain();
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,450 @@
+// Host detection service: one process watches every audio producer on the
+// box. Clients stream PCM over a UNIX socket (protocol in KwsProtocol.h);
+// the shared Model runs on a StreamRunner worker pool and detections go back
+// to the client that produced the audio.
+//
+//   pio run -e native_kwsd
+//   .pio/build/native_kwsd/program [--socket PATH] [--workers N] [--max-clients N]
+//       [--threshold T] [--batch B] [--wait-us U]
+//
+// I/O is one epoll loop (level triggered); it does all the socket writes.
+// A connection whose stream ring is full stops being read until the workers
+// catch up, so back-pressure reaches the client through its socket buffer.
+// Half-closing the socket (shutdown(SHUT_WR)) flushes: the server processes
+// everything received, sends the remaining events and then closes.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "StreamRunner.h"
+#include "Logger.h"
+#include "KwsProtocol.h"
+
+#define CONNECTION_BUFFER_BYTES 8192
+#define CONNECTION_OUTBOX_BYTES 4096 // Events waiting for room in the socket
+#define THROTTLE_POLL_MS 2
+#define CLOSE_LINGER_MS 1000 // A closed stream's last events get this long to go out
+#define CLOSE_POLL_MS 50
+
+struct Options {
+    std::string socket_path = KWS_DEFAULT_SOCKET;
+    unsigned workers = 0;
+    int max_clients = 64;
+    float threshold = KWS_TRIGGER_THRESHOLD;
+    int batch = DSCNN_MAX_BATCH;
+    unsigned wait_us = 0;
+};
+
+struct Connection {
+    int fd;
+    int stream;
+    bool throttled;     // Not read until the stream ring has room
+    bool eof;           // Client half-closed; flush and close
+    bool closing;       // Not read; waiting for the runner to release the stream
+    bool released;      // Stream gone, lingering until the outbox is sent
+    uint32_t watched;   // epoll events registered, 0 when out of the set
+    uint64_t released_ms;
+    size_t fill;
+    uint64_t bytes;
+    std::atomic<uint32_t> events;
+    std::atomic<uint32_t> dropped;  // Events the client did not read in time
+    // Workers append whole event lines; the I/O loop sends them.
+    std::mutex outbox_mutex;
+    size_t outbox_fill;
+    char outbox[CONNECTION_OUTBOX_BYTES];
+    alignas(2) uint8_t buffer[CONNECTION_BUFFER_BYTES];
+};
+
+struct Server {
+    StreamRunner* runner;
+    std::vector<Connection*> connections;   // By stream index
+    std::vector<Connection*> lingering;     // Released, events still going out
+    int epoll_fd;
+    int wake_fd;                            // eventfd: events queued or a stream went idle
+};
+
+static std::atomic<bool> running(true);
+
+static void onSignal(int) {
+    running = false;
+}
+
+static uint64_t clockMillis(clockid_t clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static void wake(Server& server) {
+    uint64_t one = 1;
+    ssize_t written = write(server.wake_fd, &one, sizeof(one));
+    (void)written; // Already signalled when the counter is saturated
+}
+
+// Runs on a worker thread. The line is queued whole and the I/O loop sends
+// it, so a full socket never leaves half an event on the wire; when the
+// outbox is full as well the event is dropped whole. The connection
+// outlives its callbacks: it is only deleted once the runner has released
+// its stream.
+static void onDetection(const StreamState& stream, void* context) {
+    Server* server = static_cast<Server*>(context);
+    Connection* connection = server->connections[stream.id];
+    char line[KWS_EVENT_MAX_LINE];
+    int length = snprintf(line, sizeof(line), "WAKE %llu %llu %.4f %llu\n",
+                          (unsigned long long)stream.last_detection_sample,
+                          (unsigned long long)(stream.last_detection_sample * 1000 / KWS_SAMPLE_RATE_HZ),
+                          stream.posteriors[KWS_LABEL_MARVIN_IDX], (unsigned long long)clockMillis(CLOCK_REALTIME));
+    connection->events++;
+    {
+        std::lock_guard<std::mutex> lock(connection->outbox_mutex);
+        if (length > 0 && connection->outbox_fill + length <= sizeof(connection->outbox)) {
+            memcpy(connection->outbox + connection->outbox_fill, line, length);
+            connection->outbox_fill += length;
+        } else {
+            connection->dropped++;
+        }
+    }
+    wake(*server);
+}
+
+// Runs on a worker thread once a closing connection's stream goes idle.
+static void onStreamIdle(int, void* context) {
+    wake(*static_cast<Server*>(context));
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [--socket PATH] [--workers N] [--max-clients N] [--threshold T]\n"
+            "          [--batch B] [--wait-us U]\n",
+            program);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) return false;
+        if (!strcmp(arg, "--socket")) options.socket_path = argv[++i];
+        else if (!strcmp(arg, "--workers")) options.workers = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(arg, "--max-clients")) options.max_clients = atoi(argv[++i]);
+        else if (!strcmp(arg, "--threshold")) options.threshold = (float)atof(argv[++i]);
+        else if (!strcmp(arg, "--batch")) options.batch = atoi(argv[++i]);
+        else if (!strcmp(arg, "--wait-us")) options.wait_us = (unsigned)atoi(argv[++i]);
+        else return false;
+    }
+    return options.max_clients > 0;
+}
+
+static int listenOn(const std::string& path) {
+    struct sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path)) {
+        fprintf(stderr, "❌ Socket path too long: %s\n", path.c_str());
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    unlink(path.c_str());
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 64) != 0) {
+        perror(path.c_str());
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool outboxPending(Connection* connection) {
+    std::lock_guard<std::mutex> lock(connection->outbox_mutex);
+    return connection->outbox_fill > 0;
+}
+
+// Drops what is left in the outbox, counting the events it held (a line
+// already partly sent ends in the remainder too).
+static void discardOutbox(Connection* connection) {
+    std::lock_guard<std::mutex> lock(connection->outbox_mutex);
+    connection->dropped += (uint32_t)std::count(connection->outbox, connection->outbox + connection->outbox_fill, '\n');
+    connection->outbox_fill = 0;
+}
+
+// Sends as much of the outbox as the socket takes. A peer that is gone
+// gets its events dropped.
+static void sendOutbox(Connection* connection) {
+    {
+        std::lock_guard<std::mutex> lock(connection->outbox_mutex);
+        size_t sent = 0;
+        while (sent < connection->outbox_fill) {
+            ssize_t n = send(connection->fd, connection->outbox + sent, connection->outbox_fill - sent,
+                             MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (n > 0) sent += n;
+            else if (n < 0 && errno == EINTR) continue;
+            else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            else {
+                sent = SIZE_MAX;
+                break;
+            }
+        }
+        if (sent != SIZE_MAX) {
+            memmove(connection->outbox, connection->outbox + sent, connection->outbox_fill - sent);
+            connection->outbox_fill -= sent;
+            return;
+        }
+    }
+    discardOutbox(connection);
+}
+
+// Registers what the loop waits for: input unless the connection is
+// throttled or closing, output while its outbox waits for the socket. With
+// neither it leaves the epoll set entirely: hangups are reported regardless
+// of the event mask and would spin the loop.
+static void watch(Server& server, Connection* connection) {
+    uint32_t wanted = 0;
+    if (!connection->throttled && !connection->closing) wanted |= EPOLLIN | EPOLLRDHUP;
+    if (outboxPending(connection)) wanted |= EPOLLOUT;
+    if (wanted == connection->watched) return;
+    struct epoll_event event;
+    event.events = wanted;
+    event.data.ptr = connection;
+    int op = !wanted ? EPOLL_CTL_DEL : connection->watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    epoll_ctl(server.epoll_fd, op, connection->fd, &event);
+    connection->watched = wanted;
+}
+
+// The stream is released: whatever the socket takes of the outbox goes
+// out, the rest is dropped.
+static void closeConnection(Server& server, Connection* connection) {
+    sendOutbox(connection);
+    discardOutbox(connection);
+    if (connection->watched) epoll_ctl(server.epoll_fd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    printf("👋 Client %d closed: %.1f s of audio, %u detections (%u undelivered)\n", connection->stream,
+           connection->bytes / (2.0 * KWS_SAMPLE_RATE_HZ), (unsigned)connection->events,
+           (unsigned)connection->dropped);
+    close(connection->fd);
+    delete connection;
+}
+
+// Steps a closing connection on without blocking the loop. The workers may
+// still be on its last audio; onStreamIdle wakes the loop when they are
+// done. Released, no more events arrive, and the connection lingers until
+// its outbox is sent, the peer is gone or CLOSE_LINGER_MS passes.
+static void finishClose(Server& server, Connection* connection) {
+    if (!connection->released) {
+        if (!server.runner->tryRemoveStream(connection->stream)) return;
+        connection->released = true;
+        connection->released_ms = clockMillis(CLOCK_MONOTONIC);
+        server.connections[connection->stream] = nullptr; // The index may be reused now
+        server.lingering.push_back(connection);
+    }
+    if (outboxPending(connection) && clockMillis(CLOCK_MONOTONIC) - connection->released_ms < CLOSE_LINGER_MS) {
+        watch(server, connection);
+        return;
+    }
+    server.lingering.erase(std::find(server.lingering.begin(), server.lingering.end(), connection));
+    closeConnection(server, connection);
+}
+
+static void beginClose(Server& server, Connection* connection) {
+    connection->closing = true;
+    watch(server, connection);
+    finishClose(server, connection);
+}
+
+// Moves whole samples from the connection buffer into the stream ring.
+// Returns true when everything buffered was accepted.
+static bool flush(Server& server, Connection* connection) {
+    size_t samples = connection->fill / sizeof(int16_t);
+    if (samples == 0) return true;
+    size_t accepted = server.runner->push(connection->stream,
+                                          reinterpret_cast<const int16_t*>(connection->buffer), samples);
+    size_t consumed = accepted * sizeof(int16_t);
+    memmove(connection->buffer, connection->buffer + consumed, connection->fill - consumed);
+    connection->fill -= consumed;
+    return accepted == samples;
+}
+
+// Reads until the socket is drained or the stream pushes back. Returns
+// false once the connection is closing (and possibly already deleted);
+// otherwise the caller re-registers it with watch().
+static bool pump(Server& server, Connection* connection) {
+    while (true) {
+        if (!flush(server, connection)) {
+            connection->throttled = true;
+            return true;
+        }
+        if (connection->eof) {
+            beginClose(server, connection);
+            return false;
+        }
+        connection->throttled = false; // Room again
+        ssize_t n = read(connection->fd, connection->buffer + connection->fill,
+                         sizeof(connection->buffer) - connection->fill);
+        if (n > 0) {
+            connection->fill += n;
+            connection->bytes += n;
+        } else if (n == 0) {
+            connection->eof = true; // A trailing odd byte is dropped
+            connection->fill &= ~(size_t)1;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        } else {
+            connection->eof = true;
+            connection->fill = 0;
+        }
+    }
+}
+
+static void acceptClients(Server& server, int listen_fd) {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        int stream = server.runner->addStream();
+        if (stream < 0) {
+            fprintf(stderr, "⚠️ Client refused: all %u streams busy\n", (unsigned)server.connections.size());
+            close(fd);
+            continue;
+        }
+        Connection* connection = new Connection();
+        connection->fd = fd;
+        connection->stream = stream;
+        connection->throttled = false;
+        connection->eof = false;
+        connection->closing = false;
+        connection->released = false;
+        connection->watched = 0;
+        connection->released_ms = 0;
+        connection->fill = 0;
+        connection->bytes = 0;
+        connection->events = 0;
+        connection->dropped = 0;
+        connection->outbox_fill = 0;
+        server.connections[stream] = connection;
+        watch(server, connection);
+        printf("🔌 Client %d connected\n", stream);
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    Logger::init(LOG_LEVEL_ERROR);
+    Logger::startTask();
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    Model model;
+    model.setThreshold(options.threshold);
+    unsigned workers = options.workers ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+    Server server;
+    server.connections.assign(options.max_clients, nullptr);
+    StreamRunner runner(model, options.max_clients, workers, onDetection, &server);
+    runner.setBatching(options.batch, options.wait_us);
+    runner.setIdleCallback(onStreamIdle, &server);
+    server.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    server.runner = &runner;
+    if (!runner.start()) return 1;
+
+    int listen_fd = listenOn(options.socket_path);
+    if (listen_fd < 0) return 1;
+    server.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr; // The listening socket
+    epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.ptr = &server.wake_fd;
+    epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.wake_fd, &event);
+    printf("🎧 Listening on %s: %u workers, %d clients max, %u bytes per stream\n", options.socket_path.c_str(),
+           workers, options.max_clients, (unsigned)StreamRunner::bytesPerStream());
+
+    struct epoll_event events[64];
+    while (running) {
+        bool throttled = false;
+        for (Connection* connection : server.connections) throttled |= connection && connection->throttled;
+        // Throttled connections are retried on a short timer: the workers
+        // free ring space without telling the I/O loop. Lingering ones are
+        // timed out on one.
+        int timeout = throttled ? THROTTLE_POLL_MS : !server.lingering.empty() ? CLOSE_POLL_MS : 500;
+        int ready = epoll_wait(server.epoll_fd, events, 64, timeout);
+        if (ready < 0 && errno != EINTR) {
+            perror("epoll_wait");
+            break;
+        }
+        bool woken = false;
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.ptr == &server.wake_fd) {
+                uint64_t count;
+                ssize_t n = read(server.wake_fd, &count, sizeof(count));
+                (void)n;
+                woken = true;
+                continue;
+            }
+            Connection* connection = static_cast<Connection*>(events[i].data.ptr);
+            if (!connection) {
+                acceptClients(server, listen_fd);
+                continue;
+            }
+            if (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) sendOutbox(connection);
+            if (connection->closing) {
+                finishClose(server, connection);
+            } else if (!(events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) ||
+                       pump(server, connection)) {
+                watch(server, connection);
+            }
+        }
+        // After the events: closing connections can be deleted here.
+        for (Connection* connection : server.connections) {
+            if (!connection) continue;
+            if (woken && connection->closing) {
+                finishClose(server, connection);
+                continue;
+            }
+            if (woken) sendOutbox(connection);
+            if (!connection->throttled || pump(server, connection)) watch(server, connection);
+        }
+        const std::vector<Connection*> lingering = server.lingering;
+        for (Connection* connection : lingering) finishClose(server, connection);
+    }
+
+    printf("🛑 Shutting down\n");
+    for (Connection* connection : server.connections) {
+        if (!connection) continue;
+        // The loop is over, so waiting for the workers here is fine.
+        runner.removeStream(connection->stream);
+        closeConnection(server, connection);
+    }
+    for (Connection* connection : server.lingering) closeConnection(server, connection);
+    runner.stop();
+    close(server.wake_fd);
+    close(server.epoll_fd);
+    close(listen_fd);
+    unlink(options.socket_path.c_str());
+    return 0;
+}
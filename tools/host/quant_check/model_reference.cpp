@@ -0,0 +1,691 @@
+// Generated by tools/model_converter.py --reference from model_weights.h. Do not edit.
+#include "model_reference.h"
+#include <cmath>
+
+static const float ref_conv_weights[] = {
+    0.627654095f, -1.22801888f, -1.40539939f, -0.90054718f, 0.0818679255f, -0.750455984f, 0.573075478f, 0.845968563f,
+    1.73287109f, 0.723166675f, -1.1325063f, -0.163735851f, 0.0818679255f, 0.682232712f, 1.00970441f, 1.73287109f,
+    0.941481143f, -1.73287109f, -0.695877367f, -1.03699372f, -0.245603776f, 0.764100638f, -1.73287109f, -0.982415106f,
+    0.35476101f, -0.218314468f, 1.59642455f, 1.56913524f, -1.73287109f, 0.955125797f, 0.573075478f, -0.600364787f,
+    0.90054718f, -0.491207553f, -1.22801888f, 0.300182393f, -1.459978f, -1.40539939f, 0.54578617f, -0.873257872f,
+    0.941481143f, -0.559430824f, 1.73287109f, 0.873257872f, 0.600364787f, 0.122801888f, 1.73287109f, -0.873257872f,
+    -0.90054718f, 0.45027359f, -0.341116356f, 1.11886165f, -1.17344027f, -0.409339627f, 1.73287109f, 1.62371386f,
+    -0.982415106f, 1.05063838f, 1.07792769f, 0.832323909f, -1.54184593f, -0.955125797f, -0.0136446542f, -1.24166354f,
+    -0.723166675f, 1.1325063f, 1.20072957f, 1.09157234f, 1.73287109f, -1.1325063f, -1.03699372f, -0.382050319f,
+    -0.368405665f, 0.777745292f, -1.73287109f, -0.218314468f, 1.09157234f, -0.286537739f, -0.327471702f, 0.709522021f,
+    -0.286537739f, 0.231959122f, -1.35082077f, 0.600364787f, -0.409339627f, 0.054578617f, -0.0818679255f, 0.955125797f,
+    -1.73287109f, -1.07792769f, -0.341116356f, 0.300182393f, 0.259248431f, -0.422984282f, 0.504852207f, 0.859613218f,
+    -0.600364787f, -0.764100638f, 1.73287109f, 1.02334907f, -0.368405665f, -0.272893085f, -0.90054718f, -1.73287109f,
+    0.64129875f, -0.723166675f, 1.37811008f, -1.59642455f, 0.818679255f, 0.805034601f, 1.1325063f, -0.245603776f,
+    0.614009441f, -0.231959122f, 0.654943404f, -0.518496861f, -1.73287109f, -0.654943404f, -1.67829247f, 0.518496861f,
+    0.491207553f, 0.341116356f, -1.73287109f, -0.136446542f, -0.109157234f, -1.06428303f, 0.750455984f, -1.55549058f,
+    0.0818679255f, -0.859613218f, 0.0409339627f, 1.2825975f, -1.09157234f, 1.73287109f, -0.0955125797f, 0.64129875f,
+    1.67829247f, -1.09157234f, 0.859613218f, -1.18708492f, -0.982415106f, 0.504852207f, -1.73287109f, 0.90054718f,
+};
+
+static const float ref_conv_bias[] = {
+    1.53887114f, 23.2731629f, -19.6613419f, -16.3301384f, 1.05910543f, 12.9808307f, 16.6198083f, -7.70340788f,
+    14.5468584f, -8.13791267f, -5.95633653f, 6.42705005f, 15.7598509f, -2.02768903f, -3.56656017f, 12.256656f,
+};
+
+static void ref_conv(const float* input, float* output) {
+    for (int y = 0; y < 33; y++) {
+        for (int x = 0; x < 5; x++) {
+            for (int o = 0; o < 16; o++) {
+                float acc = ref_conv_bias[o];
+                for (int ky = 0; ky < 3; ky++) {
+                    const int iy = y * 2 - 1 + ky;
+                    if (iy < 0 || iy >= 65) continue;
+                    for (int kx = 0; kx < 3; kx++) {
+                        const int ix = x * 2 - 0 + kx;
+                        if (ix < 0 || ix >= 10) continue;
+                        const float* in = input + (iy * 10 + ix) * 1;
+                        const float* w = ref_conv_weights + ((o * 3 + ky) * 3 + kx) * 1;
+                        for (int i = 0; i < 1; i++) acc += in[i] * w[i];
+                    }
+                }
+                output[(y * 5 + x) * 16 + o] = acc > 0.0f ? acc : 0.0f;
+            }
+        }
+    }
+}
+
+static const float ref_b1_dw_weights[] = {
+    0.728041587f, 0.734909904f, 0.618148517f, 0.233522773f, 0.872276241f, -0.467045546f, 0.0137366337f, 0.0206049506f,
+    -0.357152477f, -0.453308913f, -0.467045546f, -0.144234654f, -0.116761387f, 0.425835645f, -0.549465349f, -0.24039109f,
+    0.549465349f, 0.872276241f, -0.192312872f, -0.0618148517f, 0.0549465349f, 0.48078218f, 0.151102971f, 0.872276241f,
+    -0.178576238f, 0.460177229f, -0.309074259f, -0.192312872f, 0.10989307f, 0.185444555f, -0.817329706f, -0.116761387f,
+    -0.405230695f, 0.151102971f, -0.872276241f, 0.0824198023f, -0.59067525f, -0.405230695f, -0.748646537f, -0.212917823f,
+    -0.460177229f, 0.872276241f, 0.048078218f, 0.638753468f, 0.13049802f, 0.872276241f, -0.6112802f, 0.0824198023f,
+    0.0686831686f, -0.199181189f, 0.59067525f, 0.151102971f, 0.0824198023f, 0.659358418f, 0.322810892f, 0.226654456f,
+    0.274732674f, 0.631885151f, 0.185444555f, -0.37088911f, 0.35028416f, -0.391494061f, -0.872276241f, -0.192312872f,
+    0.0755514854f, 0.137366337f, 0.37088911f, -0.377757427f, 0.0892881191f, -0.872276241f, 0.872276241f, 0.123629703f,
+    -0.85167129f, -0.0755514854f, -0.0412099011f, 0.872276241f, 0.460177229f, -0.37088911f, -0.494518814f, -0.329679209f,
+    0.0412099011f, -0.309074259f, -0.096156436f, 0.872276241f, -0.0206049506f, -0.508255447f, -0.48078218f, 0.274732674f,
+    -0.137366337f, -0.185444555f, -0.872276241f, 0.686831686f, -0.487650497f, 0.734909904f, 0.0f, -0.233522773f,
+    0.467045546f, -0.810461389f, 0.0274732674f, 0.302205942f, 0.570070299f, -0.679963369f, -0.164839605f, -0.226654456f,
+    0.872276241f, -0.00686831686f, -0.199181189f, -0.535728715f, 0.260996041f, -0.666226735f, -0.0618148517f, -0.872276241f,
+    -0.254127724f, 0.171707921f, -0.336547526f, 0.171707921f, -0.233522773f, 0.164839605f, 0.096156436f, -0.679963369f,
+    0.226654456f, -0.391494061f, -0.206049506f, -0.151102971f, 0.872276241f, -0.748646537f, 0.137366337f, -0.0824198023f,
+    -0.872276241f, -0.226654456f, -0.625016834f, 0.377757427f, -0.295337625f, 0.295337625f, 0.0412099011f, -0.281600991f,
+    -0.501387131f, -0.460177229f, -0.85167129f, 0.35028416f, -0.00686831686f, 0.315942575f, 0.357152477f, -0.13049802f,
+};
+
+static const float ref_b1_dw_bias[] = {
+    -6.99881488f, -9.60877528f, -15.3300832f, -3.27618714f, -3.98362378f, 19.5266248f, -4.75287527f, -2.17038813f,
+    19.2450238f, 0.0343415843f, 27.8372882f, -8.67468419f, -27.4526625f, 8.00158914f, 44.4105368f, 31.690414f,
+};
+
+static void ref_b1_dw(const float* input, float* output) {
+    for (int y = 0; y < 33; y++) {
+        for (int x = 0; x < 5; x++) {
+            for (int o = 0; o < 16; o++) {
+                float acc = ref_b1_dw_bias[o];
+                for (int ky = 0; ky < 3; ky++) {
+                    const int iy = y * 1 - 1 + ky;
+                    if (iy < 0 || iy >= 33) continue;
+                    for (int kx = 0; kx < 3; kx++) {
+                        const int ix = x * 1 - 1 + kx;
+                        if (ix < 0 || ix >= 5) continue;
+                        acc += input[(iy * 5 + ix) * 16 + o] * ref_b1_dw_weights[(ky * 3 + kx) * 16 + o];
+                    }
+                }
+                output[(y * 5 + x) * 16 + o] = acc > 0.0f ? acc : 0.0f;
+            }
+        }
+    }
+}
+
+static const float ref_b1_pw_weights[] = {
+    0.759159849f, -0.340725287f, 0.239105464f, -0.358658196f, -0.70536112f, -0.490166202f, -0.233127828f, 0.412456926f,
+    -0.322792377f, -0.245083101f, 0.029888183f, -0.149440915f, 0.442345109f, 0.35268056f, -0.400501653f, 0.591786024f,
+    -0.0717316393f, 0.0537987295f, 0.603741297f, -0.741226939f, 0.621674207f, 0.0896645491f, 0.155418552f, -0.173351462f,
+    -0.286926557f, -0.029888183f, 0.520054385f, 0.107597459f, -0.286926557f, 0.0179329098f, -0.759159849f, 0.514076748f,
+    0.0119552732f, 0.340725287f, -0.735249303f, -0.472233292f, 0.245083101f, 0.179329098f, -0.125530369f, -0.0836869125f,
+    0.532009658f, -0.221172554f, -0.376591106f, -0.292904194f, -0.167373825f, 0.63362948f, -0.759159849f, 0.29888183f,
+    -0.448322746f, 0.215194918f, -0.268993647f, 0.454300382f, -0.340725287f, 0.400501653f, 0.567875478f, 0.573853114f,
+    -0.759159849f, 0.101619822f, 0.31681474f, 0.693405846f, 0.490166202f, -0.70536112f, 0.101619822f, -0.119552732f,
+    -0.532009658f, 0.251060737f, -0.143463279f, -0.0777092759f, 0.759159849f, 0.33474765f, -0.149440915f, -0.245083101f,
+    0.107597459f, -0.400501653f, 0.310837104f, -0.328770013f, 0.101619822f, 0.759159849f, -0.657540027f, 0.430389836f,
+    0.418434562f, -0.161396188f, 0.143463279f, 0.119552732f, -0.603741297f, -0.179329098f, 0.388546379f, 0.376591106f,
+    0.358658196f, 0.400501653f, -0.37061347f, -0.759159849f, -0.167373825f, -0.263016011f, -0.412456926f, 0.31681474f,
+    -0.561897841f, 0.639607117f, -0.221172554f, 0.759159849f, -0.747204576f, 0.233127828f, 0.340725287f, -0.388546379f,
+    -0.358658196f, 0.161396188f, -0.0537987295f, -0.0179329098f, -0.508099112f, 0.520054385f, 0.388546379f, -0.508099112f,
+    0.0239105464f, 0.173351462f, -0.711338756f, 0.753182212f, -0.131508005f, 0.520054385f, -0.496143838f, 0.759159849f,
+    0.514076748f, 0.33474765f, 0.310837104f, -0.657540027f, 0.221172554f, 0.167373825f, -0.741226939f, -0.0478210929f,
+    -0.520054385f, -0.657540027f, 0.514076748f, 0.215194918f, 0.412456926f, -0.406479289f, -0.239105464f, 0.759159849f,
+    0.543964931f, -0.526032021f, 0.0956421857f, -0.0478210929f, 0.741226939f, 0.029888183f, -0.0836869125f, 0.358658196f,
+    -0.693405846f, -0.155418552f, -0.741226939f, 0.0358658196f, 0.029888183f, -0.729271666f, -0.0239105464f, -0.759159849f,
+    -0.37061347f, 0.33474765f, 0.472233292f, 0.609718934f, 0.0896645491f, 0.29888183f, -0.514076748f, -0.573853114f,
+    -0.149440915f, 0.573853114f, 0.227150191f, -0.173351462f, -0.484188565f, -0.00597763661f, -0.143463279f, 0.185306735f,
+    -0.143463279f, -0.358658196f, 0.35268056f, -0.759159849f, -0.286926557f, 0.149440915f, 0.0657540027f, -0.424412199f,
+    0.239105464f, 0.137485642f, 0.0956421857f, -0.424412199f, 0.215194918f, 0.555920204f, -0.274971284f, 0.412456926f,
+    0.35268056f, 0.573853114f, -0.0358658196f, -0.31681474f, 0.185306735f, -0.735249303f, -0.759159849f, 0.466255655f,
+    -0.0418434562f, 0.257038374f, 0.699383483f, 0.0777092759f, -0.0836869125f, 0.645584754f, -0.31681474f, 0.567875478f,
+    -0.555920204f, 0.274971284f, -0.723294029f, 0.472233292f, 0.759159849f, 0.251060737f, 0.555920204f, 0.376591106f,
+    0.376591106f, 0.197262008f, 0.179329098f, 0.245083101f, -0.101619822f, 0.263016011f, 0.101619822f, -0.304859467f,
+    0.125530369f, 0.448322746f, -0.759159849f, -0.274971284f, -0.0836869125f, -0.29888183f, 0.179329098f, -0.101619822f,
+    -0.125530369f, -0.113575096f, -0.0717316393f, 0.119552732f, -0.0478210929f, 0.394524016f, -0.322792377f, -0.663517663f,
+    -0.107597459f, 0.0717316393f, -0.759159849f, 0.161396188f, 0.31681474f, -0.645584754f, -0.203239645f, -0.101619822f,
+    -0.0896645491f, -0.573853114f, -0.191284371f, -0.245083101f, 0.609718934f, 0.759159849f, 0.0597763661f, 0.0657540027f,
+    0.537987295f, 0.532009658f, -0.107597459f, 0.137485642f, 0.029888183f, 0.0418434562f, -0.382568743f, 0.693405846f,
+    -0.0537987295f, 0.0119552732f, -0.759159849f, -0.382568743f, -0.310837104f, -0.0119552732f, -0.346702923f, 0.328770013f,
+    -0.6694953f, -0.0418434562f, -0.573853114f, -0.0119552732f, 0.203239645f, -0.502121475f, -0.639607117f, 0.561897841f,
+    0.0478210929f, 0.70536112f, -0.693405846f, 0.00597763661f, -0.400501653f, -0.6694953f, -0.233127828f, 0.532009658f,
+    -0.328770013f, -0.759159849f, -0.597763661f, -0.185306735f, -0.185306735f, -0.113575096f, -0.149440915f, -0.209217281f,
+    -0.322792377f, -0.412456926f, -0.741226939f, -0.496143838f, 0.0836869125f, 0.191284371f, -0.0657540027f, -0.567875478f,
+    0.155418552f, -0.759159849f, -0.101619822f, 0.0358658196f, 0.37061347f, -0.0657540027f, 0.227150191f, -0.221172554f,
+    -0.0657540027f, -0.364635833f, 0.197262008f, -0.0119552732f, 0.567875478f, -0.155418552f, 0.0478210929f, 0.759159849f,
+    -0.143463279f, 0.460278019f, -0.615696571f, -0.00597763661f, -0.304859467f, -0.526032021f, 0.209217281f, 0.448322746f,
+    -0.251060737f, 0.0777092759f, 0.448322746f, -0.268993647f, 0.382568743f, -0.400501653f, 0.143463279f, 0.263016011f,
+    -0.65156239f, 0.227150191f, 0.0358658196f, 0.0478210929f, -0.759159849f, 0.286926557f, -0.537987295f, -0.496143838f,
+    0.609718934f, 0.0418434562f, -0.173351462f, -0.621674207f, 0.328770013f, 0.759159849f, 0.412456926f, 0.143463279f,
+    -0.532009658f, -0.549942568f, -0.0179329098f, -0.304859467f, -0.029888183f, 0.274971284f, -0.364635833f, -0.0119552732f,
+    -0.65156239f, 0.0119552732f, 0.191284371f, -0.173351462f, -0.621674207f, 0.263016011f, 0.0836869125f, -0.304859467f,
+    0.627651844f, 0.484188565f, 0.113575096f, 0.675472937f, 0.454300382f, -0.759159849f, -0.137485642f, -0.35268056f,
+    -0.639607117f, 0.520054385f, -0.418434562f, -0.143463279f, -0.394524016f, 0.0717316393f, -0.00597763661f, 0.00597763661f,
+    -0.603741297f, 0.490166202f, -0.388546379f, 0.681450573f, 0.0717316393f, 0.0657540027f, 0.0836869125f, -0.759159849f,
+};
+
+static const float ref_b1_pw_bias[] = {
+    5.06305821f, -1.04608641f, 20.5152488f, -13.4257718f, -8.77517054f, 7.77690523f, 10.2875126f, 0.926533674f,
+    -20.8260859f, 54.611688f, 25.1000961f, -8.0339436f, -38.6334654f, -3.56864905f, 26.8575213f, -31.3706369f,
+    44.7545653f, 45.2447315f, 49.8475117f, -14.0414684f, 34.9631965f, -0.436367472f, 1.04608641f, 32.7036499f,
+};
+
+static void ref_b1_pw(const float* input, float* output) {
+    for (int p = 0; p < 165; p++) {
+        for (int o = 0; o < 24; o++) {
+            float acc = ref_b1_pw_bias[o];
+            for (int i = 0; i < 16; i++) acc += input[p * 16 + i] * ref_b1_pw_weights[o * 16 + i];
+            output[p * 24 + o] = acc > 0.0f ? acc : 0.0f;
+        }
+    }
+}
+
+static const float ref_b2_dw_weights[] = {
+    0.164762894f, 0.211838006f, 0.747317411f, 0.394254067f, 0.576670128f, 0.458982347f, 0.541363794f, 0.476635514f,
+    -0.747317411f, -0.417791623f, -0.747317411f, 0.747317411f, -0.0235375562f, -0.535479405f, -0.241259952f, -0.0647282797f,
+    -0.0470751125f, -0.406022845f, 0.288335064f, -0.247144341f, 0.0117687781f, 0.606092073f, 0.523710627f, 0.56490135f,
+    -0.747317411f, 0.488404292f, -0.0529595016f, -0.588438906f, 0.506057459f, -0.0235375562f, 0.488404292f, 0.258913119f,
+    -0.18830045f, -0.370716511f, 0.0411907234f, 0.300103842f, -0.0411907234f, 0.158878505f, 0.729664244f, 0.264797508f,
+    0.747317411f, -0.712011076f, 0.382485289f, 0.44132918f, 0.223606784f, 0.217722395f, -0.747317411f, -0.200069228f,
+    0.323641398f, -0.235375562f, -0.235375562f, -0.747317411f, 0.335410177f, -0.523710627f, 0.453097958f, 0.0117687781f,
+    0.00588438906f, 0.200069228f, 0.541363794f, 0.0529595016f, 0.541363794f, 0.464866736f, 0.494288681f, -0.488404292f,
+    0.547248183f, -0.100034614f, 0.211838006f, -0.0117687781f, -0.411907234f, -0.129456559f, 0.105919003f, -0.176531672f,
+    -0.594323295f, 0.429560402f, -0.31187262f, 0.735548633f, 0.659051575f, 0.0764970578f, -0.241259952f, 0.747317411f,
+    0.317757009f, -0.276566286f, -0.406022845f, 0.164762894f, -0.482519903f, 0.482519903f, -0.176531672f, 0.270681897f,
+    -0.506057459f, -0.576670128f, 0.158878505f, 0.506057459f, 0.0411907234f, 0.100034614f, 0.129456559f, -0.100034614f,
+    -0.141225337f, 0.25302873f, -0.147109727f, 0.0529595016f, -0.353063344f, -0.12357217f, -0.0411907234f, -0.335410177f,
+    0.135340948f, -0.494288681f, -0.0176531672f, 0.129456559f, 0.56490135f, 0.529595016f, -0.317757009f, -0.588438906f,
+    -0.129456559f, -0.094150225f, -0.0235375562f, 0.747317411f, -0.152994116f, -0.270681897f, 0.141225337f, 0.323641398f,
+    0.294219453f, -0.129456559f, 0.105919003f, -0.176531672f, 0.235375562f, -0.747317411f, -0.323641398f, -0.506057459f,
+    0.211838006f, 0.182416061f, 0.200069228f, -0.164762894f, -0.0823814469f, -0.241259952f, -0.747317411f, 0.0823814469f,
+    0.111803392f, 0.217722395f, -0.158878505f, -0.453097958f, -0.50017307f, 0.747317411f, -0.0529595016f, -0.0176531672f,
+    0.105919003f, -0.335410177f, -0.435444791f, -0.235375562f, 0.453097958f, 0.423676012f, -0.712011076f, 0.411907234f,
+    -0.18830045f, -0.747317411f, 0.117687781f, -0.400138456f, -0.205953617f, 0.282450675f, 0.576670128f, 0.0117687781f,
+    -0.453097958f, -0.747317411f, -0.264797508f, 0.394254067f, 0.511941848f, -0.541363794f, 0.288335064f, 0.00588438906f,
+    -0.0294219453f, -0.747317411f, 0.664935964f, -0.576670128f, -0.747317411f, -0.506057459f, -0.747317411f, -0.0647282797f,
+    0.00588438906f, 0.176531672f, -0.0882658359f, -0.282450675f, 0.747317411f, -0.747317411f, -0.0176531672f, 0.141225337f,
+    -0.341294566f, 0.211838006f, -0.147109727f, -0.294219453f, -0.747317411f, 0.176531672f, -0.270681897f, -0.158878505f,
+    -0.0117687781f, 0.0235375562f, 0.00588438906f, 0.423676012f, 0.223606784f, -0.735548633f, -0.247144341f, -0.0470751125f,
+    -0.323641398f, 0.553132572f, -0.3766009f, 0.18830045f, -0.300103842f, -0.0294219453f, -0.676704742f, 0.747317411f,
+    -0.529595016f, 0.50017307f, -0.747317411f, -0.229491173f, -0.664935964f, -0.300103842f, -0.0235375562f, -0.747317411f,
+};
+
+static const float ref_b2_dw_bias[] = {
+    6.14918657f, -1.41813776f, -3.40706127f, 15.0346141f, -19.8539287f, 30.8283143f, 3.25406715f, -9.66216684f,
+    7.48494289f, 20.1128418f, 7.27310488f, -16.2350294f, -13.4105227f, -6.59051575f, -4.41917619f, -4.05434406f,
+    5.20768432f, 18.5534787f, 3.35998615f, -10.6919349f, 23.9788854f, -2.72447214f, 0.12357217f, 1.00623053f,
+};
+
+static void ref_b2_dw(const float* input, float* output) {
+    for (int y = 0; y < 33; y++) {
+        for (int x = 0; x < 5; x++) {
+            for (int o = 0; o < 24; o++) {
+                float acc = ref_b2_dw_bias[o];
+                for (int ky = 0; ky < 3; ky++) {
+                    const int iy = y * 1 - 1 + ky;
+                    if (iy < 0 || iy >= 33) continue;
+                    for (int kx = 0; kx < 3; kx++) {
+                        const int ix = x * 1 - 1 + kx;
+                        if (ix < 0 || ix >= 5) continue;
+                        acc += input[(iy * 5 + ix) * 24 + o] * ref_b2_dw_weights[(ky * 3 + kx) * 24 + o];
+                    }
+                }
+                output[(y * 5 + x) * 24 + o] = acc > 0.0f ? acc : 0.0f;
+            }
+        }
+    }
+}
+
+static const float ref_b2_pw_weights[] = {
+    0.922334975f, 0.0512408319f, 0.57218929f, 0.70029137f, 0.0597809706f, -0.350145685f, -0.230583744f, 0.845473727f,
+    -0.290364714f, 0.247664021f, 0.247664021f, 0.657590676f, 0.0768612479f, -0.538028735f, -0.657590676f, 0.222043605f,
+    -0.409926655f, 0.768612479f, -0.102481664f, -0.555109012f, -1.08459761f, 0.0f, 0.0768612479f, -0.930875113f,
+    -0.57218929f, 0.298904853f, 0.751532201f, 0.12810208f, 0.12810208f, 0.102481664f, 0.264744298f, -0.546568874f,
+    0.392846378f, -0.367225962f, 0.31598513f, 0.478247765f, -0.597809706f, 0.204963328f, -0.683211092f, -1.08459761f,
+    0.384306239f, 0.222043605f, -0.384306239f, -0.264744298f, 0.845473727f, 0.264744298f, -0.495328042f, 0.452627349f,
+    0.503868181f, 0.102481664f, -0.392846378f, -0.478247765f, -0.666130815f, 0.503868181f, 0.290364714f, 0.640510399f,
+    -0.281824576f, 0.597809706f, -0.580729428f, -0.495328042f, -0.44408721f, -0.367225962f, -0.239123882f, -0.25620416f,
+    0.0597809706f, 0.204963328f, -0.324525269f, -0.145182357f, -1.08459761f, 0.520948458f, -0.298904853f, 0.204963328f,
+    -0.401386517f, -0.333065407f, 0.222043605f, 0.222043605f, 0.708831508f, 0.213503466f, -0.563649151f, 0.298904853f,
+    0.102481664f, -0.0597809706f, 1.08459761f, 0.358685823f, -0.0512408319f, -0.63197026f, -0.179342912f, 0.230583744f,
+    0.606349844f, -0.965035668f, 0.563649151f, 0.273284437f, -0.136642218f, 0.469707626f, 0.862554004f, 0.170802773f,
+    0.324525269f, 0.298904853f, 0.18788305f, -0.264744298f, -0.230583744f, 0.0597809706f, -0.742992063f, -0.213503466f,
+    0.18788305f, 1.08459761f, 0.273284437f, -0.0683211092f, 0.290364714f, 0.777152617f, -0.0683211092f, -0.0768612479f,
+    -0.222043605f, -0.0597809706f, -0.862554004f, 0.0512408319f, 0.905254697f, 0.367225962f, 0.230583744f, -0.0170802773f,
+    -0.281824576f, 0.290364714f, -0.0597809706f, -0.204963328f, 0.170802773f, 0.136642218f, -1.08459761f, 0.204963328f,
+    0.281824576f, -0.102481664f, 0.401386517f, 0.247664021f, 0.196423189f, 0.375766101f, 0.486787903f, -0.0683211092f,
+    0.538028735f, -0.230583744f, 0.0597809706f, 0.367225962f, -0.0341605546f, 0.0597809706f, -0.290364714f, 0.162262634f,
+    -0.119561941f, -1.08459761f, -0.12810208f, -0.435547071f, -0.777152617f, -0.0170802773f, -0.290364714f, 0.546568874f,
+    0.281824576f, 0.452627349f, -0.136642218f, -0.222043605f, -0.298904853f, 0.478247765f, -0.512408319f, -0.802773033f,
+    -0.785692756f, -0.0683211092f, 0.273284437f, -0.119561941f, -0.0427006933f, -0.111021802f, 0.102481664f, -0.435547071f,
+    -1.08459761f, 0.418466794f, -0.657590676f, 0.401386517f, -0.119561941f, -0.589269567f, -0.649050538f, -0.520948458f,
+    0.0854013865f, -0.520948458f, -0.333065407f, 0.102481664f, 0.520948458f, -0.25620416f, 0.503868181f, 0.341605546f,
+    -0.785692756f, -0.281824576f, 0.427006933f, 0.785692756f, -0.025620416f, 0.31598513f, -0.145182357f, 0.76007234f,
+    0.802773033f, -0.0170802773f, 0.520948458f, -0.204963328f, -0.111021802f, 0.18788305f, 1.08459761f, -0.44408721f,
+    0.025620416f, 0.281824576f, 0.768612479f, 0.12810208f, 0.614889983f, 0.25620416f, -0.640510399f, -0.708831508f,
+    -0.742992063f, -0.794232895f, -0.162262634f, 0.418466794f, 0.281824576f, -0.00854013865f, 0.563649151f, -0.879634281f,
+    -0.358685823f, 0.409926655f, 0.31598513f, -0.640510399f, -0.162262634f, 0.196423189f, 0.717371647f, -0.0768612479f,
+    0.555109012f, -0.70029137f, -0.427006933f, -0.119561941f, -0.392846378f, 0.179342912f, 0.358685823f, 0.290364714f,
+    -0.102481664f, -1.08459761f, 0.819853311f, 0.0597809706f, 0.170802773f, -0.00854013865f, 0.538028735f, 0.401386517f,
+    0.290364714f, -0.794232895f, 0.12810208f, 0.392846378f, 0.18788305f, -0.555109012f, -0.461167487f, 0.0854013865f,
+    0.367225962f, 0.119561941f, 0.358685823f, -0.63197026f, -0.0512408319f, -0.768612479f, -0.358685823f, 0.503868181f,
+    -0.836933588f, 0.145182357f, -1.08459761f, 0.0854013865f, 0.486787903f, 0.683211092f, 0.025620416f, -0.0597809706f,
+    0.247664021f, 0.00854013865f, 0.162262634f, 0.25620416f, -0.623430122f, 0.469707626f, 0.12810208f, -0.0427006933f,
+    -0.102481664f, -0.179342912f, 0.375766101f, 0.0597809706f, -0.18788305f, 0.401386517f, 0.18788305f, -0.520948458f,
+    -0.12810208f, 0.836933588f, 0.350145685f, 0.725911786f, -0.623430122f, -0.0170802773f, 0.563649151f, 1.08459761f,
+    -0.179342912f, -0.982115945f, -0.836933588f, -0.461167487f, 0.57218929f, 0.538028735f, -0.162262634f, -0.213503466f,
+    0.896714559f, -0.230583744f, -0.264744298f, -0.418466794f, 0.367225962f, 0.597809706f, 0.990656084f, -1.05897719f,
+    -0.341605546f, -0.469707626f, 0.264744298f, 0.179342912f, 0.478247765f, -0.717371647f, -1.08459761f, -0.358685823f,
+    0.213503466f, 1.08459761f, -1.07605747f, -0.0597809706f, -0.145182357f, -0.375766101f, -0.768612479f, 0.563649151f,
+    0.12810208f, 0.025620416f, 0.44408721f, -0.264744298f, -0.204963328f, -0.546568874f, 0.384306239f, -0.674670954f,
+    -0.452627349f, 0.239123882f, -0.222043605f, 0.70029137f, -0.00854013865f, -0.580729428f, 0.529488596f, 0.478247765f,
+    -0.119561941f, -0.495328042f, -0.469707626f, -0.401386517f, -0.119561941f, 0.401386517f, 0.63197026f, -0.717371647f,
+    0.409926655f, -0.538028735f, -1.08459761f, -0.495328042f, -0.683211092f, 0.734451924f, -0.768612479f, 0.111021802f,
+    -0.555109012f, -0.725911786f, -0.350145685f, -0.111021802f, 0.0854013865f, -0.751532201f, -0.0768612479f, -0.401386517f,
+    -0.538028735f, -1.08459761f, -0.947955391f, 0.614889983f, 0.930875113f, 0.469707626f, 0.469707626f, -0.956495529f,
+    -0.0683211092f, -0.512408319f, -0.725911786f, -0.0170802773f, 0.854013865f, -0.871094143f, 0.623430122f, 0.734451924f,
+    0.666130815f, -0.418466794f, -0.546568874f, 0.589269567f, 0.247664021f, -0.63197026f, 0.401386517f, 0.401386517f,
+    0.111021802f, -0.520948458f, -0.00854013865f, -0.478247765f, -0.606349844f, -0.503868181f, -0.57218929f, -0.153722496f,
+    -0.683211092f, -0.0170802773f, 0.495328042f, 0.307444992f, 0.0512408319f, -0.025620416f, -0.0768612479f, 1.08459761f,
+    -0.691751231f, -0.273284437f, 0.213503466f, 0.239123882f, -0.375766101f, -0.691751231f, 0.350145685f, 0.435547071f,
+    -0.725911786f, 0.57218929f, 0.461167487f, -0.63197026f, -0.452627349f, 0.546568874f, -0.555109012f, -0.025620416f,
+    -0.734451924f, -0.691751231f, 1.08459761f, 0.478247765f, -0.973575806f, -0.0768612479f, -0.375766101f, 0.358685823f,
+    -0.0427006933f, -0.427006933f, -0.00854013865f, -0.922334975f, 0.768612479f, 0.57218929f, 0.708831508f, 0.435547071f,
+    -0.350145685f, -0.401386517f, -0.31598513f, -1.07605747f, -0.879634281f, -0.683211092f, 0.0341605546f, -1.08459761f,
+    -0.153722496f, -0.555109012f, -0.213503466f, -0.273284437f, 0.298904853f, 0.170802773f, -0.350145685f, -0.452627349f,
+    -0.503868181f, -0.589269567f, -0.247664021f, -0.589269567f, -0.469707626f, -0.768612479f, -0.999196222f, -0.196423189f,
+    0.273284437f, 0.333065407f, -1.08459761f, -0.0768612479f, 0.136642218f, -0.57218929f, 0.0170802773f, -0.153722496f,
+    -0.290364714f, 0.0854013865f, 0.495328042f, -0.503868181f, 0.0854013865f, 0.179342912f, 0.273284437f, 0.0683211092f,
+    -0.230583744f, -0.196423189f, 0.333065407f, 0.0427006933f, -0.179342912f, -0.409926655f, 0.350145685f, 0.145182357f,
+    0.18788305f, -0.12810208f, -0.00854013865f, 0.281824576f, 0.427006933f, -0.57218929f, -0.409926655f, 0.350145685f,
+    -0.691751231f, 1.08459761f, 0.324525269f, -0.0854013865f, 0.666130815f, 0.222043605f, 0.0f, -0.179342912f,
+    0.44408721f, 0.905254697f, 0.674670954f, 0.63197026f, 0.384306239f, 0.0427006933f, 0.102481664f, 0.0683211092f,
+    0.298904853f, 0.478247765f, -0.264744298f, 0.230583744f, 1.08459761f, 0.409926655f, 0.230583744f, 0.196423189f,
+    0.367225962f, 0.785692756f, 0.614889983f, 0.273284437f, 0.691751231f, -0.503868181f, -0.204963328f, -0.614889983f,
+    0.298904853f, -0.230583744f, -0.828393449f, 0.57218929f, 0.947955391f, -0.529488596f, 0.025620416f, -0.264744298f,
+    0.18788305f, -0.520948458f, -0.18788305f, -0.461167487f, -0.273284437f, -0.153722496f, -0.281824576f, -0.0597809706f,
+    0.819853311f, 0.649050538f, 0.25620416f, -0.777152617f, -0.452627349f, -0.819853311f, 0.649050538f, -0.273284437f,
+    -0.691751231f, -0.196423189f, -0.538028735f, 0.341605546f, 0.239123882f, -1.08459761f, 0.25620416f, 0.0f,
+    -0.88817442f, -0.76007234f, 0.691751231f, -0.478247765f, -0.358685823f, 0.734451924f, 0.162262634f, 0.111021802f,
+    0.418466794f, 0.76007234f, -0.597809706f, 0.751532201f, 0.18788305f, 0.18788305f, -1.08459761f, -0.435547071f,
+    -0.802773033f, 0.264744298f, -0.204963328f, -0.63197026f, -0.580729428f, 0.204963328f, 0.273284437f, -0.657590676f,
+    -0.0597809706f, -0.0854013865f, -0.0170802773f, 0.239123882f, 0.520948458f, -0.44408721f, -0.0170802773f, 0.204963328f,
+    -0.854013865f, -0.657590676f, 0.896714559f, 0.00854013865f, 0.341605546f, 0.196423189f, -0.409926655f, 0.333065407f,
+    -0.580729428f, -0.965035668f, -0.495328042f, -0.31598513f, 1.08459761f, 0.025620416f, 0.0597809706f, 0.811313172f,
+    -0.18788305f, -0.657590676f, 0.478247765f, -0.239123882f, 0.538028735f, -0.375766101f, 0.725911786f, -0.836933588f,
+    0.230583744f, -0.025620416f, -0.333065407f, 0.452627349f, 0.478247765f, -0.0683211092f, 0.31598513f, 1.08459761f,
+    -0.930875113f, -0.213503466f, -0.264744298f, 0.503868181f, 0.0341605546f, -0.170802773f, 0.708831508f, 0.461167487f,
+    -0.18788305f, -0.666130815f, 0.520948458f, -0.683211092f, -0.879634281f, -0.427006933f, 0.222043605f, 0.204963328f,
+    -0.196423189f, 0.384306239f, 0.204963328f, 0.614889983f, -1.08459761f, -0.70029137f, -0.264744298f, -0.905254697f,
+    -0.478247765f, -0.44408721f, 0.478247765f, -0.384306239f, -0.589269567f, -0.264744298f, 0.777152617f, -0.785692756f,
+    0.12810208f, 0.18788305f, 0.025620416f, 0.324525269f, -0.324525269f, -0.196423189f, 1.08459761f, 0.230583744f,
+    -0.503868181f, -0.298904853f, 0.281824576f, -0.0170802773f, 0.0683211092f, 0.0597809706f, 0.0768612479f, 0.0854013865f,
+    0.589269567f, -0.222043605f, 0.384306239f, -0.828393449f, -0.674670954f, -0.597809706f, 0.12810208f, -0.623430122f,
+    0.145182357f, -0.529488596f, 0.12810208f, -0.170802773f, -0.555109012f, 0.836933588f, 0.179342912f, 0.683211092f,
+    -0.546568874f, 0.0768612479f, 0.136642218f, -0.179342912f, -0.836933588f, 0.538028735f, -1.08459761f, 0.0512408319f,
+    0.717371647f, 0.153722496f, -0.725911786f, 0.162262634f, 0.0427006933f, 0.170802773f, 0.358685823f, 0.0768612479f,
+    0.589269567f, 0.57218929f, -0.179342912f, -1.08459761f, -0.18788305f, -0.717371647f, -0.0427006933f, -0.264744298f,
+    -0.0597809706f, -0.640510399f, -0.0683211092f, 0.520948458f, 0.247664021f, 0.614889983f, 0.0854013865f, -0.0170802773f,
+    -0.136642218f, -0.153722496f, 0.273284437f, -0.273284437f, -0.375766101f, -0.76007234f, -0.802773033f, -0.0939415252f,
+    -0.196423189f, -0.179342912f, -1.06751733f, -0.333065407f, 0.546568874f, -0.546568874f, 0.529488596f, 0.0939415252f,
+    0.298904853f, -0.606349844f, 0.529488596f, 0.264744298f, 0.0939415252f, -0.0768612479f, 0.025620416f, 0.213503466f,
+    0.495328042f, 0.0939415252f, 0.879634281f, -0.486787903f, 0.273284437f, -0.392846378f, -1.04189692f, -1.08459761f,
+    -0.00854013865f, -1.08459761f, -0.239123882f, 0.461167487f, -0.845473727f, -0.350145685f, -0.725911786f, -0.384306239f,
+    0.102481664f, -0.12810208f, -0.0768612479f, 0.409926655f, 0.0170802773f, -0.247664021f, -0.836933588f, -1.03335678f,
+    -0.819853311f, -0.204963328f, 0.990656084f, 0.247664021f, 0.392846378f, 0.0427006933f, -0.469707626f, 0.213503466f,
+};
+
+static const float ref_b2_pw_bias[] = {
+    -21.9566965f, -1.27248066f, 27.7127499f, -48.0809806f, -1.56284537f, -21.1112228f, 36.1077062f, 3.56123782f,
+    -21.3588868f, -3.38189491f, 20.7269165f, -37.3033256f, 25.5862554f, 0.162262634f, 73.3256305f, -5.77313373f,
+    23.7074249f, -1.02481664f, 151.476439f, 32.3585854f, -66.8180448f, -55.3315583f, 41.6929569f, 61.2413343f,
+    -3.32211394f, -20.6415151f, 82.3952577f, 3.86868281f, 0.401386517f, 53.6918517f, 36.4920125f, 40.343615f,
+};
+
+static void ref_b2_pw(const float* input, float* output) {
+    for (int p = 0; p < 165; p++) {
+        for (int o = 0; o < 32; o++) {
+            float acc = ref_b2_pw_bias[o];
+            for (int i = 0; i < 24; i++) acc += input[p * 24 + i] * ref_b2_pw_weights[o * 24 + i];
+            output[p * 32 + o] = acc > 0.0f ? acc : 0.0f;
+        }
+    }
+}
+
+static const float ref_b3_dw_weights[] = {
+    0.670450173f, -0.692253431f, 0.0817622163f, -0.103565474f, 0.0490573298f, -0.332499679f, -0.485122483f, 0.141721175f,
+    0.65409773f, 0.343401308f, -0.561433885f, 0.125368732f, -0.692253431f, -0.692253431f, -0.261639092f, 0.0872130307f,
+    0.0545081442f, 0.692253431f, 0.692253431f, 0.626843658f, -0.141721175f, -0.310696422f, -0.692253431f, 0.00545081442f,
+    -0.125368732f, 0.0272540721f, 0.114467103f, 0.65409773f, 0.51782737f, 0.109016288f, 0.0f, -0.00545081442f,
+    0.692253431f, 0.109016288f, 0.223483391f, -0.13627036f, -0.13627036f, -0.692253431f, -0.692253431f, -0.403360267f,
+    -0.0381557009f, 0.692253431f, -0.572335514f, -0.158073618f, 0.130819546f, 0.109016288f, 0.250737463f, 0.250737463f,
+    -0.0327048865f, -0.179876876f, 0.512376555f, -0.299794793f, -0.261639092f, -0.327048865f, 0.239835834f, -0.452417597f,
+    0.218032577f, 0.18532769f, 0.109016288f, 0.359753752f, -0.228934206f, 0.321598051f, -0.327048865f, 0.125368732f,
+    0.245286649f, 0.152622804f, 0.310696422f, -0.692253431f, -0.561433885f, -0.218032577f, -0.528728998f, 0.28344235f,
+    0.692253431f, 0.392458638f, -0.692253431f, -0.436065153f, 0.163524433f, -0.239835834f, 0.37065538f, -0.599589586f,
+    -0.6050404f, 0.566884699f, 0.664999359f, -0.277991535f, -0.163524433f, -0.13627036f, 0.41971271f, -0.539630627f,
+    0.555983071f, 0.207130948f, 0.354302937f, 0.659548544f, 0.539630627f, 0.288893164f, -0.190778505f, 0.223483391f,
+    -0.0218032577f, -0.37065538f, 0.0872130307f, -0.354302937f, 0.392458638f, 0.0327048865f, -0.299794793f, -0.0436065153f,
+    0.506925741f, 0.239835834f, -0.436065153f, -0.288893164f, -0.550532256f, -0.452417597f, -0.626843658f, 0.130819546f,
+    0.0545081442f, 0.561433885f, -0.615942029f, 0.228934206f, -0.0981146595f, -0.496024112f, -0.539630627f, -0.119917917f,
+    -0.692253431f, -0.692253431f, -0.103565474f, 0.376106195f, 0.0163524433f, -0.245286649f, -0.288893164f, -0.692253431f,
+    0.46877004f, -0.239835834f, -0.00545081442f, -0.321598051f, -0.0272540721f, 0.109016288f, -0.23438502f, -0.414261896f,
+    -0.168975247f, 0.403360267f, -0.583237143f, 0.125368732f, 0.0817622163f, -0.228934206f, -0.103565474f, 0.0272540721f,
+    -0.0218032577f, -0.0327048865f, -0.250737463f, -0.0545081442f, -0.0763114018f, 0.267089906f, 0.0327048865f, -0.0708605874f,
+    0.37065538f, 0.174426061f, -0.147171989f, 0.245286649f, -0.599589586f, -0.0545081442f, -0.294343979f, -0.692253431f,
+    -0.228934206f, 0.277991535f, 0.228934206f, -0.41971271f, -0.327048865f, -0.130819546f, -0.250737463f, 0.272540721f,
+    0.572335514f, 0.245286649f, -0.643196101f, -0.555983071f, 0.310696422f, -0.0545081442f, -0.179876876f, -0.218032577f,
+    -0.692253431f, 0.376106195f, -0.250737463f, -0.692253431f, -0.512376555f, 0.0272540721f, 0.539630627f, -0.316147236f,
+    0.403360267f, 0.0109016288f, 0.245286649f, 0.474220854f, 0.523278184f, 0.00545081442f, -0.348852123f, 0.065409773f,
+    0.332499679f, -0.245286649f, 0.528728998f, -0.103565474f, 0.125368732f, 0.00545081442f, -0.430614339f, 0.337950494f,
+    0.692253431f, 0.403360267f, -0.528728998f, 0.305245607f, -0.41971271f, -0.207130948f, -0.692253431f, -0.13627036f,
+    -0.00545081442f, 0.545081442f, -0.550532256f, 0.643196101f, 0.692253431f, 0.065409773f, -0.359753752f, -0.408811081f,
+    0.158073618f, -0.28344235f, -0.51782737f, 0.692253431f, 0.692253431f, -0.692253431f, -0.692253431f, -0.490573298f,
+    -0.147171989f, -0.245286649f, 0.566884699f, -0.130819546f, -0.190778505f, -0.463319225f, -0.474220854f, -0.692253431f,
+    0.065409773f, 0.6050404f, -0.512376555f, 0.147171989f, 0.119917917f, -0.490573298f, 0.0327048865f, 0.245286649f,
+    -0.0163524433f, -0.327048865f, -0.196229319f, 0.288893164f, 0.561433885f, 0.692253431f, 0.201680133f, -0.692253431f,
+    0.506925741f, 0.387007824f, -0.692253431f, 0.496024112f, -0.479671669f, 0.0545081442f, -0.6050404f, 0.261639092f,
+    -0.621392844f, 0.179876876f, 0.692253431f, 0.168975247f, -0.692253431f, 0.109016288f, -0.299794793f, -0.00545081442f,
+    0.686802617f, 0.332499679f, -0.648646916f, -0.692253431f, 0.163524433f, -0.337950494f, -0.316147236f, -0.692253431f,
+    -0.528728998f, 0.28344235f, -0.0981146595f, -0.343401308f, -0.201680133f, 0.46877004f, 0.37065538f, -0.354302937f,
+    0.0163524433f, 0.00545081442f, 0.147171989f, 0.555983071f, 0.343401308f, 0.207130948f, -0.239835834f, 0.6050404f,
+};
+
+static const float ref_b3_dw_bias[] = {
+    -17.8350648f, 13.2018725f, -19.5575221f, 28.5568167f, 15.4857638f, 19.1814159f, 42.1020906f, -8.44331153f,
+    -25.727844f, -43.088688f, 97.307939f, 9.27728614f, 1.79331794f, 22.7953059f, 16.5595742f, -1.86962934f,
+    -1.47717071f, -28.8947672f, 0.632294472f, -4.7640118f, 0.88848275f, -8.78671284f, -11.5611774f, 59.6264589f,
+    -22.7080929f, -9.05925356f, 5.20007695f, -33.484353f, -29.3253816f, -1.54258048f, 49.6841734f, 4.10446326f,
+};
+
+static void ref_b3_dw(const float* input, float* output) {
+    for (int y = 0; y < 33; y++) {
+        for (int x = 0; x < 5; x++) {
+            for (int o = 0; o < 32; o++) {
+                float acc = ref_b3_dw_bias[o];
+                for (int ky = 0; ky < 3; ky++) {
+                    const int iy = y * 1 - 1 + ky;
+                    if (iy < 0 || iy >= 33) continue;
+                    for (int kx = 0; kx < 3; kx++) {
+                        const int ix = x * 1 - 1 + kx;
+                        if (ix < 0 || ix >= 5) continue;
+                        acc += input[(iy * 5 + ix) * 32 + o] * ref_b3_dw_weights[(ky * 3 + kx) * 32 + o];
+                    }
+                }
+                output[(y * 5 + x) * 32 + o] = acc > 0.0f ? acc : 0.0f;
+            }
+        }
+    }
+}
+
+static const float ref_b3_pw_weights[] = {
+    0.765366044f, 0.392666058f, 0.525773196f, -0.212971421f, -0.758710688f, 0.326112489f, -0.512462482f, 0.625603549f,
+    -0.0133107138f, 0.459219627f, -0.811953543f, -0.419287485f, -0.259558919f, -0.312801775f, 0.519117839f, 0.412632128f,
+    0.0931749967f, 0.199660707f, 0.0865196398f, -0.359389273f, -0.386010701f, -0.672191048f, 0.252903563f, -0.17303928f,
+    0.073208926f, -0.712123189f, 0.372699987f, -0.379355344f, -0.212971421f, -0.126451781f, 0.845230327f, -0.199660707f,
+    0.459219627f, 0.658880334f, 0.552394623f, -0.166383923f, 0.55904998f, 0.386010701f, -0.831919614f, -0.0798642829f,
+    -0.386010701f, 0.0598982122f, -0.579016051f, -0.0532428553f, 0.166383923f, 0.572360694f, -0.0665535691f, 0.405976771f,
+    -0.212971421f, 0.45256427f, 0.479185697f, -0.332767845f, -0.585671408f, -0.206316064f, 0.845230327f, 0.179694637f,
+    0.678846405f, -0.232937492f, 0.545739267f, -0.199660707f, -0.439253556f, 0.485841054f, 0.785332115f, -0.405976771f,
+    0.485841054f, 0.252903563f, 0.55904998f, -0.472530341f, 0.139762495f, -0.0399321415f, -0.405976771f, -0.638914263f,
+    -0.579016051f, 0.359389273f, -0.805298186f, -0.0931749967f, -0.485841054f, -0.106485711f, 0.352733916f, -0.479185697f,
+    0.618948192f, 0.272869633f, 0.0f, 0.186349993f, -0.705467832f, -0.459219627f, 0.845230327f, 0.332767845f,
+    0.352733916f, -0.153073209f, 0.299491061f, -0.113141067f, 0.0266214276f, 0.705467832f, 0.678846405f, 0.0332767845f,
+    0.53908391f, 0.585671408f, 0.692157118f, -0.485841054f, -0.55904998f, -0.492496411f, -0.665535691f, -0.139762495f,
+    -0.179694637f, 0.226282135f, -0.845230327f, -0.332767845f, -0.36604463f, 0.552394623f, -0.306146418f, -0.525773196f,
+    -0.598982122f, 0.459219627f, 0.0998303536f, 0.073208926f, 0.206316064f, -0.119796424f, 0.831919614f, 0.565705337f,
+    0.672191048f, -0.226282135f, 0.319457132f, -0.346078559f, -0.692157118f, 0.332767845f, 0.665535691f, -0.299491061f,
+    0.472530341f, 0.845230327f, 0.545739267f, -0.346078559f, -0.0332767845f, -0.0399321415f, -0.552394623f, 0.0865196398f,
+    -0.139762495f, -0.0665535691f, -0.678846405f, 0.139762495f, -0.219626778f, 0.55904998f, -0.113141067f, -0.139762495f,
+    0.0532428553f, 0.386010701f, 0.0665535691f, -0.459219627f, -0.412632128f, -0.492496411f, 0.552394623f, 0.492496411f,
+    -0.166383923f, 0.326112489f, 0.525773196f, -0.212971421f, -0.199660707f, 0.565705337f, 0.565705337f, -0.45256427f,
+    0.585671408f, 0.266214276f, 0.525773196f, -0.572360694f, 0.678846405f, -0.585671408f, 0.0998303536f, -0.27952499f,
+    -0.379355344f, 0.379355344f, -0.845230327f, -0.17303928f, 0.146417852f, 0.545739267f, 0.598982122f, -0.126451781f,
+    0.139762495f, 0.166383923f, 0.405976771f, 0.598982122f, -0.64556962f, 0.106485711f, 0.465874984f, 0.0332767845f,
+    0.399321415f, 0.0266214276f, 0.618948192f, -0.252903563f, 0.0199660707f, 0.232937492f, 0.126451781f, -0.286180347f,
+    0.0332767845f, -0.286180347f, -0.232937492f, -0.0266214276f, -0.465874984f, -0.439253556f, 0.392666058f, -0.199660707f,
+    0.259558919f, -0.439253556f, 0.845230327f, 0.106485711f, 0.199660707f, -0.0532428553f, 0.0133107138f, -0.146417852f,
+    0.073208926f, -0.166383923f, -0.339423202f, -0.252903563f, -0.0998303536f, 0.119796424f, -0.259558919f, -0.579016051f,
+    -0.319457132f, 0.326112489f, -0.379355344f, 0.632258906f, -0.492496411f, 0.0f, -0.0399321415f, 0.17303928f,
+    0.445908913f, 0.326112489f, 0.512462482f, -0.638914263f, 0.465874984f, -0.292835704f, -0.685501762f, -0.206316064f,
+    -0.159728566f, 0.00665535691f, -0.678846405f, 0.319457132f, -0.772021401f, 0.0931749967f, -0.153073209f, 0.432598199f,
+    -0.352733916f, 0.259558919f, 0.845230327f, -0.419287485f, -0.545739267f, -0.199660707f, -0.0931749967f, 0.439253556f,
+    -0.19300535f, 0.319457132f, 0.179694637f, -0.146417852f, -0.372699987f, 0.499151768f, 0.379355344f, -0.339423202f,
+    0.0f, -0.226282135f, -0.153073209f, 0.19300535f, -0.226282135f, 0.0931749967f, 0.306146418f, -0.073208926f,
+    0.226282135f, -0.592326765f, 0.845230327f, 0.592326765f, -0.139762495f, -0.27952499f, -0.0865196398f, -0.439253556f,
+    -0.0865196398f, -0.0998303536f, -0.219626778f, 0.0199660707f, -0.27952499f, 0.0266214276f, -0.126451781f, -0.412632128f,
+    -0.0133107138f, 0.146417852f, -0.332767845f, 0.552394623f, -0.246248206f, 0.146417852f, -0.0133107138f, 0.232937492f,
+    -0.0266214276f, -0.239592849f, -0.186349993f, 0.339423202f, -0.45256427f, -0.17303928f, 0.306146418f, -0.126451781f,
+    0.206316064f, -0.492496411f, 0.845230327f, -0.146417852f, 0.226282135f, -0.206316064f, 0.0199660707f, -0.319457132f,
+    0.27952499f, -0.0598982122f, -0.286180347f, -0.0798642829f, -0.073208926f, 0.166383923f, -0.219626778f, -0.485841054f,
+    -0.00665535691f, -0.0865196398f, -0.27952499f, 0.572360694f, -0.299491061f, -0.0399321415f, -0.0199660707f, 0.159728566f,
+    -0.0133107138f, -0.212971421f, -0.212971421f, 0.139762495f, -0.246248206f, -0.505807125f, 0.339423202f, 0.0465874984f,
+    0.199660707f, -0.53908391f, 0.845230327f, -0.146417852f, 0.133107138f, -0.259558919f, -0.392666058f, 0.17303928f,
+    -0.133107138f, -0.126451781f, -0.166383923f, 0.00665535691f, -0.259558919f, 0.126451781f, -0.19300535f, -0.525773196f,
+    -0.133107138f, -0.432598199f, -0.139762495f, 0.64556962f, -0.306146418f, 0.159728566f, 0.0332767845f, 0.139762495f,
+    0.0399321415f, -0.419287485f, -0.179694637f, 0.19300535f, -0.579016051f, 0.346078559f, 0.292835704f, 0.266214276f,
+    0.212971421f, -0.505807125f, 0.845230327f, -0.579016051f, -0.19300535f, -0.206316064f, 0.0931749967f, 0.565705337f,
+    0.359389273f, -0.0798642829f, -0.319457132f, 0.00665535691f, -0.0532428553f, 0.0332767845f, -0.153073209f, -0.399321415f,
+    -0.0399321415f, -0.798642829f, -0.259558919f, 0.652224977f, -0.126451781f, 0.306146418f, 0.00665535691f, 0.166383923f,
+    0.206316064f, -0.399321415f, 0.0133107138f, 0.292835704f, -0.386010701f, 0.139762495f, 0.405976771f, 0.113141067f,
+    0.0532428553f, -0.399321415f, 0.692157118f, -0.259558919f, -0.153073209f, -0.492496411f, -0.372699987f, -0.166383923f,
+    0.36604463f, -0.133107138f, -0.0465874984f, 0.0332767845f, 0.0266214276f, -0.00665535691f, -0.199660707f, -0.485841054f,
+    -0.292835704f, 0.36604463f, -0.226282135f, 0.845230327f, -0.392666058f, 0.0798642829f, -0.166383923f, 0.0665535691f,
+    -0.0598982122f, -0.0931749967f, -0.0931749967f, 0.00665535691f, -0.312801775f, -0.232937492f, 0.439253556f, -0.119796424f,
+    0.146417852f, -0.479185697f, 0.845230327f, 0.146417852f, 0.339423202f, -0.199660707f, -0.405976771f, -0.0133107138f,
+    -0.306146418f, -0.126451781f, -0.166383923f, 0.106485711f, -0.17303928f, 0.17303928f, -0.19300535f, -0.432598199f,
+    -0.0998303536f, -0.0665535691f, -0.272869633f, 0.372699987f, -0.252903563f, -0.0865196398f, -0.0598982122f, 0.306146418f,
+    0.672191048f, 0.592326765f, 0.36604463f, -0.332767845f, -0.186349993f, -0.505807125f, 0.126451781f, 0.0f,
+    -0.212971421f, 0.0665535691f, -0.825264257f, 0.552394623f, -0.299491061f, 0.439253556f, 0.419287485f, 0.811953543f,
+    -0.153073209f, 0.519117839f, 0.399321415f, 0.392666058f, 0.0665535691f, 0.186349993f, 0.845230327f, 0.392666058f,
+    0.326112489f, 0.166383923f, 0.698812475f, -0.352733916f, -0.206316064f, 0.113141067f, -0.0865196398f, 0.0931749967f,
+    0.332767845f, 0.286180347f, 0.745399974f, -0.519117839f, -0.179694637f, -0.312801775f, -0.532428553f, -0.00665535691f,
+    -0.625603549f, 0.00665535691f, -0.845230327f, -0.246248206f, 0.27952499f, -0.0865196398f, 0.405976771f, 0.186349993f,
+    -0.186349993f, 0.432598199f, -0.0399321415f, 0.146417852f, -0.379355344f, 0.259558919f, 0.685501762f, 0.445908913f,
+    0.36604463f, -0.0865196398f, 0.00665535691f, -0.119796424f, -0.0598982122f, -0.073208926f, 0.379355344f, -0.0798642829f,
+    0.598982122f, 0.598982122f, 0.785332115f, -0.0332767845f, 0.532428553f, -0.565705337f, -0.772021401f, 0.0665535691f,
+    -0.359389273f, 0.0399321415f, -0.778676758f, -0.186349993f, 0.405976771f, 0.758710688f, 0.0665535691f, 0.0465874984f,
+    -0.0332767845f, 0.379355344f, 0.64556962f, -0.0998303536f, -0.845230327f, 0.0332767845f, 0.678846405f, 0.352733916f,
+    -0.0598982122f, 0.106485711f, -0.485841054f, -0.27952499f, 0.0266214276f, -0.139762495f, 0.83857497f, -0.55904998f,
+    -0.0399321415f, -0.299491061f, -0.226282135f, -0.106485711f, -0.339423202f, -0.332767845f, 0.326112489f, -0.339423202f,
+    0.272869633f, -0.552394623f, 0.845230327f, 0.139762495f, 0.212971421f, -0.0665535691f, -0.199660707f, -0.166383923f,
+    0.0931749967f, -0.159728566f, -0.27952499f, 0.133107138f, -0.286180347f, 0.0332767845f, -0.226282135f, -0.512462482f,
+    -0.0931749967f, -0.319457132f, -0.246248206f, 0.605637479f, -0.319457132f, 0.352733916f, 0.00665535691f, 0.153073209f,
+    0.625603549f, 0.811953543f, 0.845230327f, 0.106485711f, 0.306146418f, -0.585671408f, -0.492496411f, 0.752055331f,
+    -0.0865196398f, -0.226282135f, -0.658880334f, 0.0665535691f, 0.346078559f, -0.0598982122f, 0.359389273f, 0.485841054f,
+    0.472530341f, 0.445908913f, 0.505807125f, 0.492496411f, -0.206316064f, -0.505807125f, 0.705467832f, 0.419287485f,
+    0.332767845f, -0.332767845f, 0.292835704f, -0.432598199f, 0.186349993f, 0.146417852f, 0.0399321415f, -0.266214276f,
+    0.492496411f, 0.572360694f, 0.252903563f, -0.512462482f, -0.372699987f, 0.0665535691f, -0.658880334f, 0.0931749967f,
+    -0.073208926f, 0.17303928f, -0.485841054f, -0.232937492f, -0.53908391f, 0.0332767845f, -0.239592849f, 0.386010701f,
+    0.146417852f, 0.212971421f, 0.073208926f, -0.572360694f, -0.419287485f, 0.00665535691f, 0.359389273f, -0.0465874984f,
+    0.512462482f, 0.19300535f, 0.219626778f, -0.159728566f, -0.146417852f, -0.19300535f, 0.845230327f, 0.0332767845f,
+    0.405976771f, 0.565705337f, 0.259558919f, -0.286180347f, 0.352733916f, -0.119796424f, -0.579016051f, -0.0133107138f,
+    0.0931749967f, -0.199660707f, -0.572360694f, -0.332767845f, -0.572360694f, 0.492496411f, 0.405976771f, 0.126451781f,
+    -0.306146418f, 0.419287485f, 0.0798642829f, -0.519117839f, 0.0532428553f, 0.412632128f, 0.432598199f, 0.0798642829f,
+    0.405976771f, 0.319457132f, -0.439253556f, -0.319457132f, 0.00665535691f, -0.139762495f, 0.845230327f, -0.485841054f,
+    0.36604463f, 0.259558919f, 0.572360694f, -0.845230327f, -0.219626778f, -0.545739267f, -0.598982122f, 0.226282135f,
+    -0.665535691f, -0.126451781f, -0.698812475f, -0.246248206f, 0.492496411f, 0.146417852f, 0.439253556f, 0.0266214276f,
+    0.292835704f, 0.485841054f, 0.64556962f, -0.0399321415f, -0.698812475f, 0.133107138f, 0.665535691f, 0.0199660707f,
+    0.445908913f, 0.292835704f, 0.612292836f, -0.0399321415f, 0.246248206f, -0.119796424f, -0.0266214276f, 0.113141067f,
+    0.346078559f, 0.579016051f, 0.432598199f, -0.845230327f, -0.0133107138f, 0.0133107138f, -0.292835704f, 0.339423202f,
+    -0.0865196398f, 0.0532428553f, -0.485841054f, -0.159728566f, 0.405976771f, -0.0532428553f, 0.55904998f, -0.206316064f,
+    0.399321415f, 0.219626778f, 0.625603549f, 0.17303928f, -0.0199660707f, -0.073208926f, 0.166383923f, 0.352733916f,
+    -0.219626778f, 0.445908913f, 0.0931749967f, -0.199660707f, 0.206316064f, -0.179694637f, -0.139762495f, -0.119796424f,
+    -0.0133107138f, -0.186349993f, -0.212971421f, -0.106485711f, -0.19300535f, -0.45256427f, 0.386010701f, 0.073208926f,
+    0.239592849f, -0.552394623f, 0.845230327f, 0.00665535691f, 0.073208926f, -0.159728566f, -0.512462482f, -0.0931749967f,
+    -0.073208926f, -0.139762495f, -0.106485711f, -0.0266214276f, -0.259558919f, 0.0998303536f, -0.179694637f, -0.572360694f,
+    -0.159728566f, -0.073208926f, -0.252903563f, 0.605637479f, -0.419287485f, 0.0598982122f, -0.00665535691f, 0.139762495f,
+    0.492496411f, 0.725433903f, 0.845230327f, -0.199660707f, -0.166383923f, 0.206316064f, -0.512462482f, -0.19300535f,
+    -0.798642829f, 0.27952499f, -0.618948192f, -0.386010701f, 0.0598982122f, 0.0598982122f, -0.386010701f, -0.565705337f,
+    0.246248206f, 0.525773196f, -0.0199660707f, 0.485841054f, -0.146417852f, -0.0798642829f, 0.692157118f, 0.485841054f,
+    0.738744617f, -0.53908391f, 0.492496411f, -0.27952499f, -0.0399321415f, 0.55904998f, 0.73208926f, -0.226282135f,
+    0.412632128f, 0.712123189f, 0.286180347f, -0.632258906f, -0.665535691f, 0.319457132f, -0.845230327f, 0.0266214276f,
+    0.0332767845f, 0.219626778f, -0.658880334f, -0.106485711f, -0.519117839f, -0.0998303536f, 0.425942842f, -0.445908913f,
+    -0.399321415f, 0.346078559f, 0.159728566f, -0.339423202f, -0.652224977f, -0.552394623f, 0.73208926f, 0.073208926f,
+    0.0399321415f, -0.133107138f, -0.0266214276f, -0.232937492f, 0.332767845f, 0.379355344f, 0.585671408f, -0.232937492f,
+    0.0f, -0.299491061f, -0.133107138f, 0.199660707f, -0.246248206f, 0.153073209f, 0.292835704f, 0.226282135f,
+    0.36604463f, -0.632258906f, 0.845230327f, 0.073208926f, 0.212971421f, -0.266214276f, -0.0798642829f, 0.405976771f,
+    0.372699987f, -0.0798642829f, -0.232937492f, -0.00665535691f, -0.0332767845f, -0.073208926f, -0.232937492f, -0.326112489f,
+    -0.239592849f, 0.00665535691f, -0.286180347f, 0.598982122f, -0.525773196f, -0.0332767845f, -0.0133107138f, 0.166383923f,
+    0.485841054f, 0.246248206f, 0.579016051f, -0.346078559f, -0.64556962f, -0.379355344f, -0.845230327f, -0.27952499f,
+    -0.0798642829f, 0.306146418f, -0.73208926f, -0.259558919f, -0.672191048f, 0.0532428553f, -0.0133107138f, 0.465874984f,
+    -0.159728566f, 0.372699987f, 0.698812475f, -0.585671408f, 0.0266214276f, 0.286180347f, 0.505807125f, 0.206316064f,
+    0.545739267f, -0.532428553f, 0.0532428553f, -0.299491061f, -0.585671408f, 0.625603549f, 0.499151768f, -0.625603549f,
+    -0.0798642829f, -0.379355344f, -0.232937492f, 0.0931749967f, -0.226282135f, -0.405976771f, 0.379355344f, -0.459219627f,
+    0.259558919f, -0.552394623f, 0.845230327f, 0.585671408f, -0.119796424f, -0.00665535691f, 0.0332767845f, -0.359389273f,
+    0.0133107138f, -0.153073209f, -0.246248206f, 0.0665535691f, -0.352733916f, 0.0598982122f, -0.166383923f, -0.532428553f,
+    0.0399321415f, -0.352733916f, -0.259558919f, 0.712123189f, -0.212971421f, 0.379355344f, 0.0f, 0.159728566f,
+    0.0f, -0.232937492f, -0.199660707f, 0.119796424f, -0.259558919f, -0.379355344f, 0.346078559f, -0.133107138f,
+    0.232937492f, -0.545739267f, 0.845230327f, 0.339423202f, 0.19300535f, -0.212971421f, -0.27952499f, -0.425942842f,
+    -0.232937492f, -0.126451781f, -0.166383923f, 0.0598982122f, -0.286180347f, 0.0266214276f, -0.212971421f, -0.572360694f,
+    -0.0798642829f, 0.0532428553f, -0.219626778f, 0.579016051f, -0.352733916f, 0.133107138f, -0.0133107138f, 0.139762495f,
+    -0.073208926f, -0.259558919f, -0.232937492f, -0.166383923f, -0.266214276f, -0.658880334f, 0.372699987f, 0.0199660707f,
+    0.246248206f, -0.499151768f, 0.845230327f, 0.352733916f, 0.0199660707f, 0.0798642829f, -0.166383923f, 0.392666058f,
+    0.45256427f, -0.153073209f, -0.246248206f, -0.106485711f, -0.226282135f, -0.179694637f, -0.212971421f, -0.592326765f,
+    -0.0465874984f, -0.53908391f, -0.352733916f, 0.652224977f, -0.339423202f, 0.166383923f, -0.0133107138f, 0.139762495f,
+    0.206316064f, -0.0998303536f, 0.399321415f, -0.272869633f, -0.199660707f, -0.432598199f, -0.45256427f, -0.106485711f,
+    -0.299491061f, 0.073208926f, -0.718778546f, -0.199660707f, -0.166383923f, 0.405976771f, -0.27952499f, -0.0266214276f,
+    0.226282135f, 0.232937492f, 0.845230327f, -0.392666058f, -0.299491061f, 0.146417852f, 0.252903563f, -0.199660707f,
+    0.0465874984f, 0.106485711f, -0.00665535691f, -0.119796424f, 0.153073209f, 0.505807125f, 0.685501762f, -0.372699987f,
+    0.585671408f, 0.825264257f, 0.532428553f, 0.0798642829f, -0.432598199f, 0.652224977f, -0.725433903f, 0.332767845f,
+    -0.672191048f, 0.0199660707f, -0.791987472f, -0.625603549f, -0.479185697f, -0.126451781f, 0.0332767845f, -0.392666058f,
+    0.179694637f, 0.499151768f, 0.153073209f, -0.166383923f, -0.27952499f, -0.419287485f, 0.765366044f, 0.346078559f,
+    0.565705337f, -0.312801775f, 0.505807125f, -0.0399321415f, 0.119796424f, -0.0465874984f, 0.845230327f, -0.133107138f,
+    0.073208926f, -0.199660707f, -0.17303928f, 0.0865196398f, -0.399321415f, 0.252903563f, 0.319457132f, -0.0332767845f,
+    0.332767845f, -0.618948192f, 0.845230327f, 0.292835704f, 0.0865196398f, -0.266214276f, -0.239592849f, 0.0931749967f,
+    -0.19300535f, -0.106485711f, -0.206316064f, 0.0332767845f, -0.0665535691f, 0.0532428553f, -0.212971421f, -0.372699987f,
+    -0.212971421f, 0.0931749967f, -0.219626778f, 0.605637479f, -0.53908391f, 0.179694637f, -0.0399321415f, 0.166383923f,
+    0.399321415f, 0.552394623f, 0.612292836f, -0.159728566f, 0.432598199f, -0.252903563f, -0.485841054f, 0.0266214276f,
+    0.0931749967f, 0.332767845f, -0.845230327f, -0.252903563f, -0.598982122f, 0.0266214276f, -0.419287485f, 0.272869633f,
+    -0.0399321415f, 0.579016051f, 0.386010701f, -0.565705337f, -0.738744617f, -0.479185697f, 0.53908391f, -0.259558919f,
+    0.652224977f, -0.199660707f, 0.485841054f, -0.532428553f, -0.0665535691f, 0.186349993f, 0.805298186f, -0.778676758f,
+    0.519117839f, 0.53908391f, 0.765366044f, -0.19300535f, 0.17303928f, -0.0598982122f, -0.339423202f, 0.432598199f,
+    -0.0399321415f, -0.0332767845f, -0.758710688f, -0.386010701f, 0.519117839f, 0.791987472f, 0.113141067f, -0.199660707f,
+    0.499151768f, 0.499151768f, 0.532428553f, 0.372699987f, -0.386010701f, -0.179694637f, 0.845230327f, -0.106485711f,
+    0.605637479f, -0.519117839f, 0.519117839f, -0.465874984f, -0.0332767845f, -0.179694637f, 0.392666058f, -0.346078559f,
+    0.465874984f, 0.212971421f, 0.592326765f, -0.845230327f, 0.0465874984f, -0.139762495f, -0.778676758f, 0.432598199f,
+    -0.19300535f, -0.119796424f, -0.811953543f, -0.259558919f, 0.159728566f, 0.27952499f, 0.53908391f, 0.472530341f,
+    -0.778676758f, 0.252903563f, 0.0133107138f, -0.113141067f, -0.605637479f, -0.346078559f, 0.492496411f, 0.439253556f,
+    -0.0532428553f, -0.412632128f, 0.219626778f, -0.199660707f, -0.359389273f, 0.252903563f, 0.386010701f, -0.405976771f,
+    0.612292836f, 0.672191048f, 0.572360694f, -0.572360694f, -0.572360694f, -0.712123189f, -0.718778546f, -0.179694637f,
+    -0.126451781f, 0.19300535f, -0.572360694f, 0.199660707f, 0.0332767845f, 0.0931749967f, -0.525773196f, -0.27952499f,
+    -0.605637479f, 0.326112489f, 0.352733916f, 0.206316064f, -0.00665535691f, -0.0266214276f, 0.166383923f, 0.405976771f,
+    0.319457132f, -0.55904998f, 0.0598982122f, -0.339423202f, -0.432598199f, 0.299491061f, 0.845230327f, -0.0399321415f,
+    0.545739267f, 0.752055331f, 0.698812475f, -0.565705337f, -0.259558919f, 0.166383923f, -0.465874984f, -0.372699987f,
+    -0.505807125f, 0.239592849f, -0.845230327f, 0.286180347f, -0.133107138f, 0.266214276f, 0.232937492f, -0.552394623f,
+    0.073208926f, 0.312801775f, -0.133107138f, -0.386010701f, -0.226282135f, -0.432598199f, 0.27952499f, 0.306146418f,
+    0.266214276f, 0.419287485f, -0.0598982122f, -0.179694637f, 0.326112489f, 0.485841054f, 0.738744617f, -0.405976771f,
+    0.612292836f, 0.685501762f, 0.638914263f, -0.845230327f, -0.226282135f, -0.139762495f, -0.798642829f, 0.392666058f,
+    -0.133107138f, 0.27952499f, -0.778676758f, -0.472530341f, -0.772021401f, 0.64556962f, -0.232937492f, -0.831919614f,
+    -0.605637479f, 0.339423202f, -0.17303928f, -0.239592849f, 0.19300535f, 0.259558919f, 0.199660707f, 0.386010701f,
+    0.299491061f, -0.166383923f, -0.36604463f, -0.286180347f, -0.252903563f, -0.0998303536f, 0.831919614f, -0.399321415f,
+    0.465874984f, 0.672191048f, 0.306146418f, -0.845230327f, -0.272869633f, -0.153073209f, -0.725433903f, -0.0532428553f,
+    -0.372699987f, 0.0532428553f, -0.752055331f, 0.232937492f, 0.505807125f, 0.259558919f, 0.625603549f, -0.312801775f,
+    -0.0998303536f, 0.465874984f, 0.798642829f, 0.0332767845f, -0.472530341f, 0.133107138f, 0.572360694f, 0.425942842f,
+    0.286180347f, 0.432598199f, 0.17303928f, -0.153073209f, 0.0532428553f, 0.0133107138f, 0.0865196398f, -0.139762495f,
+    0.45256427f, 0.612292836f, 0.479185697f, -0.845230327f, 0.0998303536f, 0.405976771f, -0.139762495f, -0.00665535691f,
+    -0.219626778f, 0.206316064f, -0.612292836f, 0.0133107138f, 0.0199660707f, 0.339423202f, -0.073208926f, -0.332767845f,
+    0.758710688f, 0.346078559f, 0.692157118f, 0.326112489f, -0.505807125f, -0.073208926f, 0.652224977f, 0.186349993f,
+    0.199660707f, 0.179694637f, 0.412632128f, -0.27952499f, 0.326112489f, 0.412632128f, 0.106485711f, -0.232937492f,
+    -0.0399321415f, -0.332767845f, -0.199660707f, 0.286180347f, -0.339423202f, -0.306146418f, 0.412632128f, -0.0665535691f,
+    0.139762495f, -0.545739267f, 0.845230327f, -0.0998303536f, 0.0931749967f, 0.0465874984f, -0.139762495f, -0.246248206f,
+    -0.219626778f, -0.0665535691f, -0.146417852f, 0.139762495f, -0.239592849f, 0.179694637f, -0.219626778f, -0.55904998f,
+    0.0f, -0.445908913f, -0.312801775f, 0.638914263f, -0.0266214276f, 0.179694637f, -0.0133107138f, 0.17303928f,
+    -0.0465874984f, -0.27952499f, -0.206316064f, 0.219626778f, -0.339423202f, -0.432598199f, 0.312801775f, 0.00665535691f,
+    0.226282135f, -0.492496411f, 0.845230327f, 0.232937492f, -0.0998303536f, -0.359389273f, -0.0266214276f, -0.399321415f,
+    -0.45256427f, -0.133107138f, -0.27952499f, -0.0332767845f, -0.17303928f, 0.0133107138f, -0.17303928f, -0.505807125f,
+    -0.179694637f, 0.226282135f, -0.346078559f, 0.525773196f, -0.319457132f, 0.133107138f, -0.0133107138f, 0.199660707f,
+    0.698812475f, 0.399321415f, 0.399321415f, 0.0598982122f, 0.306146418f, 0.419287485f, -0.592326765f, -0.219626778f,
+    -0.139762495f, -0.159728566f, -0.239592849f, -0.226282135f, -0.159728566f, 0.698812475f, -0.19300535f, -0.0199660707f,
+    0.332767845f, 0.133107138f, -0.219626778f, -0.405976771f, 0.0931749967f, 0.0199660707f, -0.299491061f, 0.519117839f,
+    0.00665535691f, 0.432598199f, 0.252903563f, -0.226282135f, 0.532428553f, 0.319457132f, 0.845230327f, -0.266214276f,
+    0.472530341f, 0.545739267f, 0.845230327f, -0.632258906f, 0.592326765f, -0.0399321415f, -0.55904998f, -0.272869633f,
+    -0.678846405f, 0.419287485f, -0.359389273f, 0.139762495f, -0.0865196398f, 0.698812475f, -0.572360694f, 0.219626778f,
+    -0.166383923f, 0.432598199f, 0.19300535f, -0.292835704f, 0.339423202f, 0.0598982122f, 0.499151768f, 0.19300535f,
+    0.412632128f, 0.505807125f, -0.159728566f, -0.392666058f, -0.0532428553f, 0.585671408f, 0.831919614f, -0.678846405f,
+    -0.0199660707f, -0.246248206f, -0.212971421f, 0.372699987f, -0.159728566f, -0.652224977f, 0.425942842f, 0.0665535691f,
+    0.212971421f, -0.45256427f, 0.845230327f, 0.266214276f, 0.17303928f, -0.272869633f, -0.206316064f, 0.073208926f,
+    -0.113141067f, -0.139762495f, -0.0931749967f, 0.0465874984f, -0.372699987f, -0.0266214276f, -0.19300535f, -0.685501762f,
+    0.0598982122f, -0.505807125f, -0.339423202f, 0.585671408f, -0.219626778f, 0.0998303536f, -0.0332767845f, 0.106485711f,
+    0.552394623f, 0.545739267f, 0.445908913f, -0.00665535691f, -0.259558919f, 0.0998303536f, -0.352733916f, -0.0665535691f,
+    -0.119796424f, 0.36604463f, -0.805298186f, 0.0598982122f, 0.372699987f, 0.545739267f, 0.552394623f, 0.465874984f,
+    -0.212971421f, 0.266214276f, -0.319457132f, -0.386010701f, -0.306146418f, -0.632258906f, -0.0998303536f, 0.00665535691f,
+    0.232937492f, -0.359389273f, 0.379355344f, -0.186349993f, 0.352733916f, 0.45256427f, 0.845230327f, -0.652224977f,
+};
+
+static const float ref_b3_pw_bias[] = {
+    3.21453739f, -21.6964635f, -8.73182826f, 8.92483361f, -1.2046196f, -21.2372439f, 14.3622602f, 24.2321545f,
+    -4.36591413f, 2.13636957f, 13.0977424f, -3.15463917f, 3.85345165f, 10.9214407f, -36.4114576f, 13.7566227f,
+    -6.02975336f, 12.6385228f, -21.4169385f, 15.1010048f, 1.30444995f, 13.8032102f, -0.858541041f, 18.4353386f,
+    -23.9859063f, 18.8413154f, -4.63212841f, 27.8460133f, 1.10478925f, 8.80503719f, 17.3904476f, 25.4500848f,
+    -9.61033538f, -2.26947671f, 19.8462743f, -23.4335117f, 25.7096437f, 4.54560877f, -4.55226413f, 24.6647527f,
+    5.52394623f, -15.3871852f, -0.186349993f, 11.3673496f, -25.3302884f, -18.1824351f, 8.30588542f, -15.7399191f,
+};
+
+static void ref_b3_pw(const float* input, float* output) {
+    for (int p = 0; p < 165; p++) {
+        for (int o = 0; o < 48; o++) {
+            float acc = ref_b3_pw_bias[o];
+            for (int i = 0; i < 32; i++) acc += input[p * 32 + i] * ref_b3_pw_weights[o * 32 + i];
+            output[p * 48 + o] = acc > 0.0f ? acc : 0.0f;
+        }
+    }
+}
+
+static void ref_pool(const float* input, float* output) {
+    for (int c = 0; c < 48; c++) {
+        float sum = 0.0f;
+        for (int p = 0; p < 165; p++) sum += input[p * 48 + c];
+        output[c] = sum / 165;
+    }
+}
+
+static const float ref_logits_weights[] = {
+    -0.003320786f, -0.000433146f, -0.0072191f, -0.003826123f, -0.003248595f, -0.00433146f, 0.008735111f, -0.000938483f,
+    0.00577528f, 0.008229774f, 0.003465168f, 0.004908988f, 0.005486516f, 0.003537359f, -0.001660393f, -0.000866292f,
+    -0.006208426f, 0.002526685f, -0.000649719f, -0.003970505f, -0.005414325f, -0.005703089f, -0.000938483f, 0.005991853f,
+    -0.00433146f, -0.008157583f, 0.004764606f, -0.002526685f, 0.001588202f, 0.006064044f, 0.008735111f, -0.003320786f,
+    -0.004764606f, 0.007507864f, -0.002598876f, -0.004836797f, -0.006064044f, -0.003465168f, -0.006352808f, -0.002959831f,
+    0.001876966f, -0.000144382f, 0.007002527f, 0.009168257f, -0.000144382f, -0.002382303f, 0.006064044f, -0.00649719f,
+    0.002382303f, 0.008229774f, 0.005630898f, 0.005919662f, 0.007652246f, 0.004259269f, -0.006352808f, 0.005630898f,
+    -0.00360955f, -0.003248595f, -0.005558707f, -0.002743258f, 0.000216573f, -0.00216573f, 0.007507864f, 0.008013201f,
+    0.006858145f, -0.006930336f, 0.007868819f, 0.004548033f, 0.00072191f, 0.004620224f, 0.004764606f, -0.006424999f,
+    0.005991853f, 0.002815449f, -0.003104213f, 0.006352808f, -0.006785954f, -0.005630898f, -0.004692415f, 0.004042696f,
+    0.005125561f, -0.001299438f, 0.006930336f, 0.005558707f, 0.004403651f, 0.00216573f, 0.007146909f, 0.005847471f,
+    0.007580055f, 0.007435673f, -0.005414325f, -0.001588202f, 0.006785954f, 0.008085392f, -0.003898314f, 0.004475842f,
+    0.003032022f, 0.001299438f, -0.001804775f, 0.000649719f, -0.001299438f, -0.0072191f, -0.00433146f, -0.006930336f,
+    -0.004836797f, -0.000288764f, -0.002093539f, 0.002526685f, 0.00288764f, -0.007580055f, -0.005269943f, 0.001299438f,
+    -0.004259269f, -0.004042696f, 0.001010674f, -0.007363482f, -0.00360955f, -0.00794101f, -0.006280617f, -0.003681741f,
+    0.000649719f, -0.005125561f, 0.002093539f, -0.005558707f, -0.000360955f, -0.002959831f, -0.00072191f, -0.005558707f,
+    0.0f, 0.000505337f, 0.002526685f, -0.00072191f, -0.004981179f, 0.001155056f, 0.001876966f, -0.007291291f,
+    -0.001660393f, -0.000505337f, 0.00144382f, -0.002671067f, -0.004620224f, -0.002815449f, -0.003320786f, -0.007002527f,
+};
+
+static const float ref_logits_bias[] = {
+    -0.157665144f, 0.203145474f, -0.250214006f,
+};
+
+static void ref_logits(const float* input, float* output) {
+    for (int k = 0; k < 3; k++) {
+        float acc = ref_logits_bias[k];
+        for (int i = 0; i < 48; i++) acc += input[i] * ref_logits_weights[k * 48 + i];
+        output[k] = acc;
+    }
+}
+
+static void ref_probabilities(const float* input, float* output) {
+    float peak = input[0];
+    for (int k = 1; k < 3; k++) peak = input[k] > peak ? input[k] : peak;
+    float total = 0.0f;
+    for (int k = 0; k < 3; k++) total += output[k] = expf(input[k] - peak);
+    for (int k = 0; k < 3; k++) output[k] /= total;
+}
+
+const ReferenceLayer model_reference_layers[MODEL_REFERENCE_LAYERS] = {
+    {"conv", 33, 5, 16, 0},
+    {"b1_dw", 33, 5, 16, 2640},
+    {"b1_pw", 33, 5, 24, 5280},
+    {"b2_dw", 33, 5, 24, 9240},
+    {"b2_pw", 33, 5, 32, 13200},
+    {"b3_dw", 33, 5, 32, 18480},
+    {"b3_pw", 33, 5, 48, 23760},
+    {"pool", 1, 1, 48, 31680},
+    {"logits", 1, 1, 3, 31728},
+    {"probabilities", 1, 1, 3, 31731},
+};
+
+void model_reference_run(const float* input, float* activations) {
+    ref_conv(input, activations + 0);
+    ref_b1_dw(activations + 0, activations + 2640);
+    ref_b1_pw(activations + 2640, activations + 5280);
+    ref_b2_dw(activations + 5280, activations + 9240);
+    ref_b2_pw(activations + 9240, activations + 13200);
+    ref_b3_dw(activations + 13200, activations + 18480);
+    ref_b3_pw(activations + 18480, activations + 23760);
+    ref_pool(activations + 23760, activations + 31680);
+    ref_logits(activations + 31680, activations + 31728);
+    ref_probabilities(activations + 31728, activations + 31731);
+}
@@ -0,0 +1,26 @@
+// Generated by tools/model_converter.py --reference from model_weights.h. Do not edit.
+#pragma once
+#include <cstdint>
+
+// Float reference of ds_cnn_tiny_v2: the int8 graph's weights dequantized, float
+// activations, no requantization or saturation. For host tools only.
+#define MODEL_REFERENCE_NAME "ds_cnn_tiny_v2"
+// 1: dequantized with scales recovered from the graph's own requantization
+// (no .tflite scales), so it shares the graph's calibration and only checks
+// the kernels, not how well the int8 model approximates the trained one.
+#define MODEL_REFERENCE_RECOVERED 1
+#define MODEL_REFERENCE_LAYERS 10 // One per graph node, in node order
+#define MODEL_REFERENCE_INPUT_SIZE 650
+#define MODEL_REFERENCE_ACTIVATIONS 31734 // Floats of all layer outputs
+
+struct ReferenceLayer {
+    const char* name;
+    uint16_t h, w, c;
+    uint32_t offset; // Floats from the start of the activation buffer
+};
+
+extern const ReferenceLayer model_reference_layers[MODEL_REFERENCE_LAYERS];
+
+// `input` is the real-valued feature window ([h][w][c]); every layer's
+// output is written to activations + its offset.
+void model_reference_run(const float* input, float* activations);
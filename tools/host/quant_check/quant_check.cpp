@@ -0,0 +1,310 @@
+// Quantization error of the int8 DS-CNN against its float reference
+// (model_reference.cpp, from tools/model_converter.py --reference): runs
+// both on every inference window of a WAV corpus, as the detector would
+// see it, and reports per-layer max/mean absolute error and SQNR plus how
+// often the two agree on the top class. Run it before and after a kernel
+// change; any drift shows up in the layer that caused it.
+//
+//   pio run -e native_quant_check
+//   .pio/build/native_quant_check/program [data/test_samples] [--graph variant.kwsg]
+//       [--golden tools/host/quant_check/model_golden.bin] [--dump-features features.bin] [--no-gain]
+//
+// --golden first checks this C++ reference against the converter's own
+// float pass (model_converter.py --reference DIR --golden features.bin) and
+// adds that file's windows to the ones measured. --dump-features writes the
+// corpus windows in the format --golden reads.
+//
+// The reference is only an independent baseline when the converter had the
+// .tflite export's weight scales. One built from a legacy model_weights.h
+// (MODEL_REFERENCE_RECOVERED) reuses the graph's own requantization, so its
+// error measures the kernels, not the quantization; the report says so.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "AudioCapture.h"
+#include "Model.h"
+#include "WavSource.h"
+#include "GraphFile.h"
+#include "model_reference.h"
+
+namespace fs = std::filesystem;
+
+static_assert(!DSCNN_BACKEND_AOT, "quant_check reads every layer through the graph interpreter");
+
+// The C++ reference must match the converter's Python pass to this
+// fraction of each layer's peak (float vs double accumulation).
+static const float GOLDEN_TOLERANCE = 1e-4f;
+
+struct Options {
+    std::string corpus = "data/test_samples";
+    std::string graph;
+    std::string golden;
+    std::string dump_features;
+    bool gain = true;
+};
+
+typedef std::vector<int8_t> Window;
+
+struct LayerError {
+    double max_abs = 0.0;
+    double sum_abs = 0.0;
+    double signal = 0.0; // Sum of reference squares
+    double noise = 0.0;  // Sum of error squares
+    uint64_t count = 0;
+};
+
+// Every layer of the engine's latest window, dequantized.
+struct EngineLayers {
+    std::vector<float> values[MODEL_REFERENCE_LAYERS];
+};
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [corpus_dir] [--graph variant.kwsg] [--golden model_golden.bin] "
+                    "[--dump-features features.bin] [--no-gain]\n", program);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    bool corpus_given = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--graph" && has_value) options.graph = argv[++i];
+        else if (arg == "--golden" && has_value) options.golden = argv[++i];
+        else if (arg == "--dump-features" && has_value) options.dump_features = argv[++i];
+        else if (arg == "--no-gain") options.gain = false;
+        else if (arg[0] != '-' && !corpus_given) {
+            options.corpus = arg;
+            corpus_given = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every window the detector would infer on, streamed hop by hop through the
+// production front end (see eval_runner).
+static size_t collectWindows(const Options& options, std::vector<Window>& windows) {
+    std::vector<fs::path> files;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(options.corpus, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".wav") files.push_back(it->path());
+    }
+    std::sort(files.begin(), files.end());
+
+    Model model;
+    static Workspace workspace;
+    size_t used = 0;
+    for (const fs::path& path : files) {
+        WavSource wav;
+        if (!wav.open(path.c_str())) {
+            fprintf(stderr, "⚠️ Skipping %s: %s\n", path.c_str(), wav.error());
+            continue;
+        }
+        StreamState stream;
+        int16_t hop[DETECTOR_HOP_SAMPLES];
+        const size_t total = std::max(wav.frameCount(), (size_t)KWS_WINDOW_SAMPLES);
+        for (size_t position = 0; position < total; position += DETECTOR_HOP_SAMPLES) {
+            size_t count = std::min((size_t)DETECTOR_HOP_SAMPLES, total - position);
+            size_t available = wav.read(hop, count);
+            memset(hop + available, 0, (count - available) * sizeof(int16_t));
+            if (options.gain) AudioCapture::condition(hop, count);
+            const int16_t* samples = hop;
+            while (model.feed(stream, workspace, samples, count)) {
+                windows.emplace_back(KWS_FRAMES * KWS_NUM_MFCC);
+                AudioProcessor::copyFeatures(stream.features, windows.back().data());
+            }
+        }
+        used++;
+    }
+    return used;
+}
+
+static bool readGolden(const std::string& path, std::vector<Window>& windows, std::vector<std::vector<float>>& layers) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    uint32_t header[5], sizes[MODEL_REFERENCE_LAYERS];
+    char magic[4];
+    bool ok = fread(header, sizeof(header), 1, file) == 1;
+    memcpy(magic, header, sizeof(magic));
+    ok = ok && !memcmp(magic, "KWSR", 4) && header[1] == 1 && header[3] == MODEL_REFERENCE_INPUT_SIZE &&
+         header[4] == MODEL_REFERENCE_LAYERS && fread(sizes, sizeof(sizes), 1, file) == 1;
+    for (int l = 0; ok && l < MODEL_REFERENCE_LAYERS; l++) {
+        const ReferenceLayer& layer = model_reference_layers[l];
+        ok = sizes[l] == (uint32_t)layer.h * layer.w * layer.c;
+    }
+    for (uint32_t w = 0; ok && w < header[2]; w++) {
+        Window window(MODEL_REFERENCE_INPUT_SIZE);
+        std::vector<float> activations(MODEL_REFERENCE_ACTIVATIONS);
+        ok = fread(window.data(), window.size(), 1, file) == 1 &&
+             fread(activations.data(), sizeof(float), activations.size(), file) == activations.size();
+        windows.push_back(window);
+        layers.push_back(activations);
+    }
+    fclose(file);
+    return ok && !windows.empty();
+}
+
+static void dequantize(const GraphTensor& tensor, const int8_t* codes, float* real) {
+    for (uint32_t i = 0; i < (uint32_t)tensor.h * tensor.w * tensor.c; i++) {
+        real[i] = (codes[i] - tensor.zero_point) * tensor.scale;
+    }
+}
+
+static void captureLayer(int node, const GraphTensor& tensor, const void* data, int, void* context) {
+    std::vector<float>& values = static_cast<EngineLayers*>(context)->values[node];
+    values.resize((size_t)tensor.h * tensor.w * tensor.c);
+    if (tensor.type == TYPE_FLOAT32) {
+        memcpy(values.data(), data, values.size() * sizeof(float));
+    } else {
+        dequantize(tensor, static_cast<const int8_t*>(data), values.data());
+    }
+}
+
+static void runReference(const GraphModel& graph, const Window& window, std::vector<float>& activations) {
+    std::vector<float> input(MODEL_REFERENCE_INPUT_SIZE);
+    dequantize(graph.tensors[graph.input], window.data(), input.data());
+    activations.resize(MODEL_REFERENCE_ACTIVATIONS);
+    model_reference_run(input.data(), activations.data());
+}
+
+static bool sameTopology(const GraphModel& graph) {
+    if (graph.node_count != MODEL_REFERENCE_LAYERS) return false;
+    for (int l = 0; l < MODEL_REFERENCE_LAYERS; l++) {
+        const GraphTensor& out = graph.tensors[graph.nodes[l].output];
+        const ReferenceLayer& layer = model_reference_layers[l];
+        if (out.h != layer.h || out.w != layer.w || out.c != layer.c) return false;
+    }
+    return graphTensorBytes(graph.tensors[graph.input]) == MODEL_REFERENCE_INPUT_SIZE;
+}
+
+static int argmax(const float* values, int count) {
+    return (int)(std::max_element(values, values + count) - values);
+}
+
+// Worst deviation of the C++ reference from the converter's float pass,
+// as a fraction of each layer's peak.
+static float checkGolden(const GraphModel& graph, const std::vector<Window>& windows,
+                         const std::vector<std::vector<float>>& golden) {
+    float worst = 0.0f;
+    std::vector<float> activations;
+    for (size_t w = 0; w < windows.size(); w++) {
+        runReference(graph, windows[w], activations);
+        for (int l = 0; l < MODEL_REFERENCE_LAYERS; l++) {
+            const ReferenceLayer& layer = model_reference_layers[l];
+            const float* expected = golden[w].data() + layer.offset;
+            float peak = 1e-12f, diff = 0.0f;
+            for (uint32_t i = 0; i < (uint32_t)layer.h * layer.w * layer.c; i++) {
+                peak = std::max(peak, fabsf(expected[i]));
+                diff = std::max(diff, fabsf(activations[layer.offset + i] - expected[i]));
+            }
+            worst = std::max(worst, diff / peak);
+        }
+    }
+    return worst;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    static ManualDSCNN engine;
+    GraphFile variant;
+    if (!options.graph.empty() && !variant.load(options.graph.c_str())) {
+        fprintf(stderr, "❌ Cannot load %s: %s\n", options.graph.c_str(), variant.error());
+        return 1;
+    }
+    if (!(options.graph.empty() ? engine.init() : engine.init(variant.model()))) return 1;
+    const GraphModel& graph = engine.graph();
+    if (!sameTopology(graph)) {
+        fprintf(stderr, "❌ %s does not have the layers of the reference (%s); regenerate model_reference.cpp\n",
+                graph.name, MODEL_REFERENCE_NAME);
+        return 1;
+    }
+
+    std::vector<Window> windows;
+    const size_t files = collectWindows(options, windows);
+    const size_t corpus_windows = windows.size();
+    if (!options.dump_features.empty()) {
+        FILE* out = fopen(options.dump_features.c_str(), "wb");
+        for (const Window& window : windows) {
+            if (out) fwrite(window.data(), window.size(), 1, out);
+        }
+        if (!out || fclose(out) != 0) {
+            fprintf(stderr, "❌ Cannot write %s\n", options.dump_features.c_str());
+            return 1;
+        }
+        printf("✅ Wrote %zu windows to %s\n", windows.size(), options.dump_features.c_str());
+    }
+    if (!options.golden.empty()) {
+        std::vector<Window> golden_windows;
+        std::vector<std::vector<float>> golden;
+        if (!readGolden(options.golden, golden_windows, golden)) {
+            fprintf(stderr, "❌ %s is not a golden file for %s\n", options.golden.c_str(), MODEL_REFERENCE_NAME);
+            return 1;
+        }
+        const float worst = checkGolden(graph, golden_windows, golden);
+        printf("%s Reference vs converter golden: worst layer deviation %.2e of peak over %zu windows\n",
+               worst <= GOLDEN_TOLERANCE ? "✅" : "❌", worst, golden_windows.size());
+        if (worst > GOLDEN_TOLERANCE) return 1;
+        windows.insert(windows.end(), golden_windows.begin(), golden_windows.end());
+    }
+    if (windows.empty()) {
+        fprintf(stderr, "❌ No windows: %s has no readable WAV files\n", options.corpus.c_str());
+        return 1;
+    }
+
+    EngineLayers engine_layers;
+    engine.setLayerObserver(captureLayer, &engine_layers);
+    LayerError errors[MODEL_REFERENCE_LAYERS];
+    std::vector<float> reference;
+    float probabilities[KWS_NUM_CLASSES];
+    const int classes = model_reference_layers[MODEL_REFERENCE_LAYERS - 1].c;
+    size_t agree = 0;
+    for (const Window& window : windows) {
+        if (!engine.infer(window.data(), probabilities)) return 1;
+        runReference(graph, window, reference);
+        for (int l = 0; l < MODEL_REFERENCE_LAYERS; l++) {
+            const std::vector<float>& actual = engine_layers.values[l];
+            const float* expected = reference.data() + model_reference_layers[l].offset;
+            LayerError& e = errors[l];
+            for (size_t i = 0; i < actual.size(); i++) {
+                const double err = fabs((double)actual[i] - expected[i]);
+                e.max_abs = std::max(e.max_abs, err);
+                e.sum_abs += err;
+                e.signal += (double)expected[i] * expected[i];
+                e.noise += err * err;
+            }
+            e.count += actual.size();
+        }
+        const float* final_reference = reference.data() + model_reference_layers[MODEL_REFERENCE_LAYERS - 1].offset;
+        if (argmax(probabilities, classes) == argmax(final_reference, classes)) agree++;
+    }
+
+    printf("📊 %s vs float reference: %zu windows (%zu from %zu files in %s)\n", graph.name, windows.size(),
+           corpus_windows, files, options.corpus.c_str());
+    if (MODEL_REFERENCE_RECOVERED) {
+        printf("⚠️ Reference dequantized with scales recovered from the graph's own requantization (no .tflite "
+               "scales): this checks the kernels, not the quantization\n");
+    }
+    printf("   %-14s %-10s %12s %12s %9s\n", "layer", "shape", "max |err|", "mean |err|", "SQNR dB");
+    for (int l = 0; l < MODEL_REFERENCE_LAYERS; l++) {
+        const ReferenceLayer& layer = model_reference_layers[l];
+        const LayerError& e = errors[l];
+        char shape[32];
+        snprintf(shape, sizeof(shape), "%ux%ux%u", layer.h, layer.w, layer.c);
+        const double sqnr = e.noise > 0.0 ? 10.0 * log10(e.signal / e.noise) : INFINITY;
+        printf("   %-14s %-10s %12.4g %12.4g %9.1f\n", layer.name, shape, e.max_abs, e.sum_abs / e.count, sqnr);
+    }
+    printf("   top class agrees on %zu/%zu windows (%.1f%%)\n", agree, windows.size(), 100.0 * agree / windows.size());
+    return 0;
+}
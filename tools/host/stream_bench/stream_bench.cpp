@@ -0,0 +1,95 @@
+// Multi-stream throughput: feeds N synthetic channels through one shared
+// Model on a StreamRunner and reports real-time factor per worker count.
+//
+//   pio run -e native_streams
+//   .pio/build/native_streams/program [--streams N] [--seconds S] [--max-workers W]
+//       [--batch B] [--wait-us U]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "StreamRunner.h"
+#include "Logger.h"
+
+// Deterministic per-stream audio: noise with a stream-specific tone.
+static void synthesize(int stream, size_t offset, int16_t* out, size_t count) {
+    uint32_t seed = 2654435761u * (uint32_t)(stream + 1) + (uint32_t)offset;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = ((int32_t)(seed >> 16) - 32768) * 0.05f;
+        float tone = 3000.0f * sinf(2.0f * 3.14159265f * (200.0f + 50.0f * stream) * (offset + i) / KWS_SAMPLE_RATE_HZ);
+        out[i] = (int16_t)(noise + tone);
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [--streams N] [--seconds S] [--max-workers W] [--batch B] [--wait-us U]\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    int streams = 32;
+    double seconds = 10.0;
+    unsigned max_workers = std::max(1u, std::thread::hardware_concurrency());
+    int batch = DSCNN_MAX_BATCH;
+    unsigned wait_us = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--streams") && i + 1 < argc) streams = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--max-workers") && i + 1 < argc) max_workers = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--batch") && i + 1 < argc) batch = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--wait-us") && i + 1 < argc) wait_us = (unsigned)atoi(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (streams <= 0 || seconds <= 0.0 || max_workers == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    Logger::init(LOG_LEVEL_ERROR);
+    Logger::startTask();
+
+    Model model;
+    const size_t total = (size_t)(seconds * KWS_SAMPLE_RATE_HZ);
+    printf("%d streams x %.1f s, %u bytes per stream, batch %d, wait %u us\n\n", streams, seconds,
+           (unsigned)StreamRunner::bytesPerStream(), batch, wait_us);
+    printf("workers  wall s  x realtime  speedup\n");
+
+    double baseline = 0.0;
+    for (unsigned workers = 1; workers <= max_workers; workers *= 2) {
+        StreamRunner runner(model, streams, workers);
+        runner.setBatching(batch, wait_us);
+        for (int s = 0; s < streams; s++) runner.addStream();
+        if (!runner.start()) return 1;
+
+        int16_t hop[DETECTOR_HOP_SAMPLES];
+        auto start = std::chrono::steady_clock::now();
+        // Round-robin one hop per stream, as a capture loop would deliver it;
+        // a full ring means the workers are behind, so wait for them.
+        for (size_t position = 0; position < total; position += DETECTOR_HOP_SAMPLES) {
+            size_t count = std::min((size_t)DETECTOR_HOP_SAMPLES, total - position);
+            for (int s = 0; s < streams; s++) {
+                synthesize(s, position, hop, count);
+                for (size_t sent = 0; sent < count; ) {
+                    size_t accepted = runner.push(s, hop + sent, count - sent);
+                    if (accepted == 0) std::this_thread::yield();
+                    sent += accepted;
+                }
+            }
+        }
+        runner.drain();
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double realtime = streams * seconds / wall;
+        if (workers == 1) baseline = realtime;
+        printf("%7u  %6.2f  %10.1f  %6.2fx\n", workers, wall, realtime, realtime / baseline);
+    }
+    return 0;
+}
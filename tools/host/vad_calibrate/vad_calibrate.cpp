@@ -0,0 +1,121 @@
+// Calibrates the voice-activity gate (lib/AudioProcessor/VoiceActivity) from
+// a recording of the target microphone in a quiet room, conditioned the way
+// the detector conditions it, and writes include/vad_params.h.
+//
+//   pio run -e native_vad_calibrate
+//   .pio/build/native_vad_calibrate/program data/calibration/noise_samples.wav
+//       [--out include/vad_params.h]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "AudioCapture.h"
+#include "Model.h"
+#include "VoiceActivity.h"
+#include "WavSource.h"
+
+// Onset never closer to the noise than this (+6 dB), and at least twice
+// the loudest noise frame relative to the median.
+static const float MIN_ONSET_RATIO = 4.0f;
+
+struct NoiseFrames {
+    std::vector<uint32_t> energy;
+    std::vector<uint16_t> crossings;
+};
+
+static float percentile(std::vector<uint32_t> values, double p) {
+    std::sort(values.begin(), values.end());
+    return (float)values[(size_t)(p * (values.size() - 1))];
+}
+
+// Replays the file in detector hops; `gate` sees every frame and `frames`,
+// when given, collects their measures.
+static void replay(WavSource& wav, VoiceActivity& gate, NoiseFrames* frames, uint32_t& open_frames) {
+    int16_t hop[DETECTOR_HOP_SAMPLES];
+    open_frames = 0;
+    wav.rewind();
+    while (wav.read(hop, DETECTOR_HOP_SAMPLES) == DETECTOR_HOP_SAMPLES) {
+        AudioCapture::condition(hop, DETECTOR_HOP_SAMPLES);
+        for (int f = 0; f < DETECTOR_HOP_FRAMES; f++) {
+            gate.update(hop + f * KWS_STRIDE_SAMPLES, KWS_STRIDE_SAMPLES);
+            if (gate.frames() > VAD_HANGOVER_FRAMES && gate.active()) open_frames++;
+            if (frames) {
+                frames->energy.push_back(gate.lastEnergy());
+                frames->crossings.push_back(gate.lastCrossings());
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* input = nullptr;
+    std::string out_path = "include/vad_params.h";
+    bool usage_error = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--out") && i + 1 < argc) out_path = argv[++i];
+        else if (argv[i][0] != '-' && !input) input = argv[i];
+        else usage_error = true;
+    }
+    if (!input || usage_error) {
+        fprintf(stderr, "usage: %s <noise.wav> [--out include/vad_params.h]\n", argv[0]);
+        return 2;
+    }
+
+    WavSource wav;
+    if (!wav.open(input)) {
+        fprintf(stderr, "❌ Cannot read %s: %s\n", input, wav.error());
+        return 1;
+    }
+    if (wav.frameCount() < (size_t)KWS_WINDOW_SAMPLES * 2) {
+        fprintf(stderr, "❌ %s is too short: record at least a few seconds of room noise\n", input);
+        return 1;
+    }
+
+    // Only the probe's per-frame measures are used, not its decisions.
+    VoiceActivity probe;
+    NoiseFrames frames;
+    uint32_t ignored;
+    replay(wav, probe, &frames, ignored);
+
+    std::vector<uint32_t> crossings(frames.crossings.begin(), frames.crossings.end());
+    const float median = std::max(percentile(frames.energy, 0.5), (float)VAD_MIN_ENERGY);
+    const float loudest = percentile(frames.energy, 0.99);
+    VadConfig config;
+    config.noise_floor = (uint32_t)median;
+    config.onset_ratio = std::max(MIN_ONSET_RATIO, 2.0f * loudest / median);
+    // Above nearly every noise frame; past a full frame the rule is off
+    // (hiss crosses as often as fricatives do).
+    config.zcr_threshold = (uint16_t)std::min<float>(percentile(crossings, 0.99) + 8, KWS_STRIDE_SAMPLES + 1);
+
+    VoiceActivity gate(config);
+    uint32_t open_frames = 0;
+    replay(wav, gate, nullptr, open_frames);
+    const uint32_t judged = gate.frames() > VAD_HANGOVER_FRAMES ? gate.frames() - VAD_HANGOVER_FRAMES : 1;
+
+    printf("📊 %s: %.1f s, %zu frames\n", input, wav.seconds(), frames.energy.size());
+    printf("   noise rms %.0f (median), p99/median %+.1f dB, p99 crossings %.0f/frame\n", sqrtf(median),
+           10.0f * log10f(loudest / median), percentile(crossings, 0.99));
+    printf("   onset ratio %.2f (%+.1f dB), fricative crossings >= %u\n", config.onset_ratio,
+           10.0f * log10f(config.onset_ratio), (unsigned)config.zcr_threshold);
+    printf("   gate open on %.2f%% of this noise after the first window\n", 100.0 * open_frames / judged);
+
+    FILE* out = fopen(out_path.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "❌ Cannot write %s\n", out_path.c_str());
+        return 1;
+    }
+    fprintf(out, "#pragma once\n");
+    fprintf(out, "// Generated by tools/host/vad_calibrate from %s.\n", input);
+    fprintf(out, "#define VAD_NOISE_FLOOR %u // Mean square per frame (0 = learned from the first frame)\n",
+            (unsigned)config.noise_floor);
+    fprintf(out, "#define VAD_ONSET_RATIO %.2ff // Speech above floor * ratio (%+.1f dB)\n", config.onset_ratio,
+            10.0f * log10f(config.onset_ratio));
+    fprintf(out, "#define VAD_ZCR_THRESHOLD %u // Zero crossings per %d-sample frame marking fricatives\n",
+            (unsigned)config.zcr_threshold, KWS_STRIDE_SAMPLES);
+    fclose(out);
+    printf("✅ Wrote %s\n", out_path.c_str());
+    return 0;
+}
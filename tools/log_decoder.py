@@ -0,0 +1,87 @@
+import re
+import struct
+import sys
+from pathlib import Path
+
+LEVEL_TAGS = {1: 'E', 2: 'I', 3: 'V'}
+INT32, INT64, FLOAT, POINTER = range(4)
+SPEC_RE = re.compile(r'%([-+ #0-9.]*)(hh|h|ll|l|L|q|j|z|t)?([diouxXeEfFgGaAcsp%])')
+
+
+def unpack_args(type_bits, count, words, ptr_words):
+    args, w = [], 0
+    for i in range(count):
+        kind = (type_bits >> (2 * i)) & 0x3
+        if kind == INT32:
+            args.append((kind, words[w]))
+            w += 1
+        elif kind == FLOAT:
+            args.append((kind, struct.unpack('<f', struct.pack('<I', words[w]))[0]))
+            w += 1
+        else:
+            n = 2 if kind == INT64 else ptr_words
+            value = words[w] | (words[w + 1] << 32 if n == 2 else 0)
+            args.append((kind, value))
+            w += n
+    return args
+
+
+def format_message(fmt, args, strings):
+    args = list(args)
+
+    def convert(match):
+        flags, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if not args:
+            return '?'
+        kind, value = args.pop(0)
+        if conv == 's':
+            return ('%' + flags + 's') % strings.get(value, f'<str@{value:x}>')
+        if conv == 'p':
+            return f'0x{value:x}'
+        if conv in 'eEfFgGaA':
+            return ('%' + flags + conv.replace('a', 'e').replace('A', 'E')) % float(value)
+        if kind == INT32 and conv in 'di' and value & 0x80000000:
+            value -= 1 << 32
+        if kind == INT64 and conv in 'di' and value & (1 << 63):
+            value -= 1 << 64
+        if kind == FLOAT:
+            value = int(value)
+        return ('%' + flags + ('d' if conv in 'diu' else conv)) % value
+
+    return SPEC_RE.sub(convert, fmt)
+
+
+def decode(lines):
+    formats, strings, ptr_words = {}, {}, 1
+    for line in lines:
+        line = line.rstrip('\r\n')
+        if line.startswith('LOG-COMPACT'):
+            fields = dict(f.split('=', 1) for f in line.split()[2:] if '=' in f)
+            ptr_words = max(1, int(fields.get('ptr', '4')) // 4)
+            formats.clear()
+            strings.clear()
+        elif line.startswith('F '):
+            _, key, fmt = (line.split(' ', 2) + [''])[:3]
+            formats[int(key, 16)] = fmt
+        elif line.startswith('S '):
+            _, key, text = (line.split(' ', 2) + [''])[:3]
+            strings[int(key, 16)] = text
+        elif line.startswith('L '):
+            parts = line.split()
+            level, ts, key, meta = int(parts[1]), int(parts[2]), int(parts[3], 16), int(parts[4], 16)
+            words = [int(w, 16) for w in parts[5:]]
+            args = unpack_args(meta & 0xFFFF, meta >> 16, words, ptr_words)
+            fmt = formats.get(key, f'<unknown format {key:x}>')
+            yield f'[{ts}][{LEVEL_TAGS.get(level, "?")}] {format_message(fmt, args, strings)}'
+        else:
+            yield line
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print("Usage: python log_decoder.py <serial_log.txt>")
+        sys.exit(1)
+    for text in decode(Path(sys.argv[1]).read_text(errors='replace').splitlines()):
+        print(text)
@@ -0,0 +1,115 @@
+"""Golden MFCC frames for test/test_mfcc, computed the way tf.signal computes them.
+
+Mirrors tf.signal.stft (periodic Hann, no end padding), linear_to_mel_weight_matrix
+(HTK mel scale, DC bin zeroed), log(mel + 1e-6) and mfccs_from_log_mel_spectrograms
+(DCT-II scaled by 1/sqrt(2 * bands)) in plain Python, so it runs without numpy or
+TensorFlow. The input is regenerated by the test from the same recipe: two tones plus
+the TestSignal LCG's noiseSample().
+
+Usage: python tools/mfcc_reference.py [test/test_mfcc/mfcc_golden.h]
+"""
+import math
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+FFT_SIZE = 512               # KWS_FFT_SIZE in AudioProcessor.h
+MEL_LOW_HZ, MEL_HIGH_HZ = 20.0, 4000.0
+LOG_OFFSET = 1e-6
+SEED = 3
+TONES = ((440.0, 8000.0), (1370.0, 3000.0))  # (Hz, amplitude)
+# Quantization of the golden frames. Fixed here rather than taken from the model,
+# so a new model does not change the check, and about 16x finer than the model
+# input's: the coefficients of this signal span -3.9..5.2 (-117..111 here, unclipped).
+SCALE, ZERO_POINT = 0.04, -20
+
+
+def frontend_params():
+    text = (ROOT / 'include' / 'frontend_params.h').read_text()
+    return {name: int(value) for name, value in re.findall(r'#define\s+(KWS_\w+)\s+(\d+)\s*$', text, re.M)}
+
+
+PARAMS = frontend_params()
+RATE = PARAMS['KWS_SAMPLE_RATE_HZ']
+FRAME_LEN = RATE * PARAMS['KWS_FRAME_MS'] // 1000
+STRIDE = RATE * PARAMS['KWS_STRIDE_MS'] // 1000
+
+
+def test_signal(count, seed):
+    """The samples fillGolden() in test_mfcc.cpp builds: tones plus TestSignal(seed).noiseSample()."""
+    state, samples = seed, []
+    for n in range(count):
+        state = (state * 1664525 + 1013904223) & 0xffffffff
+        noise = int(((state >> 16) - 32768) / 16)  # C++ truncates toward zero
+        value = sum(a * math.sin(2.0 * math.pi * hz * n / RATE) for hz, a in TONES) + noise
+        samples.append(int(value))
+    return samples
+
+
+def hz_to_mel(hz):
+    return 1127.0 * math.log(1.0 + hz / 700.0)
+
+
+def mel_weights(bands, bins):
+    lo, hi = hz_to_mel(MEL_LOW_HZ), hz_to_mel(MEL_HIGH_HZ)
+    edges = [lo + (hi - lo) * i / (bands + 1) for i in range(bands + 2)]
+    weights = [[0.0] * bands for _ in range(bins)]
+    for k in range(1, bins):  # tf zeroes the DC bin
+        mel = hz_to_mel(k * RATE / FFT_SIZE)
+        for m in range(bands):
+            lower, center, upper = edges[m], edges[m + 1], edges[m + 2]
+            weights[k][m] = max(0.0, min((mel - lower) / (center - lower), (upper - mel) / (upper - center)))
+    return weights
+
+
+def mfcc_frames(samples, p):
+    bands, coeffs, bins = p['KWS_NUM_MEL'], p['KWS_NUM_MFCC'], FFT_SIZE // 2 + 1
+    window = [0.5 - 0.5 * math.cos(2.0 * math.pi * n / FRAME_LEN) for n in range(FRAME_LEN)]
+    cos_table = [[math.cos(2.0 * math.pi * k * n / FFT_SIZE) for n in range(FRAME_LEN)] for k in range(bins)]
+    sin_table = [[math.sin(2.0 * math.pi * k * n / FFT_SIZE) for n in range(FRAME_LEN)] for k in range(bins)]
+    weights = mel_weights(bands, bins)
+    dct = [[math.sqrt(2.0 / bands) * math.cos(math.pi * c * (2 * m + 1) / (2 * bands)) for m in range(bands)]
+           for c in range(coeffs)]
+    frames = []
+    for f in range(p['KWS_FRAMES']):
+        frame = [samples[f * STRIDE + n] / 32768.0 * window[n] for n in range(FRAME_LEN)]
+        magnitude = [math.hypot(sum(a * b for a, b in zip(frame, cos_table[k])),
+                                sum(a * b for a, b in zip(frame, sin_table[k]))) for k in range(bins)]
+        log_mel = [math.log(sum(magnitude[k] * weights[k][m] for k in range(bins)) + LOG_OFFSET)
+                   for m in range(bands)]
+        for c in range(coeffs):
+            value = sum(d * v for d, v in zip(dct[c], log_mel))
+            frames.append(max(-128, min(127, round(value / SCALE) + ZERO_POINT)))
+    return frames
+
+
+def write_header(path, p, frames):
+    coeffs = p['KWS_NUM_MFCC']
+    rows = [', '.join(str(v) for v in frames[i:i + coeffs]) + ',' for i in range(0, len(frames), coeffs)]
+    tones = ' + '.join(f'{a:g} sin({hz:g} Hz)' for hz, a in TONES)
+    path.write_text(f"""#ifndef MFCC_GOLDEN_H
+#define MFCC_GOLDEN_H
+
+// Generated by tools/mfcc_reference.py, do not edit. tf.signal MFCCs of
+// {tones} + TestSignal({SEED}).noiseSample(): {p['KWS_FRAME_MS']} ms frames every {p['KWS_STRIDE_MS']} ms,
+// {FFT_SIZE}-point FFT, {p['KWS_NUM_MEL']} mel bands over {MEL_LOW_HZ:g}-{MEL_HIGH_HZ:g} Hz, quantized with the scale
+// and zero point below.
+
+#define MFCC_GOLDEN_SEED {SEED}
+#define MFCC_GOLDEN_SCALE {SCALE!r}f
+#define MFCC_GOLDEN_ZERO_POINT {ZERO_POINT}
+
+static const int8_t mfcc_golden[{p['KWS_FRAMES']} * {coeffs}] = {{
+""" + '\n'.join('    ' + row for row in rows) + """
+};
+
+#endif
+""")
+
+
+if __name__ == '__main__':
+    window_samples = (PARAMS['KWS_FRAMES'] - 1) * STRIDE + FRAME_LEN
+    out = Path(sys.argv[1]) if len(sys.argv) > 1 else ROOT / 'test' / 'test_mfcc' / 'mfcc_golden.h'
+    write_header(out, PARAMS, mfcc_frames(test_signal(window_samples, SEED), PARAMS))
+    print(f"Wrote {out} ({PARAMS['KWS_FRAMES']} frames of {PARAMS['KWS_NUM_MFCC']} coefficients)")
@@ -1,70 +1,1195 @@
-import tensorflow as tf
-import numpy as np
+"""Convert a trained int8 DS-CNN into the graph description ManualDSCNN runs.
+
+Usage:
+    python tools/model_converter.py <model_int8.tflite | model_graph.json | model_weights.h> <output_dir>
+        [--aot] [--int4 LAYERS] [--blob] [--symbol NAME] [--reference DIR [--golden FEATURES]]
+        [--placeholder-scales]
+
+Writes to <output_dir>:
+    model_graph.json   ops, tensor shapes, strides, padding, quant params, weights
+    model_graph.h/.cpp the same as C arrays plus a pre-planned activation arena
+    model_aot.h/.cpp   with --aot: the model compiled to straight-line C++
+    model_graph.kwsg   with --blob: the graph as one binary file for host tools
+
+--reference DIR writes model_reference.h/.cpp there: the same network in
+float (weights dequantized with the scales the .tflite export stores, no
+requantization), the baseline tools/host/quant_check measures the int8
+engine against. A graph without those scales (a legacy header) only gets a
+reference with --placeholder-scales, dequantized with scales recovered from
+its own multipliers and labelled MODEL_REFERENCE_RECOVERED. With --golden,
+model_golden.bin holds every layer's reference output for the given input
+windows, computed here in Python independently of the C++.
+
+--int4 gives the chosen convolutions int4 weights (two per byte) with a
+scale per output channel, derived from their int8 weights.
+
+Inputs:
+    .tflite   the exported int8 model (needs TensorFlow)
+    .json     a graph written earlier (re-plan / re-emit only)
+    .h        a legacy model_weights.h: the ds_cnn_tiny_v2 topology is
+              rebuilt from its tensor shapes. That header carries no
+              activation scales, so every activation gets a placeholder
+              scale of 1.0 and requantization hand-tuned on synthetic
+              features (LEGACY_CALIBRATION). Refused without
+              --placeholder-scales; the graph is marked, and ManualDSCNN
+              only runs it when built with DSCNN_ALLOW_PLACEHOLDER_SCALES=1.
+"""
+import argparse
+import json
+import math
+import re
+import struct
 import sys
 from pathlib import Path
 
-def convert_tflite_to_c_arrays(tflite_path: Path, output_h: Path):
-    interp = tf.lite.Interpreter(model_path=str(tflite_path))
+ARENA_ALIGNMENT = 16
+
+# Ops the C++ op registry implements (lib/ManualDSCNN/Graph.h, GraphOp).
+OPS = ['conv2d', 'depthwise', 'pointwise', 'avgpool', 'fully_connected', 'softmax']
+
+
+def quantize_multiplier(real):
+    """TFLite QuantizeMultiplier: real = q31 * 2^shift / 2^31."""
+    if real == 0.0:
+        return 0, 0
+    fraction, shift = math.frexp(real)
+    q = int(round(fraction * (1 << 31)))
+    if q == (1 << 31):
+        q //= 2
+        shift += 1
+    return q, shift
+
+
+def same_padding(in_size, out_size, kernel, stride):
+    total = max((out_size - 1) * stride + kernel - in_size, 0)
+    return total // 2
+
+
+def make_tensor(name, shape, dtype='int8', scale=1.0, zero_point=0):
+    h, w, c = ([1, 1] + list(shape))[-3:]
+    return {'name': name, 'shape': [int(h), int(w), int(c)], 'dtype': dtype,
+            'scale': float(scale), 'zero_point': int(zero_point)}
+
+
+# ---------------------------------------------------------------------------
+# TFLite
+# ---------------------------------------------------------------------------
+
+def graph_from_tflite(path):
+    import numpy as np
+    import tensorflow as tf
+
+    interp = tf.lite.Interpreter(model_path=str(path))
     interp.allocate_tensors()
-    tensors = interp.get_tensor_details()
-    input_details = interp.get_input_details()[0]
-    output_details = interp.get_output_details()[0]
-
-    print("Tensor Details:")
-    for tensor in tensors:
-        print(f"Name: {tensor['name']}, Shape: {tensor['shape']}, Type: {tensor['dtype']}")
-
-    with output_h.open('w') as f:
-        f.write('#pragma once\n#include <cstdint>\n\n')
-        scale, zp = input_details['quantization']
-        f.write(f'const float input_scale = {scale}f;\n')
-        f.write(f'const int32_t input_zero_point = {zp};\n\n')
-        scale, zp = output_details['quantization']
-        f.write(f'const float output_scale = {scale}f;\n')
-        f.write(f'const int32_t output_zero_point = {zp};\n\n')
-
-        seen_names = set()
-        for tensor in tensors:
-            if 'serving_default' in tensor['name'] or 'reduction_indices' in tensor['name'] or \
-                any(x in tensor['name'] for x in ['Relu', 'Mean', 'AvgPool', 'Stateful']):
-                print(f"Skipping tensor (non-weight): {tensor['name']}")
-                continue
-            try:
-                data = interp.get_tensor(tensor['index'])
-                if data.size == 0:
-                    print(f"Skipping empty tensor: {tensor['name']}")
-                    continue
-                shape = tensor['shape']
-                dtype = 'int8_t' if tensor['dtype'] == np.int8 else 'int32_t' if tensor['dtype'] == np.int32 else 'float'
-                flat = data.flatten()
-                # Split fused names on ';' and use the last part for the name
-                parts = tensor['name'].split(';')
-                name_part = parts[-1].strip() if len(parts) > 1 else tensor['name']
-                name = name_part.replace('/', '_').replace(':', '_').replace(' ', '_')
-                # Ensure unique names
-                base_name = name
-                counter = 1
-                while name in seen_names:
-                    name = f"{base_name}_{counter}"
-                    counter += 1
-                seen_names.add(name)
-                f.write(f'const {dtype} {name}[] = {{\n')
-                for i in range(0, len(flat), 8):
-                    chunk = flat[i:i+8]
-                    f.write('  ' + ', '.join(f'{int(v)}' for v in chunk) + ',\n')
-                f.write('};\n')
-                f.write(f'// Shape: {shape}\n\n')
-            except ValueError as e:
-                print(f"Error processing tensor {tensor['name']}: {e}")
+    details = {t['index']: t for t in interp.get_tensor_details()}
+    ops = interp._get_ops_details()
+
+    def quant(index):
+        q = details[index]['quantization_parameters']
+        scales = list(q['scales']) or [details[index]['quantization'][0]]
+        zero_points = list(q['zero_points']) or [details[index]['quantization'][1]]
+        return [float(s) for s in scales], [int(z) for z in zero_points]
+
+    tensors, tensor_ids, nodes = [], {}, []
+    aliases = {}
+
+    def tensor(index, dtype='int8'):
+        index = aliases.get(index, index)
+        if index not in tensor_ids:
+            t = details[index]
+            scales, zero_points = quant(index)
+            tensor_ids[index] = len(tensors)
+            tensors.append(make_tensor(t['name'].split(';')[-1], t['shape'][1:] if len(t['shape']) > 1 else t['shape'],
+                                       dtype, scales[0], zero_points[0]))
+        return tensor_ids[index]
+
+    graph_input = interp.get_input_details()[0]['index']
+    for op in ops:
+        name = op['op_name']
+        inputs, outputs = list(op['inputs']), list(op['outputs'])
+        if name in ('QUANTIZE', 'DEQUANTIZE', 'RESHAPE', 'SQUEEZE'):
+            if inputs[0] == graph_input and name == 'QUANTIZE':
+                graph_input = outputs[0]
+            aliases[outputs[0]] = aliases.get(inputs[0], inputs[0])
+            continue
+
+        x = aliases.get(inputs[0], inputs[0])
+        in_scale = quant(x)[0][0]
+        node = {'input': tensor(x)}
+        out_detail = details[outputs[0]]
+        relu = 'relu' in out_detail['name'].lower()
+
+        if name in ('CONV_2D', 'DEPTHWISE_CONV_2D', 'FULLY_CONNECTED'):
+            weights = interp.get_tensor(inputs[1])
+            bias = interp.get_tensor(inputs[2]) if len(inputs) > 2 and inputs[2] >= 0 else \
+                np.zeros(weights.shape[0 if name != 'DEPTHWISE_CONV_2D' else -1], dtype=np.int32)
+            w_scales = quant(inputs[1])[0]
+            node['weights'] = [int(v) for v in weights.flatten()]
+            node['bias'] = [int(v) for v in bias.flatten()]
+            node['weight_scale'] = w_scales  # For --reference, independent of the requantization
+
+        if name in ('CONV_2D', 'DEPTHWISE_CONV_2D'):
+            in_shape = details[x]['shape'][1:]
+            out_shape = out_detail['shape'][1:]
+            kh, kw = weights.shape[1], weights.shape[2]
+            sh = max(1, round(in_shape[0] / out_shape[0]))
+            sw = max(1, round(in_shape[1] / out_shape[1]))
+            if name == 'CONV_2D' and kh == 1 and kw == 1 and sh == 1 and sw == 1:
+                node['op'] = 'pointwise'
+            else:
+                node['op'] = 'conv2d' if name == 'CONV_2D' else 'depthwise'
+                node.update(kernel=[int(kh), int(kw)], stride=[int(sh), int(sw)],
+                            padding=[same_padding(in_shape[0], out_shape[0], kh, sh),
+                                     same_padding(in_shape[1], out_shape[1], kw, sw)])
+            out_scale = quant(outputs[0])[0][0]
+            multipliers = [quantize_multiplier(in_scale * s / out_scale) for s in w_scales]
+            node['multiplier'] = [m for m, _ in multipliers]
+            node['shift'] = [s for _, s in multipliers]
+            node['activation'] = 'relu' if relu else 'none'
+            node['output'] = tensor(outputs[0])
+        elif name in ('AVERAGE_POOL_2D', 'MEAN'):
+            node['op'] = 'avgpool'
+            node['output'] = tensor(outputs[0])
+        elif name == 'FULLY_CONNECTED':
+            node['op'] = 'fully_connected'
+            # Logits stay float (real = accumulator * scale) for the float
+            # softmax that follows, instead of TFLite's int8 round trip.
+            logits = make_tensor(out_detail['name'].split(';')[-1], [len(node['bias'])], 'float32')
+            tensor_ids[outputs[0]] = len(tensors)
+            tensors.append(logits)
+            node['output'] = tensor_ids[outputs[0]]
+            node['output_scale'] = in_scale * w_scales[0]
+        elif name == 'SOFTMAX':
+            node['op'] = 'softmax'
+            probabilities = make_tensor('probabilities', [tensors[node['input']]['shape'][2]], 'float32')
+            tensor_ids[outputs[0]] = len(tensors)
+            tensors.append(probabilities)
+            node['output'] = tensor_ids[outputs[0]]
+        else:
+            raise SystemExit(f'Unsupported op {name}: extend OPS and the C++ op registry')
+        nodes.append(node)
+
+    return {'name': Path(path).stem, 'tensors': tensors, 'nodes': nodes,
+            'input': tensor_ids[aliases.get(graph_input, graph_input)], 'output': nodes[-1]['output']}
+
+
+# ---------------------------------------------------------------------------
+# Legacy model_weights.h (ds_cnn_tiny_v2)
+# ---------------------------------------------------------------------------
+
+# Requantization hand-tuned on synthetic features for the weights in the
+# legacy header (it has no activation scales): (q31 multiplier, shift) per
+# layer, and the real value of one dense-layer accumulator unit. Not derived
+# from the trained model; graphs built from it are marked placeholder_scales.
+LEGACY_CALIBRATION = {
+    'conv2d': (1244122582, -6),
+    'b1_dw': (1887948562, -7),
+    'b1_pw': (1643120239, -7),
+    'b2_dw': (1617488549, -7),
+    'b2_pw': (1173747719, -6),
+    'b3_dw': (1498308458, -7),
+    'b3_pw': (1829410577, -7),
+    'logit_scale': 7.2191e-05,
+}
+LEGACY_ACTIVATION_ZERO_POINT = -128
+
+
+def graph_from_legacy_header(path, frames=65, coefficients=10):
+    text = Path(path).read_text()
+    arrays = {}
+    for m in re.finditer(r'const (\w+) (\w+)\[\] = \{([^}]*)\};\s*// Shape: \[([^\]]*)\]', text):
+        values = [int(v) for v in m.group(3).replace('\n', ' ').split(',') if v.strip()]
+        shape = [int(v) for v in m.group(4).split()]
+        arrays[m.group(2).replace('ds_cnn_tiny_v2_', '')] = (values, shape)
+    scalars = dict(re.findall(r'const \w+ (input_scale|input_zero_point) = ([-0-9.e]+)f?;', text))
+
+    act = LEGACY_ACTIVATION_ZERO_POINT
+    tensors = [make_tensor('input', [frames, coefficients, 1], 'int8',
+                           float(scalars['input_scale']), int(scalars['input_zero_point']))]
+    nodes = []
+
+    def add(op, output_tensor, **fields):
+        tensors.append(output_tensor)
+        node = {'op': op, 'input': len(tensors) - 2, 'output': len(tensors) - 1}
+        node.update(fields)
+        nodes.append(node)
+
+    def conv_fields(weights, bias, calibration, **extra):
+        multiplier, shift = LEGACY_CALIBRATION[calibration]
+        fields = {'weights': arrays[weights][0], 'bias': arrays[bias][0],
+                  'multiplier': [multiplier], 'shift': [shift], 'activation': 'relu'}
+        fields.update(extra)
+        return fields
+
+    h, w = (frames + 1) // 2, (coefficients + 1) // 2
+    channels = arrays['conv2d_Conv2D'][1][0]
+    add('conv2d', make_tensor('conv', [h, w, channels], 'int8', 1.0, act),
+        **conv_fields('conv2d_Conv2D', 'batch_normalization_FusedBatchNormV3', 'conv2d',
+                      kernel=[3, 3], stride=[2, 2],
+                      padding=[same_padding(frames, h, 3, 2), same_padding(coefficients, w, 3, 2)]))
+    bn = 1
+    for block in (1, 2, 3):
+        add('depthwise', make_tensor(f'b{block}_dw', [h, w, channels], 'int8', 1.0, act),
+            **conv_fields(f'b{block}_dw_depthwise', f'batch_normalization_{bn}_FusedBatchNormV3', f'b{block}_dw',
+                          kernel=[3, 3], stride=[1, 1], padding=[1, 1]))
+        channels = arrays[f'b{block}_pw_Conv2D'][1][0]
+        add('pointwise', make_tensor(f'b{block}_pw', [h, w, channels], 'int8', 1.0, act),
+            **conv_fields(f'b{block}_pw_Conv2D', f'batch_normalization_{bn + 1}_FusedBatchNormV3', f'b{block}_pw'))
+        bn += 2
+    add('avgpool', make_tensor('pool', [channels], 'int8', 1.0, act))
+    classes = len(arrays['dense_BiasAdd_ReadVariableOp'][0])
+    add('fully_connected', make_tensor('logits', [classes], 'float32'),
+        weights=arrays['dense_MatMul'][0], bias=arrays['dense_BiasAdd_ReadVariableOp'][0],
+        output_scale=LEGACY_CALIBRATION['logit_scale'])
+    add('softmax', make_tensor('probabilities', [classes], 'float32'))
+    return {'name': 'ds_cnn_tiny_v2', 'tensors': tensors, 'nodes': nodes, 'input': 0, 'output': len(tensors) - 1,
+            'placeholder_scales': True}
+
+
+# ---------------------------------------------------------------------------
+# Mixed precision (--int4)
+# ---------------------------------------------------------------------------
+
+INT4_OPS = ('conv2d', 'depthwise', 'pointwise')
+
+
+def round_half_away(x):
+    return int(math.copysign(math.floor(abs(x) + 0.5), x))
+
+
+def weight_channels(node, out_channels):
+    """Output channel of every weight, in the node's flat layout."""
+    count = len(node['weights'])
+    if node['op'] == 'depthwise':
+        return [i % out_channels for i in range(count)]
+    per_channel = count // out_channels
+    return [i // per_channel for i in range(count)]
+
+
+def quantize_int4(node, out_channels):
+    """Requantize a layer's int8 weights to int4 with one scale per output
+    channel. The scale folds into that channel's multiplier and bias, so
+    the kernels only see smaller integers."""
+    channels = weight_channels(node, out_channels)
+    peak = [0] * out_channels
+    for w, c in zip(node['weights'], channels):
+        peak[c] = max(peak[c], abs(w))
+    scale = [p / 7.0 if p else 1.0 for p in peak]
+    node['weights'] = [max(-8, min(7, round_half_away(w / scale[c]))) for w, c in zip(node['weights'], channels)]
+    multipliers, shifts = node['multiplier'], node['shift']
+    if len(multipliers) == 1:
+        multipliers, shifts = multipliers * out_channels, shifts * out_channels
+    requantized = [quantize_multiplier(m * 2.0 ** s / 2 ** 31 * scale[c])
+                   for c, (m, s) in enumerate(zip(multipliers, shifts))]
+    node['multiplier'] = [m for m, _ in requantized]
+    node['shift'] = [s for _, s in requantized]
+    node['bias'] = [round_half_away(b / scale[c]) for c, b in enumerate(node['bias'])]
+    node['weight_bits'] = 4
+    node.pop('weight_scale', None)  # Describes the int8 weights only
+
+
+def apply_precision(graph, spec):
+    """spec: comma-separated op kinds (conv2d, depthwise, pointwise), output
+    tensor names, or `all`; the matching layers get int4 weights."""
+    wanted = {item.strip() for item in spec.split(',') if item.strip()}
+    matched = set()
+    for node in graph['nodes']:
+        name = graph['tensors'][node['output']]['name']
+        hits = {item for item in wanted if item in (node['op'], name)}
+        if 'all' in wanted and node['op'] in INT4_OPS:
+            hits.add('all')
+        if not hits:
+            continue
+        matched |= hits
+        if node['op'] not in INT4_OPS:
+            raise SystemExit(f'{name}: int4 weights are only supported for {", ".join(INT4_OPS)}')
+        if node.get('weight_bits', 8) == 8:
+            quantize_int4(node, graph['tensors'][node['output']]['shape'][2])
+    if wanted - matched:
+        raise SystemExit(f'--int4: no layer matches {", ".join(sorted(wanted - matched))}')
+
+
+def pack_weights(node):
+    """Weight bytes as stored: int4 values two per byte, low nibble first."""
+    weights = node.get('weights', [])
+    if node.get('weight_bits', 8) == 8:
+        return weights
+    return pack_int4(weights)
+
+
+def pack_int4(values):
+    values = list(values) + [0] * (len(values) % 2)
+    packed = [(values[i] & 0xF) | ((values[i + 1] & 0xF) << 4) for i in range(0, len(values), 2)]
+    return [b - 256 if b > 127 else b for b in packed]
+
+
+def precision_summary(graph):
+    layers = [node for node in graph['nodes'] if node.get('weights')]
+    bits = '/'.join(str(node.get('weight_bits', 8)) for node in layers)
+    total = sum(len(pack_weights(node)) for node in layers)
+    return f'weights {bits} bits, {total} bytes'
+
+
+# ---------------------------------------------------------------------------
+# Binary graph (--blob), loadable at run time on the host
+# ---------------------------------------------------------------------------
+#
+# Little endian: header, tensors, nodes, then the weight bytes (padded to 4),
+# biases, multipliers and shifts. tools/host/common/GraphFile.cpp reads it.
+
+BLOB_MAGIC = b'KWSG'
+BLOB_VERSION = 2
+BLOB_PLACEHOLDER_SCALES = 1  # Header flag bit
+
+
+def write_blob(graph, path):
+    weights, biases, multipliers, shifts, nodes = [], [], [], [], []
+    for node in graph['nodes']:
+        kernel = node.get('kernel', [1, 1])
+        stride = node.get('stride', [1, 1])
+        padding = node.get('padding', [0, 0])
+        nodes.append(struct.pack(
+            '<12BIIIf', OPS.index(node['op']), 1 if node.get('activation') == 'relu' else 0,
+            kernel[0], kernel[1], stride[0], stride[1], padding[0], padding[1],
+            1 if len(node.get('multiplier', [])) > 1 else 0, node.get('weight_bits', 8),
+            node['input'], node['output'], len(weights), len(biases), len(multipliers),
+            node.get('output_scale', 0.0)))
+        weights += pack_weights(node)
+        biases += node.get('bias', [])
+        multipliers += node.get('multiplier', [])
+        shifts += node.get('shift', [])
+    tensors = [struct.pack('<HHHBxifI', *t['shape'], 1 if t['dtype'] == 'float32' else 0, t['zero_point'],
+                           t['scale'], t['arena_offset']) for t in graph['tensors']]
+    weights += [0] * (-len(weights) % 4)
+    flags = BLOB_PLACEHOLDER_SCALES if graph.get('placeholder_scales') else 0
+    header = struct.pack('<4s10I32s', BLOB_MAGIC, BLOB_VERSION, len(tensors), len(nodes), graph['input'],
+                         graph['output'], graph['arena_size'], len(weights), len(biases), len(multipliers), flags,
+                         graph['name'].encode()[:31])
+    path.write_bytes(header + b''.join(tensors) + b''.join(nodes) + struct.pack(f'<{len(weights)}b', *weights)
+                     + struct.pack(f'<{len(biases)}i', *biases) + struct.pack(f'<{len(multipliers)}i', *multipliers)
+                     + struct.pack(f'<{len(shifts)}b', *shifts))
+
+
+# ---------------------------------------------------------------------------
+# Planning and emission
+# ---------------------------------------------------------------------------
+
+def tensor_bytes(tensor):
+    h, w, c = tensor['shape']
+    return h * w * c * (4 if tensor['dtype'] == 'float32' else 1)
+
+
+def plan_arena(graph):
+    """Greedy first-fit by size over tensor lifetimes (node indices)."""
+    tensors, nodes = graph['tensors'], graph['nodes']
+    first = {graph['input']: -1}
+    last = {graph['output']: len(nodes)}
+    for i, node in enumerate(nodes):
+        first.setdefault(node['output'], i)
+        last[node['input']] = max(last.get(node['input'], i), i)
+    placed = []
+    order = sorted(first, key=lambda t: -tensor_bytes(tensors[t]))
+    for t in order:
+        size = tensor_bytes(tensors[t])
+        begin, end = first[t], last.get(t, first[t])
+        offset = 0
+        for other, other_offset in sorted(placed, key=lambda p: p[1]):
+            o_begin, o_end = first[other], last.get(other, first[other])
+            if o_end < begin or end < o_begin:
                 continue
+            if offset + size <= other_offset:
+                break
+            offset = max(offset, other_offset + tensor_bytes(tensors[other]))
+            offset = (offset + ARENA_ALIGNMENT - 1) // ARENA_ALIGNMENT * ARENA_ALIGNMENT
+        tensors[t]['arena_offset'] = offset
+        placed.append((t, offset))
+    graph['arena_size'] = max(t['arena_offset'] + tensor_bytes(t) for t in tensors)
+    return graph
+
+
+def c_array(ctype, name, values, per_line=16, qualifier='const'):
+    lines = [f'static {qualifier} {ctype} {name}[] = {{']
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(str(v) for v in values[i:i + per_line]) + ',')
+    if not values:
+        lines.append('    0,')
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def write_sources(graph, output_dir, source, symbol='model_graph'):
+    weights, biases, multipliers, shifts = [], [], [], []
+    node_rows = []
+    for node in graph['nodes']:
+        kernel = node.get('kernel', [1, 1])
+        stride = node.get('stride', [1, 1])
+        padding = node.get('padding', [0, 0])
+        w_offset, b_offset, q_offset = len(weights), len(biases), len(multipliers)
+        weights += pack_weights(node)
+        biases += node.get('bias', [])
+        multipliers += node.get('multiplier', [])
+        shifts += node.get('shift', [])
+        per_channel = 1 if len(node.get('multiplier', [])) > 1 else 0
+        activation = 'ACT_RELU' if node.get('activation') == 'relu' else 'ACT_NONE'
+        node_rows.append(
+            f'    {{OP_{node["op"].upper()}, {activation}, {kernel[0]}, {kernel[1]}, {stride[0]}, {stride[1]}, '
+            f'{padding[0]}, {padding[1]}, {per_channel}, {node.get("weight_bits", 8)}, {node["input"]}, {node["output"]}, '
+            f'{w_offset}, {b_offset}, {q_offset}, {node.get("output_scale", 0.0)!r}f}},')
+
+    tensor_rows = []
+    for t in graph['tensors']:
+        h, w, c = t['shape']
+        dtype = 'TYPE_FLOAT32' if t['dtype'] == 'float32' else 'TYPE_INT8'
+        tensor_rows.append(f'    {{{h}, {w}, {c}, {dtype}, {t["zero_point"]}, {t["scale"]!r}f, '
+                           f'{t["arena_offset"]}}}, // {t["name"]}')
+
+    header = f'''// Generated by tools/model_converter.py from {source}. Do not edit.
+#pragma once
+#include "Graph.h"
+
+// Bytes of activation arena one window needs (tensor offsets are planned).
+#define {symbol.upper()}_ARENA_SIZE {graph["arena_size"]}
+
+extern const GraphModel {symbol};
+'''
+    body = f'''// Generated by tools/model_converter.py from {source}. Do not edit.
+#include "{symbol}.h"
+
+{c_array('int8_t', 'graph_weights', weights)}
+
+{c_array('int32_t', 'graph_biases', biases, 8)}
+
+{c_array('int32_t', 'graph_multipliers', multipliers, 8)}
+
+{c_array('int8_t', 'graph_shifts', shifts)}
+
+// h, w, c, type, zero point, scale, arena offset
+static const GraphTensor graph_tensors[] = {{
+{chr(10).join(tensor_rows)}
+}};
+
+// op, activation, kernel h/w, stride h/w, pad top/left, per-channel, weight
+// bits, input, output, weight/bias/quant offsets, output scale
+static const GraphNode graph_nodes[] = {{
+{chr(10).join(node_rows)}
+}};
+
+const GraphModel {symbol} = {{
+    "{graph["name"]}",
+    graph_tensors, {len(graph["tensors"])},
+    graph_nodes, {len(graph["nodes"])},
+    {graph["input"]}, {graph["output"]},
+    graph_weights, graph_biases, graph_multipliers, graph_shifts,
+    {symbol.upper()}_ARENA_SIZE,
+    {'true' if graph.get('placeholder_scales') else 'false'}, // Placeholder activation scales
+}};
+'''
+    (output_dir / f'{symbol}.h').write_text(header)
+    (output_dir / f'{symbol}.cpp').write_text(body)
+
+
+# ---------------------------------------------------------------------------
+# Ahead-of-time C++ (--aot)
+# ---------------------------------------------------------------------------
+#
+# One function per node with every shape, stride, zero point and multiplier
+# as a literal. Weights are repacked so the innermost loop runs over output
+# channels (contiguous, constant trip count), and the input zero point is
+# folded into the bias wherever no padding is involved. The integer math is
+# the interpreter's, so results are bit-exact with it.
+
+def c_identifier(name, used, prefix='aot_'):
+    ident = prefix + re.sub(r'\W', '_', name).strip('_').lower()
+    while ident in used:
+        ident += '_'
+    used.add(ident)
+    return ident
+
+
+def offset_expr(zero_point):
+    """The `- zero_point` of `x - zero_point`, without a double negative."""
+    return f'+ {-zero_point}' if zero_point < 0 else f'- {zero_point}'
+
+
+def requant_expr(fn, node, out, acc, channel):
+    low = out['zero_point'] if node.get('activation') == 'relu' else -128
+    if len(node['multiplier']) > 1:
+        return f'requantize({acc}, {fn}_multipliers[{channel}], {fn}_shifts[{channel}], {out["zero_point"]}, {low})'
+    return f'requantize({acc}, {node["multiplier"][0]}, {node["shift"][0]}, {out["zero_point"]}, {low})'
+
+
+def quant_arrays(fn, node):
+    if len(node['multiplier']) <= 1:
+        return []
+    return [c_array('int32_t', f'{fn}_multipliers', node['multiplier'], 8, 'constexpr'),
+            c_array('int8_t', f'{fn}_shifts', node['shift'], 16, 'constexpr')]
+
+
+def folded_bias(node, zero_point, inputs):
+    """bias - zero_point * sum(w): lets the kernel accumulate raw x * w."""
+    weights = node['weights']
+    return [b - zero_point * sum(weights[o * inputs:(o + 1) * inputs]) for o, b in enumerate(node['bias'])]
+
+
+SPATIAL_TEMPLATE = '''static void {fn}(const int8_t* input, int8_t* output, int windows, int part, int parts) {{
+    int row_begin, row_end;
+    DualCore::split({oh}, part, parts, row_begin, row_end);
+    for (int b = 0; b < windows; b++) {{
+        const int8_t* in = input + b * {in_bytes};
+        int8_t* out = output + b * {out_bytes};
+        for (int oy = row_begin; oy < row_end; oy++) {{
+            const int iy0 = oy * {sh} - {pt};
+            const int ky_begin = iy0 < 0 ? -iy0 : 0;
+            const int ky_end = iy0 + {kh} > {ih} ? {ih} - iy0 : {kh};
+            for (int ox = 0; ox < {ow}; ox++) {{
+                const int ix0 = ox * {sw} - {pl};
+                const int kx_begin = ix0 < 0 ? -ix0 : 0;
+                const int kx_end = ix0 + {kw} > {iw} ? {iw} - ix0 : {kw};
+                int32_t acc[{oc}];
+                for (int c = 0; c < {oc}; c++) acc[c] = {fn}_bias[c];
+                for (int ky = ky_begin; ky < ky_end; ky++) {{
+                    for (int kx = kx_begin; kx < kx_end; kx++) {{
+                        const int8_t* src = in + ((iy0 + ky) * {iw} + ix0 + kx) * {ic};
+{taps}
+                    }}
+                }}
+                int8_t* px = out + (oy * {ow} + ox) * {oc};
+                for (int c = 0; c < {oc}; c++) px[c] = {requant};
+            }}
+        }}
+    }}
+}}'''
+
+CONV_TAPS = '''                        const int tap = (ky * {kw} + kx) * {tap};
+                        for (int i = 0; i < {ic}; i++) {{
+                            const int32_t x = src[i] {zp};
+                            for (int c = 0; c < {oc}; c++) acc[c] += x * {weight};
+                        }}'''
+
+DEPTHWISE_TAPS = '''                        const int tap = (ky * {kw} + kx) * {oc};
+                        for (int c = 0; c < {oc}; c++) acc[c] += (src[c] {zp}) * {weight};'''
+
+
+def weight_read(fn, node, index):
+    """C expression for one weight; int4 layers unpack in the MAC loop."""
+    if node.get('weight_bits', 8) == 4:
+        return f'unpackInt4({fn}_weights, {index})'
+    return f'{fn}_weights[{index}]'
+
+
+def weight_array(fn, node, weights):
+    if node.get('weight_bits', 8) == 4:
+        weights = pack_int4(weights)
+    return c_array('int8_t', f'{fn}_weights', weights, 16, 'constexpr')
+
+
+def aot_spatial(fn, node, tin, tout):
+    ih, iw, ic = tin['shape']
+    oh, ow, oc = tout['shape']
+    kh, kw = node['kernel']
+    weights = node['weights']
+    if node['op'] == 'depthwise':
+        taps = DEPTHWISE_TAPS.format(kw=kw, oc=oc, zp=offset_expr(tin['zero_point']),
+                                     weight=weight_read(fn, node, 'tap + c'))
+    else:
+        # [out][ky][kx][in] -> [ky][kx][in][out]
+        weights = [weights[((o * kh + y) * kw + x) * ic + i]
+                   for y in range(kh) for x in range(kw) for i in range(ic) for o in range(oc)]
+        taps = CONV_TAPS.format(kw=kw, tap=ic * oc, ic=ic, oc=oc, zp=offset_expr(tin['zero_point']),
+                                weight=weight_read(fn, node, f'tap + i * {oc} + c'))
+    body = SPATIAL_TEMPLATE.format(
+        fn=fn, ih=ih, iw=iw, ic=ic, oh=oh, ow=ow, oc=oc, kh=kh, kw=kw,
+        sh=node['stride'][0], sw=node['stride'][1], pt=node['padding'][0], pl=node['padding'][1],
+        in_bytes=ih * iw * ic, out_bytes=oh * ow * oc, taps=taps,
+        requant=requant_expr(fn, node, tout, 'acc[c]', 'c'))
+    data = [weight_array(fn, node, weights),
+            c_array('int32_t', f'{fn}_bias', node['bias'], 8, 'constexpr')] + quant_arrays(fn, node)
+    return data, body, True
+
+
+POINTWISE_TEMPLATE = '''static void {fn}(const int8_t* input, int8_t* output, int windows, int part, int parts) {{
+    int row_begin, row_end;
+    DualCore::split(windows * {positions}, part, parts, row_begin, row_end);
+    for (int r = row_begin; r < row_end; r++) {{
+        const int8_t* in = input + r * {ic};
+        int32_t acc[{oc}];
+        for (int c = 0; c < {oc}; c++) acc[c] = {fn}_bias[c];
+        for (int i = 0; i < {ic}; i++) {{
+            const int32_t x = in[i];
+            const int row = i * {oc};
+            for (int c = 0; c < {oc}; c++) acc[c] += x * {weight};
+        }}
+        int8_t* out = output + r * {oc};
+        for (int c = 0; c < {oc}; c++) out[c] = {requant};
+    }}
+}}'''
+
+
+def aot_pointwise(fn, node, tin, tout):
+    h, w, ic = tin['shape']
+    oc = tout['shape'][2]
+    # [out][in] -> [in][out]
+    weights = [node['weights'][o * ic + i] for i in range(ic) for o in range(oc)]
+    body = POINTWISE_TEMPLATE.format(fn=fn, positions=h * w, ic=ic, oc=oc, weight=weight_read(fn, node, 'row + c'),
+                                     requant=requant_expr(fn, node, tout, 'acc[c]', 'c'))
+    data = [weight_array(fn, node, weights),
+            c_array('int32_t', f'{fn}_bias', folded_bias(node, tin['zero_point'], ic), 8, 'constexpr')]
+    return data + quant_arrays(fn, node), body, True
+
+
+AVGPOOL_TEMPLATE = '''static void {fn}(const int8_t* input, int8_t* output, int windows, int, int) {{
+    for (int b = 0; b < windows; b++) {{
+        const int8_t* in = input + b * {in_bytes};
+        int8_t* out = output + b * {c};
+        int32_t sum[{c}] = {{0}};
+        for (int p = 0; p < {positions}; p++) {{
+            for (int c = 0; c < {c}; c++) sum[c] += in[p * {c} + c];
+        }}
+        for (int c = 0; c < {c}; c++) {{
+            int32_t mean = sum[c] >= 0 ? (sum[c] + {half}) / {positions} : -((-sum[c] + {half}) / {positions});
+            out[c] = (int8_t)(mean < -128 ? -128 : mean > 127 ? 127 : mean);
+        }}
+    }}
+}}'''
+
+
+def aot_avgpool(fn, node, tin, tout):
+    h, w, c = tin['shape']
+    body = AVGPOOL_TEMPLATE.format(fn=fn, in_bytes=h * w * c, c=c, positions=h * w, half=h * w // 2)
+    return [], body, False
+
+
+FULLY_CONNECTED_TEMPLATE = '''static void {fn}(const int8_t* input, int8_t* output, int windows, int, int) {{
+    for (int b = 0; b < windows; b++) {{
+        const int8_t* in = input + b * {inputs};
+        float* logits = reinterpret_cast<float*>(output) + b * {outputs};
+        for (int k = 0; k < {outputs}; k++) {{
+            int32_t acc = {fn}_bias[k];
+            const int8_t* w = {fn}_weights + k * {inputs};
+            for (int i = 0; i < {inputs}; i++) acc += in[i] * w[i];
+            logits[k] = acc * {scale}f;
+        }}
+    }}
+}}'''
+
+
+def aot_fully_connected(fn, node, tin, tout):
+    inputs = tensor_bytes(tin)
+    outputs = tout['shape'][2]
+    body = FULLY_CONNECTED_TEMPLATE.format(fn=fn, inputs=inputs, outputs=outputs, scale=repr(node['output_scale']))
+    data = [c_array('int8_t', f'{fn}_weights', node['weights'], 16, 'constexpr'),
+            c_array('int32_t', f'{fn}_bias', folded_bias(node, tin['zero_point'], inputs), 8, 'constexpr')]
+    return data, body, False
+
+
+SOFTMAX_TEMPLATE = '''static void {fn}(const int8_t* input, int8_t* output, int windows, int, int) {{
+    for (int b = 0; b < windows; b++) {{
+        const float* logits = reinterpret_cast<const float*>(input) + b * {classes};
+        float* probabilities = reinterpret_cast<float*>(output) + b * {classes};
+        float max_logit = -INFINITY;
+        for (int k = 0; k < {classes}; k++) {{
+            if (logits[k] > max_logit) max_logit = logits[k];
+        }}
+        float total = 0.0f;
+        for (int k = 0; k < {classes}; k++) {{
+            probabilities[k] = expf(logits[k] - max_logit);
+            total += probabilities[k];
+        }}
+        for (int k = 0; k < {classes}; k++) probabilities[k] /= total;
+    }}
+}}'''
+
+
+def aot_softmax(fn, node, tin, tout):
+    return [], SOFTMAX_TEMPLATE.format(fn=fn, classes=tout['shape'][2]), False
+
+
+AOT_EMITTERS = {
+    'conv2d': aot_spatial,
+    'depthwise': aot_spatial,
+    'pointwise': aot_pointwise,
+    'avgpool': aot_avgpool,
+    'fully_connected': aot_fully_connected,
+    'softmax': aot_softmax,
+}
+
+AOT_HEADER = '''// Generated by tools/model_converter.py --aot from {source}. Do not edit.
+#pragma once
+#include <cstdint>
+#include "DualCore.h"
+
+#define MODEL_AOT_NAME "{name}"
+#define MODEL_AOT_ARENA_SIZE {arena_size} // Bytes per window
+#define MODEL_AOT_INPUT_H {h}
+#define MODEL_AOT_INPUT_W {w}
+#define MODEL_AOT_INPUT_C {c}
+#define MODEL_AOT_INPUT_SCALE {scale}f
+#define MODEL_AOT_INPUT_ZERO_POINT {zero_point}
+#define MODEL_AOT_OUTPUTS {outputs}
+#define MODEL_AOT_PLACEHOLDER_SCALES {placeholder} // 1: activation scales are stand-ins
+
+// Runs `windows` feature windows through the network. `arena` holds
+// windows * MODEL_AOT_ARENA_SIZE bytes, 16-byte aligned; outputs is
+// [windows][MODEL_AOT_OUTPUTS]. Convolutions are split by rows through
+// dual_core (inline unless its helper is running).
+void model_aot_run(const int8_t* const* inputs, int windows, int8_t* arena, float* outputs, DualCore& dual_core);
+'''
+
+AOT_SOURCE = '''// Generated by tools/model_converter.py --aot from {source}. Do not edit.
+#include "model_aot.h"
+#include <cmath>
+#include <cstring>
+#include "Quantize.h"
+#include "Trace.h"
+
+typedef void (*AotLayer)(const int8_t* input, int8_t* output, int windows, int part, int parts);
+
+{sections}
+
+struct AotCall {{
+    AotLayer layer;
+    const int8_t* input;
+    int8_t* output;
+    int windows;
+}};
+
+static void runPart(void* context, int part, int parts) {{
+    const AotCall& call = *static_cast<const AotCall*>(context);
+    call.layer(call.input, call.output, call.windows, part, parts);
+}}
+
+static void runSplit(DualCore& dual_core, AotLayer layer, const int8_t* input, int8_t* output, int windows) {{
+    AotCall call = {{layer, input, output, windows}};
+    dual_core.run(runPart, &call);
+}}
+
+void model_aot_run(const int8_t* const* inputs, int windows, int8_t* arena, float* outputs, DualCore& dual_core) {{
+    for (int b = 0; b < windows; b++) {{
+        memcpy(arena + {input_offset} * windows + b * {input_bytes}, inputs[b], {input_bytes});
+    }}
+{calls}
+    memcpy(outputs, arena + {output_offset} * windows, windows * {output_bytes});
+}}
+'''
+
+
+def write_aot(graph, output_dir, source):
+    tensors = graph['tensors']
+    tin, tout = tensors[graph['input']], tensors[graph['output']]
+    if tout['dtype'] != 'float32':
+        raise SystemExit('--aot expects float probabilities out')
+
+    used, sections, calls = set(), [], []
+    for node in graph['nodes']:
+        fn = c_identifier(tensors[node['output']]['name'], used)
+        data, body, splittable = AOT_EMITTERS[node['op']](fn, node, tensors[node['input']], tensors[node['output']])
+        sections.append('\n\n'.join(data + [body]))
+        src = f'arena + {tensors[node["input"]]["arena_offset"]} * windows'
+        dst = f'arena + {tensors[node["output"]]["arena_offset"]} * windows'
+        run = f'runSplit(dual_core, {fn}, {src}, {dst}, windows)' if splittable else \
+            f'{fn}({src}, {dst}, windows, 0, 1)'
+        calls.append(f'    {{\n        TRACE_SPAN("{fn}");\n        {run};\n    }}')
+
+    h, w, c = tin['shape']
+    (output_dir / 'model_aot.h').write_text(AOT_HEADER.format(
+        source=source, name=graph['name'], arena_size=graph['arena_size'], h=h, w=w, c=c,
+        scale=repr(tin['scale']), zero_point=tin['zero_point'], outputs=tout['shape'][2],
+        placeholder=1 if graph.get('placeholder_scales') else 0))
+    (output_dir / 'model_aot.cpp').write_text(AOT_SOURCE.format(
+        source=source, sections='\n\n'.join(sections), calls='\n'.join(calls),
+        input_offset=tin['arena_offset'], input_bytes=tensor_bytes(tin),
+        output_offset=tout['arena_offset'], output_bytes=tensor_bytes(tout)))
+
+# ---------------------------------------------------------------------------
+# Float reference (--reference, --golden)
+# ---------------------------------------------------------------------------
+# The same network with the int8 weights dequantized and float activations
+# throughout (no requantization, no saturation): what the quantized model
+# approximates. Weights and biases are dequantized with the weight scales
+# and input tensor scales the .tflite export stores (a bias is quantized
+# with input scale * weight scale), so a wrong multiplier in the graph shows
+# up as error instead of cancelling out. A graph without weight scales can
+# only have them recovered from its own requantization (multiplier = input
+# scale * weight scale / output scale): that reference shares the graph's
+# calibration, so it checks the kernels, not the quantization.
+
+def reference_params(graph, recover=False):
+    """Real weights and biases of every node (None for weightless ops)."""
+    params = []
+    for node in graph['nodes']:
+        if not node.get('weights'):
+            params.append(None)
+            continue
+        tin, tout = graph['tensors'][node['input']], graph['tensors'][node['output']]
+        channels = tout['shape'][2]
+        if 'weight_scale' in node:
+            scales = node['weight_scale']
+            scales = scales * channels if len(scales) == 1 else scales
+        elif not recover:
+            raise SystemExit(f'{tout["name"]}: no weight scales to dequantize with; build --reference from the '
+                             '.tflite export (or its model_graph.json, before --int4)')
+        elif node['op'] == 'fully_connected':
+            scales = [node['output_scale'] / tin['scale']] * channels
+        else:
+            multipliers, shifts = node['multiplier'], node['shift']
+            if len(multipliers) == 1:
+                multipliers, shifts = multipliers * channels, shifts * channels
+            scales = [m * 2.0 ** s / 2 ** 31 * tout['scale'] / tin['scale'] for m, s in zip(multipliers, shifts)]
+        owners = weight_channels(node, channels)
+        params.append({'weights': [w * scales[c] for w, c in zip(node['weights'], owners)],
+                       'bias': [b * tin['scale'] * scales[c] for c, b in enumerate(node['bias'])]})
+    return params
+
+
+def reference_forward(graph, params, window):
+    """Every node's float output ([h][w][c], flat) for one int8 input window."""
+    tin = graph['tensors'][graph['input']]
+    x = [(q - tin['zero_point']) * tin['scale'] for q in window]
+    layers = []
+    for node, p in zip(graph['nodes'], params):
+        ih, iw, ic = graph['tensors'][node['input']]['shape']
+        oh, ow, oc = graph['tensors'][node['output']]['shape']
+        op, relu = node['op'], node.get('activation') == 'relu'
+        if op in ('conv2d', 'depthwise', 'pointwise'):
+            kh, kw = node.get('kernel', [1, 1])
+            sh, sw = node.get('stride', [1, 1])
+            pt, pl = node.get('padding', [0, 0])
+            w, b = p['weights'], p['bias']
+            y = []
+            for oy in range(oh):
+                for ox in range(ow):
+                    for o in range(oc):
+                        acc = b[o]
+                        for ky in range(kh):
+                            iy = oy * sh - pt + ky
+                            if not 0 <= iy < ih:
+                                continue
+                            for kx in range(kw):
+                                ix = ox * sw - pl + kx
+                                if not 0 <= ix < iw:
+                                    continue
+                                base = (iy * iw + ix) * ic
+                                if op == 'depthwise':
+                                    acc += x[base + o] * w[(ky * kw + kx) * oc + o]
+                                else:
+                                    row = ((o * kh + ky) * kw + kx) * ic
+                                    acc += sum(x[base + i] * w[row + i] for i in range(ic))
+                        y.append(max(acc, 0.0) if relu else acc)
+        elif op == 'avgpool':
+            positions = ih * iw
+            y = [sum(x[q * ic + c] for q in range(positions)) / positions for c in range(ic)]
+        elif op == 'fully_connected':
+            n = len(x)
+            y = [p['bias'][k] + sum(x[i] * p['weights'][k * n + i] for i in range(n)) for k in range(oc)]
+        else:  # softmax
+            peak = max(x)
+            e = [math.exp(v - peak) for v in x]
+            y = [v / sum(e) for v in e]
+        layers.append(y)
+        x = y
+    return layers
+
+
+GOLDEN_MAGIC = b'KWSR'
+GOLDEN_VERSION = 1
+
+
+def write_golden(graph, params, features_path, path):
+    """Per-layer reference activations for the int8 windows in a features
+    file (quant_check --dump-features). Layout (little endian): "KWSR",
+    version, windows, input bytes, layers (u32); elements per layer (u32);
+    then per window its input (int8) and every layer's output (f32)."""
+    tin = graph['tensors'][graph['input']]
+    size = tensor_bytes(tin)
+    data = Path(features_path).read_bytes()
+    if not data or len(data) % size:
+        raise SystemExit(f'{features_path}: not a whole number of {size}-byte input windows')
+    windows = [struct.unpack(f'{size}b', data[i:i + size]) for i in range(0, len(data), size)]
+    sizes = [math.prod(graph['tensors'][node['output']]['shape']) for node in graph['nodes']]
+    with open(path, 'wb') as f:
+        f.write(struct.pack('<4s4I', GOLDEN_MAGIC, GOLDEN_VERSION, len(windows), size, len(sizes)))
+        f.write(struct.pack(f'<{len(sizes)}I', *sizes))
+        for window in windows:
+            f.write(struct.pack(f'{size}b', *window))
+            for layer in reference_forward(graph, params, window):
+                f.write(struct.pack(f'<{len(layer)}f', *layer))
+    return len(windows)
+
+
+def c_float(value):
+    text = f'{value:.9g}'
+    return text + ('f' if '.' in text or 'e' in text else '.0f')
+
+
+def c_floats(values):
+    return [c_float(v) for v in values]
+
+
+def reference_arrays(fn, p):
+    return [c_array('float', f'{fn}_weights', c_floats(p['weights']), 8),
+            c_array('float', f'{fn}_bias', c_floats(p['bias']), 8)]
+
+
+def reference_activation(node):
+    return 'acc > 0.0f ? acc : 0.0f' if node.get('activation') == 'relu' else 'acc'
+
+
+REF_SPATIAL_TEMPLATE = '''static void {fn}(const float* input, float* output) {{
+    for (int y = 0; y < {oh}; y++) {{
+        for (int x = 0; x < {ow}; x++) {{
+            for (int o = 0; o < {oc}; o++) {{
+                float acc = {fn}_bias[o];
+                for (int ky = 0; ky < {kh}; ky++) {{
+                    const int iy = y * {sh} - {pt} + ky;
+                    if (iy < 0 || iy >= {ih}) continue;
+                    for (int kx = 0; kx < {kw}; kx++) {{
+                        const int ix = x * {sw} - {pl} + kx;
+                        if (ix < 0 || ix >= {iw}) continue;
+{taps}
+                    }}
+                }}
+                output[(y * {ow} + x) * {oc} + o] = {activation};
+            }}
+        }}
+    }}
+}}'''
+
+REF_CONV_TAPS = '''                        const float* in = input + (iy * {iw} + ix) * {ic};
+                        const float* w = {fn}_weights + ((o * {kh} + ky) * {kw} + kx) * {ic};
+                        for (int i = 0; i < {ic}; i++) acc += in[i] * w[i];'''
+
+REF_DEPTHWISE_TAPS = '''                        acc += input[(iy * {iw} + ix) * {oc} + o] * {fn}_weights[(ky * {kw} + kx) * {oc} + o];'''
+
+
+def ref_spatial(fn, node, tin, tout, p):
+    ih, iw, ic = tin['shape']
+    oh, ow, oc = tout['shape']
+    kh, kw = node['kernel']
+    fields = dict(fn=fn, ih=ih, iw=iw, ic=ic, oh=oh, ow=ow, oc=oc, kh=kh, kw=kw,
+                  sh=node['stride'][0], sw=node['stride'][1], pt=node['padding'][0], pl=node['padding'][1])
+    taps = (REF_CONV_TAPS if node['op'] == 'conv2d' else REF_DEPTHWISE_TAPS).format(**fields)
+    return reference_arrays(fn, p), REF_SPATIAL_TEMPLATE.format(taps=taps, activation=reference_activation(node),
+                                                                **fields)
+
+
+REF_POINTWISE_TEMPLATE = '''static void {fn}(const float* input, float* output) {{
+    for (int p = 0; p < {positions}; p++) {{
+        for (int o = 0; o < {oc}; o++) {{
+            float acc = {fn}_bias[o];
+            for (int i = 0; i < {ic}; i++) acc += input[p * {ic} + i] * {fn}_weights[o * {ic} + i];
+            output[p * {oc} + o] = {activation};
+        }}
+    }}
+}}'''
+
+
+def ref_pointwise(fn, node, tin, tout, p):
+    ih, iw, ic = tin['shape']
+    return reference_arrays(fn, p), REF_POINTWISE_TEMPLATE.format(
+        fn=fn, positions=ih * iw, ic=ic, oc=tout['shape'][2], activation=reference_activation(node))
+
+
+REF_AVGPOOL_TEMPLATE = '''static void {fn}(const float* input, float* output) {{
+    for (int c = 0; c < {ic}; c++) {{
+        float sum = 0.0f;
+        for (int p = 0; p < {positions}; p++) sum += input[p * {ic} + c];
+        output[c] = sum / {positions};
+    }}
+}}'''
+
+
+def ref_avgpool(fn, node, tin, tout, p):
+    ih, iw, ic = tin['shape']
+    return [], REF_AVGPOOL_TEMPLATE.format(fn=fn, positions=ih * iw, ic=ic)
+
+
+REF_FULLY_CONNECTED_TEMPLATE = '''static void {fn}(const float* input, float* output) {{
+    for (int k = 0; k < {oc}; k++) {{
+        float acc = {fn}_bias[k];
+        for (int i = 0; i < {inputs}; i++) acc += input[i] * {fn}_weights[k * {inputs} + i];
+        output[k] = acc;
+    }}
+}}'''
+
+
+def ref_fully_connected(fn, node, tin, tout, p):
+    return reference_arrays(fn, p), REF_FULLY_CONNECTED_TEMPLATE.format(
+        fn=fn, oc=tout['shape'][2], inputs=math.prod(tin['shape']))
+
+
+REF_SOFTMAX_TEMPLATE = '''static void {fn}(const float* input, float* output) {{
+    float peak = input[0];
+    for (int k = 1; k < {classes}; k++) peak = input[k] > peak ? input[k] : peak;
+    float total = 0.0f;
+    for (int k = 0; k < {classes}; k++) total += output[k] = expf(input[k] - peak);
+    for (int k = 0; k < {classes}; k++) output[k] /= total;
+}}'''
+
+
+def ref_softmax(fn, node, tin, tout, p):
+    return [], REF_SOFTMAX_TEMPLATE.format(fn=fn, classes=tout['shape'][2])
+
+
+REF_EMITTERS = {
+    'conv2d': ref_spatial,
+    'depthwise': ref_spatial,
+    'pointwise': ref_pointwise,
+    'avgpool': ref_avgpool,
+    'fully_connected': ref_fully_connected,
+    'softmax': ref_softmax,
+}
+
+REF_HEADER = '''// Generated by tools/model_converter.py --reference from {source}. Do not edit.
+#pragma once
+#include <cstdint>
+
+// Float reference of {name}: the int8 graph's weights dequantized, float
+// activations, no requantization or saturation. For host tools only.
+#define MODEL_REFERENCE_NAME "{name}"
+// 1: dequantized with scales recovered from the graph's own requantization
+// (no .tflite scales), so it shares the graph's calibration and only checks
+// the kernels, not how well the int8 model approximates the trained one.
+#define MODEL_REFERENCE_RECOVERED {recovered}
+#define MODEL_REFERENCE_LAYERS {layers} // One per graph node, in node order
+#define MODEL_REFERENCE_INPUT_SIZE {input_size}
+#define MODEL_REFERENCE_ACTIVATIONS {activations} // Floats of all layer outputs
+
+struct ReferenceLayer {{
+    const char* name;
+    uint16_t h, w, c;
+    uint32_t offset; // Floats from the start of the activation buffer
+}};
+
+extern const ReferenceLayer model_reference_layers[MODEL_REFERENCE_LAYERS];
+
+// `input` is the real-valued feature window ([h][w][c]); every layer's
+// output is written to activations + its offset.
+void model_reference_run(const float* input, float* activations);
+'''
+
+REF_SOURCE = '''// Generated by tools/model_converter.py --reference from {source}. Do not edit.
+#include "model_reference.h"
+#include <cmath>
+
+{sections}
+
+const ReferenceLayer model_reference_layers[MODEL_REFERENCE_LAYERS] = {{
+{layers}
+}};
+
+void model_reference_run(const float* input, float* activations) {{
+{calls}
+}}
+'''
+
+
+def write_reference(graph, params, output_dir, source, recovered):
+    tensors = graph['tensors']
+    used, sections, layers, calls = set(), [], [], []
+    offset, previous = 0, 'input'
+    for node, p in zip(graph['nodes'], params):
+        tin, tout = tensors[node['input']], tensors[node['output']]
+        fn = c_identifier(tout['name'], used, 'ref_')
+        data, body = REF_EMITTERS[node['op']](fn, node, tin, tout, p)
+        sections.append('\n\n'.join(data + [body]))
+        h, w, c = tout['shape']
+        layers.append(f'    {{"{tout["name"]}", {h}, {w}, {c}, {offset}}},')
+        calls.append(f'    {fn}({previous}, activations + {offset});')
+        previous = f'activations + {offset}'
+        offset += h * w * c
+    (output_dir / 'model_reference.h').write_text(REF_HEADER.format(
+        source=source, name=graph['name'], recovered=1 if recovered else 0, layers=len(layers),
+        input_size=math.prod(tensors[graph['input']]['shape']), activations=offset))
+    (output_dir / 'model_reference.cpp').write_text(REF_SOURCE.format(
+        source=source, sections='\n\n'.join(sections), layers='\n'.join(layers), calls='\n'.join(calls)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert an int8 DS-CNN into the graph ManualDSCNN runs.')
+    parser.add_argument('source', type=Path, help='model_int8.tflite, model_graph.json or a legacy model_weights.h')
+    parser.add_argument('output_dir', type=Path)
+    parser.add_argument('--aot', action='store_true',
+                        help='also emit model_aot.h/.cpp, straight-line C++ for -DDSCNN_BACKEND_AOT=1')
+    parser.add_argument('--int4', metavar='LAYERS',
+                        help='int4 weights for these layers: op kinds (conv2d, depthwise, pointwise), '
+                             'tensor names (b3_pw) or all, comma separated')
+    parser.add_argument('--blob', action='store_true',
+                        help='also write model_graph.kwsg, loadable by the host tools (eval_runner --graph)')
+    parser.add_argument('--reference', type=Path, metavar='DIR',
+                        help='also write the float reference (model_reference.h/.cpp) to DIR, '
+                             'e.g. tools/host/quant_check')
+    parser.add_argument('--golden', type=Path, metavar='FEATURES',
+                        help='with --reference: per-layer reference activations for the windows in '
+                             'FEATURES (quant_check --dump-features), written to DIR/model_golden.bin')
+    parser.add_argument('--symbol', default='model_graph',
+                        help='name of the emitted GraphModel and its files; another name adds a keyword '
+                             'model next to the built-in one (WakeWordDetector::addKeyword)')
+    parser.add_argument('--placeholder-scales', action='store_true',
+                        help='accept a graph without real activation scales (a legacy model_weights.h); '
+                             'ManualDSCNN refuses it unless built with DSCNN_ALLOW_PLACEHOLDER_SCALES=1')
+    args = parser.parse_args()
+    if not re.fullmatch(r'[A-Za-z_][A-Za-z0-9_]*', args.symbol):
+        raise SystemExit(f'--symbol {args.symbol} is not a C identifier')
+    if args.symbol != 'model_graph' and (args.aot or args.blob):
+        raise SystemExit('--aot and --blob only apply to the built-in model_graph')
+    source, output_dir = args.source, args.output_dir
+    if source.suffix == '.tflite':
+        graph = graph_from_tflite(source)
+    elif source.suffix == '.json':
+        graph = json.loads(source.read_text())
+    elif source.suffix == '.h':
+        graph = graph_from_legacy_header(source)
+    else:
+        raise SystemExit(f'Unknown input type: {source}')
+
+    if graph.get('placeholder_scales') and not args.placeholder_scales:
+        raise SystemExit(f'{source}: no activation scales (placeholders of 1.0 and hand-tuned requantization '
+                         'would stand in); convert the .tflite export, or pass --placeholder-scales')
+    for node in graph['nodes']:
+        if node['op'] not in OPS:
+            raise SystemExit(f'Op {node["op"]} has no C++ kernel')
+    if args.golden and not args.reference:
+        raise SystemExit('--golden needs --reference')
+    # Dequantized before --int4, so the reference stays the int8 model.
+    recovered = bool(args.reference) and any(node.get('weights') and 'weight_scale' not in node
+                                             for node in graph['nodes'])
+    if recovered and not args.placeholder_scales:
+        raise SystemExit(f'{source}: --reference needs the .tflite weight scales, which a legacy header or an '
+                         '--int4 graph lacks; convert the .tflite export, or pass --placeholder-scales for a '
+                         'reference recovered from the graph\'s own requantization')
+    reference = reference_params(graph, recovered) if args.reference else None
+    if args.int4:
+        apply_precision(graph, args.int4)
+    plan_arena(graph)
+    output_dir.mkdir(parents=True, exist_ok=True)
+    # Number lists stay on one line so weights do not take a line per value.
+    text = re.sub(r'\[\s+([-0-9.e,\s]+?)\s+\]', lambda m: '[' + ' '.join(m.group(1).split()) + ']',
+                  json.dumps(graph, indent=1))
+    (output_dir / f'{args.symbol}.json').write_text(text + '\n')
+    write_sources(graph, output_dir, source.name, args.symbol)
+    outputs = [f'{args.symbol}.{ext}' for ext in ('json', 'h', 'cpp')]
+    if args.aot:
+        write_aot(graph, output_dir, source.name)
+        outputs += ['model_aot.h', 'model_aot.cpp']
+    if args.blob:
+        write_blob(graph, output_dir / 'model_graph.kwsg')
+        outputs.append('model_graph.kwsg')
+    if reference:
+        args.reference.mkdir(parents=True, exist_ok=True)
+        write_reference(graph, reference, args.reference, source.name, recovered)
+        outputs += [str(args.reference / 'model_reference.h'), str(args.reference / 'model_reference.cpp')]
+        if args.golden:
+            windows = write_golden(graph, reference, args.golden, args.reference / 'model_golden.bin')
+            outputs.append(f'{args.reference / "model_golden.bin"} ({windows} windows)')
+    ops = ', '.join(node['op'] for node in graph['nodes'])
+    print(f'{graph["name"]}: {len(graph["nodes"])} nodes ({ops}), arena {graph["arena_size"]} bytes')
+    print(f'  {precision_summary(graph)}')
+    if graph.get('placeholder_scales'):
+        print('  Placeholder activation scales: runs only with DSCNN_ALLOW_PLACEHOLDER_SCALES=1')
+    if recovered:
+        print('  Reference recovered from the graph\'s own requantization: checks the kernels only')
+    print(f'Generated in {output_dir}: {", ".join(outputs)}')
 
-    print(f"Generated: {output_h}")
 
 if __name__ == '__main__':
-    if len(sys.argv) < 3:
-        print("Usage: python model_converter.py <model_int8.tflite> <output_dir>")
-        sys.exit(1)
-    tflite_path = Path(sys.argv[1])
-    output_dir = Path(sys.argv[2])
-    output_h = output_dir / 'model_weights.h'
-    convert_tflite_to_c_arrays(tflite_path, output_h)
\ No newline at end of file
+    main()
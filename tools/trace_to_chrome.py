@@ -0,0 +1,74 @@
+import json
+import sys
+from pathlib import Path
+
+
+def parse_trace_dump(lines):
+    """Parse the TRACE-BEGIN/TRACE-END block written by Trace::dump()."""
+    names = {}
+    lanes = {}
+    ts_hz = None
+    ts_bits = 32
+    inside = False
+    for line in lines:
+        line = line.strip()
+        if line.startswith('TRACE-BEGIN'):
+            inside = True
+            names.clear()
+            lanes.clear()
+            fields = dict(f.split('=', 1) for f in line.split()[2:] if '=' in f)
+            ts_hz = int(fields.get('ts_hz', '240000000'))
+            ts_bits = int(fields.get('ts_bits', '32'))
+            continue
+        if not inside:
+            continue
+        if line.startswith('TRACE-END'):
+            break
+        if line.startswith('N '):
+            _, name_id, name = line.split(' ', 2)
+            names[int(name_id)] = name
+        elif line.startswith('R '):
+            _, lane, ts, ph, name_id = line.split()
+            lanes.setdefault(int(lane), []).append((int(ts, 16), ph, int(name_id)))
+    if ts_hz is None:
+        raise ValueError('no TRACE-BEGIN block found')
+    return names, lanes, ts_hz, ts_bits
+
+
+def to_chrome_events(names, lanes, ts_hz, ts_bits):
+    # Device timestamps are a free-running 32-bit cycle counter: unwrap each
+    # lane, then rebase every lane on the earliest record.
+    unwrapped = {}
+    for lane, records in lanes.items():
+        offset, prev, out = 0, None, []
+        for ts, ph, name_id in records:
+            if prev is not None and ts < prev and ts_bits < 64:
+                offset += 1 << ts_bits
+            prev = ts
+            out.append((ts + offset, ph, name_id))
+        unwrapped[lane] = out
+    origin = min((r[0][0] for r in unwrapped.values() if r), default=0)
+
+    events = []
+    for lane, records in sorted(unwrapped.items()):
+        depth = 0
+        for ts, ph, name_id in records:
+            if ph == 'E' and depth == 0:
+                continue
+            depth += 1 if ph == 'B' else -1 if ph == 'E' else 0
+            event = {'name': names.get(name_id, f'#{name_id}'), 'ph': ph,
+                     'ts': (ts - origin) * 1e6 / ts_hz, 'pid': 0, 'tid': lane}
+            if ph == 'i':
+                event['s'] = 't'
+            events.append(event)
+    return events
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        print("Usage: python trace_to_chrome.py <serial_log.txt> <trace.json>")
+        sys.exit(1)
+    names, lanes, ts_hz, ts_bits = parse_trace_dump(Path(sys.argv[1]).read_text(errors='replace').splitlines())
+    events = to_chrome_events(names, lanes, ts_hz, ts_bits)
+    Path(sys.argv[2]).write_text(json.dumps({'traceEvents': events, 'displayTimeUnit': 'ns'}))
+    print(f"Wrote {len(events)} events to {sys.argv[2]} (open in ui.perfetto.dev or chrome://tracing)")